@@ -253,7 +253,14 @@ main(int argc, char** argv) {
   }
 
   // Decision -> Fib
-  ReplicateQueue<DecisionRouteUpdate> routeUpdatesQueue;
+  // ATTN: route updates are coalesced for a lagging reader (e.g. Fib retrying
+  // on agent failure) to bound the backlog
+  ReplicateQueue<DecisionRouteUpdate> routeUpdatesQueue(
+      messaging::QueueOptions<DecisionRouteUpdate>{
+          Constants::kQueueCoalesceThreshold,
+          [](DecisionRouteUpdate& pending, DecisionRouteUpdate& incoming) {
+            return pending.coalesce(incoming);
+          }});
   auto fibDecisionRouteUpdatesQueueReader =
       routeUpdatesQueue.getReader("fibDecision");
 
@@ -297,7 +304,17 @@ main(int argc, char** argv) {
       prefixUpdatesQueue.getReader("prefixManager");
 
   // KvStore -> Subscribers
-  ReplicateQueue<KvStorePublication> kvStoreUpdatesQueue;
+  // ATTN: consecutive publications are coalesced for a lagging reader.
+  // Initialization events are never merged and retain their order.
+  ReplicateQueue<KvStorePublication> kvStoreUpdatesQueue(
+      messaging::QueueOptions<KvStorePublication>{
+          Constants::kQueueCoalesceThreshold,
+          [](KvStorePublication& pending, KvStorePublication& incoming) {
+            auto* pendingPub = std::get_if<thrift::Publication>(&pending);
+            auto* incomingPub = std::get_if<thrift::Publication>(&incoming);
+            return pendingPub and incomingPub and
+                mergePublication(*pendingPub, *incomingPub);
+          }});
   auto decisionKvStoreUpdatesQueueReader =
       kvStoreUpdatesQueue.getReader("decision");
   auto prefixMgrKvStoreUpdatesReader =
@@ -334,7 +351,7 @@ main(int argc, char** argv) {
         orderedEvbs,
         nullptr /* watchdog won't monitor itself */,
         "watchdog",
-        std::make_unique<Watchdog>(config));
+        std::make_unique<Watchdog>(config, logSampleQueue));
   }
 
   // Create Netlink Protocol object in a new thread
@@ -405,6 +422,10 @@ main(int argc, char** argv) {
           config->getAreaIds(),
           config->toThriftKvStoreConfig()));
   watchdog->addQueue(kvStoreUpdatesQueue, "kvStoreUpdatesQueue");
+  // Monitor dedicated per-area event bases of KvStore, if enabled
+  for (auto* areaEvb : kvStore->getAreaEventBases()) {
+    watchdog->addEvb(areaEvb);
+  }
 
   Dispatcher* dispatcher{nullptr};
   if (config->isKvStoreDispatcherEnabled()) {
@@ -10,12 +10,14 @@
 namespace openr {
 
 constexpr folly::StringPiece Constants::kAdjDbMarker;
+constexpr folly::StringPiece Constants::kAdjDbShardMarker;
 constexpr folly::StringPiece Constants::kDefaultArea;
 constexpr folly::StringPiece Constants::kEventLogCategory;
 constexpr folly::StringPiece Constants::kNodeLabelRangePrefix;
 constexpr folly::StringPiece Constants::kOpenrCtrlSessionContext;
 constexpr folly::StringPiece Constants::kPlatformHost;
 constexpr folly::StringPiece Constants::kPrefixAllocMarker;
+constexpr folly::StringPiece Constants::kPrefixBundleMarker;
 constexpr folly::StringPiece Constants::kPrefixDbMarker;
 constexpr folly::StringPiece Constants::kPrefixNameSeparator;
 constexpr folly::StringPiece Constants::kSeedPrefixAllocLenSeparator;
@@ -24,13 +26,19 @@ constexpr folly::StringPiece Constants::kSparkMcastAddr;
 constexpr folly::StringPiece Constants::kStaticPrefixAllocParamKey;
 constexpr int32_t Constants::kDefaultPathPreference;
 constexpr int32_t Constants::kDefaultSourcePreference;
+constexpr int32_t Constants::kEvbStallTimeoutDivisor;
 constexpr int32_t Constants::kOpenrCtrlPort;
 constexpr int32_t Constants::kOpenrSupportedVersion;
 constexpr int32_t Constants::kOpenrVersion;
 constexpr int64_t Constants::kDefaultAdjWeight;
 constexpr int64_t Constants::kTtlInfinity;
+constexpr size_t Constants::kFibMaxInflightBatches;
+constexpr size_t Constants::kFibProgrammingBatchSize;
+constexpr size_t Constants::kKvStoreSubscriberMaxPendingBytes;
 constexpr size_t Constants::kMaxFullSyncPendingCountThreshold;
 constexpr size_t Constants::kNumTimeSeries;
+constexpr size_t Constants::kPolicyResultCacheMaxSize;
+constexpr size_t Constants::kQueueCoalesceThreshold;
 constexpr std::chrono::milliseconds Constants::kAdjacencyThrottleTimeout;
 constexpr std::chrono::milliseconds Constants::kFibInitialBackoff;
 constexpr std::chrono::milliseconds Constants::kFibMaxBackoff;
@@ -61,12 +69,16 @@ constexpr std::chrono::milliseconds Constants::kTtlInfInterval;
 constexpr std::chrono::milliseconds Constants::kTtlThreshold;
 constexpr std::chrono::seconds Constants::kConvergenceMaxDuration;
 constexpr std::chrono::seconds Constants::kCounterSubmitInterval;
+constexpr std::chrono::seconds Constants::kEvbStallThresholdMin;
 constexpr std::chrono::seconds Constants::kFloodTopoDumpInterval;
 constexpr std::chrono::seconds Constants::kMemoryThresholdTime;
 constexpr std::chrono::seconds Constants::kPlatformSyncInterval;
 constexpr std::chrono::seconds Constants::kPlatformThriftIdleTimeout;
 constexpr std::chrono::seconds Constants::kThriftClientKeepAliveInterval;
 constexpr uint16_t Constants::kPerfBufferSize;
+constexpr uint32_t Constants::kMaxAdjDbShards;
+constexpr std::chrono::milliseconds Constants::kAdjDbUnshardedClearDelay;
 constexpr uint32_t Constants::kMaxAllowedPps;
+constexpr uint32_t Constants::kMaxPrefixBundleShards;
 
 } // namespace openr
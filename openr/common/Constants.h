@@ -132,6 +132,14 @@ class Constants {
   // for the purpose of limiting the number of packets per second processed
   static constexpr size_t kNumTimeSeries{1024};
 
+  //
+  // Messaging specific
+  //
+
+  // Backlog of a replicated queue reader beyond which new route updates and
+  // KvStore publications are merged into the last pending one
+  static constexpr size_t kQueueCoalesceThreshold{8};
+
   //
   // Platform/Fib specific
   //
@@ -157,6 +165,11 @@ class Constants {
   static constexpr std::chrono::seconds kPlatformThriftIdleTimeout{
       Constants::kPlatformSyncInterval * 3};
 
+  // Incremental route updates are programmed in batches of bounded size with
+  // a bounded number of batches outstanding to the FibService at a time
+  static constexpr size_t kFibProgrammingBatchSize{1000};
+  static constexpr size_t kFibMaxInflightBatches{4};
+
   // PrefixAllocator address programming retry interval 100 ms
   static constexpr std::chrono::milliseconds kPrefixAllocatorRetryInterval{100};
 
@@ -179,6 +192,15 @@ class Constants {
   // RangeAllocator keys TTLs
   static constexpr std::chrono::milliseconds kRangeAllocTtl{5min};
 
+  // Bytes of publications a KvStore stream subscriber can lag behind, before
+  // its pending updates are dropped in favor of a resync snapshot
+  static constexpr size_t kKvStoreSubscriberMaxPendingBytes{64 * 1024 * 1024};
+
+  // Number of entries in a page of paginated read APIs, when unspecified by
+  // the client, and the upper bound of it
+  static constexpr size_t kDefaultPageSize{1000};
+  static constexpr size_t kMaxPageSize{10000};
+
   // delimiter separating prefix and name in kvstore key
   static constexpr folly::StringPiece kPrefixNameSeparator{":"};
 
@@ -191,7 +213,20 @@ class Constants {
 
   // KvStore key markers
   static constexpr folly::StringPiece kAdjDbMarker{"adj:"};
+  // sub-marker of adj keys carrying a shard of adjacency database, e.g.
+  // `adj:<node>:shard:<shard>`
+  static constexpr folly::StringPiece kAdjDbShardMarker{"shard"};
+  // upper limit of shards a node can spread its adjacency database across
+  static constexpr uint32_t kMaxAdjDbShards{1024};
+  // delay of withdrawing unsharded `adj:<node>` key after shards got first
+  // advertised, so that shards are flooded ahead of the empty database
+  static constexpr std::chrono::milliseconds kAdjDbUnshardedClearDelay{1000};
   static constexpr folly::StringPiece kPrefixDbMarker{"prefix:"};
+  // sub-marker of prefix keys carrying a bundle of prefix entries, e.g.
+  // `prefix:<node>:bundle:<shard>`
+  static constexpr folly::StringPiece kPrefixBundleMarker{"bundle"};
+  // upper limit of shards a node can spread its prefix bundles across
+  static constexpr uint32_t kMaxPrefixBundleShards{65536};
   static constexpr folly::StringPiece kPrefixAllocMarker{"allocprefix:"};
   static constexpr folly::StringPiece kNodeLabelRangePrefix{"nodeLabel:"};
 
@@ -228,6 +263,10 @@ class Constants {
   static constexpr int32_t kDefaultPathPreference{1000}; // LIVE routes
   static constexpr int32_t kDefaultSourcePreference{200}; // Source pref
 
+  // Upper bound of memoized policy results kept by PolicyManager. The cache is
+  // flushed entirely once the bound is hit.
+  static constexpr size_t kPolicyResultCacheMaxSize{200000};
+
   // Nexthops used to program drop route
   static constexpr folly::StringPiece kLocalRouteNexthopV4{"0.0.0.0"};
   static constexpr folly::StringPiece kLocalRouteNexthopV6{"::"};
@@ -253,6 +292,15 @@ class Constants {
 
   // Threshold time in secs to crash after reaching critical memory
   static constexpr std::chrono::seconds kMemoryThresholdTime{600};
+
+  // Eventbase not refreshing its timestamp for 1/kEvbStallTimeoutDivisor of
+  // watchdog thread_timeout_s is reported as stalled (well before considered
+  // dead)
+  static constexpr int32_t kEvbStallTimeoutDivisor{10};
+
+  // Lower bound of stall threshold. Eventbase timestamp is refreshed every
+  // second, any shorter threshold would report healthy eventbases
+  static constexpr std::chrono::seconds kEvbStallThresholdMin{2};
 };
 
 } // namespace openr
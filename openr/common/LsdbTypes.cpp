@@ -6,6 +6,7 @@
  */
 
 #include <fmt/core.h>
+#include <folly/hash/Hash.h>
 
 #include <openr/common/LsdbTypes.h>
 
@@ -50,4 +51,76 @@ PrefixKey::fromStr(const std::string& key, const std::string& areaIn) {
   return PrefixKey(node, network, areaIn);
 }
 
+PrefixBundleKey::PrefixBundleKey(
+    std::string const& node, uint32_t shardId, const std::string& area)
+    : nodeAndArea_(node, area),
+      shardId_(shardId),
+      prefixBundleKeyString_(fmt::format(
+          "{}{}:{}:{}",
+          Constants::kPrefixDbMarker.toString(),
+          node,
+          Constants::kPrefixBundleMarker.toString(),
+          shardId)) {}
+
+folly::Expected<PrefixBundleKey, std::string>
+PrefixBundleKey::fromStr(const std::string& key, const std::string& areaIn) {
+  uint32_t shardId{0};
+  std::string node{};
+
+  auto patt = RE2::FullMatch(
+      key, PrefixBundleKey::getPrefixBundleRE2(), &node, &shardId);
+  if (not patt) {
+    return folly::makeUnexpected(
+        fmt::format("Invalid format for bundle key: {}.", key));
+  }
+  return PrefixBundleKey(node, shardId, areaIn);
+}
+
+uint32_t
+PrefixBundleKey::getShardId(
+    folly::CIDRNetwork const& prefix, uint32_t numShards) {
+  CHECK_GT(numShards, 0);
+  // ATTN: hash on raw address bytes (instead of std::hash) to keep the
+  // assignment stable across restarts and builds.
+  auto hash =
+      folly::hash::fnv64_buf(prefix.first.bytes(), prefix.first.byteCount());
+  const uint8_t plen = prefix.second;
+  hash = folly::hash::fnv64_buf(&plen, sizeof(plen), hash);
+  return static_cast<uint32_t>(hash % numShards);
+}
+
+AdjDbShardKey::AdjDbShardKey(std::string const& node, uint32_t shardId)
+    : nodeName_(node),
+      shardId_(shardId),
+      adjDbShardKeyString_(fmt::format(
+          "{}{}:{}:{}",
+          Constants::kAdjDbMarker.toString(),
+          node,
+          Constants::kAdjDbShardMarker.toString(),
+          shardId)) {}
+
+folly::Expected<AdjDbShardKey, std::string>
+AdjDbShardKey::fromStr(const std::string& key) {
+  uint32_t shardId{0};
+  std::string node{};
+
+  auto patt =
+      RE2::FullMatch(key, AdjDbShardKey::getAdjDbShardRE2(), &node, &shardId);
+  if (not patt) {
+    return folly::makeUnexpected(
+        fmt::format("Invalid format for adj shard key: {}.", key));
+  }
+  return AdjDbShardKey(node, shardId);
+}
+
+uint32_t
+AdjDbShardKey::getShardId(
+    std::string const& otherNodeName, uint32_t numShards) {
+  CHECK_GT(numShards, 0);
+  // ATTN: fnv64 (instead of std::hash) to keep the assignment stable across
+  // restarts and builds.
+  return static_cast<uint32_t>(
+      folly::hash::fnv64(otherNodeName) % numShards);
+}
+
 } // namespace openr
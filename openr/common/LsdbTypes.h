@@ -481,8 +481,168 @@ class PrefixKey {
   std::string const prefixKeyStringV2_;
 };
 
+/**
+ * PrefixBundleKey class to form and parse the key of a prefix bundle. A prefix
+ * bundle packs multiple prefix entries originated by one node into a single
+ * KvStore key. Prefixes are spread across a fixed number of shards with stable
+ * assignment, so a change to one prefix rewrites exactly one bundle.
+ *
+ * Sample format:
+ *  prefix    :    node1    :    bundle    :    12
+ *    |              |              |            |
+ *  marker         nodeId     bundle-marker   shardId
+ */
+class PrefixBundleKey {
+ public:
+  // constructor using node, shard id and area
+  PrefixBundleKey(
+      std::string const& node, uint32_t shardId, const std::string& area);
+
+  // construct PrefixBundleKey object from a give key string
+  static folly::Expected<PrefixBundleKey, std::string> fromStr(
+      const std::string& key,
+      const std::string& area = Constants::kDefaultArea.toString());
+
+  static const RE2&
+  getPrefixBundleRE2() {
+    static const RE2 prefixBundleKeyPattern{fmt::format(
+        "{}(?P<node>[a-zA-Z\\d\\.\\-\\_]+):{}:(?P<shard>[\\d]{{1,5}})",
+        Constants::kPrefixDbMarker.toString(),
+        Constants::kPrefixBundleMarker.toString())};
+    return prefixBundleKeyPattern;
+  }
+
+  /*
+   * Stable shard assignment of a prefix among `numShards` bundles. It only
+   * depends on the prefix bytes so that the assignment survives restarts.
+   */
+  static uint32_t getShardId(
+      folly::CIDRNetwork const& prefix, uint32_t numShards);
+
+  // return node name and area pair
+  inline NodeAndArea const&
+  getNodeAndArea() const {
+    return nodeAndArea_;
+  }
+
+  // return node name
+  inline std::string const&
+  getNodeName() const {
+    return nodeAndArea_.first;
+  }
+
+  // return area of the bundle
+  inline std::string const&
+  getBundleArea() const {
+    return nodeAndArea_.second;
+  }
+
+  // return shard id of the bundle
+  inline uint32_t
+  getShardId() const {
+    return shardId_;
+  }
+
+  // return raw prefix bundle key string from kvstore
+  inline std::string const&
+  getPrefixBundleKeyStr() const {
+    return prefixBundleKeyString_;
+  }
+
+  bool
+  operator==(openr::PrefixBundleKey const& other) const {
+    return shardId_ == other.shardId_ && nodeAndArea_ == other.nodeAndArea_;
+  }
+
+ private:
+  // node name and area
+  NodeAndArea const nodeAndArea_;
+
+  // shard id
+  uint32_t const shardId_{0};
+
+  // raw key string from KvStore
+  std::string const prefixBundleKeyString_;
+};
+
+/**
+ * AdjDbShardKey class to form and parse the key of an adjacency database
+ * shard. A node may spread its adjacencies across a fixed number of shards,
+ * each advertised as a full thrift::AdjacencyDatabase carrying node attributes
+ * plus the adjacencies assigned to the shard. Assignment is by neighbor name,
+ * so parallel adjacencies towards one neighbor always share a shard.
+ *
+ * Sample format:
+ *    adj     :    node1    :    shard    :    12
+ *     |             |             |            |
+ *   marker        nodeId     shard-marker   shardId
+ */
+class AdjDbShardKey {
+ public:
+  AdjDbShardKey(std::string const& node, uint32_t shardId);
+
+  // construct AdjDbShardKey object from a give key string
+  static folly::Expected<AdjDbShardKey, std::string> fromStr(
+      const std::string& key);
+
+  static const RE2&
+  getAdjDbShardRE2() {
+    static const RE2 adjDbShardKeyPattern{fmt::format(
+        "{}(?P<node>[a-zA-Z\\d\\.\\-\\_]+):{}:(?P<shard>[\\d]{{1,5}})",
+        Constants::kAdjDbMarker.toString(),
+        Constants::kAdjDbShardMarker.toString())};
+    return adjDbShardKeyPattern;
+  }
+
+  /*
+   * Stable shard assignment of an adjacency among `numShards` shards. It only
+   * depends on the neighbor name so that the assignment survives restarts.
+   */
+  static uint32_t getShardId(
+      std::string const& otherNodeName, uint32_t numShards);
+
+  // return node name
+  inline std::string const&
+  getNodeName() const {
+    return nodeName_;
+  }
+
+  // return shard id
+  inline uint32_t
+  getShardId() const {
+    return shardId_;
+  }
+
+  // return raw adjacency shard key string from kvstore
+  inline std::string const&
+  getAdjDbShardKeyStr() const {
+    return adjDbShardKeyString_;
+  }
+
+ private:
+  // node name
+  std::string const nodeName_;
+
+  // shard id
+  uint32_t const shardId_{0};
+
+  // raw key string from KvStore
+  std::string const adjDbShardKeyString_;
+};
+
 } // namespace openr
 
+template <>
+struct std::hash<openr::PrefixBundleKey> {
+  size_t
+  operator()(openr::PrefixBundleKey const& bundleKey) const {
+    return folly::hash::hash_combine(
+        bundleKey.getNodeName(),
+        bundleKey.getShardId(),
+        bundleKey.getBundleArea());
+  }
+};
+
 template <>
 struct std::hash<openr::PrefixKey> {
   size_t
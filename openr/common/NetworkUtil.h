@@ -207,4 +207,14 @@ toIPNetwork(const thrift::IpPrefix& prefix, bool applyMask = true) {
   return network;
 }
 
+/**
+ * Check if `prefix` is the same as or a more specific prefix of `network`
+ */
+inline bool
+isPrefixWithin(
+    const folly::CIDRNetwork& prefix, const folly::CIDRNetwork& network) {
+  return prefix.second >= network.second and
+      prefix.first.inSubnet(network.first, network.second);
+}
+
 } // namespace openr
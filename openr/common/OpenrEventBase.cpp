@@ -5,6 +5,9 @@
  * LICENSE file in the root directory of this source tree.
  */
 
+#include <array>
+#include <atomic>
+
 #include <folly/fibers/FiberManagerMap.h>
 #include <folly/logging/xlog.h>
 
@@ -20,8 +23,59 @@ getFmOptions() {
   options.stackSize = 256 * 1024;
   return options;
 }
+
+// Loop busy time histogram covers [0, 100ms) with 100us buckets. Longer loops
+// land in the overflow bucket, while the exact max is tracked separately.
+constexpr int64_t kLoopBusyBucketUs{100};
+constexpr int64_t kLoopBusyMaxUs{100 * 1000};
+constexpr size_t kNumLoopBusyBuckets{kLoopBusyMaxUs / kLoopBusyBucketUs + 1};
 } // namespace
 
+struct EvbLoopCounters {
+  // Loop count per busy time bucket. Last bucket is the overflow one
+  std::array<std::atomic<uint64_t>, kNumLoopBusyBuckets> busyTimeBuckets{};
+  std::atomic<int64_t> maxBusyTimeUs{0};
+  std::atomic<uint64_t> numLoops{0};
+};
+
+namespace {
+// Records busy time of every loop iteration of the event base. Runs on every
+// loop, hence only updates atomics and never takes a lock.
+class LoopObserver : public folly::EventBaseObserver {
+ public:
+  explicit LoopObserver(std::shared_ptr<EvbLoopCounters> loopCounters)
+      : loopCounters_(std::move(loopCounters)) {}
+
+  uint32_t
+  getSampleRate() const override {
+    return 1;
+  }
+
+  void
+  loopSample(int64_t busyTime, int64_t /* idleTime */) override {
+    const auto bucket = std::min<size_t>(
+        std::max<int64_t>(busyTime, 0) / kLoopBusyBucketUs,
+        kNumLoopBusyBuckets - 1);
+    loopCounters_->busyTimeBuckets[bucket].fetch_add(
+        1, std::memory_order_relaxed);
+    // Max may be reset concurrently by Watchdog, hence compare-exchange
+    auto maxBusyTimeUs =
+        loopCounters_->maxBusyTimeUs.load(std::memory_order_relaxed);
+    while (busyTime > maxBusyTimeUs &&
+           not loopCounters_->maxBusyTimeUs.compare_exchange_weak(
+               maxBusyTimeUs, busyTime, std::memory_order_relaxed)) {
+    }
+    loopCounters_->numLoops.fetch_add(1, std::memory_order_relaxed);
+  }
+
+ private:
+  std::shared_ptr<EvbLoopCounters> loopCounters_;
+};
+} // namespace
+
+EvbLoopStats::EvbLoopStats()
+    : busyTimeUs(kLoopBusyBucketUs, 0, kLoopBusyMaxUs) {}
+
 EventBaseStopSignalHandler::EventBaseStopSignalHandler(folly::EventBase* evb)
     : folly::AsyncSignalHandler(evb) {
   registerSignalHandler(SIGINT);
@@ -57,7 +111,10 @@ OpenrEventBase::OpenrEventHandler::handlerReady(uint16_t events) noexcept {
 }
 
 OpenrEventBase::OpenrEventBase()
-    : fiberManager_(folly::fibers::getFiberManager(evb_, getFmOptions())) {
+    : fiberManager_(folly::fibers::getFiberManager(evb_, getFmOptions())),
+      loopCounters_(std::make_shared<EvbLoopCounters>()) {
+  evb_.setObserver(std::make_shared<LoopObserver>(loopCounters_));
+
   // Periodic timer to update eventbase's timestamp. This is used by Watchdog to
   // identify stuck threads.
   // update aliveness timestamp
@@ -85,6 +142,27 @@ OpenrEventBase::stop() {
   evb_.terminateLoopSoon();
 }
 
+EvbLoopStats
+OpenrEventBase::getAndResetLoopStats() {
+  // Counters are reset one by one while the loop keeps updating them. A loop
+  // iteration racing with this may be partially accounted in next interval.
+  EvbLoopStats stats;
+  for (size_t i = 0; i < kNumLoopBusyBuckets; ++i) {
+    const auto count = loopCounters_->busyTimeBuckets[i].exchange(
+        0, std::memory_order_relaxed);
+    if (count) {
+      // Samples are approximated by the middle of their bucket
+      stats.busyTimeUs.addRepeatedValue(
+          i * kLoopBusyBucketUs + kLoopBusyBucketUs / 2, count);
+    }
+  }
+  stats.maxBusyTimeUs =
+      loopCounters_->maxBusyTimeUs.exchange(0, std::memory_order_relaxed);
+  stats.numLoops =
+      loopCounters_->numLoops.exchange(0, std::memory_order_relaxed);
+  return stats;
+}
+
 bool
 OpenrEventBase::isRunning() const {
   return evb_.isRunning();
@@ -12,6 +12,7 @@
 #include <folly/fibers/FiberManager.h>
 #include <folly/io/async/AsyncSignalHandler.h>
 #include <folly/io/async/EventHandler.h>
+#include <folly/stats/Histogram.h>
 
 namespace openr {
 
@@ -25,6 +26,23 @@ class EventBaseStopSignalHandler : public folly::AsyncSignalHandler {
   void signalReceived(int signum) noexcept override;
 };
 
+// Lock-free loop counters, updated by the event base on every loop iteration
+struct EvbLoopCounters;
+
+/**
+ * Busy time of event loop iterations, i.e. time spent running callbacks,
+ * timers and fibers between two polls. A single module hogging its event base
+ * shows up as a high tail here long before Watchdog considers it dead.
+ */
+struct EvbLoopStats {
+  EvbLoopStats();
+
+  // Busy time per loop iteration in microseconds
+  folly::Histogram<int64_t> busyTimeUs;
+  int64_t maxBusyTimeUs{0};
+  uint64_t numLoops{0};
+};
+
 class OpenrEventBase {
  public:
   OpenrEventBase();
@@ -77,6 +95,11 @@ class OpenrEventBase {
         std::chrono::steady_clock::duration(timestamp_.load()));
   }
 
+  /**
+   * Get loop stats collected since last invocation, and reset them
+   */
+  EvbLoopStats getAndResetLoopStats();
+
   /**
    * Runnable interface APIs
    */
@@ -157,6 +180,9 @@ class OpenrEventBase {
 
   // Timestamp
   std::atomic<std::chrono::steady_clock::duration::rep> timestamp_;
+
+  // Loop counters. Written by evb thread on every loop, read by Watchdog
+  std::shared_ptr<EvbLoopCounters> loopCounters_;
   std::unique_ptr<folly::AsyncTimeout> timeout_;
 
   // Unique name to identify eventbase
@@ -7,6 +7,11 @@
 
 #pragma once
 
+#include <algorithm>
+#include <memory>
+#include <optional>
+#include <vector>
+
 #include <boost/functional/hash.hpp>
 #include <folly/memory/MallctlHelper.h>
 #include <openr/common/Constants.h>
@@ -118,6 +123,16 @@ getUnixTimeStampMs() noexcept {
       .count();
 }
 
+/**
+ * Initial generation of state served by versioned read APIs. Seeded with wall
+ * clock so that a generation seen by client before process restart is not
+ * mistaken for the current one.
+ */
+inline int64_t
+getInitialGeneration() noexcept {
+  return getUnixTimeStampMs();
+}
+
 /**
  * template method to return jittered time based on:
  *
@@ -145,6 +160,98 @@ getCurrentTime() {
       std::chrono::system_clock::now().time_since_epoch());
 }
 
+/**
+ * Resolve the number of entries in a page of paginated read APIs from the
+ * client requested limit. Non-positive limit selects the default.
+ */
+inline size_t
+getPageLimit(int32_t limit) {
+  if (limit <= 0) {
+    return Constants::kDefaultPageSize;
+  }
+  return std::min(static_cast<size_t>(limit), Constants::kMaxPageSize);
+}
+
+/**
+ * Sorted snapshot of keys of a container shared across page requests of a
+ * stream, so that the container is scanned and sorted only once per stream.
+ * Built on first use, i.e. while empty.
+ */
+template <typename Key>
+using PageKeysSnapshot = std::shared_ptr<std::vector<Key>>;
+
+/**
+ * Select a page of at most `limit` entries of an associative container.
+ * Only entries with key greater than `cursor` (if specified) and accepted by
+ * `filter` (invoked with the entry) are considered, and the smallest of them
+ * by key are returned in ascending order. Cost is O(n + limit * log(limit))
+ * for hash containers as the container is never sorted as a whole.
+ *
+ * With `sortedKeys` snapshot, the page is resumed from the cursor within the
+ * snapshot instead, at O(log n + limit) after the snapshot got built. Keys
+ * added after the snapshot are not visited, removed ones are skipped.
+ *
+ * @return iterators to the selected entries, and whether there are more
+ *         entries left after the page
+ */
+template <typename Container, typename Filter>
+std::pair<std::vector<typename Container::const_iterator>, bool>
+selectPage(
+    const Container& container,
+    const std::optional<typename Container::key_type>& cursor,
+    size_t limit,
+    Filter&& filter,
+    std::vector<typename Container::key_type>* sortedKeys = nullptr) {
+  using Iterator = typename Container::const_iterator;
+  std::vector<Iterator> page;
+
+  if (sortedKeys) {
+    if (sortedKeys->empty()) {
+      sortedKeys->reserve(container.size());
+      for (auto const& entry : container) {
+        if (filter(entry)) {
+          sortedKeys->emplace_back(entry.first);
+        }
+      }
+      std::sort(sortedKeys->begin(), sortedKeys->end());
+    }
+    auto keyIt = cursor.has_value()
+        ? std::upper_bound(sortedKeys->cbegin(), sortedKeys->cend(), *cursor)
+        : sortedKeys->cbegin();
+    for (; keyIt != sortedKeys->cend(); ++keyIt) {
+      auto it = container.find(*keyIt);
+      if (it == container.cend() or not filter(*it)) {
+        continue;
+      }
+      if (page.size() == limit) {
+        return {std::move(page), true};
+      }
+      page.emplace_back(it);
+    }
+    return {std::move(page), false};
+  }
+
+  for (auto it = container.cbegin(); it != container.cend(); ++it) {
+    if (cursor.has_value() and not(*cursor < it->first)) {
+      continue;
+    }
+    if (filter(*it)) {
+      page.emplace_back(it);
+    }
+  }
+
+  auto const keyLess = [](const Iterator& lhs, const Iterator& rhs) {
+    return lhs->first < rhs->first;
+  };
+  bool const hasMore = page.size() > limit;
+  if (hasMore) {
+    std::nth_element(page.begin(), page.begin() + limit, page.end(), keyLess);
+    page.resize(limit);
+  }
+  std::sort(page.begin(), page.end(), keyLess);
+  return {std::move(page), hasMore};
+}
+
 /**
  * Utility functions for conversion between thrift objects and string/IOBuf
  */
@@ -9,6 +9,7 @@
 #include <gtest/gtest.h>
 
 #include <openr/common/LsdbTypes.h>
+#include <openr/common/LsdbUtil.h>
 
 using namespace openr;
 
@@ -54,6 +55,83 @@ TEST(TypesTest, fromStrTest) {
   EXPECT_TRUE(PrefixKey::fromStr(invalidStrWithBadPrefixV2, areaId).hasError());
 }
 
+TEST(TypesTest, prefixBundleKeyTest) {
+  const std::string nodeName{"node-1"};
+  const std::string areaId{"default-area"};
+
+  // form and parse bundle key
+  const PrefixBundleKey bundleKey(nodeName, 12, areaId);
+  EXPECT_EQ(
+      fmt::format(
+          "{}{}:{}:12",
+          Constants::kPrefixDbMarker.toString(),
+          nodeName,
+          Constants::kPrefixBundleMarker.toString()),
+      bundleKey.getPrefixBundleKeyStr());
+
+  auto maybeBundleKey =
+      PrefixBundleKey::fromStr(bundleKey.getPrefixBundleKeyStr(), areaId);
+  ASSERT_FALSE(maybeBundleKey.hasError());
+  EXPECT_EQ(bundleKey, maybeBundleKey.value());
+  EXPECT_EQ(nodeName, maybeBundleKey->getNodeName());
+  EXPECT_EQ(areaId, maybeBundleKey->getBundleArea());
+  EXPECT_EQ(12, maybeBundleKey->getShardId());
+
+  // per-prefix key is not a bundle key and vice versa
+  const PrefixKey prefixKey(
+      nodeName, folly::IPAddress::createNetwork("1.1.1.1/32"), areaId);
+  EXPECT_TRUE(
+      PrefixBundleKey::fromStr(prefixKey.getPrefixKeyV2(), areaId).hasError());
+  EXPECT_TRUE(
+      PrefixKey::fromStr(bundleKey.getPrefixBundleKeyStr(), areaId).hasError());
+  EXPECT_TRUE(PrefixBundleKey::fromStr(
+                  fmt::format(
+                      "{}{}:{}:",
+                      Constants::kPrefixDbMarker.toString(),
+                      nodeName,
+                      Constants::kPrefixBundleMarker.toString()),
+                  areaId)
+                  .hasError());
+
+  // shard assignment is stable and within range
+  const auto network = folly::IPAddress::createNetwork("fc00::1/128");
+  const auto shardId = PrefixBundleKey::getShardId(network, 16);
+  EXPECT_LT(shardId, 16);
+  EXPECT_EQ(shardId, PrefixBundleKey::getShardId(network, 16));
+  EXPECT_EQ(0, PrefixBundleKey::getShardId(network, 1));
+}
+
+TEST(TypesTest, adjDbShardKeyTest) {
+  const std::string nodeName{"node-1"};
+
+  // form and parse shard key
+  const AdjDbShardKey shardKey(nodeName, 7);
+  EXPECT_EQ(
+      fmt::format(
+          "{}{}:{}:7",
+          Constants::kAdjDbMarker.toString(),
+          nodeName,
+          Constants::kAdjDbShardMarker.toString()),
+      shardKey.getAdjDbShardKeyStr());
+
+  auto maybeShardKey = AdjDbShardKey::fromStr(shardKey.getAdjDbShardKeyStr());
+  ASSERT_FALSE(maybeShardKey.hasError());
+  EXPECT_EQ(nodeName, maybeShardKey->getNodeName());
+  EXPECT_EQ(7, maybeShardKey->getShardId());
+
+  // full adjacency database key is not a shard key
+  EXPECT_TRUE(
+      AdjDbShardKey::fromStr(Constants::kAdjDbMarker.toString() + nodeName)
+          .hasError());
+  EXPECT_EQ(nodeName, getNodeNameFromKey(shardKey.getAdjDbShardKeyStr()));
+
+  // shard assignment is stable and within range
+  const auto shardId = AdjDbShardKey::getShardId("node-2", 16);
+  EXPECT_LT(shardId, 16);
+  EXPECT_EQ(shardId, AdjDbShardKey::getShardId("node-2", 16));
+  EXPECT_EQ(0, AdjDbShardKey::getShardId("node-2", 1));
+}
+
 int
 main(int argc, char* argv[]) {
   // Parse command line flags
@@ -1119,6 +1119,86 @@ TEST(UtilTest, logInitializationEvent) {
       "initialization.KVSTORE_SYNCED.duration_ms"));
 }
 
+TEST(UtilTest, SelectPage) {
+  std::unordered_map<std::string, int> entries;
+  for (int i = 0; i < 10; ++i) {
+    entries.emplace(fmt::format("key{}", i), i);
+  }
+  auto const acceptAll = [](auto const&) { return true; };
+
+  // Page through all entries in order of keys
+  {
+    std::optional<std::string> cursor;
+    std::vector<int> values;
+    bool hasMore{true};
+    while (hasMore) {
+      auto [page, more] = selectPage(entries, cursor, 3, acceptAll);
+      EXPECT_LE(page.size(), 3);
+      for (auto const& it : page) {
+        values.emplace_back(it->second);
+      }
+      cursor = page.back()->first;
+      hasMore = more;
+    }
+    EXPECT_EQ(std::vector<int>({0, 1, 2, 3, 4, 5, 6, 7, 8, 9}), values);
+  }
+
+  // Filter is applied before bounding the page size
+  {
+    auto [page, hasMore] = selectPage(
+        entries, std::string("key2"), 2, [](auto const& entry) {
+          return entry.second % 2 == 0;
+        });
+    EXPECT_TRUE(hasMore);
+    ASSERT_EQ(2, page.size());
+    EXPECT_EQ("key4", page.at(0)->first);
+    EXPECT_EQ("key6", page.at(1)->first);
+  }
+
+  // Exact fit doesn't report more entries
+  {
+    auto [page, hasMore] =
+        selectPage(entries, std::string("key6"), 3, acceptAll);
+    EXPECT_FALSE(hasMore);
+    EXPECT_EQ(3, page.size());
+  }
+
+  // Pages resumed from sorted keys snapshot match the ones scanned, while
+  // entries removed meanwhile are skipped
+  {
+    std::vector<std::string> sortedKeys;
+    auto [page, hasMore] =
+        selectPage(entries, std::nullopt, 3, acceptAll, &sortedKeys);
+    EXPECT_TRUE(hasMore);
+    ASSERT_EQ(3, page.size());
+    EXPECT_EQ("key2", page.back()->first);
+    EXPECT_EQ(10, sortedKeys.size());
+
+    auto copy = entries;
+    copy.erase("key3");
+    copy.emplace("key30", 30);
+    std::tie(page, hasMore) =
+        selectPage(copy, std::string("key2"), 3, acceptAll, &sortedKeys);
+    EXPECT_TRUE(hasMore);
+    ASSERT_EQ(3, page.size());
+    EXPECT_EQ("key4", page.at(0)->first);
+    EXPECT_EQ("key6", page.at(2)->first);
+
+    std::tie(page, hasMore) =
+        selectPage(copy, std::string("key6"), 3, acceptAll, &sortedKeys);
+    EXPECT_FALSE(hasMore);
+    EXPECT_EQ(3, page.size());
+  }
+
+  // Page limit
+  EXPECT_EQ(Constants::kDefaultPageSize, getPageLimit(0));
+  EXPECT_EQ(Constants::kDefaultPageSize, getPageLimit(-1));
+  EXPECT_EQ(10, getPageLimit(10));
+  EXPECT_EQ(
+      Constants::kMaxPageSize,
+      getPageLimit(std::numeric_limits<int32_t>::max()));
+}
+
 int
 main(int argc, char* argv[]) {
   // Parse command line flags
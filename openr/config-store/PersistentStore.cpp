@@ -5,9 +5,11 @@
  * LICENSE file in the root directory of this source tree.
  */
 
+#include <folly/Exception.h>
 #include <folly/FileUtil.h>
 #include <folly/io/IOBuf.h>
 #include <folly/logging/xlog.h>
+#include <folly/system/MemoryMapping.h>
 
 #include <openr/common/Util.h>
 #include <openr/config-store/PersistentStore.h>
@@ -17,8 +19,22 @@ using std::exception;
 
 namespace {
 
+// Number of PersistentObjects appended to log before it gets compacted
 static const long kDbFlushRatio = 10000;
 
+// Apply Add/Delete persistentObject to/from `database`
+void
+applyPersistentObject(
+    std::unordered_map<std::string, std::string>& database,
+    const openr::PersistentObject& pObject) {
+  if (pObject.type == openr::ActionType::ADD) {
+    database.insert_or_assign(
+        pObject.key, pObject.data.has_value() ? pObject.data.value() : "");
+  } else if (pObject.type == openr::ActionType::DEL) {
+    database.erase(pObject.key);
+  }
+}
+
 } // anonymous namespace
 
 namespace openr {
@@ -30,22 +46,11 @@ PersistentStore::PersistentStore(
     : storageFilePath_(*config->getConfig().persistent_config_store_path()),
       dryrun_(dryrun) {
   if (periodicallySaveToDisk) {
-    // Create timer and backoff mechanism only if backoff is requested
+    // Create backoff mechanism only if retry is requested
     saveDbTimerBackoff_ =
         std::make_unique<ExponentialBackoff<std::chrono::milliseconds>>(
             Constants::kPersistentStoreInitialBackoff,
             Constants::kPersistentStoreMaxBackoff);
-
-    saveDbTimer_ = folly::AsyncTimeout::make(*getEvb(), [this]() noexcept {
-      if (savePersistentObjectToDisk()) {
-        saveDbTimerBackoff_->reportSuccess();
-      } else {
-        // Report error and schedule next-try
-        saveDbTimerBackoff_->reportError();
-        saveDbTimer_->scheduleTimeout(
-            saveDbTimerBackoff_->getTimeRemainingUntilRetry());
-      }
-    });
   }
 
   // Load initial database. On failure we will just report error and continue
@@ -54,10 +59,29 @@ PersistentStore::PersistentStore(
     XLOG(ERR) << "Failed to load config-database from file: "
               << storageFilePath_;
   }
+  committedDatabase_ = database_;
+
+  diskWriterThread_ =
+      std::make_unique<folly::ScopedEventBaseThread>("config_store_writer");
 }
 
 PersistentStore::~PersistentStore() {
-  saveDatabaseToDisk();
+  // Finish in-flight writes before taking over the file
+  diskWriterThread_.reset();
+  logFile_.reset();
+
+  // Whole database is on disk now, if written successfully. Complete any
+  // uncommitted objects accordingly.
+  folly::exception_wrapper error;
+  if (not saveDatabaseToDisk(database_)) {
+    error = folly::make_exception_wrapper<std::runtime_error>(
+        "Failed to write database to file '" + storageFilePath_.string() +
+        "'");
+  }
+  auto onCommits = std::move(pendingObjects_.wlock()->onCommits);
+  for (auto& onCommit : onCommits) {
+    onCommit(error);
+  }
 }
 
 folly::SemiFuture<folly::Unit>
@@ -73,9 +97,15 @@ PersistentStore::store(std::string key, std::string value) {
     // Override previous value if any
     database_.insert_or_assign(key, value);
     auto pObject = toPersistentObject(ActionType::ADD, key, value);
-    pObjects_.emplace_back(std::move(pObject));
-    maybeSaveObjectToDisk();
-    p.setValue();
+    enqueueObject(
+        std::move(pObject),
+        [p = std::move(p)](folly::exception_wrapper error) mutable noexcept {
+          if (error) {
+            p.setException(std::move(error));
+          } else {
+            p.setValue();
+          }
+        });
   });
   return sf;
 }
@@ -89,9 +119,16 @@ PersistentStore::erase(std::string key) {
         SYSLOG(INFO) << "Erase key: " << key << " from config-store";
         if (database_.erase(key) > 0) {
           auto pObject = toPersistentObject(ActionType::DEL, key, "");
-          pObjects_.emplace_back(std::move(pObject));
-          maybeSaveObjectToDisk();
-          p.setValue(true);
+          enqueueObject(
+              std::move(pObject),
+              [p = std::move(p)](
+                  folly::exception_wrapper error) mutable noexcept {
+                if (error) {
+                  p.setException(std::move(error));
+                } else {
+                  p.setValue(true);
+                }
+              });
         } else {
           XLOG(WARNING) << "Key: " << key << " doesn't exist";
           p.setValue(false);
@@ -117,73 +154,188 @@ PersistentStore::load(std::string key) {
 }
 
 void
-PersistentStore::maybeSaveObjectToDisk() noexcept {
+PersistentStore::enqueueObject(
+    PersistentObject pObject, OnCommit onCommit) noexcept {
+  if (dryrun_) {
+    XLOG(DBG1) << "Skipping writing to disk in dryrun mode";
+    numOfWritesToDisk_++;
+    onCommit(folly::exception_wrapper());
+    return;
+  }
+
+  // Queue object. Objects queued while disk-writer is busy get committed
+  // together with its next write.
+  bool scheduleWrite{false};
+  pendingObjects_.withWLock([&](auto& pending) {
+    pending.pObjects.emplace_back(std::move(pObject));
+    pending.onCommits.emplace_back(std::move(onCommit));
+    scheduleWrite = not std::exchange(pending.writeScheduled, true);
+  });
+  if (scheduleWrite) {
+    diskWriterThread_->getEventBase()->runInEventBaseThread(
+        [this]() noexcept { savePersistentObjectToDisk(); });
+  }
+
+  // Compact log once it has grown enough. Database to write is built on
+  // disk-writer thread from what is committed so far plus all the queued
+  // objects, hence it never misses an object appended in the meantime.
+  if (++numOfNewWritesToDisk_ >= kDbFlushRatio) {
+    numOfNewWritesToDisk_ = 0;
+    diskWriterThread_->getEventBase()->runInEventBaseThread(
+        [this]() noexcept { compactDatabaseOnDisk(); });
+  }
+}
+
+void
+PersistentStore::takePendingObjects(
+    std::vector<PersistentObject>& pObjects,
+    std::vector<OnCommit>& onCommits) noexcept {
+  pendingObjects_.withWLock([&](auto& pending) {
+    pObjects = std::move(pending.pObjects);
+    onCommits = std::move(pending.onCommits);
+    pending.pObjects.clear();
+    pending.onCommits.clear();
+    pending.writeScheduled = false;
+  });
+}
+
+void
+PersistentStore::retryPendingObjects(
+    std::vector<PersistentObject>&& pObjects,
+    std::vector<OnCommit>&& onCommits,
+    folly::exception_wrapper error) noexcept {
+  // Objects stay uncommitted. Database is kept in memory and written out on
+  // destruction in any case. Without retry, nothing would complete them, so
+  // fail their completions now. Objects go out with the next write.
   if (not saveDbTimerBackoff_) {
-    // This is primarily used for unit testing to save DB immediately
-    // Block the response till file is saved
-    savePersistentObjectToDisk();
-  } else if (not saveDbTimer_->isScheduled()) {
-    saveDbTimer_->scheduleTimeout(
-        saveDbTimerBackoff_->getTimeRemainingUntilRetry());
+    for (auto& onCommit : onCommits) {
+      onCommit(error);
+    }
+    onCommits.clear();
+  }
+  bool scheduleRetry{false};
+  pendingObjects_.withWLock([&](auto& pending) {
+    pObjects.insert(
+        pObjects.end(),
+        std::make_move_iterator(pending.pObjects.begin()),
+        std::make_move_iterator(pending.pObjects.end()));
+    onCommits.insert(
+        onCommits.end(),
+        std::make_move_iterator(pending.onCommits.begin()),
+        std::make_move_iterator(pending.onCommits.end()));
+    pending.pObjects = std::move(pObjects);
+    pending.onCommits = std::move(onCommits);
+    scheduleRetry = saveDbTimerBackoff_ and
+        not std::exchange(pending.writeScheduled, true);
+  });
+  if (scheduleRetry) {
+    saveDbTimerBackoff_->reportError();
+    diskWriterThread_->getEventBase()->runAfterDelay(
+        [this]() noexcept { savePersistentObjectToDisk(); },
+        saveDbTimerBackoff_->getTimeRemainingUntilRetry().count());
   }
 }
 
 bool
 PersistentStore::savePersistentObjectToDisk() noexcept {
-  if (not dryrun_) {
-    // Write PersistentObject to ioBuf
-    std::vector<PersistentObject> newObjects;
-    newObjects = std::move(pObjects_);
-
-    auto queue = folly::IOBufQueue(folly::IOBufQueue::cacheChainLength());
+  // Take all objects queued so far
+  std::vector<PersistentObject> newObjects;
+  std::vector<OnCommit> onCommits;
+  takePendingObjects(newObjects, onCommits);
+  if (newObjects.empty()) {
+    return true;
+  }
 
-    for (auto& pObject : newObjects) {
-      auto buf = encodePersistentObject(pObject);
-      if (buf.hasError()) {
-        XLOG(ERR) << "Failed to encode PersistentObject to ioBuf. Error: "
-                  << buf.error();
-        return false;
-      }
-      queue.append(std::move(**buf));
+  // Write PersistentObject to ioBuf
+  auto queue = folly::IOBufQueue(folly::IOBufQueue::cacheChainLength());
+  folly::exception_wrapper error;
+  for (auto& pObject : newObjects) {
+    auto buf = encodePersistentObject(pObject);
+    if (buf.hasError()) {
+      XLOG(ERR) << "Failed to encode PersistentObject to ioBuf. Error: "
+                << buf.error();
+      error = folly::make_exception_wrapper<std::runtime_error>(
+          "Failed to encode PersistentObject: " + buf.error());
+      break;
     }
+    queue.append(std::move(**buf));
+  }
 
-    // Append IoBuf to disk
+  // Append IoBuf to disk
+  if (not error) {
     auto ioBuf = queue.move();
-    auto success = writeIoBufToDisk(ioBuf, WriteType::APPEND);
-    if (success.hasError()) {
+    auto writeSuccess = writeIoBufToDisk(ioBuf, WriteType::APPEND);
+    if (writeSuccess.hasError()) {
       XLOG(ERR) << "Failed to write PersistentObject to file '"
-                << storageFilePath_ << "'. Error: " << success.error();
-      return false;
+                << storageFilePath_ << "'. Error: " << writeSuccess.error();
+      error = folly::make_exception_wrapper<std::runtime_error>(
+          "Failed to write PersistentObject to file '" +
+          storageFilePath_.string() + "': " + writeSuccess.error());
     }
+  }
 
-    numOfNewWritesToDisk_++;
-
-    // Write the whole database to disk periodically
-    if (numOfNewWritesToDisk_ >= kDbFlushRatio) {
-      numOfNewWritesToDisk_ = 0;
-      const auto startTs = std::chrono::steady_clock::now();
-      if (not saveDatabaseToDisk()) {
-        return false;
-      }
-      XLOG(INFO) << "Updated database on disk. Took "
-                 << std::chrono::duration_cast<std::chrono::milliseconds>(
-                        std::chrono::steady_clock::now() - startTs)
-                        .count()
-                 << "ms";
-    }
-  } else {
-    XLOG(DBG1) << "Skipping writing to disk in dryrun mode";
+  if (error) {
+    // Put objects back in front of newer ones and retry later
+    retryPendingObjects(
+        std::move(newObjects), std::move(onCommits), std::move(error));
+    return false;
   }
+
   numOfWritesToDisk_++;
+  if (saveDbTimerBackoff_) {
+    saveDbTimerBackoff_->reportSuccess();
+  }
+  for (const auto& pObject : newObjects) {
+    applyPersistentObject(committedDatabase_, pObject);
+  }
 
+  // Unblock callers of this group
+  for (auto& onCommit : onCommits) {
+    onCommit(folly::exception_wrapper());
+  }
   return true;
 }
 
+void
+PersistentStore::compactDatabaseOnDisk() noexcept {
+  const auto startTs = std::chrono::steady_clock::now();
+
+  // Fold queued objects into the compacted log rather than appending them
+  // to the log which is about to be replaced
+  std::vector<PersistentObject> newObjects;
+  std::vector<OnCommit> onCommits;
+  takePendingObjects(newObjects, onCommits);
+  auto database = committedDatabase_;
+  for (const auto& pObject : newObjects) {
+    applyPersistentObject(database, pObject);
+  }
+
+  if (not saveDatabaseToDisk(database)) {
+    retryPendingObjects(
+        std::move(newObjects),
+        std::move(onCommits),
+        folly::make_exception_wrapper<std::runtime_error>(
+            "Failed to write database to file '" + storageFilePath_.string() +
+            "'"));
+    return;
+  }
+  committedDatabase_ = std::move(database);
+  for (auto& onCommit : onCommits) {
+    onCommit(folly::exception_wrapper());
+  }
+  XLOG(INFO) << "Updated database on disk. Took "
+             << std::chrono::duration_cast<std::chrono::milliseconds>(
+                    std::chrono::steady_clock::now() - startTs)
+                    .count()
+             << "ms";
+}
+
 bool
-PersistentStore::saveDatabaseToDisk() noexcept {
+PersistentStore::saveDatabaseToDisk(
+    const std::unordered_map<std::string, std::string>& database) noexcept {
   std::unique_ptr<folly::IOBuf> ioBuf;
   // If database is empty, write 'kTlvFormatMarker' to disk and return
-  if (database_.empty()) {
+  if (database.empty()) {
     ioBuf = folly::IOBuf::copyBuffer(
         kTlvFormatMarker.data(), kTlvFormatMarker.size());
   } else {
@@ -191,8 +343,8 @@ PersistentStore::saveDatabaseToDisk() noexcept {
     auto queue = folly::IOBufQueue(folly::IOBufQueue::cacheChainLength());
     queue.append(kTlvFormatMarker.data(), kTlvFormatMarker.size());
 
-    // Encode database_ and append to queue
-    for (auto& keyPair : database_) {
+    // Encode database and append to queue
+    for (auto& keyPair : database) {
       PersistentObject pObject;
       pObject =
           toPersistentObject(ActionType::ADD, keyPair.first, keyPair.second);
@@ -227,26 +379,43 @@ PersistentStore::loadDatabaseFromDisk() noexcept {
     return true;
   }
 
-  // Read data from file
-  std::string fileData{""};
-  if (not folly::readFile(storageFilePath_.c_str(), fileData)) {
-    XLOG(ERR) << "Failed to read file contents from '" << storageFilePath_
-              << "'. Error (" << errno << "): " << folly::errnoStr(errno);
+  // Map file instead of reading it. Data gets copied out while decoding
+  // anyway, so there is no point in an intermediate copy of the whole file.
+  std::unique_ptr<folly::MemoryMapping> mapping;
+  try {
+    mapping = std::make_unique<folly::MemoryMapping>(storageFilePath_.c_str());
+  } catch (std::exception const& e) {
+    XLOG(ERR) << "Failed to map file contents from '" << storageFilePath_
+              << "'. Error: " << folly::exceptionStr(e);
     return false;
   }
 
   // Create IoBuf and cursor for loading data from disk (TlvFormat)
-  auto ioBuf = folly::IOBuf::wrapBuffer(fileData.c_str(), fileData.size());
+  auto range = mapping->range();
+  auto ioBuf = folly::IOBuf::wrapBuffer(range.data(), range.size());
   auto tlvSuccess = loadDatabaseTlvFormat(ioBuf);
   if (tlvSuccess.hasError()) {
     XLOG(ERR) << "Failed to read Tlv-format file contents from '"
               << storageFilePath_ << "'. Error: " << tlvSuccess.error();
     return false;
   }
+
+  // Cut off truncated trailing object, otherwise objects appended later on
+  // would follow it and could never be read back
+  const auto validLength = *tlvSuccess;
+  if (validLength < range.size() and not dryrun_) {
+    ioBuf.reset();
+    mapping.reset();
+    if (folly::truncateNoInt(storageFilePath_.c_str(), validLength) != 0) {
+      XLOG(ERR) << "Failed to truncate '" << storageFilePath_ << "' to "
+                << validLength << " bytes. Error: " << folly::errnoStr(errno);
+      return false;
+    }
+  }
   return true;
 }
 
-folly::Expected<folly::Unit, std::string>
+folly::Expected<size_t, std::string>
 PersistentStore::loadDatabaseTlvFormat(
     const std::unique_ptr<folly::IOBuf>& ioBuf) noexcept {
   // Parse ioBuf to persistentObject and then to `database_`
@@ -260,11 +429,18 @@ PersistentStore::loadDatabaseTlvFormat(
         folly::exceptionStr(e).toStdString());
   }
   // Iteratively read persistentObject from disk
+  size_t validLength{0};
   while (true) {
     // Read and decode into persistentObject
+    validLength = cursor.getCurrentPosition();
     auto optionalObject = decodePersistentObject(cursor);
     if (optionalObject.hasError()) {
-      return folly::makeUnexpected(optionalObject.error());
+      // Incomplete trailing object, e.g. interrupted append. Everything
+      // before it has been committed, hence keep it.
+      XLOG(WARNING) << "Ignoring truncated PersistentObject at the end of '"
+                    << storageFilePath_ << "'. Error: "
+                    << optionalObject.error();
+      break;
     }
 
     // Read finish
@@ -274,38 +450,48 @@ PersistentStore::loadDatabaseTlvFormat(
     auto pObject = std::move(optionalObject->value());
 
     // Add/Delete persistentObject to/from 'newDatabase'
-    if (pObject.type == ActionType::ADD) {
-      newDatabase.insert_or_assign(
-          pObject.key, pObject.data.has_value() ? pObject.data.value() : "");
-    } else if (pObject.type == ActionType::DEL) {
-      newDatabase.erase(pObject.key);
-    }
+    applyPersistentObject(newDatabase, pObject);
   }
   database_ = std::move(newDatabase);
-  return folly::Unit();
+  return validLength;
 }
 
-// Write over or append IoBuf to disk atomically
+// Write over IoBuf to disk atomically, or append and fsync it to log
 folly::Expected<folly::Unit, std::string>
 PersistentStore::writeIoBufToDisk(
     const std::unique_ptr<folly::IOBuf>& ioBuf, WriteType writeType) noexcept {
-  std::string fileData("");
   try {
-    ioBuf->coalesce();
-    fileData = ioBuf->moveToFbString().toStdString();
-
     if (writeType == WriteType::WRITE) {
-      // Write over
-      folly::writeFileAtomic(storageFilePath_.c_str(), fileData, 0666);
-    } else {
-      // Append to file
-      folly::writeFile(
-          fileData,
+      // Write over. Log file is replaced, re-open it on next append
+      ioBuf->coalesce();
+      folly::writeFileAtomic(
           storageFilePath_.c_str(),
-          O_WRONLY | O_APPEND | O_CREAT,
+          folly::ByteRange(ioBuf->data(), ioBuf->length()),
           0666);
+      logFile_.reset();
+      return folly::Unit();
+    }
+
+    // Append to file
+    if (not logFile_) {
+      logFile_.emplace(
+          storageFilePath_.c_str(), O_WRONLY | O_APPEND | O_CREAT, 0666);
+    }
+    const auto fd = logFile_->fd();
+    const auto offset = ::lseek(fd, 0, SEEK_END);
+    if (offset < 0) {
+      folly::throwSystemError("lseek failed");
+    }
+    auto iov = ioBuf->getIovec();
+    if (folly::writevFull(fd, iov.data(), iov.size()) < 0 or
+        folly::fsyncNoInt(fd) != 0) {
+      const auto err = errno;
+      // Drop partially written objects, so that later appends stay readable
+      folly::ftruncateNoInt(fd, offset);
+      folly::throwSystemError(err, "append failed");
     }
   } catch (std::exception const& e) {
+    logFile_.reset();
     return folly::makeUnexpected<std::string>(
         folly::exceptionStr(e).toStdString());
   }
@@ -17,7 +17,12 @@ namespace fs = std::experimental::filesystem;
 #endif
 #include <string>
 
+#include <folly/ExceptionWrapper.h>
+#include <folly/File.h>
+#include <folly/Function.h>
+#include <folly/Synchronized.h>
 #include <folly/futures/Future.h>
+#include <folly/io/async/ScopedEventBaseThread.h>
 #include <thrift/lib/cpp2/protocol/Serializer.h>
 
 #include <openr/common/Constants.h>
@@ -51,6 +56,14 @@ struct PersistentObject {
  *
  * `storageFilePath`: Describe the path of file in file system where data will
  * be stored/retrieved from (in binary format).
+ *
+ * The file is a write-ahead log of TLV encoded PersistentObjects. Updates are
+ * applied to the in-memory `database_` on the event base and handed to a
+ * disk-writer thread, which appends everything queued since its last write
+ * with a single write+fsync (group commit). `store()`/`erase()` complete
+ * once their record is committed. Every `kDbFlushRatio` records the log is
+ * compacted on the disk-writer thread from its own copy of the committed
+ * database, hence `load()` never waits behind disk IO.
  */
 class PersistentStore : public OpenrEventBase {
  public:
@@ -118,21 +131,47 @@ class PersistentStore : public OpenrEventBase {
   }
 
  private:
-  // Function to save/load `database_` to local disk. Returns true on success
+  // Function to save/load database to local disk. Returns true on success
   // else false. Doesn't throw exception.
-  bool saveDatabaseToDisk() noexcept;
+  bool saveDatabaseToDisk(
+      const std::unordered_map<std::string, std::string>& database) noexcept;
   bool loadDatabaseFromDisk() noexcept;
 
-  // Load TlvFormat from disk
-  folly::Expected<folly::Unit, std::string> loadDatabaseTlvFormat(
+  // Load TlvFormat from disk. Returns length of the valid part of `ioBuf`,
+  // i.e. excluding a truncated trailing object if any.
+  folly::Expected<size_t, std::string> loadDatabaseTlvFormat(
       const std::unique_ptr<folly::IOBuf>& ioBuf) noexcept;
 
-  // Wrapper function to save persistent object to disk immediately or later
-  void maybeSaveObjectToDisk() noexcept;
-
-  // Function to save Persistent Object to local disk.
+  // Completion of a queued persistent object. Invoked with an empty
+  // exception_wrapper once committed, else with the write error.
+  using OnCommit = folly::Function<void(folly::exception_wrapper)>;
+
+  // Queue persistent object for group commit. `onCommit` is invoked once the
+  // object is written on disk-writer thread
+  void enqueueObject(PersistentObject pObject, OnCommit onCommit) noexcept;
+
+  // [disk-writer] Take all queued persistent objects along with their
+  // completions
+  void takePendingObjects(
+      std::vector<PersistentObject>& pObjects,
+      std::vector<OnCommit>& onCommits) noexcept;
+
+  // [disk-writer] Put back objects which failed to be written in front of
+  // newer ones and schedule a retry. Without retry, completions of the
+  // objects are failed with `error` right away.
+  void retryPendingObjects(
+      std::vector<PersistentObject>&& pObjects,
+      std::vector<OnCommit>&& onCommits,
+      folly::exception_wrapper error) noexcept;
+
+  // [disk-writer] Append all queued persistent objects to disk with one
+  // write+fsync. Returns true on success else false.
   bool savePersistentObjectToDisk() noexcept;
 
+  // [disk-writer] Re-write the log from committed database plus all queued
+  // persistent objects
+  void compactDatabaseOnDisk() noexcept;
+
   // Write IoBuf ro local disk
   folly::Expected<folly::Unit, std::string> writeIoBufToDisk(
       const std::unique_ptr<folly::IOBuf>& ioBuf, WriteType writeType) noexcept;
@@ -144,8 +183,8 @@ class PersistentStore : public OpenrEventBase {
   // Keeps track of number of writes of Database to disk
   std::atomic<std::uint64_t> numOfWritesToDisk_{0};
 
-  // Keeps track of number of writes of PersistentObject to disk
-  std::atomic<std::uint64_t> numOfNewWritesToDisk_{0};
+  // Keeps track of number of PersistentObjects appended since last compaction
+  std::uint64_t numOfNewWritesToDisk_{0};
 
   // Location on disk where data will be synced up. A file will be created
   // if doesn't exists.
@@ -154,8 +193,7 @@ class PersistentStore : public OpenrEventBase {
   // Dryrun to avoid disk writes in UTs
   bool dryrun_{false};
 
-  // Timer for saving database to disk
-  std::unique_ptr<folly::AsyncTimeout> saveDbTimer_;
+  // Backoff for retrying failed writes. Used on disk-writer thread only
   std::unique_ptr<ExponentialBackoff<std::chrono::milliseconds>>
       saveDbTimerBackoff_;
 
@@ -163,11 +201,30 @@ class PersistentStore : public OpenrEventBase {
   // layer (disk) in a file.
   std::unordered_map<std::string, std::string> database_;
 
+  // [disk-writer] Database as committed to disk. Compaction writes it out,
+  // so that it never drops objects appended after `database_` moved on.
+  std::unordered_map<std::string, std::string> committedDatabase_;
+
   // Serializer for encoding/decoding of thrift objects
   apache::thrift::CompactSerializer serializer_;
 
-  // Define a persistent object
-  std::vector<PersistentObject> pObjects_;
+  // Persistent objects pending to be written, along with their completion.
+  // Enqueued by event base and drained by disk-writer thread.
+  struct PendingObjects {
+    std::vector<PersistentObject> pObjects;
+    std::vector<OnCommit> onCommits;
+    // A drain is already scheduled on disk-writer thread
+    bool writeScheduled{false};
+  };
+  folly::Synchronized<PendingObjects> pendingObjects_;
+
+  // [disk-writer] Append handle of the log file. Re-opened after compaction
+  // replaces the file.
+  std::optional<folly::File> logFile_;
+
+  // Thread performing all disk writes (appends & compaction) in order.
+  // Declared last so that it is stopped before rest of state is destroyed.
+  std::unique_ptr<folly::ScopedEventBaseThread> diskWriterThread_;
 };
 
 } // namespace openr
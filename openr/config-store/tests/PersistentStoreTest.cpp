@@ -16,7 +16,9 @@
 
 #include <openr/config-store/PersistentStore.h>
 #include <openr/config-store/PersistentStoreWrapper.h>
+#include <openr/config/Config.h>
 #include <openr/if/gen-cpp2/Types_types.h>
+#include <openr/tests/utils/Utils.h>
 
 namespace openr {
 
@@ -41,6 +43,7 @@ loadDatabaseFromDisk(const std::string& filePath) {
     auto optionalObject = PersistentStore::decodePersistentObject(cursor);
     if (optionalObject.hasError()) {
       LOG(ERROR) << optionalObject.error();
+      break;
     }
 
     // Read finish
@@ -215,6 +218,162 @@ TEST(PersistentStoreTest, BulkStoreLoad) {
   }
 }
 
+TEST(PersistentStoreTest, GroupCommitConcurrentStore) {
+  const auto tid = std::hash<std::thread::id>()(std::this_thread::get_id());
+  const size_t kNumThreads = 8;
+  const size_t kNumKeys = 50;
+
+  StoreDatabase database;
+  std::string filePath;
+  {
+    PersistentStoreWrapper store(tid);
+    store.run();
+    filePath = store.filePath;
+
+    //
+    // Store keys concurrently. Each store is committed to disk once its
+    // future completes, but concurrent ones share the write+fsync.
+    //
+    std::vector<std::thread> threads;
+    for (size_t t = 0; t < kNumThreads; ++t) {
+      threads.emplace_back([&store, t]() {
+        std::vector<folly::SemiFuture<folly::Unit>> futures;
+        for (size_t index = 0; index < kNumKeys; ++index) {
+          futures.emplace_back(store->store(
+              fmt::format("key-{}-{}", t, index), fmt::format("val-{}", t)));
+        }
+        folly::collectAll(std::move(futures)).get();
+      });
+      for (size_t index = 0; index < kNumKeys; ++index) {
+        database[fmt::format("key-{}-{}", t, index)] = fmt::format("val-{}", t);
+      }
+    }
+    for (auto& thread : threads) {
+      thread.join();
+    }
+    EXPECT_GE(kNumThreads * kNumKeys, store->getNumOfDbWritesToDisk());
+    EXPECT_LE(1, store->getNumOfDbWritesToDisk());
+
+    // Committed objects are on disk before store is destroyed. File may
+    // hold keys of other tests as well.
+    auto databaseStore = loadDatabaseFromDisk(filePath);
+    for (const auto& [key, val] : database) {
+      EXPECT_EQ(val, databaseStore[key]) << key;
+    }
+
+    for (const auto& [key, _] : database) {
+      store->erase(key).get();
+    }
+  }
+}
+
+TEST(PersistentStoreTest, StoreDuringCompaction) {
+  const auto tid = std::hash<std::thread::id>()(std::this_thread::get_id());
+  const size_t kNumThreads = 8;
+  // Enough objects for the log to be compacted while stores are in flight
+  const size_t kNumKeys = 1500;
+
+  StoreDatabase database;
+  {
+    PersistentStoreWrapper store(tid);
+    store.run();
+
+    std::vector<std::thread> threads;
+    for (size_t t = 0; t < kNumThreads; ++t) {
+      threads.emplace_back([&store, t]() {
+        std::vector<folly::SemiFuture<folly::Unit>> futures;
+        for (size_t index = 0; index < kNumKeys; ++index) {
+          futures.emplace_back(store->store(
+              fmt::format("key-{}-{}", t, index), fmt::format("val-{}", t)));
+        }
+        folly::collectAll(std::move(futures)).get();
+      });
+      for (size_t index = 0; index < kNumKeys; ++index) {
+        database[fmt::format("key-{}-{}", t, index)] = fmt::format("val-{}", t);
+      }
+    }
+    for (auto& thread : threads) {
+      thread.join();
+    }
+
+    // Every committed object survives compaction of the log
+    auto databaseStore = loadDatabaseFromDisk(store.filePath);
+    for (const auto& [key, val] : database) {
+      EXPECT_EQ(val, databaseStore[key]) << key;
+    }
+
+    for (const auto& [key, _] : database) {
+      store->erase(key).get();
+    }
+  }
+}
+
+TEST(PersistentStoreTest, LoadTruncatedLog) {
+  const auto tid = std::hash<std::thread::id>()(std::this_thread::get_id());
+
+  std::string filePath;
+  {
+    PersistentStoreWrapper store(tid);
+    store.run();
+    filePath = store.filePath;
+    store->store("key1", "val1").get();
+  }
+
+  // Simulate an interrupted append with a partial object at the end
+  PersistentObject pObject;
+  pObject.type = ActionType::ADD;
+  pObject.key = "key2";
+  pObject.data = "val2";
+  auto buf = PersistentStore::encodePersistentObject(pObject);
+  ASSERT_FALSE(buf.hasError());
+  std::string partial(
+      reinterpret_cast<const char*>((*buf)->data()), (*buf)->length() - 2);
+  EXPECT_TRUE(folly::writeFile(
+      partial, filePath.c_str(), O_WRONLY | O_APPEND | O_CREAT, 0666));
+
+  // Committed objects are recovered, partial one is dropped
+  {
+    PersistentStoreWrapper store(tid);
+    store.run();
+    EXPECT_EQ("val1", store->load("key1").get());
+    EXPECT_FALSE(store->load("key2").get());
+
+    // Partial object is cut off from the log, hence objects appended after
+    // recovery can be read back
+    store->store("key3", "val3").get();
+    auto databaseStore = loadDatabaseFromDisk(filePath);
+    EXPECT_EQ("val1", databaseStore["key1"]);
+    EXPECT_EQ("val3", databaseStore["key3"]);
+    EXPECT_EQ(0, databaseStore.count("key2"));
+    store->erase("key1").get();
+    store->erase("key3").get();
+  }
+}
+
+TEST(PersistentStoreTest, WriteFailureWithoutRetry) {
+  // Log file can't be created in a non-existing directory
+  auto tConfig = getBasicOpenrConfig();
+  tConfig.persistent_config_store_path() =
+      "/tmp/openr_persistent_store_no_such_dir/store";
+  auto config = std::make_shared<Config>(tConfig);
+
+  auto store = std::make_unique<PersistentStore>(
+      config, false /* dryrun */, false /* periodicallySaveToDisk */);
+  std::thread storeThread([&store]() { store->run(); });
+  store->waitUntilRunning();
+
+  // Failed write is reported to callers rather than leaving them blocked
+  EXPECT_THROW(store->store("key1", "val1").get(), std::runtime_error);
+  EXPECT_THROW(store->erase("key1").get(), std::runtime_error);
+
+  // Database stays in memory
+  store->store("key2", "val2").wait();
+  EXPECT_EQ("val2", store->load("key2").get());
+
+  store->stop();
+  storeThread.join();
+}
+
 } // namespace openr
 
 int
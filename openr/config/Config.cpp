@@ -16,6 +16,7 @@
 #include <openr/config/Config.h>
 #include <openr/if/gen-cpp2/Network_types.h>
 #include <openr/if/gen-cpp2/OpenrConfig_types.h>
+#include <openr/policy/PolicyManager.h>
 
 using apache::thrift::util::enumName;
 using openr::thrift::PrefixAllocationMode;
@@ -212,6 +213,16 @@ Config::populateAreaConfig() {
   if (auto areaPolicies = getAreaPolicies()) {
     propagationPolicy =
         areaPolicies->filters()->routePropagationPolicy().to_optional();
+
+    // Compile policies once upfront. Invalid ones, e.g. with dangling
+    // references, are rejected along with the config rather than on
+    // PrefixManager construction.
+    try {
+      PolicyManager policyManager(*areaPolicies);
+    } catch (const std::invalid_argument& ex) {
+      throw std::invalid_argument(
+          fmt::format("Invalid area policies: {}", ex.what()));
+    }
   }
 
   for (auto& areaConf : *config_.areas()) {
@@ -375,6 +386,20 @@ Config::checkMonitorConfig() const {
   }
 }
 
+void
+Config::checkFibPriorityConfig() const {
+  if (not config_.fib_priority_config()) {
+    return;
+  }
+  for (auto const& prefix :
+       *config_.fib_priority_config()->priority_prefixes()) {
+    if (folly::IPAddress::tryCreateNetwork(prefix).hasError()) {
+      throw std::invalid_argument(
+          fmt::format("Invalid fib priority prefix: {}", prefix));
+    }
+  }
+}
+
 void
 Config::checkLinkMonitorConfig() const {
   auto& lmConf = *config_.link_monitor_config();
@@ -398,6 +423,19 @@ Config::checkLinkMonitorConfig() const {
         *lmConf.linkflap_initial_backoff_ms(),
         *lmConf.linkflap_max_backoff_ms()));
   }
+
+  // rtt damping validation
+  if (*lmConf.rtt_metric_change_threshold_pct() < 0) {
+    throw std::out_of_range(fmt::format(
+        "rtt_metric_change_threshold_pct ({}) should be >= 0",
+        *lmConf.rtt_metric_change_threshold_pct()));
+  }
+
+  if (*lmConf.rtt_metric_hold_time_ms() < 0) {
+    throw std::out_of_range(fmt::format(
+        "rtt_metric_hold_time_ms ({}) should be >= 0",
+        *lmConf.rtt_metric_hold_time_ms()));
+  }
 }
 
 void
@@ -610,6 +648,24 @@ Config::populateInternalDb() {
     throw std::invalid_argument("Route delete duration must be >= 0ms");
   }
 
+  // Check prefix bundle shards
+  const auto& bundleShards = *config_.prefix_bundle_shards();
+  if (bundleShards < 0 or
+      static_cast<uint32_t>(bundleShards) > Constants::kMaxPrefixBundleShards) {
+    throw std::out_of_range(
+        "prefix_bundle_shards must be in range [0, " +
+        std::to_string(Constants::kMaxPrefixBundleShards) + "]");
+  }
+
+  // Check adjacency database shards
+  const auto& adjDbShards = *config_.adj_db_shards();
+  if (adjDbShards < 0 or
+      static_cast<uint32_t>(adjDbShards) > Constants::kMaxAdjDbShards) {
+    throw std::out_of_range(
+        "adj_db_shards must be in range [0, " +
+        std::to_string(Constants::kMaxAdjDbShards) + "]");
+  }
+
   // validate KvStore config (e.g. ttl/flood-rate/etc.)
   checkKvStoreConfig();
 
@@ -625,6 +681,9 @@ Config::populateInternalDb() {
   // validate Link Monitor config (e.g. backoff)
   checkLinkMonitorConfig();
 
+  // validate Fib priority config (e.g. prefixes)
+  checkFibPriorityConfig();
+
   // validate Segment Routing config
   checkSegmentRoutingConfig();
 
@@ -687,6 +746,8 @@ Config::toThriftKvStoreConfig() const {
   if (auto keyOriginatorIdFilters = oldConfig.key_originator_id_filters()) {
     config.key_originator_id_filters() = *keyOriginatorIdFilters;
   }
+  config.enable_per_area_event_base() =
+      *oldConfig.enable_per_area_event_base();
   if (auto maybeIpTos = getConfig().ip_tos()) {
     config.ip_tos() = *maybeIpTos;
   }
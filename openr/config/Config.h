@@ -194,6 +194,26 @@ class Config {
     return *config_.enable_ucmp();
   }
 
+  bool
+  isPrefixBundlingEnabled() const {
+    return *config_.prefix_bundle_shards() > 0;
+  }
+
+  uint32_t
+  getPrefixBundleShards() const {
+    return static_cast<uint32_t>(*config_.prefix_bundle_shards());
+  }
+
+  bool
+  isAdjDbShardingEnabled() const {
+    return *config_.adj_db_shards() > 0;
+  }
+
+  uint32_t
+  getAdjDbShards() const {
+    return static_cast<uint32_t>(*config_.adj_db_shards());
+  }
+
   bool
   isDryrun() const {
     return config_.dryrun().value_or(false);
@@ -594,6 +614,9 @@ class Config {
   // validate Monitor config
   void checkMonitorConfig() const;
 
+  // validate Fib priority config
+  void checkFibPriorityConfig() const;
+
   // validate Link Monitor config
   void checkLinkMonitorConfig() const;
 
@@ -189,6 +189,25 @@ TEST(ConfigTest, PopulateAreaConfig) {
     confInvalidAreaPolicy.areas()->emplace_back(std::move(areaConfig));
     EXPECT_THROW((Config(confInvalidAreaPolicy)), std::invalid_argument);
   }
+  // area policy referencing undefined prefix filter fails to compile
+  {
+    auto confInvalidAreaPolicy = getBasicOpenrConfig();
+    neteng::config::routing_policy::FilterCriteria criteria;
+    criteria.prefixFilters() = {"PL"};
+    neteng::config::routing_policy::FilterRule rule;
+    rule._name() = "ALLOW_PL";
+    rule.criteria() = {criteria};
+    neteng::config::routing_policy::Filter policy;
+    policy.ruleset() = {rule};
+    auto& filters = *confInvalidAreaPolicy.area_policies().ensure().filters();
+    filters.routePropagationPolicy().ensure().objects() = {{"BLA", policy}};
+    EXPECT_THROW((Config(confInvalidAreaPolicy)), std::invalid_argument);
+
+    // valid once prefix filter is defined
+    filters.prefixFilter().ensure().objects() = {
+        {"PL", neteng::config::routing_policy::Filter()}};
+    EXPECT_NO_THROW((Config(confInvalidAreaPolicy)));
+  }
 
   // non-empty interface regex
   {
@@ -564,6 +583,47 @@ TEST(ConfigTest, PopulateInternalDb) {
     EXPECT_THROW(auto c = Config(confInvalidSpark), std::invalid_argument);
   }
 
+  // prefix bundle
+
+  // prefix_bundle_shards < 0
+  {
+    auto confInvalidBundle = getBasicOpenrConfig();
+    confInvalidBundle.prefix_bundle_shards() = -1;
+    EXPECT_THROW(auto c = Config(confInvalidBundle), std::out_of_range);
+  }
+  // prefix_bundle_shards > kMaxPrefixBundleShards
+  {
+    auto confInvalidBundle = getBasicOpenrConfig();
+    confInvalidBundle.prefix_bundle_shards() =
+        Constants::kMaxPrefixBundleShards + 1;
+    EXPECT_THROW(auto c = Config(confInvalidBundle), std::out_of_range);
+  }
+
+  // adjacency database shards
+
+  // adj_db_shards < 0
+  {
+    auto confInvalidShards = getBasicOpenrConfig();
+    confInvalidShards.adj_db_shards() = -1;
+    EXPECT_THROW(auto c = Config(confInvalidShards), std::out_of_range);
+  }
+  // adj_db_shards > kMaxAdjDbShards
+  {
+    auto confInvalidShards = getBasicOpenrConfig();
+    confInvalidShards.adj_db_shards() = Constants::kMaxAdjDbShards + 1;
+    EXPECT_THROW(auto c = Config(confInvalidShards), std::out_of_range);
+  }
+
+  // fib priority
+
+  // invalid priority prefix
+  {
+    auto confInvalidFib = getBasicOpenrConfig();
+    confInvalidFib.fib_priority_config().ensure().priority_prefixes() = {
+        "::/0", "10.0.0.0/33"};
+    EXPECT_THROW(auto c = Config(confInvalidFib), std::invalid_argument);
+  }
+
   // Monitor
 
   // Exception monitor_max_event_log >= 0
@@ -594,6 +654,18 @@ TEST(ConfigTest, PopulateInternalDb) {
     confInvalidLm.link_monitor_config()->linkflap_max_backoff_ms() = 300000;
     EXPECT_THROW(auto c = Config(confInvalidLm), std::out_of_range);
   }
+  // rtt_metric_change_threshold_pct < 0
+  {
+    auto confInvalidLm = getBasicOpenrConfig();
+    confInvalidLm.link_monitor_config()->rtt_metric_change_threshold_pct() = -1;
+    EXPECT_THROW(auto c = Config(confInvalidLm), std::out_of_range);
+  }
+  // rtt_metric_hold_time_ms < 0
+  {
+    auto confInvalidLm = getBasicOpenrConfig();
+    confInvalidLm.link_monitor_config()->rtt_metric_hold_time_ms() = -1;
+    EXPECT_THROW(auto c = Config(confInvalidLm), std::out_of_range);
+  }
 
   // prefix allocation
 
@@ -16,6 +16,11 @@ namespace fs = std::experimental::filesystem;
 #endif
 
 #include <folly/ExceptionString.h>
+#if FOLLY_HAS_COROUTINES
+#include <folly/experimental/coro/AsyncGenerator.h>
+#else
+#include <folly/executors/GlobalExecutor.h>
+#endif
 #include <folly/logging/xlog.h>
 
 #include <openr/common/Constants.h>
@@ -27,6 +32,57 @@ namespace fb303 = facebook::fb303;
 
 namespace openr {
 
+namespace {
+
+/**
+ * Stream pages of a paginated read API, starting from the page selected by
+ * `request` and following `nextCursor` till the last page. `getPage` is
+ * invoked for the next page only once the previous page is consumed.
+ */
+#if FOLLY_HAS_COROUTINES
+template <typename Page, typename GetPage>
+folly::coro::AsyncGenerator<Page&&>
+generatePages(thrift::PageRequest request, GetPage getPage) {
+  while (true) {
+    auto page = co_await getPage(request);
+    auto nextCursor = page->nextCursor().to_optional();
+    co_yield std::move(*page);
+    if (not nextCursor.has_value()) {
+      co_return;
+    }
+    request.cursor() = std::move(*nextCursor);
+  }
+}
+#endif
+
+template <typename Page, typename GetPage>
+apache::thrift::ServerStream<Page>
+streamPages(thrift::PageRequest request, GetPage getPage) {
+#if FOLLY_HAS_COROUTINES
+  return generatePages<Page>(std::move(request), std::move(getPage));
+#else
+  // Without coroutines, publisher can't tell when the client consumed a
+  // page. Only the requested page is streamed, client resumes from its
+  // `nextCursor` with the paginated API.
+  auto streamAndPublisher =
+      apache::thrift::ServerStream<Page>::createPublisher();
+  getPage(request)
+      .via(folly::getGlobalCPUExecutor())
+      .thenTry([publisher = std::move(streamAndPublisher.second)](
+                   folly::Try<std::unique_ptr<Page>>&& page) mutable {
+        if (page.hasException()) {
+          std::move(publisher).complete(std::move(page.exception()));
+          return;
+        }
+        publisher.next(std::move(*page.value()));
+        std::move(publisher).complete();
+      });
+  return std::move(streamAndPublisher.first);
+#endif
+}
+
+} // namespace
+
 OpenrCtrlHandler::OpenrCtrlHandler(
     const std::string& nodeName,
     const std::unordered_set<std::string>& acceptablePeerCommonNames,
@@ -188,7 +244,7 @@ OpenrCtrlHandler::~OpenrCtrlHandler() {
 // SYNCHRONIZED block
 void
 OpenrCtrlHandler::closeKvStorePublishers() {
-  std::vector<std::unique_ptr<KvStorePublisher>> publishers;
+  std::vector<std::shared_ptr<KvStorePublisher>> publishers;
   kvStorePublishers_.withWLock([&](auto& kvStorePublishers_) {
     for (auto& [_, publisher] : kvStorePublishers_) {
       publishers.emplace_back(std::move(publisher));
@@ -223,11 +279,11 @@ OpenrCtrlHandler::closeFibPublishers() {
 
 void
 OpenrCtrlHandler::processPublication(thrift::Publication&& pub) {
-  // publish via KvStorePublisher
-  kvStorePublishers_.withWLock([&](auto& kvStorePublishers_) {
-    for (auto& [_, publisher] : kvStorePublishers_) {
-      publisher->last_message_time_ = std::chrono::system_clock::now();
-      publisher->total_messages_++;
+  // publish via KvStorePublisher. Publishers buffer & coalesce updates for
+  // their subscriber, hence read lock is sufficient and never blocks on a
+  // slow subscriber.
+  kvStorePublishers_.withRLock([&](auto const& kvStorePublishers_) {
+    for (auto const& [_, publisher] : kvStorePublishers_) {
       publisher->publish(pub);
     }
   });
@@ -587,6 +643,12 @@ OpenrCtrlHandler::semifuture_getRouteDb() {
   return fib_->getRouteDb();
 }
 
+folly::SemiFuture<std::unique_ptr<thrift::VersionedRouteDb>>
+OpenrCtrlHandler::semifuture_getRouteDbVersioned(int64_t lastGeneration) {
+  CHECK(fib_);
+  return fib_->getRouteDbVersioned(lastGeneration);
+}
+
 folly::SemiFuture<std::unique_ptr<thrift::RouteDatabaseDetail>>
 OpenrCtrlHandler::semifuture_getRouteDetailDb() {
   CHECK(fib_);
@@ -607,6 +669,13 @@ OpenrCtrlHandler::semifuture_getUnicastRoutes() {
   return fib_->getUnicastRoutes({});
 }
 
+folly::SemiFuture<std::unique_ptr<thrift::UnicastRoutesPage>>
+OpenrCtrlHandler::semifuture_getUnicastRoutesPage(
+    std::unique_ptr<thrift::PageRequest> request) {
+  CHECK(fib_);
+  return fib_->getUnicastRoutesPage(std::move(*request));
+}
+
 folly::SemiFuture<std::unique_ptr<std::vector<thrift::MplsRoute>>>
 OpenrCtrlHandler::semifuture_getMplsRoutes() {
   CHECK(fib_);
@@ -644,6 +713,12 @@ OpenrCtrlHandler::semifuture_getPerfDb() {
   return fib_->getPerfDb();
 }
 
+folly::SemiFuture<std::unique_ptr<thrift::PerfDatabase>>
+OpenrCtrlHandler::semifuture_getSlowestPerfDb() {
+  CHECK(fib_);
+  return fib_->getSlowestPerfDb();
+}
+
 //
 // Decision APIs
 //
@@ -661,6 +736,13 @@ OpenrCtrlHandler::semifuture_getReceivedRoutesFiltered(
   return decision_->getReceivedRoutesFiltered(std::move(*filter));
 }
 
+folly::SemiFuture<std::unique_ptr<thrift::ReceivedRoutesPage>>
+OpenrCtrlHandler::semifuture_getReceivedRoutesPage(
+    std::unique_ptr<thrift::PageRequest> request) {
+  CHECK(decision_);
+  return decision_->getReceivedRoutesPage(std::move(*request));
+}
+
 folly::SemiFuture<std::unique_ptr<thrift::RouteDatabase>>
 OpenrCtrlHandler::semifuture_getRouteDbComputed(
     std::unique_ptr<std::string> nodeName) {
@@ -684,6 +766,15 @@ OpenrCtrlHandler::semifuture_getDecisionAdjacencyDbs() {
       });
 }
 
+folly::SemiFuture<std::unique_ptr<thrift::VersionedAdjDbs>>
+OpenrCtrlHandler::semifuture_getDecisionAdjacencyDbsVersioned(
+    int64_t lastGeneration) {
+  CHECK(decision_);
+  return decision_->getDecisionAdjacencyDbsVersioned(
+      *getSingleAreaOrThrow("getDecisionAdjacencyDbsVersioned"),
+      lastGeneration);
+}
+
 folly::SemiFuture<std::unique_ptr<std::vector<thrift::AdjacencyDatabase>>>
 OpenrCtrlHandler::semifuture_getDecisionAdjacenciesFiltered(
     std::unique_ptr<thrift::AdjacenciesFilter> filter) {
@@ -699,6 +790,15 @@ OpenrCtrlHandler::semifuture_getDecisionAreaAdjacenciesFiltered(
   return decision_->getDecisionAreaAdjacenciesFiltered(std::move(*filter));
 }
 
+folly::SemiFuture<std::unique_ptr<thrift::AdjacencyDbsPage>>
+OpenrCtrlHandler::semifuture_getDecisionAdjacencyDbsPage(
+    std::unique_ptr<std::string> area,
+    std::unique_ptr<thrift::PageRequest> request) {
+  CHECK(decision_);
+  return decision_->getDecisionAdjacencyDbsPage(
+      std::move(*area), std::move(*request));
+}
+
 //
 // Dispatcher APIs
 //
@@ -756,6 +856,16 @@ OpenrCtrlHandler::semifuture_getKvStoreKeyValsFilteredArea(
           });
 }
 
+folly::SemiFuture<std::unique_ptr<thrift::VersionedPublication>>
+OpenrCtrlHandler::semifuture_getKvStoreKeyValsFilteredAreaVersioned(
+    std::unique_ptr<thrift::KeyDumpParams> filter,
+    std::unique_ptr<std::string> area,
+    int64_t lastGeneration) {
+  CHECK(kvStore_);
+  return kvStore_->semifuture_dumpKvStoreKeysVersioned(
+      std::move(*area), std::move(*filter), lastGeneration);
+}
+
 folly::SemiFuture<std::unique_ptr<thrift::Publication>>
 OpenrCtrlHandler::semifuture_getKvStoreHashFiltered(
     std::unique_ptr<thrift::KeyDumpParams> filter) {
@@ -869,6 +979,15 @@ OpenrCtrlHandler::semifuture_getKvStoreAreaSummary(
       std::move(*selectAreas));
 }
 
+folly::SemiFuture<std::unique_ptr<thrift::KeyValsPage>>
+OpenrCtrlHandler::semifuture_getKvStoreKeyValsPage(
+    std::unique_ptr<std::string> area,
+    std::unique_ptr<thrift::PageRequest> request) {
+  CHECK(kvStore_);
+  return kvStore_->semifuture_getKvStoreKeyValsPage(
+      std::move(*area), std::move(*request));
+}
+
 folly::SemiFuture<std::unique_ptr<std::vector<thrift::StreamSubscriberInfo>>>
 OpenrCtrlHandler::semifuture_getSubscriberInfo(int64_t type) {
   folly::Promise<std::unique_ptr<std::vector<thrift::StreamSubscriberInfo>>>
@@ -880,24 +999,11 @@ OpenrCtrlHandler::semifuture_getSubscriberInfo(int64_t type) {
                                   this]() mutable {
     std::vector<thrift::StreamSubscriberInfo> subscribers;
     if (type == 0) {
-      kvStorePublishers_.withWLock([&](auto& kvStorePublishers_) {
-        for (auto& [id, publisher] : kvStorePublishers_) {
-          thrift::StreamSubscriberInfo subscriber;
+      kvStorePublishers_.withRLock([&](auto const& kvStorePublishers_) {
+        for (auto const& [id, publisher] : kvStorePublishers_) {
+          auto subscriber = publisher->getSubscriberInfo();
           subscriber.subscriber_id() = id;
-
-          auto currentTime = std::chrono::steady_clock::now();
-          auto duration_time =
-              std::chrono::duration_cast<std::chrono::milliseconds>(
-                  currentTime - publisher->subscription_time_);
-          subscriber.uptime() = duration_time.count();
-          subscriber.last_msg_sent_time() =
-              std::chrono::time_point_cast<std::chrono::milliseconds>(
-                  publisher->last_message_time_)
-                  .time_since_epoch()
-                  .count();
-          subscriber.total_streamed_msgs() = publisher->total_messages_;
-
-          subscribers.emplace_back(subscriber);
+          subscribers.emplace_back(std::move(subscriber));
         }
       });
     } else if (type == 1) {
@@ -939,36 +1045,38 @@ OpenrCtrlHandler::subscribeKvStoreFilter(
   // Get new client-ID (monotonically increasing)
   auto clientToken = publisherToken_++;
 
-  auto streamAndPublisher =
-      apache::thrift::ServerStream<thrift::Publication>::createPublisher(
-          [this, clientToken]() {
-            kvStorePublishers_.withWLock([&](auto& kvStorePublishers_) {
-              if (kvStorePublishers_.erase(clientToken)) {
-                XLOG(INFO) << "KvStore snoop stream-" << clientToken
-                           << " ended.";
-              } else {
-                XLOG(ERR) << "Can't remove unknown KvStore snoop stream-"
-                          << clientToken;
-              }
-              fb303::fbData->setCounter(
-                  "subscribers.kvstore", kvStorePublishers_.size());
-            });
-          });
+  // Snapshot to resync subscriber with, if it falls too far behind
+  auto snapshotCallback = [kvStore = kvStore_,
+                           filter = *filter,
+                           selectAreas = *selectAreas]() {
+    return kvStore->semifuture_dumpKvStoreKeys(filter, selectAreas);
+  };
+  auto kvStorePublisher = std::make_shared<KvStorePublisher>(
+      *selectAreas,
+      std::move(*filter),
+      std::move(snapshotCallback),
+      std::chrono::steady_clock::now());
+  auto stream = kvStorePublisher->createStream([this, clientToken]() {
+    kvStorePublishers_.withWLock([&](auto& kvStorePublishers_) {
+      if (kvStorePublishers_.erase(clientToken)) {
+        XLOG(INFO) << "KvStore snoop stream-" << clientToken << " ended.";
+      } else {
+        XLOG(ERR) << "Can't remove unknown KvStore snoop stream-"
+                  << clientToken;
+      }
+      fb303::fbData->setCounter(
+          "subscribers.kvstore", kvStorePublishers_.size());
+    });
+  });
 
   kvStorePublishers_.withWLock([&](auto& kvStorePublishers_) {
     assert(kvStorePublishers_.count(clientToken) == 0);
     XLOG(INFO) << "KvStore snoop stream-" << clientToken
                << " started for areas: " << folly::join(", ", *selectAreas);
-    auto kvStorePublisher = std::make_unique<KvStorePublisher>(
-        *selectAreas,
-        std::move(*filter),
-        std::move(streamAndPublisher.second),
-        std::chrono::steady_clock::now(),
-        0);
     kvStorePublishers_.emplace(clientToken, std::move(kvStorePublisher));
     fb303::fbData->setCounter("subscribers.kvstore", kvStorePublishers_.size());
   });
-  return std::move(streamAndPublisher.first);
+  return stream;
 }
 
 folly::SemiFuture<apache::thrift::ResponseAndServerStream<
@@ -1126,6 +1234,65 @@ OpenrCtrlHandler::semifuture_subscribeAndGetFibDetail() {
       });
 }
 
+apache::thrift::ServerStream<thrift::UnicastRoutesPage>
+OpenrCtrlHandler::streamUnicastRoutes(
+    std::unique_ptr<thrift::PageRequest> request) {
+  CHECK(fib_);
+  return streamPages<thrift::UnicastRoutesPage>(
+      std::move(*request),
+      [fib = fib_,
+       sortedKeys = std::make_shared<std::vector<folly::CIDRNetwork>>()](
+          thrift::PageRequest pageRequest) {
+        return fib->getUnicastRoutesPage(std::move(pageRequest), sortedKeys);
+      });
+}
+
+apache::thrift::ServerStream<thrift::ReceivedRoutesPage>
+OpenrCtrlHandler::streamReceivedRoutes(
+    std::unique_ptr<thrift::PageRequest> request) {
+  CHECK(decision_);
+  return streamPages<thrift::ReceivedRoutesPage>(
+      std::move(*request),
+      [decision = decision_,
+       sortedKeys = std::make_shared<std::vector<folly::CIDRNetwork>>()](
+          thrift::PageRequest pageRequest) {
+        return decision->getReceivedRoutesPage(
+            std::move(pageRequest), sortedKeys);
+      });
+}
+
+apache::thrift::ServerStream<thrift::AdjacencyDbsPage>
+OpenrCtrlHandler::streamDecisionAdjacencyDbs(
+    std::unique_ptr<std::string> area,
+    std::unique_ptr<thrift::PageRequest> request) {
+  CHECK(decision_);
+  return streamPages<thrift::AdjacencyDbsPage>(
+      std::move(*request),
+      [decision = decision_,
+       area = std::move(*area),
+       sortedKeys = std::make_shared<std::vector<std::string>>()](
+          thrift::PageRequest pageRequest) {
+        return decision->getDecisionAdjacencyDbsPage(
+            area, std::move(pageRequest), sortedKeys);
+      });
+}
+
+apache::thrift::ServerStream<thrift::KeyValsPage>
+OpenrCtrlHandler::streamKvStoreKeyVals(
+    std::unique_ptr<std::string> area,
+    std::unique_ptr<thrift::PageRequest> request) {
+  CHECK(kvStore_);
+  return streamPages<thrift::KeyValsPage>(
+      std::move(*request),
+      [kvStore = kvStore_,
+       area = std::move(*area),
+       sortedKeys = std::make_shared<std::vector<std::string>>()](
+          thrift::PageRequest pageRequest) {
+        return kvStore->semifuture_getKvStoreKeyValsPage(
+            area, std::move(pageRequest), sortedKeys);
+      });
+}
+
 //
 // LinkMonitor APIs
 //
@@ -1228,6 +1395,12 @@ OpenrCtrlHandler::semifuture_getInterfaces() {
   return linkMonitor_->semifuture_getInterfaces();
 }
 
+folly::SemiFuture<std::unique_ptr<thrift::VersionedInterfaces>>
+OpenrCtrlHandler::semifuture_getInterfacesVersioned(int64_t lastGeneration) {
+  CHECK(linkMonitor_);
+  return linkMonitor_->semifuture_getInterfacesVersioned(lastGeneration);
+}
+
 folly::SemiFuture<std::unique_ptr<thrift::AdjacencyDatabase>>
 OpenrCtrlHandler::semifuture_getLinkMonitorAdjacencies() {
   CHECK(linkMonitor_);
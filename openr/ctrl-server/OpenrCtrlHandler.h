@@ -170,6 +170,9 @@ class OpenrCtrlHandler final : public thrift::OpenrCtrlCppSvIf,
   folly::SemiFuture<std::unique_ptr<thrift::RouteDatabaseDetail>>
   semifuture_getRouteDetailDb() override;
 
+  folly::SemiFuture<std::unique_ptr<thrift::VersionedRouteDb>>
+  semifuture_getRouteDbVersioned(int64_t lastGeneration) override;
+
   folly::SemiFuture<std::unique_ptr<std::vector<thrift::UnicastRoute>>>
   semifuture_getUnicastRoutesFiltered(
       std::unique_ptr<std::vector<::std::string>> prefixes) override;
@@ -177,6 +180,10 @@ class OpenrCtrlHandler final : public thrift::OpenrCtrlCppSvIf,
   folly::SemiFuture<std::unique_ptr<std::vector<thrift::UnicastRoute>>>
   semifuture_getUnicastRoutes() override;
 
+  folly::SemiFuture<std::unique_ptr<thrift::UnicastRoutesPage>>
+  semifuture_getUnicastRoutesPage(
+      std::unique_ptr<thrift::PageRequest> request) override;
+
   folly::SemiFuture<std::unique_ptr<std::vector<thrift::MplsRoute>>>
   semifuture_getMplsRoutesFiltered(
       std::unique_ptr<std::vector<int32_t>> labels) override;
@@ -200,6 +207,9 @@ class OpenrCtrlHandler final : public thrift::OpenrCtrlCppSvIf,
   folly::SemiFuture<std::unique_ptr<thrift::PerfDatabase>>
   semifuture_getPerfDb() override;
 
+  folly::SemiFuture<std::unique_ptr<thrift::PerfDatabase>>
+  semifuture_getSlowestPerfDb() override;
+
   //
   // Decision APIs
   //
@@ -211,9 +221,16 @@ class OpenrCtrlHandler final : public thrift::OpenrCtrlCppSvIf,
   semifuture_getReceivedRoutesFiltered(
       std::unique_ptr<thrift::ReceivedRouteFilter> filter) override;
 
+  folly::SemiFuture<std::unique_ptr<thrift::ReceivedRoutesPage>>
+  semifuture_getReceivedRoutesPage(
+      std::unique_ptr<thrift::PageRequest> request) override;
+
   folly::SemiFuture<std::unique_ptr<thrift::AdjDbs>>
   semifuture_getDecisionAdjacencyDbs() override;
 
+  folly::SemiFuture<std::unique_ptr<thrift::VersionedAdjDbs>>
+  semifuture_getDecisionAdjacencyDbsVersioned(int64_t lastGeneration) override;
+
   // DEPRECATED. Perfer getDecisionAreaAdjacenciesFiltered to return the areas
   // as well.
   folly::SemiFuture<std::unique_ptr<std::vector<thrift::AdjacencyDatabase>>>
@@ -225,6 +242,11 @@ class OpenrCtrlHandler final : public thrift::OpenrCtrlCppSvIf,
   semifuture_getDecisionAreaAdjacenciesFiltered(
       std::unique_ptr<thrift::AdjacenciesFilter> filter) override;
 
+  folly::SemiFuture<std::unique_ptr<thrift::AdjacencyDbsPage>>
+  semifuture_getDecisionAdjacencyDbsPage(
+      std::unique_ptr<std::string> area,
+      std::unique_ptr<thrift::PageRequest> request) override;
+
   folly::SemiFuture<std::unique_ptr<thrift::RouteDatabase>>
   semifuture_getRouteDbComputed(std::unique_ptr<std::string> nodeName) override;
 
@@ -283,6 +305,16 @@ class OpenrCtrlHandler final : public thrift::OpenrCtrlCppSvIf,
   semifuture_getKvStoreKeyValsFiltered(
       std::unique_ptr<thrift::KeyDumpParams> filter) override;
 
+  /*
+   * Same as getKvStoreKeyValsFilteredArea, but key-vals are only returned if
+   * any of the area changed since `lastGeneration`
+   */
+  folly::SemiFuture<std::unique_ptr<thrift::VersionedPublication>>
+  semifuture_getKvStoreKeyValsFilteredAreaVersioned(
+      std::unique_ptr<thrift::KeyDumpParams> filter,
+      std::unique_ptr<std::string> area,
+      int64_t lastGeneration) override;
+
   /*
    * API to return key-val HASHes(NO binary value included) only by given:
    *  - thrift::KeyDumpParams;
@@ -340,6 +372,14 @@ class OpenrCtrlHandler final : public thrift::OpenrCtrlCppSvIf,
   semifuture_getKvStoreAreaSummary(
       std::unique_ptr<std::set<std::string>> selectAreas) override;
 
+  /*
+   * API to return a page of key-val pairs of a specific area, ordered by key
+   */
+  folly::SemiFuture<std::unique_ptr<thrift::KeyValsPage>>
+  semifuture_getKvStoreKeyValsPage(
+      std::unique_ptr<std::string> area,
+      std::unique_ptr<thrift::PageRequest> request) override;
+
   // Stream API's
   // Intentionally not use SemiFuture as stream is async by nature and we will
   // immediately create and return the stream handler
@@ -380,6 +420,23 @@ class OpenrCtrlHandler final : public thrift::OpenrCtrlCppSvIf,
       thrift::RouteDatabaseDeltaDetail>>
   semifuture_subscribeAndGetFibDetail() override;
 
+  // Paginated stream API's. Pages are fetched one at a time as the client
+  // consumes them, and stream completes after the last page.
+  apache::thrift::ServerStream<thrift::UnicastRoutesPage> streamUnicastRoutes(
+      std::unique_ptr<thrift::PageRequest> request) override;
+
+  apache::thrift::ServerStream<thrift::ReceivedRoutesPage>
+  streamReceivedRoutes(std::unique_ptr<thrift::PageRequest> request) override;
+
+  apache::thrift::ServerStream<thrift::AdjacencyDbsPage>
+  streamDecisionAdjacencyDbs(
+      std::unique_ptr<std::string> area,
+      std::unique_ptr<thrift::PageRequest> request) override;
+
+  apache::thrift::ServerStream<thrift::KeyValsPage> streamKvStoreKeyVals(
+      std::unique_ptr<std::string> area,
+      std::unique_ptr<thrift::PageRequest> request) override;
+
   // Long poll support
   folly::SemiFuture<bool> semifuture_longPollKvStoreAdj(
       std::unique_ptr<thrift::KeyVals> snapshot) override;
@@ -428,6 +485,9 @@ class OpenrCtrlHandler final : public thrift::OpenrCtrlCppSvIf,
   folly::SemiFuture<std::unique_ptr<thrift::DumpLinksReply>>
   semifuture_getInterfaces() override;
 
+  folly::SemiFuture<std::unique_ptr<thrift::VersionedInterfaces>>
+  semifuture_getInterfacesVersioned(int64_t lastGeneration) override;
+
   folly::SemiFuture<std::unique_ptr<thrift::AdjacencyDatabase>>
   semifuture_getLinkMonitorAdjacencies() override;
 
@@ -533,9 +593,10 @@ class OpenrCtrlHandler final : public thrift::OpenrCtrlCppSvIf,
   // Publisher token (monotonically increasing) for all publishers
   std::atomic<int64_t> publisherToken_{0};
 
-  // Active kvstore snoop publishers
+  // Active kvstore snoop publishers. Shared with the stream of each
+  // subscriber pulling publications from it.
   folly::Synchronized<
-      std::unordered_map<int64_t, std::unique_ptr<KvStorePublisher>>>
+      std::unordered_map<int64_t, std::shared_ptr<KvStorePublisher>>>
       kvStorePublishers_;
 
   // Active Fib streaming publishers
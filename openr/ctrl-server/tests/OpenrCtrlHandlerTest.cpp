@@ -364,6 +364,24 @@ TEST_F(OpenrCtrlFixture, RouteApis) {
     auto res = handler_->semifuture_getUnicastRoutes().get();
     EXPECT_EQ(0, res->size());
   }
+  {
+    auto res = handler_
+                   ->semifuture_getUnicastRoutesPage(
+                       std::make_unique<thrift::PageRequest>())
+                   .get();
+    EXPECT_EQ(0, res->routes()->size());
+    EXPECT_FALSE(res->nextCursor().has_value());
+  }
+  {
+    thrift::PageRequest request;
+    request.cursor() = "invalid-cursor";
+    EXPECT_THROW(
+        handler_
+            ->semifuture_getUnicastRoutesPage(
+                std::make_unique<thrift::PageRequest>(std::move(request)))
+            .get(),
+        thrift::OpenrError);
+  }
   {
     const std::vector<std::int32_t> labels{1, 2};
     auto res = handler_
@@ -381,6 +399,9 @@ TEST_F(OpenrCtrlFixture, RouteApis) {
 TEST_F(OpenrCtrlFixture, PerfApis) {
   auto db = handler_->semifuture_getPerfDb().get();
   EXPECT_EQ(nodeName_, *db->thisNodeName());
+
+  auto slowestDb = handler_->semifuture_getSlowestPerfDb().get();
+  EXPECT_EQ(nodeName_, *slowestDb->thisNodeName());
 }
 
 TEST_F(OpenrCtrlFixture, DecisionApis) {
@@ -772,6 +793,159 @@ TEST_F(OpenrCtrlFixture, KvStoreApis) {
   }
 }
 
+TEST_F(OpenrCtrlFixture, KvStoreKeyValsPage) {
+  thrift::KeyVals kvs;
+  for (int i = 0; i < 5; ++i) {
+    kvs.emplace(
+        fmt::format("key{}", i),
+        createThriftValue(1, "node1", fmt::format("value{}", i)));
+  }
+  kvs.emplace("otherKey", createThriftValue(1, "node1", std::string("other")));
+  setKvStoreKeyVals(kvs, kSpineAreaId);
+
+  thrift::PageRequest request;
+  request.limit() = 2;
+  request.keyPrefix() = "key";
+
+  // Page through with cursor
+  {
+    std::vector<std::string> keys;
+    auto pageRequest = request;
+    while (true) {
+      auto page = handler_
+                      ->semifuture_getKvStoreKeyValsPage(
+                          std::make_unique<std::string>(kSpineAreaId),
+                          std::make_unique<thrift::PageRequest>(pageRequest))
+                      .get();
+      EXPECT_LE(page->keyVals()->size(), 2);
+      std::vector<std::string> pageKeys;
+      for (auto const& [key, val] : *page->keyVals()) {
+        EXPECT_EQ(kvs.at(key).value(), val.value());
+        pageKeys.emplace_back(key);
+      }
+      std::sort(pageKeys.begin(), pageKeys.end());
+      keys.insert(keys.end(), pageKeys.begin(), pageKeys.end());
+      if (not page->nextCursor().has_value()) {
+        break;
+      }
+      pageRequest.cursor() = *page->nextCursor();
+    }
+    EXPECT_EQ(
+        std::vector<std::string>({"key0", "key1", "key2", "key3", "key4"}),
+        keys);
+  }
+
+  // Stream yields the same pages
+  {
+    auto stream = handler_->streamKvStoreKeyVals(
+        std::make_unique<std::string>(kSpineAreaId),
+        std::make_unique<thrift::PageRequest>(request));
+    std::atomic<size_t> numPages{0};
+    std::atomic<size_t> numKeys{0};
+    auto subscription =
+        std::move(stream).toClientStreamUnsafeDoNotUse().subscribeExTry(
+            folly::getEventBase(), [&numPages, &numKeys](auto&& t) {
+              if (not t.hasValue()) {
+                return;
+              }
+              numPages++;
+              numKeys += t->keyVals()->size();
+            });
+
+    // Wait until stream completes after the last page
+    std::move(subscription).join();
+    EXPECT_EQ(3, numPages);
+    EXPECT_EQ(5, numKeys);
+  }
+
+  // Unknown area
+  EXPECT_THROW(
+      handler_
+          ->semifuture_getKvStoreKeyValsPage(
+              std::make_unique<std::string>("unknown"),
+              std::make_unique<thrift::PageRequest>(request))
+          .get(),
+      thrift::KvStoreError);
+}
+
+TEST_F(OpenrCtrlFixture, VersionedApis) {
+  // Route database
+  {
+    auto res = handler_->semifuture_getRouteDbVersioned(0).get();
+    ASSERT_TRUE(res->routeDb().has_value());
+    EXPECT_EQ(nodeName_, *res->routeDb()->thisNodeName());
+
+    auto unchanged =
+        handler_->semifuture_getRouteDbVersioned(*res->generation()).get();
+    EXPECT_EQ(*res->generation(), *unchanged->generation());
+    EXPECT_FALSE(unchanged->routeDb().has_value());
+  }
+
+  // Interfaces
+  {
+    auto res = handler_->semifuture_getInterfacesVersioned(0).get();
+    ASSERT_TRUE(res->interfaces().has_value());
+
+    auto unchanged =
+        handler_->semifuture_getInterfacesVersioned(*res->generation()).get();
+    EXPECT_EQ(*res->generation(), *unchanged->generation());
+    EXPECT_FALSE(unchanged->interfaces().has_value());
+
+    // Drain state is part of link information
+    handler_->semifuture_setNodeOverload().get();
+    auto changed =
+        handler_->semifuture_getInterfacesVersioned(*res->generation()).get();
+    EXPECT_NE(*res->generation(), *changed->generation());
+    ASSERT_TRUE(changed->interfaces().has_value());
+    EXPECT_TRUE(*changed->interfaces()->isOverloaded());
+    handler_->semifuture_unsetNodeOverload().get();
+  }
+
+  // KvStore key-vals
+  {
+    const std::string key{"versionedKey"};
+    setKvStoreKeyVals(
+        {{key, createThriftValue(1, "node1", std::string("value1"))}},
+        kSpineAreaId);
+
+    thrift::KeyDumpParams params;
+    params.keys() = {key};
+    auto getVersioned = [&](int64_t lastGeneration) {
+      return handler_
+          ->semifuture_getKvStoreKeyValsFilteredAreaVersioned(
+              std::make_unique<thrift::KeyDumpParams>(params),
+              std::make_unique<std::string>(kSpineAreaId),
+              lastGeneration)
+          .get();
+    };
+
+    auto res = getVersioned(0);
+    ASSERT_TRUE(res->publication().has_value());
+    EXPECT_EQ(1, res->publication()->keyVals()->count(key));
+
+    auto unchanged = getVersioned(*res->generation());
+    EXPECT_EQ(*res->generation(), *unchanged->generation());
+    EXPECT_FALSE(unchanged->publication().has_value());
+
+    setKvStoreKeyVals(
+        {{key, createThriftValue(2, "node1", std::string("value2"))}},
+        kSpineAreaId);
+    auto changed = getVersioned(*res->generation());
+    EXPECT_NE(*res->generation(), *changed->generation());
+    ASSERT_TRUE(changed->publication().has_value());
+    EXPECT_EQ("value2", *changed->publication()->keyVals()->at(key).value());
+
+    EXPECT_THROW(
+        handler_
+            ->semifuture_getKvStoreKeyValsFilteredAreaVersioned(
+                std::make_unique<thrift::KeyDumpParams>(params),
+                std::make_unique<std::string>("unknown"),
+                0)
+            .get(),
+        thrift::KvStoreError);
+  }
+}
+
 TEST_F(OpenrCtrlFixture, subscribeAndGetKvStoreFilteredWithKeysNoTtlUpdate) {
   thrift::KeyVals kvs({
       {"key1", createThriftValue(1, "node1", std::string("value1"), 30000, 1)},
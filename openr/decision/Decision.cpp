@@ -263,6 +263,10 @@ Decision::Decision(
   // Initialize some stat keys
   fb303::fbData->addStatExportType(
       "decision.rib_policy_processing.time_ms", fb303::AVG);
+  fb303::fbData->addStatExportType(
+      "decision.prefix_bundle_updates", fb303::COUNT);
+  fb303::fbData->addStatExportType(
+      "decision.adj_db_shard_updates", fb303::COUNT);
 }
 
 void
@@ -341,6 +345,35 @@ Decision::getDecisionAreaAdjacenciesFiltered(thrift::AdjacenciesFilter filter) {
   return sf;
 }
 
+folly::SemiFuture<std::unique_ptr<thrift::VersionedAdjDbs>>
+Decision::getDecisionAdjacencyDbsVersioned(
+    std::string area, int64_t lastGeneration) {
+  auto [p, sf] =
+      folly::makePromiseContract<std::unique_ptr<thrift::VersionedAdjDbs>>();
+  runInEventBaseThread([this,
+                        p = std::move(p),
+                        area = std::move(area),
+                        lastGeneration]() mutable {
+    auto versionedAdjDbs = std::make_unique<thrift::VersionedAdjDbs>();
+    auto areaLinkStateIt = areaLinkStates_.find(area);
+    // Area without any adjacency database yet has zero generation
+    versionedAdjDbs->generation() = areaLinkStateIt == areaLinkStates_.end()
+        ? 0
+        : areaLinkStateIt->second.getAdjacencyDatabasesGeneration();
+    if (lastGeneration != *versionedAdjDbs->generation()) {
+      auto& adjDbs = versionedAdjDbs->adjDbs().ensure();
+      if (areaLinkStateIt != areaLinkStates_.end()) {
+        for (auto const& [node, db] :
+             areaLinkStateIt->second.getAdjacencyDatabases()) {
+          adjDbs.emplace(node, db);
+        }
+      }
+    }
+    p.setValue(std::move(versionedAdjDbs));
+  });
+  return std::move(sf);
+}
+
 folly::SemiFuture<std::unique_ptr<std::vector<thrift::ReceivedRouteDetail>>>
 Decision::getReceivedRoutesFiltered(thrift::ReceivedRouteFilter filter) {
   auto [p, sf] = folly::makePromiseContract<
@@ -352,24 +385,7 @@ Decision::getReceivedRoutesFiltered(thrift::ReceivedRouteFilter filter) {
           auto routes = prefixState_.getReceivedRoutesFiltered(filter);
 
           // Add best path result to this
-          auto const& bestRoutesCache = spfSolver_->getBestRoutesCache();
-          for (auto& route : routes) {
-            auto const& bestRoutesIt =
-                bestRoutesCache.find(toIPNetwork(*route.prefix()));
-            if (bestRoutesIt != bestRoutesCache.end()) {
-              auto const& bestRoutes = bestRoutesIt->second;
-              // Set all selected node-area
-              for (auto const& [node, area] : bestRoutes.allNodeAreas) {
-                route.bestKeys()->emplace_back();
-                auto& key = route.bestKeys()->back();
-                key.node() = node;
-                key.area() = area;
-              }
-              // Set best node-area
-              route.bestKey()->node() = bestRoutes.bestNodeArea.first;
-              route.bestKey()->area() = bestRoutes.bestNodeArea.second;
-            }
-          }
+          addBestKeys(routes);
 
           // Set the promise
           p.setValue(std::make_unique<std::vector<thrift::ReceivedRouteDetail>>(
@@ -381,6 +397,93 @@ Decision::getReceivedRoutesFiltered(thrift::ReceivedRouteFilter filter) {
   return std::move(sf);
 }
 
+folly::SemiFuture<std::unique_ptr<thrift::ReceivedRoutesPage>>
+Decision::getReceivedRoutesPage(
+    thrift::PageRequest request,
+    PageKeysSnapshot<folly::CIDRNetwork> sortedKeys) {
+  auto [p, sf] =
+      folly::makePromiseContract<std::unique_ptr<thrift::ReceivedRoutesPage>>();
+  runInEventBaseThread([this,
+                        p = std::move(p),
+                        request = std::move(request),
+                        sortedKeys = std::move(sortedKeys)]() mutable noexcept {
+    try {
+      auto routesPage =
+          prefixState_.getReceivedRoutesPage(request, sortedKeys.get());
+      addBestKeys(*routesPage.routes());
+      p.setValue(
+          std::make_unique<thrift::ReceivedRoutesPage>(std::move(routesPage)));
+    } catch (const thrift::OpenrError& e) {
+      p.setException(e);
+    }
+  });
+  return std::move(sf);
+}
+
+folly::SemiFuture<std::unique_ptr<thrift::AdjacencyDbsPage>>
+Decision::getDecisionAdjacencyDbsPage(
+    std::string area,
+    thrift::PageRequest request,
+    PageKeysSnapshot<std::string> sortedKeys) {
+  auto [p, sf] =
+      folly::makePromiseContract<std::unique_ptr<thrift::AdjacencyDbsPage>>();
+  runInEventBaseThread([this,
+                        p = std::move(p),
+                        area = std::move(area),
+                        request = std::move(request),
+                        sortedKeys = std::move(sortedKeys)]() mutable {
+    auto areaLinkStateIt = areaLinkStates_.find(area);
+    if (areaLinkStateIt == areaLinkStates_.end()) {
+      thrift::OpenrError error;
+      error.message() = fmt::format("Invalid area: {}", area);
+      p.setException(error);
+      return;
+    }
+
+    auto const& keyPrefix = request.keyPrefix();
+    auto const [page, hasMore] = selectPage(
+        areaLinkStateIt->second.getAdjacencyDatabases(),
+        request.cursor().to_optional(),
+        getPageLimit(*request.limit()),
+        [&keyPrefix](auto const& entry) {
+          return not keyPrefix or entry.first.find(*keyPrefix) == 0;
+        },
+        sortedKeys.get());
+
+    auto adjDbsPage = std::make_unique<thrift::AdjacencyDbsPage>();
+    for (auto const& it : page) {
+      adjDbsPage->adjDbs()->push_back(it->second);
+    }
+    if (hasMore) {
+      adjDbsPage->nextCursor() = page.back()->first;
+    }
+    p.setValue(std::move(adjDbsPage));
+  });
+  return std::move(sf);
+}
+
+void
+Decision::addBestKeys(std::vector<thrift::ReceivedRouteDetail>& routes) const {
+  auto const& bestRoutesCache = spfSolver_->getBestRoutesCache();
+  for (auto& route : routes) {
+    auto const& bestRoutesIt =
+        bestRoutesCache.find(toIPNetwork(*route.prefix()));
+    if (bestRoutesIt != bestRoutesCache.end()) {
+      auto const& bestRoutes = bestRoutesIt->second;
+      // Set all selected node-area
+      for (auto const& [node, area] : bestRoutes.allNodeAreas) {
+        route.bestKeys()->emplace_back();
+        auto& key = route.bestKeys()->back();
+        key.node() = node;
+        key.area() = area;
+      }
+      // Set best node-area
+      route.bestKey()->node() = bestRoutes.bestNodeArea.first;
+      route.bestKey()->area() = bestRoutes.bestNodeArea.second;
+    }
+  }
+}
+
 folly::SemiFuture<folly::Unit>
 Decision::clearRibPolicy() {
   auto [p, sf] = folly::makePromiseContract<folly::Unit>();
@@ -718,6 +821,26 @@ Decision::updateKeyInLsdb(
 
       auto& nodeName = *adjacencyDb.thisNodeName();
       adjacencyDb.area() = area;
+
+      // Adjacency database shard carries part of adjacencies of one node
+      auto maybeShardKey = AdjDbShardKey::fromStr(key);
+      if (maybeShardKey.hasValue()) {
+        // Shards of a node using full database are kept aside by LinkState
+        fb303::fbData->addStatValue(
+            "decision.adj_db_shard_updates", 1, fb303::COUNT);
+        pendingUpdates_.applyLinkStateChange(
+            nodeName,
+            areaLinkState.updateAdjacencyDatabaseShard(
+                adjacencyDb, maybeShardKey->getShardId(), area),
+            adjacencyDb.perfEvents());
+        return;
+      }
+
+      // Empty full database withdrawn by a node switched over to shards
+      if (adjacencyDb.adjacencies()->empty() and
+          areaLinkState.hasAdjacencyDatabaseShards(nodeName)) {
+        return;
+      }
       pendingUpdates_.applyLinkStateChange(
           nodeName,
           areaLinkState.updateAdjacencyDatabase(adjacencyDb, area),
@@ -730,6 +853,13 @@ Decision::updateKeyInLsdb(
       auto prefixDb = readThriftObjStr<thrift::PrefixDatabase>(
           rawVal.value().value(), serializer_);
 
+      // Prefix bundle carries multiple prefix entries of one node
+      auto maybeBundleKey = PrefixBundleKey::fromStr(key, area);
+      if (maybeBundleKey.hasValue()) {
+        updatePrefixBundleInLsdb(maybeBundleKey.value(), prefixDb);
+        return;
+      }
+
       // We expect per prefix key, ignore if publication is still in old
       // format.
       if (1 != prefixDb.prefixEntries()->size()) {
@@ -746,8 +876,7 @@ Decision::updateKeyInLsdb(
       // Ignore self redistributed route reflection
       // These routes are programmed by Decision,
       // re-origintaed by me to areas that do not have the best prefix entry
-      if (*prefixDb.thisNodeName() == myNodeName_ && areaStack.size() > 0 &&
-          areaLinkStates_.count(areaStack.back())) {
+      if (isSelfRedistributedReflection(*prefixDb.thisNodeName(), entry)) {
         XLOG(DBG2) << "Ignore self redistributed route reflection for prefix: "
                    << key << " area_stack: " << folly::join(",", areaStack);
         return;
@@ -769,6 +898,42 @@ Decision::updateKeyInLsdb(
   }
 }
 
+bool
+Decision::isSelfRedistributedReflection(
+    const std::string& nodeName, const thrift::PrefixEntry& entry) const {
+  auto const& areaStack = *entry.area_stack();
+  return nodeName == myNodeName_ && areaStack.size() > 0 &&
+      areaLinkStates_.count(areaStack.back());
+}
+
+void
+Decision::updatePrefixBundleInLsdb(
+    const PrefixBundleKey& bundleKey, thrift::PrefixDatabase& prefixDb) {
+  fb303::fbData->addStatValue(
+      "decision.prefix_bundle_updates", 1, fb303::COUNT);
+
+  if (*prefixDb.deletePrefix()) {
+    pendingUpdates_.applyPrefixStateChange(
+        prefixState_.deletePrefixBundle(bundleKey), prefixDb.perfEvents());
+    return;
+  }
+
+  // Bundle is always advertised with its full content. Drop self redistributed
+  // route reflection, same as per-prefix keys, before replacing the content.
+  std::vector<thrift::PrefixEntry> entries;
+  entries.reserve(prefixDb.prefixEntries()->size());
+  for (auto& entry : *prefixDb.prefixEntries()) {
+    if (isSelfRedistributedReflection(*prefixDb.thisNodeName(), entry)) {
+      continue;
+    }
+    entries.emplace_back(std::move(entry));
+  }
+
+  pendingUpdates_.applyPrefixStateChange(
+      prefixState_.updatePrefixBundle(bundleKey, entries),
+      prefixDb.perfEvents());
+}
+
 void
 Decision::deleteKeyFromLsdb(
     const std::string& area, LinkState& areaLinkState, const std::string& key) {
@@ -779,6 +944,20 @@ Decision::deleteKeyFromLsdb(
 
   if (key.find(Constants::kAdjDbMarker.toString()) == 0) {
     // adjacencyDb: delete keys starting with "adj:"
+    auto maybeShardKey = AdjDbShardKey::fromStr(key);
+    if (maybeShardKey.hasValue()) {
+      // Stale shard of a node using full database leaves topology untouched
+      pendingUpdates_.applyLinkStateChange(
+          nodeName,
+          areaLinkState.deleteAdjacencyDatabaseShard(
+              nodeName, maybeShardKey->getShardId()),
+          thrift::PrefixDatabase().perfEvents()); // Empty perf events
+      return;
+    }
+    // Stale full database of a node switched over to shards
+    if (areaLinkState.hasAdjacencyDatabaseShards(nodeName)) {
+      return;
+    }
     pendingUpdates_.applyLinkStateChange(
         nodeName,
         areaLinkState.deleteAdjacencyDatabase(nodeName),
@@ -788,6 +967,14 @@ Decision::deleteKeyFromLsdb(
 
   if (key.find(Constants::kPrefixDbMarker.toString()) == 0) {
     // prefixDb: delete keys starting with "prefix:"
+    auto maybeBundleKey = PrefixBundleKey::fromStr(key, area);
+    if (maybeBundleKey.hasValue()) {
+      pendingUpdates_.applyPrefixStateChange(
+          prefixState_.deletePrefixBundle(maybeBundleKey.value()),
+          thrift::PrefixDatabase().perfEvents()); // Empty perf events
+      return;
+    }
+
     auto maybePrefixKey = PrefixKey::fromStr(key, area);
     if (maybePrefixKey.hasError()) {
       // this is bad format of key.
@@ -902,7 +1089,7 @@ Decision::rebuildRoutes(std::string const& event) {
                                        : DecisionRouteDb{};
     if (ribPolicy_) {
       auto start = std::chrono::steady_clock::now();
-      ribPolicy_->applyPolicy(db.unicastRoutes);
+      ribPolicy_->applyPolicy(db.unicastRoutes, true /* isFullSync */);
       updateCounters(
           "decision.rib_policy_processing.time_ms",
           start,
@@ -932,6 +1119,7 @@ Decision::rebuildRoutes(std::string const& event) {
       for (auto const& prefix : changes.deletedRoutes) {
         update.unicastRoutesToDelete.push_back(prefix);
       }
+      ribPolicy_->evictCachedOutcomes(update.unicastRoutesToDelete);
     }
   }
 
@@ -169,12 +169,40 @@ class Decision : public OpenrEventBase {
       std::map<std::string, std::vector<thrift::AdjacencyDatabase>>>>
   getDecisionAreaAdjacenciesFiltered(thrift::AdjacenciesFilter filter = {});
 
+  /*
+   * Retrieve AdjacencyDatabase for all nodes in given area only if any of
+   * them changed since `lastGeneration`
+   */
+  folly::SemiFuture<std::unique_ptr<thrift::VersionedAdjDbs>>
+  getDecisionAdjacencyDbsVersioned(std::string area, int64_t lastGeneration);
+
   /*
    * Retrieve received routes along with best route selection output.
    */
   folly::SemiFuture<std::unique_ptr<std::vector<thrift::ReceivedRouteDetail>>>
   getReceivedRoutesFiltered(thrift::ReceivedRouteFilter filter);
 
+  /*
+   * Retrieve a page of received routes along with best route selection
+   * output, ordered by prefix. Pass the same `sortedKeys` snapshot for
+   * consecutive pages of a stream.
+   */
+  folly::SemiFuture<std::unique_ptr<thrift::ReceivedRoutesPage>>
+  getReceivedRoutesPage(
+      thrift::PageRequest request,
+      PageKeysSnapshot<folly::CIDRNetwork> sortedKeys = nullptr);
+
+  /*
+   * Retrieve a page of AdjacencyDatabase of nodes in given area, ordered by
+   * node name. `keyPrefix` of request selects node names starting with it.
+   * Pass the same `sortedKeys` snapshot for consecutive pages of a stream.
+   */
+  folly::SemiFuture<std::unique_ptr<thrift::AdjacencyDbsPage>>
+  getDecisionAdjacencyDbsPage(
+      std::string area,
+      thrift::PageRequest request,
+      PageKeysSnapshot<std::string> sortedKeys = nullptr);
+
   /*
    * Set new or replace existing RibPolicy. This will trigger the new policy
    * run against computed routes and delta will be published.
@@ -209,6 +237,9 @@ class Decision : public OpenrEventBase {
   // Process peer updates
   void processPeerUpdates(PeerEvent&& event);
 
+  // Fill best route selection output into received routes
+  void addBestKeys(std::vector<thrift::ReceivedRouteDetail>& routes) const;
+
   /*
    * [Link-State Database(LSDB) Management]
    *
@@ -233,6 +264,15 @@ class Decision : public OpenrEventBase {
       LinkState& areaLinkState,
       const std::string& key);
 
+  // Replace prefixes carried by one prefix bundle of originator
+  void updatePrefixBundleInLsdb(
+      const PrefixBundleKey& bundleKey, thrift::PrefixDatabase& prefixDb);
+
+  // Check if the prefix entry is self redistributed route reflected back from
+  // other areas
+  bool isSelfRedistributedReflection(
+      const std::string& nodeName, const thrift::PrefixEntry& entry) const;
+
   // Process publication from PrefixManager
   void processStaticRoutesUpdate(DecisionRouteUpdate&& routeUpdate);
 
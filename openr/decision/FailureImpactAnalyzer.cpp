@@ -0,0 +1,279 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include <algorithm>
+#include <atomic>
+#include <thread>
+
+#include <fmt/format.h>
+#include <folly/logging/xlog.h>
+
+#include <openr/decision/FailureImpactAnalyzer.h>
+
+namespace openr {
+
+namespace {
+
+// Re-create link states from their adjacency databases. Link objects are
+// shared between copies of a LinkState, hence a plain copy can't be mutated
+// independently.
+std::unordered_map<std::string, LinkState>
+cloneLinkStates(
+    std::unordered_map<std::string, LinkState> const& areaLinkStates) {
+  std::unordered_map<std::string, LinkState> clone;
+  for (auto const& [area, linkState] : areaLinkStates) {
+    auto& clonedLinkState = clone.emplace(area, LinkState(area)).first->second;
+    for (auto const& [_, adjDb] : linkState.getAdjacencyDatabases()) {
+      clonedLinkState.updateAdjacencyDatabase(adjDb, area);
+    }
+  }
+  return clone;
+}
+
+bool
+hasKsp2Prefixes(PrefixState const& prefixState) {
+  for (auto const& [_, prefixEntries] : prefixState.prefixes()) {
+    for (auto const& it : prefixEntries) {
+      if (*it.second->forwardingAlgorithm() ==
+          thrift::PrefixForwardingAlgorithm::KSP2_ED_ECMP) {
+        return true;
+      }
+    }
+  }
+  return false;
+}
+
+} // namespace
+
+std::string
+FailureScenario::toString() const {
+  if (isNodeFailure()) {
+    return fmt::format("{} - node {}", area, nodeName);
+  }
+  return fmt::format("{} - link {}%{}", area, nodeName, *ifName);
+}
+
+FailureImpactAnalyzer::FailureImpactAnalyzer(
+    const std::string& myNodeName,
+    bool enableV4,
+    bool enableNodeSegmentLabel,
+    bool enableAdjacencyLabels,
+    bool enableBestRouteSelection,
+    bool v4OverV6Nexthop)
+    : myNodeName_(myNodeName),
+      enableV4_(enableV4),
+      enableNodeSegmentLabel_(enableNodeSegmentLabel),
+      enableAdjacencyLabels_(enableAdjacencyLabels),
+      enableBestRouteSelection_(enableBestRouteSelection),
+      v4OverV6Nexthop_(v4OverV6Nexthop) {}
+
+std::unique_ptr<SpfSolver>
+FailureImpactAnalyzer::createSpfSolver() const {
+  return std::make_unique<SpfSolver>(
+      myNodeName_,
+      enableV4_,
+      enableNodeSegmentLabel_,
+      enableAdjacencyLabels_,
+      enableBestRouteSelection_,
+      v4OverV6Nexthop_);
+}
+
+std::vector<FailureScenario>
+FailureImpactAnalyzer::getAllFailureScenarios(
+    const LinkState& linkState) const {
+  std::vector<std::string> nodeNames;
+  for (auto const& [nodeName, _] : linkState.getAdjacencyDatabases()) {
+    nodeNames.emplace_back(nodeName);
+  }
+  std::sort(nodeNames.begin(), nodeNames.end());
+
+  std::vector<FailureScenario> scenarios;
+  // Link failures. Every link is reported from its first node only.
+  for (auto const& nodeName : nodeNames) {
+    std::vector<std::string> ifNames;
+    for (auto const& link : linkState.linksFromNode(nodeName)) {
+      if (link->firstNodeName() == nodeName) {
+        ifNames.emplace_back(link->getIfaceFromNode(nodeName));
+      }
+    }
+    std::sort(ifNames.begin(), ifNames.end());
+    for (auto& ifName : ifNames) {
+      scenarios.emplace_back(
+          FailureScenario{linkState.getArea(), nodeName, std::move(ifName)});
+    }
+  }
+  // Node failures
+  for (auto const& nodeName : nodeNames) {
+    if (nodeName != myNodeName_) {
+      scenarios.emplace_back(FailureScenario{linkState.getArea(), nodeName});
+    }
+  }
+  return scenarios;
+}
+
+bool
+FailureImpactAnalyzer::mayChangeRoutes(
+    FailureScenario const& scenario,
+    std::unordered_map<std::string, LinkState> const& areaLinkStates,
+    std::unordered_map<std::string, LinkState::LinkSet> const& spfDagLinks)
+    const {
+  auto areaIt = areaLinkStates.find(scenario.area);
+  if (areaIt == areaLinkStates.end() or
+      not areaIt->second.hasNode(scenario.nodeName)) {
+    return false;
+  }
+  if (scenario.isNodeFailure()) {
+    return true;
+  }
+
+  for (auto const& link : areaIt->second.linksFromNode(scenario.nodeName)) {
+    if (link->getIfaceFromNode(scenario.nodeName) != *scenario.ifName) {
+      continue;
+    }
+    // Own links also carry adjacency label routes
+    if (link->firstNodeName() == myNodeName_ or
+        link->secondNodeName() == myNodeName_) {
+      return true;
+    }
+    auto dagIt = spfDagLinks.find(scenario.area);
+    return dagIt == spfDagLinks.end() or dagIt->second.count(link) != 0;
+  }
+  // Unknown or half-established link
+  return false;
+}
+
+std::vector<FailureImpact>
+FailureImpactAnalyzer::analyze(
+    std::unordered_map<std::string, LinkState> const& areaLinkStates,
+    PrefixState const& prefixState,
+    std::vector<FailureScenario> const& scenarios,
+    size_t numWorkers) const {
+  const auto startTime = std::chrono::steady_clock::now();
+
+  // Baseline routes from a private copy of the link states. SPF results are
+  // memoized on first use, hence not even const methods are called on the
+  // caller's link states.
+  auto baseLinkStates = cloneLinkStates(areaLinkStates);
+  auto baseRouteDb =
+      createSpfSolver()
+          ->buildRouteDb(myNodeName_, baseLinkStates, prefixState)
+          .value_or(DecisionRouteDb{});
+
+  // Shortest path DAG of myNodeName_ per area. With shortest path forwarding
+  // failure of a link off the DAG doesn't change any route. KSP2 forwarding
+  // uses links off the DAG, hence don't prune at all then.
+  std::unordered_map<std::string, LinkState::LinkSet> spfDagLinks;
+  if (not hasKsp2Prefixes(prefixState)) {
+    for (auto const& [area, linkState] : baseLinkStates) {
+      auto& dagLinks = spfDagLinks[area];
+      for (auto const& [_, nodeResult] :
+           linkState.getSpfResult(myNodeName_)) {
+        for (auto const& pathLink : nodeResult.pathLinks()) {
+          dagLinks.emplace(pathLink.link);
+        }
+      }
+    }
+  }
+
+  std::vector<FailureImpact> impacts(scenarios.size());
+  std::vector<size_t> scenariosToEvaluate;
+  for (size_t i = 0; i < scenarios.size(); ++i) {
+    impacts.at(i).scenario = scenarios.at(i);
+    if (mayChangeRoutes(scenarios.at(i), baseLinkStates, spfDagLinks)) {
+      scenariosToEvaluate.emplace_back(i);
+    }
+  }
+
+  // Workers pick scenarios off a shared index. Each scenario is written by
+  // exactly one worker.
+  std::atomic<size_t> nextScenario{0};
+  auto worker = [&]() {
+    auto linkStates = cloneLinkStates(baseLinkStates);
+    auto spfSolver = createSpfSolver();
+    while (true) {
+      const auto pos = nextScenario.fetch_add(1);
+      if (pos >= scenariosToEvaluate.size()) {
+        break;
+      }
+      auto& impact = impacts.at(scenariosToEvaluate.at(pos));
+      auto const& scenario = impact.scenario;
+      auto& linkState = linkStates.at(scenario.area);
+
+      // Apply failure
+      const auto adjDb =
+          linkState.getAdjacencyDatabases().at(scenario.nodeName);
+      if (scenario.isNodeFailure()) {
+        linkState.deleteAdjacencyDatabase(scenario.nodeName);
+      } else {
+        auto failedAdjDb = adjDb;
+        auto& adjs = *failedAdjDb.adjacencies();
+        adjs.erase(
+            std::remove_if(
+                adjs.begin(),
+                adjs.end(),
+                [&](thrift::Adjacency const& adj) {
+                  return *adj.ifName() == *scenario.ifName;
+                }),
+            adjs.end());
+        linkState.updateAdjacencyDatabase(failedAdjDb, scenario.area);
+      }
+
+      auto routeDb =
+          spfSolver->buildRouteDb(myNodeName_, linkStates, prefixState)
+              .value_or(DecisionRouteDb{});
+
+      // Revert failure
+      linkState.updateAdjacencyDatabase(adjDb, scenario.area);
+
+      impact.routeDelta = baseRouteDb.calculateUpdate(std::move(routeDb));
+      for (auto const& [prefix, entry] :
+           impact.routeDelta.unicastRoutesToUpdate) {
+        auto it = baseRouteDb.unicastRoutes.find(prefix);
+        const size_t before = it == baseRouteDb.unicastRoutes.end()
+            ? 0
+            : it->second.nexthops.size();
+        if (before != entry.nexthops.size()) {
+          impact.ecmpWidthChanges.emplace(
+              prefix, std::make_pair(before, entry.nexthops.size()));
+        }
+      }
+      for (auto const& prefix : impact.routeDelta.unicastRoutesToDelete) {
+        impact.ecmpWidthChanges.emplace(
+            prefix,
+            std::make_pair(
+                baseRouteDb.unicastRoutes.at(prefix).nexthops.size(), 0));
+      }
+    }
+  };
+
+  numWorkers =
+      std::max<size_t>(1, std::min(numWorkers, scenariosToEvaluate.size()));
+  if (numWorkers == 1) {
+    worker();
+  } else {
+    std::vector<std::thread> workers;
+    for (size_t i = 0; i < numWorkers; ++i) {
+      workers.emplace_back(worker);
+    }
+    for (auto& t : workers) {
+      t.join();
+    }
+  }
+
+  XLOG(INFO) << fmt::format(
+      "Analyzed {} failure scenarios, {} needed a route rebuild, using {} "
+      "workers in {}ms",
+      scenarios.size(),
+      scenariosToEvaluate.size(),
+      numWorkers,
+      std::chrono::duration_cast<std::chrono::milliseconds>(
+          std::chrono::steady_clock::now() - startTime)
+          .count());
+  return impacts;
+}
+
+} // namespace openr
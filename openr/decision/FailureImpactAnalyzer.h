@@ -0,0 +1,113 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#pragma once
+
+#include <optional>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include <openr/decision/LinkState.h>
+#include <openr/decision/PrefixState.h>
+#include <openr/decision/RouteUpdate.h>
+#include <openr/decision/SpfSolver.h>
+
+namespace openr {
+
+/*
+ * Single failure to evaluate within an area. A link is identified by one of
+ * its ends, i.e. node and interface, a node failure leaves `ifName` unset.
+ */
+struct FailureScenario {
+  std::string area;
+  std::string nodeName;
+  std::optional<std::string> ifName{std::nullopt};
+
+  bool
+  isNodeFailure() const {
+    return not ifName.has_value();
+  }
+
+  std::string toString() const;
+};
+
+/*
+ * Impact of a failure on the routes of the analyzed node
+ */
+struct FailureImpact {
+  FailureScenario scenario;
+
+  // Route changes relative to the no-failure route db, i.e. what Decision
+  // would publish to Fib on this failure
+  DecisionRouteUpdate routeDelta;
+
+  // Unicast prefixes whose number of next-hops changed, as
+  // <before, after>. `after` is 0 if route is lost.
+  std::unordered_map<folly::CIDRNetwork, std::pair<size_t, size_t>>
+      ecmpWidthChanges;
+};
+
+/*
+ * Evaluates single-link and single-node failures in bulk for capacity
+ * planning, i.e. "what happens to routes of `myNodeName` if link L / node N
+ * fails".
+ *
+ * Scenarios are spread over worker threads. Each worker owns a private copy of
+ * the link state and an SpfSolver, applies one failure at a time, rebuilds
+ * routes and reverts the failure. Link failures which can't alter any route,
+ * i.e. links off the shortest path DAG of `myNodeName` while no prefix uses
+ * KSP2 forwarding, are resolved without a rebuild.
+ *
+ * Static routes are not considered. Input states are read-only and must not
+ * be modified while `analyze()` runs.
+ */
+class FailureImpactAnalyzer {
+ public:
+  FailureImpactAnalyzer(
+      const std::string& myNodeName,
+      bool enableV4,
+      bool enableNodeSegmentLabel,
+      bool enableAdjacencyLabels,
+      bool enableBestRouteSelection = false,
+      bool v4OverV6Nexthop = false);
+
+  // All single-link (one per bidirectional link) and single-node failures
+  // within `linkState`'s area. Node failures of `myNodeName` are omitted.
+  std::vector<FailureScenario> getAllFailureScenarios(
+      const LinkState& linkState) const;
+
+  // Evaluate `scenarios` using `numWorkers` threads. Impacts are returned in
+  // the order of `scenarios`. Scenarios referring to an unknown area, node or
+  // interface yield an empty impact.
+  std::vector<FailureImpact> analyze(
+      std::unordered_map<std::string, LinkState> const& areaLinkStates,
+      PrefixState const& prefixState,
+      std::vector<FailureScenario> const& scenarios,
+      size_t numWorkers = 1) const;
+
+ private:
+  std::unique_ptr<SpfSolver> createSpfSolver() const;
+
+  // Return false if scenario can't change routes of myNodeName_, e.g. unknown
+  // node or link. `spfDagLinks` are the links on shortest paths from
+  // myNodeName_ per area, links of areas without entry are never pruned.
+  bool mayChangeRoutes(
+      FailureScenario const& scenario,
+      std::unordered_map<std::string, LinkState> const& areaLinkStates,
+      std::unordered_map<std::string, LinkState::LinkSet> const& spfDagLinks)
+      const;
+
+  const std::string myNodeName_;
+  const bool enableV4_{false};
+  const bool enableNodeSegmentLabel_{true};
+  const bool enableAdjacencyLabels_{true};
+  const bool enableBestRouteSelection_{false};
+  const bool v4OverV6Nexthop_{false};
+};
+
+} // namespace openr
@@ -389,7 +389,8 @@ Link::directionalToString(const std::string& fromNode) const {
       getIfaceFromNode(getOtherNodeName(fromNode)));
 }
 
-LinkState::LinkState(const std::string& area) : area_(area) {}
+LinkState::LinkState(const std::string& area)
+    : area_(area), adjacencyDatabasesGeneration_(getInitialGeneration()) {}
 
 size_t
 LinkState::LinkPtrHash::operator()(const std::shared_ptr<Link>& l) const {
@@ -586,11 +587,6 @@ LinkState::getOrderedLinkSet(const thrift::AdjacencyDatabase& adjDb) const {
 LinkState::LinkStateChange
 LinkState::updateAdjacencyDatabase(
     thrift::AdjacencyDatabase const& newAdjacencyDb, std::string area) {
-  LinkStateChange change;
-
-  // TODO remove holdable value
-  LinkStateMetric holdUpTtl = 0, holdDownTtl = 0;
-
   // Area field must be specified and match with area_
   DCHECK_EQ(area_, area);
   for (auto const& adj : *newAdjacencyDb.adjacencies()) {
@@ -601,18 +597,191 @@ LinkState::updateAdjacencyDatabase(
                << ", rtt: " << *adj.rtt() << ", weight: " << *adj.weight();
   }
 
+  auto const& nodeName = *newAdjacencyDb.thisNodeName();
+
+  // Withdrawn full adjacency database hands over to the shards kept aside
+  auto pendingIt = pendingAdjacencyDatabaseShards_.find(nodeName);
+  if (newAdjacencyDb.adjacencies()->empty() and
+      pendingIt != pendingAdjacencyDatabaseShards_.end()) {
+    auto& shards = adjacencyDatabaseShards_[nodeName];
+    shards = std::move(pendingIt->second);
+    pendingAdjacencyDatabaseShards_.erase(pendingIt);
+
+    thrift::AdjacencyDatabase shardedAdjacencyDb = newAdjacencyDb;
+    for (auto const& [_, adjs] : shards) {
+      shardedAdjacencyDb.adjacencies()->insert(
+          shardedAdjacencyDb.adjacencies()->end(), adjs.begin(), adjs.end());
+    }
+    return updateAdjacencyDatabaseImpl(
+        shardedAdjacencyDb,
+        orderedLinksFromNode(nodeName),
+        getOrderedLinkSet(shardedAdjacencyDb));
+  }
+
+  // Full adjacency database supersedes shards, if any
+  adjacencyDatabaseShards_.erase(nodeName);
+
+  // for comparing old and new state, we order the links based on the tuple
+  // <nodeName1, iface1, nodeName2, iface2>, this allows us to easily discern
+  // topology changes in the single loop below
+  return updateAdjacencyDatabaseImpl(
+      newAdjacencyDb,
+      orderedLinksFromNode(nodeName),
+      getOrderedLinkSet(newAdjacencyDb));
+}
+
+LinkState::LinkStateChange
+LinkState::updateAdjacencyDatabaseShard(
+    thrift::AdjacencyDatabase const& shardAdjacencyDb,
+    uint32_t shardId,
+    std::string area) {
+  // Area field must be specified and match with area_
+  DCHECK_EQ(area_, area);
+
+  auto const& nodeName = *shardAdjacencyDb.thisNodeName();
+  XLOG(DBG3) << "Updating adjacency database shard " << shardId << " of node "
+             << nodeName << " with "
+             << shardAdjacencyDb.adjacencies()->size() << " adjacencies";
+
+  // Full adjacency database of a node not using shards wins over shards
+  // received meanwhile, e.g. stale ones left over from an earlier encoding or
+  // new ones advertised ahead of the full database withdrawal. These are kept
+  // aside until the full database is withdrawn.
+  const bool isFirstShard = 0 == adjacencyDatabaseShards_.count(nodeName);
+  auto fullDbIt = adjacencyDatabases_.find(nodeName);
+  if (isFirstShard and fullDbIt != adjacencyDatabases_.end() and
+      (shardAdjacencyDb.adjacencies()->empty() or
+       not fullDbIt->second.adjacencies()->empty())) {
+    auto& pendingShards = pendingAdjacencyDatabaseShards_[nodeName];
+    setShardAdjacencies(
+        pendingShards, shardId, *shardAdjacencyDb.adjacencies());
+    if (shardAdjacencyDb.adjacencies()->empty()) {
+      pendingShards.erase(shardId);
+    }
+    if (pendingShards.empty()) {
+      pendingAdjacencyDatabaseShards_.erase(nodeName);
+    }
+    return LinkStateChange{};
+  }
+
+  // Node switching over from a full adjacency database starts over, i.e. its
+  // links not (yet) advertised by any shard go down
+  auto& shards = adjacencyDatabaseShards_[nodeName];
+  auto oldIfNames =
+      setShardAdjacencies(shards, shardId, *shardAdjacencyDb.adjacencies());
+
+  std::vector<std::shared_ptr<Link>> oldLinks;
+  if (isFirstShard) {
+    oldLinks = orderedLinksFromNode(nodeName);
+  } else {
+    for (auto const& link : linksFromNode(nodeName)) {
+      if (oldIfNames.count(link->getIfaceFromNode(nodeName))) {
+        oldLinks.emplace_back(link);
+      }
+    }
+    std::sort(oldLinks.begin(), oldLinks.end(), LinkPtrLess{});
+  }
+
+  // Node's adjacency database is the union of its shards
+  thrift::AdjacencyDatabase newAdjacencyDb = shardAdjacencyDb;
+  newAdjacencyDb.adjacencies()->clear();
+  for (auto const& [_, adjs] : shards) {
+    newAdjacencyDb.adjacencies()->insert(
+        newAdjacencyDb.adjacencies()->end(), adjs.begin(), adjs.end());
+  }
+
+  return updateAdjacencyDatabaseImpl(
+      newAdjacencyDb, oldLinks, getOrderedLinkSet(shardAdjacencyDb));
+}
+
+std::unordered_set<std::string>
+LinkState::setShardAdjacencies(
+    std::map<uint32_t, std::vector<thrift::Adjacency>>& shards,
+    uint32_t shardId,
+    std::vector<thrift::Adjacency> const& adjacencies) {
+  // Interfaces of this node possibly affected by the update: the ones this
+  // shard carried before plus the ones taken over from other shards (e.g.
+  // number of shards changed). Every interface belongs to one shard only.
+  std::unordered_set<std::string> shardIfNames;
+  for (auto const& adj : adjacencies) {
+    shardIfNames.emplace(*adj.ifName());
+  }
+  std::unordered_set<std::string> oldIfNames;
+  for (auto& [id, adjs] : shards) {
+    if (id == shardId) {
+      for (auto const& adj : adjs) {
+        oldIfNames.emplace(*adj.ifName());
+      }
+      continue;
+    }
+    adjs.erase(
+        std::remove_if(
+            adjs.begin(),
+            adjs.end(),
+            [&](thrift::Adjacency const& adj) {
+              if (shardIfNames.count(*adj.ifName())) {
+                oldIfNames.emplace(*adj.ifName());
+                return true;
+              }
+              return false;
+            }),
+        adjs.end());
+  }
+  shards[shardId] = adjacencies;
+  return oldIfNames;
+}
+
+LinkState::LinkStateChange
+LinkState::deleteAdjacencyDatabaseShard(
+    const std::string& nodeName, uint32_t shardId) {
+  // Shard kept aside behind a full adjacency database is simply forgotten
+  auto pendingIt = pendingAdjacencyDatabaseShards_.find(nodeName);
+  if (pendingIt != pendingAdjacencyDatabaseShards_.end() and
+      pendingIt->second.erase(shardId)) {
+    if (pendingIt->second.empty()) {
+      pendingAdjacencyDatabaseShards_.erase(pendingIt);
+    }
+    return LinkStateChange{};
+  }
+
+  auto nodeIt = adjacencyDatabaseShards_.find(nodeName);
+  if (nodeIt == adjacencyDatabaseShards_.end() or
+      0 == nodeIt->second.count(shardId)) {
+    XLOG(DBG2) << "Ignoring deletion of unknown adjacency db shard "
+               << shardId << " of node " << nodeName;
+    return LinkStateChange{};
+  }
+  if (1 == nodeIt->second.size()) {
+    return deleteAdjacencyDatabase(nodeName);
+  }
+
+  // Withdraw adjacencies of the shard, then forget about it
+  auto emptyShardDb = adjacencyDatabases_.at(nodeName);
+  emptyShardDb.adjacencies()->clear();
+  auto change = updateAdjacencyDatabaseShard(emptyShardDb, shardId, area_);
+  adjacencyDatabaseShards_.at(nodeName).erase(shardId);
+  return change;
+}
+
+LinkState::LinkStateChange
+LinkState::updateAdjacencyDatabaseImpl(
+    thrift::AdjacencyDatabase const& newAdjacencyDb,
+    std::vector<std::shared_ptr<Link>> const& oldLinks,
+    std::vector<std::shared_ptr<Link>> const& newLinks) {
+  LinkStateChange change;
+
+  // TODO remove holdable value
+  LinkStateMetric holdUpTtl = 0, holdDownTtl = 0;
+
   // Default construct if it did not exist
   auto const& nodeName = *newAdjacencyDb.thisNodeName();
   thrift::AdjacencyDatabase priorAdjacencyDb(
       std::move(adjacencyDatabases_[nodeName]));
   // replace
   adjacencyDatabases_[nodeName] = newAdjacencyDb;
-
-  // for comparing old and new state, we order the links based on the tuple
-  // <nodeName1, iface1, nodeName2, iface2>, this allows us to easily discern
-  // topology changes in the single loop below
-  auto oldLinks = orderedLinksFromNode(nodeName);
-  auto newLinks = getOrderedLinkSet(newAdjacencyDb);
+  if (priorAdjacencyDb != newAdjacencyDb) {
+    ++adjacencyDatabasesGeneration_;
+  }
 
   // fill these sets with the appropriate links
   std::unordered_set<Link> linksUp;
@@ -763,9 +932,20 @@ LinkState::deleteAdjacencyDatabase(const std::string& nodeName) {
   XLOG(DBG1) << "Deleting adjacency database for node " << nodeName;
   auto search = adjacencyDatabases_.find(nodeName);
 
+  // Expired full adjacency database hands over to the shards kept aside
+  if (search != adjacencyDatabases_.end() and
+      pendingAdjacencyDatabaseShards_.count(nodeName)) {
+    auto emptyAdjacencyDb = search->second;
+    emptyAdjacencyDb.adjacencies()->clear();
+    return updateAdjacencyDatabase(emptyAdjacencyDb, area_);
+  }
+
+  adjacencyDatabaseShards_.erase(nodeName);
+  pendingAdjacencyDatabaseShards_.erase(nodeName);
   if (search != adjacencyDatabases_.end()) {
     removeNode(nodeName);
     adjacencyDatabases_.erase(search);
+    ++adjacencyDatabasesGeneration_;
     spfResults_.clear();
     kthPathResults_.clear();
     change.topologyChanged = true;
@@ -805,8 +985,11 @@ LinkState::getKthPaths(
       }
     }
     std::vector<LinkState::Path> paths;
-    auto const& res = linksToIgnore.empty() ? getSpfResult(src, true)
-                                            : runSpf(src, true, linksToIgnore);
+    // Tracing paths only needs nodes no further than dest. Pruned SPF run for
+    // k > 1 is thus stopped at dest instead of exploring the whole graph.
+    auto const& res = linksToIgnore.empty()
+        ? getSpfResult(src, true)
+        : runSpf(src, true, linksToIgnore, dest);
     if (res.count(dest)) {
       LinkSet visitedLinks;
       auto path = traceOnePath(src, dest, res, visitedLinks);
@@ -839,7 +1022,8 @@ LinkState::SpfResult
 LinkState::runSpf(
     const std::string& thisNodeName,
     bool useLinkMetric,
-    const LinkState::LinkSet& linksToIgnore) const {
+    const LinkState::LinkSet& linksToIgnore,
+    const std::optional<std::string>& dest) const {
   LinkState::SpfResult result;
 
   fb303::fbData->addStatValue("decision.spf_runs", 1, fb303::COUNT);
@@ -858,6 +1042,12 @@ LinkState::runSpf(
     auto const recordedNodeMetric = emplaceRc.first->second.metric();
     auto const& recordedNodeNextHops = emplaceRc.first->second.nextHops();
 
+    if (dest.has_value() && recordedNodeName == dest.value()) {
+      // dest's shortest paths are final once it is extracted. Every node on
+      // them is already recorded as well, no need to explore further.
+      break;
+    }
+
     if (isNodeOverloaded(recordedNodeName) &&
         recordedNodeName != thisNodeName) {
       // no transit traffic through this node. we've recorded the nexthops to
@@ -9,9 +9,12 @@
 
 #include <algorithm>
 #include <cstdint>
+#include <map>
 #include <memory>
 #include <numeric>
+#include <optional>
 #include <string>
+#include <tuple>
 #include <unordered_map>
 #include <unordered_set>
 #include <vector>
@@ -420,6 +423,28 @@ class LinkState {
   // return true if this has caused any change in graph
   LinkStateChange deleteAdjacencyDatabase(const std::string& nodeName);
 
+  // update one shard of a router's adjacency database. The node's adjacency
+  // database is the union of its shards with node attributes of the latest
+  // shard. Only links of the shard are diffed. A full adjacency database
+  // received via `updateAdjacencyDatabase()` supersedes all shards. Shards
+  // of a node with non-empty full adjacency database are kept aside and only
+  // take over once the full adjacency database is withdrawn or deleted.
+  LinkStateChange updateAdjacencyDatabaseShard(
+      thrift::AdjacencyDatabase const& shardAdjacencyDb,
+      uint32_t shardId,
+      std::string area);
+
+  // delete one shard of a router's adjacency database. Node is deleted along
+  // with its last shard, unless a full adjacency database is in use.
+  LinkStateChange deleteAdjacencyDatabaseShard(
+      const std::string& nodeName, uint32_t shardId);
+
+  // whether node's adjacency database is made of shards
+  bool
+  hasAdjacencyDatabaseShards(const std::string& nodeName) const {
+    return 0 != adjacencyDatabaseShards_.count(nodeName);
+  }
+
   // const public methods
 
   // returns metric from a to b,
@@ -465,6 +490,12 @@ class LinkState {
     return adjacencyDatabases_;
   }
 
+  // get generation of adjacency databases, changes on every update of them
+  int64_t
+  getAdjacencyDatabasesGeneration() const {
+    return adjacencyDatabasesGeneration_;
+  }
+
   // check if path A is part of path B.
   // Example:
   // path A: a->b->c
@@ -517,8 +548,11 @@ class LinkState {
                              weights as advertised from the adjacent nodes,
                              otherwise it will consider the graph unweighted */
       const LinkSet& linksToIgnore =
-          {} /* optionaly specify a set of links to not use when running */)
-      const;
+          {} /* optionaly specify a set of links to not use when running */,
+      const std::optional<std::string>& dest =
+          std::nullopt /* optionaly stop once shortest paths to dest are
+                          found. result then only holds nodes no further
+                          than dest */) const;
 
   // returns Link object if the reverse adjancency is present in
   // adjacencyDatabases_.at(adj.otherNodeName), else returns nullptr
@@ -531,6 +565,20 @@ class LinkState {
   std::vector<std::shared_ptr<Link>> orderedLinksFromNode(
       const std::string& nodeName) const;
 
+  // set adjacencies of one shard, taking over interfaces from other shards.
+  // Returns interfaces whose adjacencies were carried by shards before.
+  static std::unordered_set<std::string> setShardAdjacencies(
+      std::map<uint32_t, std::vector<thrift::Adjacency>>& shards,
+      uint32_t shardId,
+      std::vector<thrift::Adjacency> const& adjacencies);
+
+  // replace node's adjacency database and apply the difference between
+  // `oldLinks` and `newLinks`, i.e. links of the node before and after update
+  LinkStateChange updateAdjacencyDatabaseImpl(
+      thrift::AdjacencyDatabase const& newAdjacencyDb,
+      std::vector<std::shared_ptr<Link>> const& oldLinks,
+      std::vector<std::shared_ptr<Link>> const& newLinks);
+
   // this stores the same link object accessible from either nodeName
   std::unordered_map<std::string /* nodeName */, LinkSet> linkMap_;
 
@@ -552,6 +600,21 @@ class LinkState {
   std::unordered_map<std::string, thrift::AdjacencyDatabase>
       adjacencyDatabases_;
 
+  // adjacencies per shard of nodes advertising sharded adjacency databases
+  std::unordered_map<
+      std::string /* nodeName */,
+      std::map<uint32_t /* shardId */, std::vector<thrift::Adjacency>>>
+      adjacencyDatabaseShards_;
+
+  // shards received while the node's full adjacency database is in use
+  std::unordered_map<
+      std::string /* nodeName */,
+      std::map<uint32_t /* shardId */, std::vector<thrift::Adjacency>>>
+      pendingAdjacencyDatabaseShards_;
+
+  // generation of adjacencyDatabases_
+  int64_t adjacencyDatabasesGeneration_{0};
+
 }; // class LinkState
 
 // Classes needed for running Dijkstra to build an SPF graph starting at a root
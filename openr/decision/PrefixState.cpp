@@ -8,32 +8,68 @@
 #include <folly/logging/xlog.h>
 
 #include <openr/common/LsdbUtil.h>
+#include <openr/common/Util.h>
 #include <openr/decision/PrefixState.h>
 
 namespace openr {
 
-std::unordered_set<folly::CIDRNetwork>
-PrefixState::updatePrefix(
-    PrefixKey const& key, thrift::PrefixEntry const& entry) {
-  std::unordered_set<folly::CIDRNetwork> changed;
-
-  auto [it, inserted] = prefixes_[key.getCIDRNetwork()].emplace(
-      key.getNodeAndArea(), std::make_shared<thrift::PrefixEntry>(entry));
+bool
+PrefixState::updatePrefixEntry(
+    NodeAndArea const& nodeAndArea,
+    folly::CIDRNetwork const& prefix,
+    thrift::PrefixEntry const& entry) {
+  auto [it, inserted] = prefixes_[prefix].emplace(
+      nodeAndArea, std::make_shared<thrift::PrefixEntry>(entry));
 
   // Skip rest of code, if prefix exists and has no change
   if (not inserted && *it->second == entry) {
-    return changed;
+    return false;
   }
   // Update prefix
   if (not inserted) {
     it->second = std::make_shared<thrift::PrefixEntry>(entry);
   }
-  changed.insert(key.getCIDRNetwork());
 
   XLOG(DBG1) << "[ROUTE ADVERTISEMENT] "
-             << "Area: " << key.getPrefixArea()
-             << ", Node: " << key.getNodeName() << ", "
+             << "Area: " << nodeAndArea.second
+             << ", Node: " << nodeAndArea.first << ", "
              << toString(entry, VLOG_IS_ON(1));
+  return true;
+}
+
+bool
+PrefixState::deletePrefixEntry(
+    NodeAndArea const& nodeAndArea, folly::CIDRNetwork const& prefix) {
+  auto search = prefixes_.find(prefix);
+  if (search == prefixes_.end() or (not search->second.erase(nodeAndArea))) {
+    return false;
+  }
+
+  XLOG(DBG1) << "[ROUTE WITHDRAW] "
+             << "Area: " << nodeAndArea.second
+             << ", Node: " << nodeAndArea.first << ", "
+             << folly::IPAddress::networkToString(prefix);
+  // clean up data structures
+  if (search->second.empty()) {
+    prefixes_.erase(search);
+  }
+  return true;
+}
+
+std::unordered_set<folly::CIDRNetwork>
+PrefixState::updatePrefix(
+    PrefixKey const& key, thrift::PrefixEntry const& entry) {
+  std::unordered_set<folly::CIDRNetwork> changed;
+
+  // Per-prefix key takes over the ownership from prefix bundle (if any)
+  auto bundledIt = bundledPrefixes_.find(key.getNodeAndArea());
+  if (bundledIt != bundledPrefixes_.end()) {
+    bundledIt->second.erase(key.getCIDRNetwork());
+  }
+
+  if (updatePrefixEntry(key.getNodeAndArea(), key.getCIDRNetwork(), entry)) {
+    changed.insert(key.getCIDRNetwork());
+  }
   return changed;
 }
 
@@ -41,22 +77,78 @@ std::unordered_set<folly::CIDRNetwork>
 PrefixState::deletePrefix(PrefixKey const& key) {
   std::unordered_set<folly::CIDRNetwork> changed;
 
-  auto search = prefixes_.find(key.getCIDRNetwork());
-  if (search != prefixes_.end() and
-      search->second.erase(key.getNodeAndArea())) {
+  // Ignore withdrawal of per-prefix key if prefix is owned by prefix bundle
+  auto bundledIt = bundledPrefixes_.find(key.getNodeAndArea());
+  if (bundledIt != bundledPrefixes_.end() and
+      bundledIt->second.count(key.getCIDRNetwork())) {
+    return changed;
+  }
+
+  if (deletePrefixEntry(key.getNodeAndArea(), key.getCIDRNetwork())) {
     changed.insert(key.getCIDRNetwork());
-    XLOG(DBG1) << "[ROUTE WITHDRAW] "
-               << "Area: " << key.getPrefixArea()
-               << ", Node: " << key.getNodeName() << ", "
-               << folly::IPAddress::networkToString(key.getCIDRNetwork());
-    // clean up data structures
-    if (search->second.empty()) {
-      prefixes_.erase(search);
+  }
+  return changed;
+}
+
+std::unordered_set<folly::CIDRNetwork>
+PrefixState::updatePrefixBundle(
+    PrefixBundleKey const& key,
+    std::vector<thrift::PrefixEntry> const& entries) {
+  std::unordered_set<folly::CIDRNetwork> changed;
+  std::unordered_set<folly::CIDRNetwork> bundlePrefixes;
+  auto const& nodeAndArea = key.getNodeAndArea();
+  auto& owners = bundledPrefixes_[nodeAndArea];
+
+  for (auto const& entry : entries) {
+    auto const network = toIPNetwork(*entry.prefix());
+    if (not bundlePrefixes.emplace(network).second) {
+      XLOG(WARNING) << "Skip duplicated prefix "
+                    << folly::IPAddress::networkToString(network)
+                    << " in bundle " << key.getPrefixBundleKeyStr();
+      continue;
+    }
+    owners[network] = key.getShardId();
+    if (updatePrefixEntry(nodeAndArea, network, entry)) {
+      changed.insert(network);
     }
   }
+
+  // Withdraw prefixes which are dropped from this bundle. Skip the ones owned
+  // by other bundle or per-prefix key in the meantime.
+  auto bundleIt = bundles_.find(key);
+  if (bundleIt != bundles_.end()) {
+    for (auto const& network : bundleIt->second) {
+      if (bundlePrefixes.count(network)) {
+        continue;
+      }
+      auto ownerIt = owners.find(network);
+      if (ownerIt == owners.end() or ownerIt->second != key.getShardId()) {
+        continue;
+      }
+      owners.erase(ownerIt);
+      if (deletePrefixEntry(nodeAndArea, network)) {
+        changed.insert(network);
+      }
+    }
+  }
+
+  if (owners.empty()) {
+    bundledPrefixes_.erase(nodeAndArea);
+  }
+  if (bundlePrefixes.empty()) {
+    bundles_.erase(key);
+  } else {
+    bundles_.insert_or_assign(key, std::move(bundlePrefixes));
+  }
   return changed;
 }
 
+std::unordered_set<folly::CIDRNetwork>
+PrefixState::deletePrefixBundle(PrefixBundleKey const& key) {
+  // Withdrawing a bundle is equivalent to advertising it empty
+  return updatePrefixBundle(key, {});
+}
+
 std::vector<thrift::ReceivedRouteDetail>
 PrefixState::getReceivedRoutesFiltered(
     thrift::ReceivedRouteFilter const& filter) const {
@@ -79,6 +171,47 @@ PrefixState::getReceivedRoutesFiltered(
   return routes;
 }
 
+thrift::ReceivedRoutesPage
+PrefixState::getReceivedRoutesPage(
+    thrift::PageRequest const& request,
+    std::vector<folly::CIDRNetwork>* sortedKeys) const {
+  std::optional<folly::CIDRNetwork> cursor;
+  if (request.cursor()) {
+    cursor = toIPNetwork(toIpPrefix(*request.cursor()));
+  }
+  std::optional<folly::CIDRNetwork> range;
+  if (request.keyPrefix()) {
+    range = toIPNetwork(toIpPrefix(*request.keyPrefix()));
+  }
+
+  auto const [page, hasMore] = selectPage(
+      prefixes_,
+      cursor,
+      getPageLimit(*request.limit()),
+      [&range](auto const& entry) {
+        return not entry.second.empty() and
+            (not range or isPrefixWithin(entry.first, *range));
+      },
+      sortedKeys);
+
+  // Routes are returned unfiltered by node and area
+  thrift::ReceivedRouteFilter const noFilter;
+  thrift::ReceivedRoutesPage routesPage;
+  for (auto const& it : page) {
+    filterAndAddReceivedRoute(
+        *routesPage.routes(),
+        noFilter.nodeName(),
+        noFilter.areaName(),
+        it->first,
+        it->second);
+  }
+  if (hasMore) {
+    routesPage.nextCursor() =
+        folly::IPAddress::networkToString(page.back()->first);
+  }
+  return routesPage;
+}
+
 void
 PrefixState::filterAndAddReceivedRoute(
     std::vector<thrift::ReceivedRouteDetail>& routes,
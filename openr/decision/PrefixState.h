@@ -31,9 +31,28 @@ class PrefixState {
   // empty if node/area did not previosuly advertise
   std::unordered_set<folly::CIDRNetwork> deletePrefix(PrefixKey const& key);
 
+  // Replace the content of one prefix bundle with given entries. Prefixes
+  // dropped from the bundle are withdrawn. Returns set of changed prefixes.
+  std::unordered_set<folly::CIDRNetwork> updatePrefixBundle(
+      PrefixBundleKey const& key,
+      std::vector<thrift::PrefixEntry> const& entries);
+
+  // Withdraw all prefixes carried by one prefix bundle. Returns set of changed
+  // prefixes.
+  std::unordered_set<folly::CIDRNetwork> deletePrefixBundle(
+      PrefixBundleKey const& key);
+
   std::vector<thrift::ReceivedRouteDetail> getReceivedRoutesFiltered(
       thrift::ReceivedRouteFilter const& filter) const;
 
+  /**
+   * Get a page of received routes ordered by prefix. Throws
+   * thrift::OpenrError on malformed cursor or prefix range.
+   */
+  thrift::ReceivedRoutesPage getReceivedRoutesPage(
+      thrift::PageRequest const& request,
+      std::vector<folly::CIDRNetwork>* sortedKeys = nullptr) const;
+
   /**
    * Filter routes only the <type> attribute
    */
@@ -45,6 +64,16 @@ class PrefixState {
       PrefixEntries const& prefixEntries);
 
  private:
+  // Add/update one prefix entry of [node, area]. Returns true if changed.
+  bool updatePrefixEntry(
+      NodeAndArea const& nodeAndArea,
+      folly::CIDRNetwork const& prefix,
+      thrift::PrefixEntry const& entry);
+
+  // Remove one prefix entry of [node, area]. Returns true if changed.
+  bool deletePrefixEntry(
+      NodeAndArea const& nodeAndArea, folly::CIDRNetwork const& prefix);
+
   // TODO: Also maintain clean list of reachable prefix entries. A node might
   // become un-reachable we might still have their prefix entries, until gets
   // expired in KvStore. This will simplify logic in route computation where
@@ -53,5 +82,21 @@ class PrefixState {
   // Data structure to maintain mapping from:
   //  IpPrefix -> collection of originator(i.e. [node, area] combination)
   std::unordered_map<folly::CIDRNetwork, PrefixEntries> prefixes_;
+
+  // Prefixes carried by each prefix bundle. Used to withdraw prefixes dropped
+  // from a bundle, as a bundle is always advertised with its full content.
+  std::unordered_map<PrefixBundleKey, std::unordered_set<folly::CIDRNetwork>>
+      bundles_;
+
+  // Ownership of bundled prefixes, i.e.
+  //  [node, area] -> prefix -> shard id of the bundle carrying the prefix
+  // ATTN: one node might transiently advertise the same prefix via both
+  // per-prefix key and bundle (e.g. migrating between encodings). The last
+  // update takes the ownership, and withdrawal from the other encoding is
+  // ignored.
+  std::unordered_map<
+      NodeAndArea,
+      std::unordered_map<folly::CIDRNetwork, uint32_t>>
+      bundledPrefixes_;
 };
 } // namespace openr
@@ -7,8 +7,11 @@
 
 #include <openr/decision/RibPolicy.h>
 
+#include <algorithm>
+
 #include <fb303/ServiceData.h>
 #include <folly/MapUtil.h>
+#include <folly/hash/Hash.h>
 #include <folly/logging/xlog.h>
 
 namespace openr {
@@ -160,6 +163,29 @@ RibPolicyStatement::applyAction(RibUnicastEntry& route) const {
   return true;
 }
 
+namespace {
+
+/**
+ * Hash of the route attributes policy outcome depends on i.e. tags for
+ * matching, next-hops for transformation and counter ID carried over from
+ * non-selecting statements. Next-hops are unordered, so are their hashes.
+ */
+size_t
+getPolicyInputHash(const RibUnicastEntry& route) {
+  size_t nexthopsHash{0};
+  for (auto const& nh : route.nexthops) {
+    nexthopsHash += std::hash<thrift::NextHopThrift>()(nh);
+  }
+  size_t hash = folly::hash::hash_combine(
+      nexthopsHash, route.nexthops.size(), route.counterID.value_or(""));
+  for (auto const& tag : *route.bestPrefixEntry.tags()) {
+    hash = folly::hash::hash_combine(hash, tag);
+  }
+  return hash;
+}
+
+} // namespace
+
 //
 // RibPolicy
 //
@@ -178,6 +204,21 @@ RibPolicy::RibPolicy(thrift::RibPolicy const& policy)
   for (auto const& statement : *policy.statements()) {
     policyStatements_.emplace_back(RibPolicyStatement(statement));
   }
+
+  // Build inverted indexes. Statement indices are appended in order, hence
+  // each index entry is sorted.
+  for (size_t idx = 0; idx < policyStatements_.size(); ++idx) {
+    auto const& statement = policyStatements_.at(idx);
+    if (not statement.getPrefixSet().empty()) {
+      for (auto const& prefix : statement.getPrefixSet()) {
+        prefixIndex_[prefix].emplace_back(idx);
+      }
+    } else {
+      for (auto const& tag : statement.getTagSet()) {
+        tagIndex_[tag].emplace_back(idx);
+      }
+    }
+  }
 }
 
 thrift::RibPolicy
@@ -208,10 +249,31 @@ RibPolicy::isActive() const {
   return getTtlDuration().count() > 0;
 }
 
+std::vector<size_t>
+RibPolicy::getCandidateStatements(const RibUnicastEntry& route) const {
+  std::vector<size_t> candidates;
+  if (auto it = prefixIndex_.find(route.prefix); it != prefixIndex_.end()) {
+    candidates = it->second;
+  }
+  if (not tagIndex_.empty()) {
+    for (auto const& tag : *route.bestPrefixEntry.tags()) {
+      if (auto it = tagIndex_.find(tag); it != tagIndex_.end()) {
+        candidates.insert(
+            candidates.end(), it->second.begin(), it->second.end());
+      }
+    }
+    // Restore statement order, a statement can be hit via multiple tags
+    std::sort(candidates.begin(), candidates.end());
+    candidates.erase(
+        std::unique(candidates.begin(), candidates.end()), candidates.end());
+  }
+  return candidates;
+}
+
 bool
 RibPolicy::match(const RibUnicastEntry& route) const {
-  for (auto const& statement : policyStatements_) {
-    if (statement.match(route)) {
+  for (auto const idx : getCandidateStatements(route)) {
+    if (policyStatements_.at(idx).match(route)) {
       return true;
     }
   }
@@ -220,30 +282,112 @@ RibPolicy::match(const RibUnicastEntry& route) const {
 
 bool
 RibPolicy::applyAction(RibUnicastEntry& route) const {
-  for (auto const& statement : policyStatements_) {
+  size_t numInvalidated{0};
+  return applyAction(route, numInvalidated);
+}
+
+bool
+RibPolicy::applyAction(RibUnicastEntry& route, size_t& numInvalidated) const {
+  for (auto const idx : getCandidateStatements(route)) {
+    auto const& statement = policyStatements_.at(idx);
     if (statement.applyAction(route)) {
       return true;
     }
+    if (statement.match(route)) {
+      ++numInvalidated;
+    }
   }
   return false;
 }
 
+void
+RibPolicy::evictCachedOutcomes(
+    const std::vector<folly::CIDRNetwork>& deletedRoutes) const {
+  for (auto const& prefix : deletedRoutes) {
+    outcomeCache_.erase(prefix);
+  }
+}
+
 RibPolicy::PolicyChange
-RibPolicy::applyPolicy(std::unordered_map<folly::CIDRNetwork, RibUnicastEntry>&
-                           unicastEntries) const {
+RibPolicy::applyPolicy(
+    std::unordered_map<folly::CIDRNetwork, RibUnicastEntry>& unicastEntries,
+    bool isFullSync) const {
   PolicyChange change;
   if (not isActive()) {
     return change;
   }
-  auto iter = unicastEntries.begin();
-  while (iter != unicastEntries.end()) {
-    if (applyAction(iter->second)) {
-      DCHECK(iter->second.nexthops.size()) << "Unexpected empty next-hops";
-      change.updatedRoutes.push_back(iter->second.prefix);
+
+  // Outcomes of routes absent from full route db are stale
+  decltype(outcomeCache_) prevOutcomeCache;
+  if (isFullSync) {
+    prevOutcomeCache.swap(outcomeCache_);
+  }
+
+  auto applyOnRoute = [&](RibUnicastEntry& route) {
+    auto& cache = isFullSync ? prevOutcomeCache : outcomeCache_;
+    auto const inputHash = getPolicyInputHash(route);
+    auto cacheIt = cache.find(route.prefix);
+    if (cacheIt != cache.end() and cacheIt->second.inputHash == inputHash) {
+      // Unchanged route, replay memoized outcome
+      auto outcome = std::move(cacheIt->second);
+      cache.erase(cacheIt);
+      if (outcome.transformed) {
+        route.nexthops = outcome.nexthops;
+      }
+      route.counterID = outcome.counterID;
+      if (outcome.numInvalidated > 0) {
+        facebook::fb303::fbData->addStatValue(
+            "decision.rib_policy.invalidated_routes",
+            outcome.numInvalidated,
+            facebook::fb303::COUNT);
+      }
+      auto const transformed = outcome.transformed;
+      outcomeCache_.insert_or_assign(route.prefix, std::move(outcome));
+      return transformed;
+    }
+
+    CachedOutcome outcome{inputHash};
+    auto const transformed = applyAction(route, outcome.numInvalidated);
+    outcome.transformed = transformed;
+    if (transformed) {
+      outcome.nexthops = route.nexthops;
+    }
+    outcome.counterID = route.counterID;
+    outcomeCache_.insert_or_assign(route.prefix, std::move(outcome));
+    return transformed;
+  };
+
+  auto processRoute = [&](RibUnicastEntry& route) {
+    if (applyOnRoute(route)) {
+      DCHECK(route.nexthops.size()) << "Unexpected empty next-hops";
+      change.updatedRoutes.push_back(route.prefix);
       XLOG(DBG2) << "RibPolicy transformed the route "
-                 << folly::IPAddress::networkToString(iter->second.prefix);
+                 << folly::IPAddress::networkToString(route.prefix);
+    }
+  };
+
+  if (tagIndex_.empty() and prefixIndex_.size() < unicastEntries.size()) {
+    // Only routes for indexed prefixes can be selected. Visit them directly
+    // instead of walking through all routes.
+    for (auto const& [prefix, _] : prefixIndex_) {
+      if (auto it = unicastEntries.find(prefix); it != unicastEntries.end()) {
+        processRoute(it->second);
+      }
+    }
+    return change;
+  }
+
+  for (auto& [prefix, route] : unicastEntries) {
+    bool isCandidate = prefixIndex_.count(prefix) > 0;
+    for (auto const& tag : *route.bestPrefixEntry.tags()) {
+      if (isCandidate) {
+        break;
+      }
+      isCandidate = tagIndex_.count(tag) > 0;
+    }
+    if (isCandidate) {
+      processRoute(route);
     }
-    ++iter;
   }
   return change;
 }
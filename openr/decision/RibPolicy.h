@@ -42,6 +42,16 @@ class RibPolicyStatement {
    */
   bool applyAction(RibUnicastEntry& route) const;
 
+  const std::unordered_set<folly::CIDRNetwork>&
+  getPrefixSet() const {
+    return prefixSet_;
+  }
+
+  const std::unordered_set<std::string>&
+  getTagSet() const {
+    return tagSet_;
+  }
+
  private:
   const std::string name_;
 
@@ -107,16 +117,67 @@ class RibPolicy {
    * Calls applyAction on all routes in unicastEntries, removes entries that
    * have no remaining nexthops.
    *
+   * Policy outcome of every selected route is memoized. A route whose
+   * policy inputs (tags, next-hops, counter ID) hash the same as on the last
+   * evaluation is transformed from the cache instead of being re-evaluated.
+   * Set `isFullSync` if `unicastEntries` is the complete route db, which
+   * lets cached outcomes of vanished routes go.
+   *
    * @returns PolicyChange struct indicating unicastEntries that were modified.
    */
   PolicyChange applyPolicy(
-      std::unordered_map<folly::CIDRNetwork, RibUnicastEntry>& unicastEntries)
-      const;
+      std::unordered_map<folly::CIDRNetwork, RibUnicastEntry>& unicastEntries,
+      bool isFullSync = false) const;
+
+  /**
+   * Forget memoized policy outcome of deleted routes
+   */
+  void evictCachedOutcomes(
+      const std::vector<folly::CIDRNetwork>& deletedRoutes) const;
+
+  /**
+   * Number of routes with memoized policy outcome
+   */
+  size_t
+  getCachedOutcomeCount() const {
+    return outcomeCache_.size();
+  }
 
  private:
+  /**
+   * Indices of policy statements which could possibly match the route, in
+   * statement order. Uses inverted indexes instead of probing every statement.
+   */
+  std::vector<size_t> getCandidateStatements(
+      const RibUnicastEntry& route) const;
+
+  /**
+   * applyAction, also reporting number of matching statements which
+   * invalidated all next-hops of the route and hence were skipped.
+   */
+  bool applyAction(RibUnicastEntry& route, size_t& numInvalidated) const;
+
   // List of policy statements
   std::vector<RibPolicyStatement> policyStatements_;
 
+  // Inverted indexes of policy statements. Statements carrying prefixes are
+  // indexed by prefix only, as both of prefix and tag criteria must match.
+  // Statements carrying only tags are indexed by tag.
+  std::unordered_map<folly::CIDRNetwork, std::vector<size_t>> prefixIndex_;
+  std::unordered_map<std::string, std::vector<size_t>> tagIndex_;
+
+  // Memoized outcome of policy evaluation for a route, keyed by hash of the
+  // route attributes policy depends on. Only next-hops and counterID are
+  // subject to transformation.
+  struct CachedOutcome {
+    size_t inputHash{0};
+    bool transformed{false};
+    size_t numInvalidated{0};
+    std::unordered_set<thrift::NextHopThrift> nexthops;
+    std::optional<thrift::RouteCounterID> counterID;
+  };
+  mutable std::unordered_map<folly::CIDRNetwork, CachedOutcome> outcomeCache_;
+
   // Validity
   const std::chrono::steady_clock::time_point validUntilTs_;
 };
@@ -8,6 +8,7 @@
 #pragma once
 
 #include <sstream>
+#include <unordered_set>
 
 #include <folly/IPAddress.h>
 
@@ -160,6 +161,61 @@ struct DecisionRouteUpdate {
     }
   }
 
+  /**
+   * Merge `newer` update, which is meant to be applied right after this one,
+   * into this update (last-writer-wins). Used to coalesce pending updates of
+   * a lagging reader.
+   *
+   * ATTN: FULL_SYNC update from Decision is a delta against its previous
+   * routes as well, hence both types are merged as deltas. Merged update is
+   * FULL_SYNC if any of them is.
+   *
+   * @returns false if updates can't be merged, e.g. they carry routes of
+   * different prefix types, in which case both are left untouched.
+   */
+  bool
+  coalesce(DecisionRouteUpdate& newer) {
+    if (prefixType != newer.prefixType) {
+      return false;
+    }
+
+    if (newer.type == FULL_SYNC) {
+      type = FULL_SYNC;
+    }
+
+    // unicast
+    std::unordered_set<folly::CIDRNetwork> unicastDeletes(
+        unicastRoutesToDelete.begin(), unicastRoutesToDelete.end());
+    for (auto& [prefix, route] : newer.unicastRoutesToUpdate) {
+      unicastDeletes.erase(prefix);
+      unicastRoutesToUpdate.insert_or_assign(prefix, std::move(route));
+    }
+    for (auto const& prefix : newer.unicastRoutesToDelete) {
+      unicastRoutesToUpdate.erase(prefix);
+      unicastDeletes.emplace(prefix);
+    }
+    unicastRoutesToDelete.assign(unicastDeletes.begin(), unicastDeletes.end());
+
+    // mpls
+    std::unordered_set<int32_t> mplsDeletes(
+        mplsRoutesToDelete.begin(), mplsRoutesToDelete.end());
+    for (auto& [label, route] : newer.mplsRoutesToUpdate) {
+      mplsDeletes.erase(label);
+      mplsRoutesToUpdate.insert_or_assign(label, std::move(route));
+    }
+    for (auto const& label : newer.mplsRoutesToDelete) {
+      mplsRoutesToUpdate.erase(label);
+      mplsDeletes.emplace(label);
+    }
+    mplsRoutesToDelete.assign(mplsDeletes.begin(), mplsDeletes.end());
+
+    // Retain the earliest perf events to measure end-to-end convergence
+    if (not perfEvents) {
+      perfEvents = std::move(newer.perfEvents);
+    }
+    return true;
+  }
+
   /**
    * Print to log for debugging
    */
@@ -101,8 +101,11 @@ SpfSolver::SpfSolver(
       "decision.duplicate_node_label", fb303::COUNT);
   fb303::fbData->addStatExportType(
       "decision.skipped_unicast_route", fb303::COUNT);
+  fb303::fbData->addStatExportType(
+      "decision.route_nexthops_reused", fb303::COUNT);
   fb303::fbData->addStatExportType("decision.spf_ms", fb303::AVG);
   fb303::fbData->addStatExportType("decision.spf_runs", fb303::COUNT);
+  fb303::fbData->addStatExportType("decision.ucmp_runs", fb303::COUNT);
   fb303::fbData->addStatExportType("decision.errors", fb303::COUNT);
   fb303::fbData->addStatExportType(
       "decision.incorrect_redistribution_route", fb303::COUNT);
@@ -299,8 +302,22 @@ SpfSolver::createRouteForPrefix(
     case thrift::PrefixForwardingAlgorithm::SP_ECMP:
     case thrift::PrefixForwardingAlgorithm::SP_UCMP_ADJ_WEIGHT_PROPAGATION:
     case thrift::PrefixForwardingAlgorithm::SP_UCMP_PREFIX_WEIGHT_PROPAGATION: {
-      auto spfAreaResults = selectBestPathsSpf(
-          myNodeName, prefix, routeSelectionResult, area, linkState->second);
+      auto spfAreaResults = getOrComputeNextHops(
+          NextHopsCacheKey(
+              routeSelectionResult.allNodeAreas,
+              area,
+              prefix.first.isV4(),
+              *areaRules.forwardingAlgo(),
+              *areaRules.forwardingType(),
+              {} /* prependLabels */),
+          [&]() {
+            return selectBestPathsSpf(
+                myNodeName,
+                prefix,
+                routeSelectionResult,
+                area,
+                linkState->second);
+          });
 
       // Only use next-hops in areas with the shortest IGP metric
       if (shortestMetric >= spfAreaResults.bestMetric) {
@@ -318,15 +335,35 @@ SpfSolver::createRouteForPrefix(
       // Also next-hops returned by selectBestPathsKsp2() should only be
       // used if they have the best IGP metrics compared to other areas.
       // Comment above for T96776309 also applies here as well.
-      auto areaNextHops = selectBestPathsKsp2(
-          myNodeName,
-          prefix,
-          routeSelectionResult,
-          prefixEntries,
-          *areaRules.forwardingType(),
-          area,
-          linkState->second);
-      ksp2NextHops.insert(areaNextHops.begin(), areaNextHops.end());
+      std::vector<std::optional<int32_t>> prependLabels;
+      for (const auto& [node, _] : routeSelectionResult.allNodeAreas) {
+        auto it = prefixEntries.find({node, area});
+        prependLabels.emplace_back(
+            it != prefixEntries.end() ? it->second->prependLabel().to_optional()
+                                      : std::nullopt);
+      }
+      auto areaResults = getOrComputeNextHops(
+          NextHopsCacheKey(
+              routeSelectionResult.allNodeAreas,
+              area,
+              prefix.first.isV4(),
+              *areaRules.forwardingAlgo(),
+              *areaRules.forwardingType(),
+              std::move(prependLabels)),
+          [&]() {
+            SpfAreaResults results;
+            results.nextHops = selectBestPathsKsp2(
+                myNodeName,
+                prefix,
+                routeSelectionResult,
+                prefixEntries,
+                *areaRules.forwardingType(),
+                area,
+                linkState->second);
+            return results;
+          });
+      ksp2NextHops.insert(
+          areaResults.nextHops.begin(), areaResults.nextHops.end());
     } break;
     default:
       XLOG(ERR)
@@ -371,13 +408,19 @@ SpfSolver::buildRouteDb(
   // Clear best route selection cache
   bestRoutesCache_.clear();
 
-  // Create IPv4, IPv6 routes (includes IP -> MPLS routes)
+  // Create IPv4, IPv6 routes (includes IP -> MPLS routes). Prefixes announced
+  // by the same set of nodes share their next-hops computation.
+  nextHopsCache_.emplace();
   for (const auto& [prefix, _] : prefixState.prefixes()) {
     if (auto maybeRoute = createRouteForPrefix(
             myNodeName, areaLinkStates, prefixState, prefix)) {
       routeDb.addUnicastRoute(std::move(maybeRoute).value());
     }
   }
+  XLOG(DBG1) << "Computed next-hops of " << prefixState.prefixes().size()
+             << " prefixes from " << nextHopsCache_->size()
+             << " unique announcer sets.";
+  nextHopsCache_.reset();
 
   // Create static unicast routes
   for (auto [prefix, ribUnicastEntry] : staticUnicastRoutes_) {
@@ -800,6 +843,23 @@ SpfSolver::selectBestPathsKsp2(
   return nextHops;
 }
 
+SpfSolver::SpfAreaResults
+SpfSolver::getOrComputeNextHops(
+    NextHopsCacheKey&& key, folly::FunctionRef<SpfAreaResults()> computeFn) {
+  // Not within a full route build, topology may change across calls
+  if (not nextHopsCache_.has_value()) {
+    return computeFn();
+  }
+
+  auto it = nextHopsCache_->find(key);
+  if (it != nextHopsCache_->end()) {
+    fb303::fbData->addStatValue(
+        "decision.route_nexthops_reused", 1, fb303::COUNT);
+    return it->second;
+  }
+  return nextHopsCache_->emplace(std::move(key), computeFn()).first->second;
+}
+
 std::optional<RibUnicastEntry>
 SpfSolver::addBestPaths(
     const std::string& myNodeName,
@@ -8,9 +8,13 @@
 #pragma once
 
 #include <chrono>
+#include <map>
 #include <string>
+#include <tuple>
 #include <unordered_map>
 
+#include <folly/Function.h>
+
 #include <openr/decision/LinkState.h>
 #include <openr/decision/PrefixState.h>
 #include <openr/decision/RibEntry.h>
@@ -221,6 +225,26 @@ class SpfSolver {
       const std::string& area,
       const LinkState& linkState);
 
+  /*
+   * [Route Calculation]: next-hops reuse
+   *
+   * Within an area, next-hops towards the selected announcers only depend on
+   * the announcer set, forwarding algorithm/type, address family and (KSP2
+   * only) prepend labels of the announcers. In a fabric, most prefixes are
+   * announced by few such sets. During a full route build next-hops are hence
+   * computed once per key via `computeFn` and reused for other prefixes.
+   */
+  using NextHopsCacheKey = std::tuple<
+      std::set<NodeAndArea> /* selected announcers */,
+      std::string /* area */,
+      bool /* isV4 */,
+      thrift::PrefixForwardingAlgorithm,
+      thrift::PrefixForwardingType,
+      std::vector<std::optional<int32_t>> /* prepend labels */>;
+
+  SpfAreaResults getOrComputeNextHops(
+      NextHopsCacheKey&& key, folly::FunctionRef<SpfAreaResults()> computeFn);
+
   std::optional<RibUnicastEntry> addBestPaths(
       const std::string& myNodeName,
       const folly::CIDRNetwork& prefix,
@@ -290,6 +314,10 @@ class SpfSolver {
   // - Updated for the prefix whenever a route is created for it
   std::unordered_map<folly::CIDRNetwork, RouteSelectionResult> bestRoutesCache_;
 
+  // Next-hops computed per `NextHopsCacheKey`. Only set while a full route
+  // build is running as topology is consistent for its whole duration.
+  std::optional<std::map<NextHopsCacheKey, SpfAreaResults>> nextHopsCache_;
+
   const std::string myNodeName_;
 
   // is v4 enabled. If yes then Decision will forward v4 prefixes with v4
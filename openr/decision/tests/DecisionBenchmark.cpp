@@ -284,6 +284,31 @@ BENCHMARK_COUNTERS_PARAM2(
     8,
     100,
     SP_ECMP);
+// KSP2_ED_ECMP traces edge-disjoint second paths towards every destination
+BENCHMARK_COUNTERS_PARAM2(
+    BM_DecisionFabricInitialUpdate,
+    counters,
+    1_1_100_KSP2_ED_ECMP,
+    1,
+    1,
+    100,
+    KSP2_ED_ECMP);
+BENCHMARK_COUNTERS_PARAM2(
+    BM_DecisionFabricInitialUpdate,
+    counters,
+    1_4_100_KSP2_ED_ECMP,
+    1,
+    4,
+    100,
+    KSP2_ED_ECMP);
+BENCHMARK_COUNTERS_PARAM2(
+    BM_DecisionFabricInitialUpdate,
+    counters,
+    1_8_100_KSP2_ED_ECMP,
+    1,
+    8,
+    100,
+    KSP2_ED_ECMP);
 /*
  * BM_DecisionFabricPrefixUpdates:
  * @first param - integer: num of pods in a fabric topology
@@ -0,0 +1,213 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include <sys/resource.h>
+
+#include <algorithm>
+#include <iostream>
+#include <thread>
+
+#include <fmt/format.h>
+#include <folly/init/Init.h>
+#include <folly/logging/xlog.h>
+
+#include <openr/decision/Decision.h>
+#include <openr/kvstore/KvStorePublicationTrace.h>
+#include <openr/tests/utils/Utils.h>
+
+DEFINE_string(
+    trace_file,
+    "",
+    "Publication trace to replay, as recorded by "
+    "`openr_kvstore_snooper --record_file`");
+DEFINE_string(
+    node_name,
+    "",
+    "Node from whose point of view routes are computed. Usually the node "
+    "the trace was recorded from.");
+DEFINE_double(
+    replay_speed,
+    1.0,
+    "Replay speed relative to the original capture, e.g. 10 replays ten "
+    "times faster. 0 replays publications back-to-back.");
+DEFINE_int32(
+    drain_timeout_ms,
+    2000,
+    "Time to wait for Decision to settle after the last publication");
+
+/**
+ * Replay a captured KvStore publication trace into Decision and report
+ * publication-to-route-update latency and CPU usage.
+ *
+ * Publications recorded at time 0 form the initial dump and are followed by
+ * KVSTORE_SYNCED, as KvStore does on a real node. Latency of a route update is
+ * measured from the earliest publication it covers, hence includes Decision
+ * debounce.
+ */
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+using openr::thrift::InitializationEvent;
+
+std::chrono::microseconds
+getCpuTime() {
+  struct rusage usage {};
+  ::getrusage(RUSAGE_SELF, &usage);
+  return std::chrono::seconds(usage.ru_utime.tv_sec) +
+      std::chrono::microseconds(usage.ru_utime.tv_usec) +
+      std::chrono::seconds(usage.ru_stime.tv_sec) +
+      std::chrono::microseconds(usage.ru_stime.tv_usec);
+}
+
+std::chrono::microseconds
+getPercentile(
+    const std::vector<std::chrono::microseconds>& sorted, double percentile) {
+  if (sorted.empty()) {
+    return std::chrono::microseconds(0);
+  }
+  const size_t idx = std::min(
+      sorted.size() - 1, static_cast<size_t>(percentile * sorted.size()));
+  return sorted.at(idx);
+}
+
+} // namespace
+
+int
+main(int argc, char** argv) {
+  folly::init(&argc, &argv);
+  CHECK(not FLAGS_trace_file.empty()) << "--trace_file must be specified";
+  CHECK(not FLAGS_node_name.empty()) << "--node_name must be specified";
+  CHECK_GE(FLAGS_replay_speed, 0);
+
+  // Decision config, same as benchmarks in DecisionBenchmark
+  auto tConfig = openr::getBasicOpenrConfig(FLAGS_node_name);
+  tConfig.decision_config()->debounce_min_ms() = 10;
+  tConfig.decision_config()->debounce_max_ms() = 500;
+  tConfig.decision_config()->enable_bgp_route_programming() = true;
+  // No peer events are replayed, don't wait for initial peers
+  tConfig.enable_ordered_adj_publication() = false;
+  auto config = std::make_shared<openr::Config>(tConfig);
+
+  openr::messaging::ReplicateQueue<openr::PeerEvent> peerUpdatesQueue;
+  openr::messaging::ReplicateQueue<openr::KvStorePublication>
+      kvStoreUpdatesQueue;
+  openr::messaging::ReplicateQueue<openr::DecisionRouteUpdate>
+      staticRouteUpdatesQueue;
+  openr::messaging::ReplicateQueue<openr::DecisionRouteUpdate>
+      routeUpdatesQueue;
+
+  auto decision = std::make_shared<openr::Decision>(
+      config,
+      peerUpdatesQueue.getReader(),
+      kvStoreUpdatesQueue.getReader(),
+      staticRouteUpdatesQueue.getReader(),
+      routeUpdatesQueue);
+  std::thread decisionThread([&decision]() { decision->run(); });
+  decision->waitUntilRunning();
+
+  // Record arrival time of every route update
+  std::vector<Clock::time_point> routeUpdateTimes;
+  size_t numRoutesUpdated{0};
+  std::thread routeReaderThread(
+      [&, reader = routeUpdatesQueue.getReader()]() mutable {
+        while (true) {
+          auto maybeUpdate = reader.get();
+          if (maybeUpdate.hasError()) {
+            break;
+          }
+          routeUpdateTimes.push_back(Clock::now());
+          numRoutesUpdated += maybeUpdate->unicastRoutesToUpdate.size() +
+              maybeUpdate->unicastRoutesToDelete.size();
+        }
+      });
+
+  // Replay trace
+  openr::PublicationTraceReader traceReader(FLAGS_trace_file);
+  std::vector<Clock::time_point> publicationTimes;
+  bool kvStoreSynced{false};
+  const auto cpuStart = getCpuTime();
+  const auto replayStart = Clock::now();
+  while (auto record = traceReader.next()) {
+    if (not kvStoreSynced and record->timestamp.count() > 0) {
+      kvStoreUpdatesQueue.push(InitializationEvent::KVSTORE_SYNCED);
+      kvStoreSynced = true;
+    }
+    if (FLAGS_replay_speed > 0) {
+      std::this_thread::sleep_until(
+          replayStart +
+          std::chrono::duration_cast<Clock::duration>(
+              record->timestamp / FLAGS_replay_speed));
+    }
+    publicationTimes.push_back(Clock::now());
+    kvStoreUpdatesQueue.push(std::move(record->publication));
+  }
+  if (not kvStoreSynced) {
+    kvStoreUpdatesQueue.push(InitializationEvent::KVSTORE_SYNCED);
+  }
+  const auto replayEnd = Clock::now();
+
+  // Let Decision settle, then tear everything down
+  std::this_thread::sleep_for(
+      std::chrono::milliseconds(FLAGS_drain_timeout_ms));
+  peerUpdatesQueue.close();
+  kvStoreUpdatesQueue.close();
+  staticRouteUpdatesQueue.close();
+  decision->stop();
+  decisionThread.join();
+  routeUpdatesQueue.close();
+  routeReaderThread.join();
+  const auto cpuTime = getCpuTime() - cpuStart;
+
+  // Attribute every route update to the publications it covers, i.e. the ones
+  // pushed since previous route update
+  std::vector<std::chrono::microseconds> latencies;
+  size_t pubIdx = 0;
+  for (auto const& updateTime : routeUpdateTimes) {
+    if (pubIdx >= publicationTimes.size() or
+        publicationTimes.at(pubIdx) > updateTime) {
+      continue;
+    }
+    latencies.push_back(
+        std::chrono::duration_cast<std::chrono::microseconds>(
+            updateTime - publicationTimes.at(pubIdx)));
+    while (pubIdx < publicationTimes.size() and
+           publicationTimes.at(pubIdx) <= updateTime) {
+      ++pubIdx;
+    }
+  }
+  std::sort(latencies.begin(), latencies.end());
+  if (routeUpdateTimes.empty()) {
+    XLOG(WARNING) << "No route update received from Decision. Check that "
+                  << "--node_name is part of the trace.";
+  }
+
+  std::cout << fmt::format(
+                   "Replayed {} publications in {}ms (speed: {})",
+                   publicationTimes.size(),
+                   std::chrono::duration_cast<std::chrono::milliseconds>(
+                       replayEnd - replayStart)
+                       .count(),
+                   FLAGS_replay_speed)
+            << std::endl;
+  std::cout << fmt::format(
+                   "Decision: {} route updates, {} routes updated/deleted",
+                   routeUpdateTimes.size(),
+                   numRoutesUpdated)
+            << std::endl;
+  std::cout << fmt::format(
+                   "Decision latency (us): p50 {}, p90 {}, p99 {}, max {}",
+                   getPercentile(latencies, 0.5).count(),
+                   getPercentile(latencies, 0.9).count(),
+                   getPercentile(latencies, 0.99).count(),
+                   getPercentile(latencies, 1.0).count())
+            << std::endl;
+  std::cout << fmt::format("CPU time (ms): {}", cpuTime.count() / 1000)
+            << std::endl;
+
+  return 0;
+}
@@ -23,10 +23,12 @@
 
 #include <openr/common/Constants.h>
 #include <openr/common/Flags.h>
+#include <openr/common/LsdbTypes.h>
 #include <openr/common/MplsUtil.h>
 #include <openr/common/NetworkUtil.h>
 #include <openr/common/Util.h>
 #include <openr/decision/Decision.h>
+#include <openr/decision/FailureImpactAnalyzer.h>
 #include <openr/decision/RouteUpdate.h>
 #include <openr/if/gen-cpp2/OpenrConfig_types.h>
 #include <openr/tests/utils/Utils.h>
@@ -1398,6 +1400,152 @@ TEST(Decision, IgpCost) {
   }
 }
 
+/**
+ * Prefixes announced by the same set of nodes share their next-hops
+ * computation during full route build. Verify routes built that way are same
+ * as routes computed individually for every prefix.
+ */
+TEST(Decision, NextHopsReuseAcrossPrefixes) {
+  SpfSolver spfSolver(
+      "1",
+      false /* enableV4 */,
+      true /* enable segment label */,
+      true /* enable adj labels */);
+
+  std::unordered_map<std::string, LinkState> areaLinkStates;
+  PrefixState prefixState;
+
+  // Test topology: spine
+  // 1     4 (SSW)
+  // |  x  |
+  // 2     3 (FSW)
+  areaLinkStates.emplace(kTestingAreaName, LinkState(kTestingAreaName));
+  auto& linkState = areaLinkStates.at(kTestingAreaName);
+  linkState.updateAdjacencyDatabase(
+      createAdjDb("1", {adj12, adj13}, 1), kTestingAreaName);
+  linkState.updateAdjacencyDatabase(
+      createAdjDb("2", {adj21, adj24}, 2), kTestingAreaName);
+  linkState.updateAdjacencyDatabase(
+      createAdjDb("3", {adj31, adj34}, 3), kTestingAreaName);
+  linkState.updateAdjacencyDatabase(
+      createAdjDb("4", {adj42, adj43}, 4), kTestingAreaName);
+
+  // addr1 and addr2 are anycast from node2 and node3, addr3 and addr4 are
+  // from node4 only
+  updatePrefixDatabase(
+      prefixState,
+      createPrefixDb(
+          "2", {createPrefixEntry(addr1), createPrefixEntry(addr2)}));
+  updatePrefixDatabase(
+      prefixState,
+      createPrefixDb(
+          "3", {createPrefixEntry(addr1), createPrefixEntry(addr2)}));
+  updatePrefixDatabase(
+      prefixState,
+      createPrefixDb(
+          "4", {createPrefixEntry(addr3), createPrefixEntry(addr4)}));
+
+  auto routeDb = spfSolver.buildRouteDb("1", areaLinkStates, prefixState);
+  ASSERT_TRUE(routeDb.has_value());
+  EXPECT_EQ(4, routeDb->unicastRoutes.size());
+
+  for (auto const& addr : {addr1, addr2, addr3, addr4}) {
+    auto const prefix = toIPNetwork(addr);
+    auto maybeRoute = spfSolver.createRouteForPrefixOrGetStaticRoute(
+        "1", areaLinkStates, prefixState, prefix);
+    ASSERT_TRUE(maybeRoute.has_value());
+    EXPECT_EQ(maybeRoute.value(), routeDb->unicastRoutes.at(prefix));
+  }
+  EXPECT_EQ(2, routeDb->unicastRoutes.at(toIPNetwork(addr1)).nexthops.size());
+  EXPECT_EQ(2, routeDb->unicastRoutes.at(toIPNetwork(addr3)).nexthops.size());
+}
+
+/**
+ * Evaluate all single link/node failures of a spine topology from node 1.
+ * Failure of a link off the shortest path DAG must not change any route, and
+ * results must not depend on number of workers.
+ */
+TEST(FailureImpactAnalyzer, AllFailures) {
+  FailureImpactAnalyzer analyzer(
+      "1",
+      false /* enableV4 */,
+      false /* enable segment label */,
+      false /* enable adj labels */);
+
+  std::unordered_map<std::string, LinkState> areaLinkStates;
+  PrefixState prefixState;
+
+  // Test topology: spine with 2 <-> 3 shortcut
+  // 1     4
+  // |  x  |
+  // 2 --- 3
+  areaLinkStates.emplace(kTestingAreaName, LinkState(kTestingAreaName));
+  auto& linkState = areaLinkStates.at(kTestingAreaName);
+  linkState.updateAdjacencyDatabase(
+      createAdjDb("1", {adj12, adj13}, 1), kTestingAreaName);
+  linkState.updateAdjacencyDatabase(
+      createAdjDb("2", {adj21, adj23, adj24}, 2), kTestingAreaName);
+  linkState.updateAdjacencyDatabase(
+      createAdjDb("3", {adj31, adj32, adj34}, 3), kTestingAreaName);
+  linkState.updateAdjacencyDatabase(
+      createAdjDb("4", {adj42, adj43}, 4), kTestingAreaName);
+
+  // addr1 from node4 (ECMP via 2 and 3), addr2 from node2
+  updatePrefixDatabase(
+      prefixState, createPrefixDb("4", {createPrefixEntry(addr1)}));
+  updatePrefixDatabase(
+      prefixState, createPrefixDb("2", {createPrefixEntry(addr2)}));
+
+  const auto scenarios = analyzer.getAllFailureScenarios(linkState);
+  ASSERT_EQ(8, scenarios.size());
+  EXPECT_EQ("1/2", scenarios.at(0).ifName);
+  EXPECT_EQ("2/3", scenarios.at(2).ifName);
+  EXPECT_TRUE(scenarios.at(5).isNodeFailure());
+  EXPECT_EQ("2", scenarios.at(5).nodeName);
+
+  const auto prefix1 = toIPNetwork(addr1);
+  const auto prefix2 = toIPNetwork(addr2);
+  using EcmpWidthChanges =
+      std::unordered_map<folly::CIDRNetwork, std::pair<size_t, size_t>>;
+  const std::vector<std::pair<size_t, EcmpWidthChanges>> expected{
+      // link 1-2: addr2 moves to 3, addr1 loses one next-hop
+      {2, {{prefix1, {2, 1}}}},
+      // link 1-3
+      {1, {{prefix1, {2, 1}}}},
+      // link 2-3: off the DAG
+      {0, {}},
+      // link 2-4
+      {1, {{prefix1, {2, 1}}}},
+      // link 3-4
+      {1, {{prefix1, {2, 1}}}},
+      // node 2: addr2 is lost
+      {2, {{prefix1, {2, 1}}, {prefix2, {1, 0}}}},
+      // node 3
+      {1, {{prefix1, {2, 1}}}},
+      // node 4: addr1 is lost
+      {1, {{prefix1, {2, 0}}}},
+  };
+
+  for (size_t numWorkers : {1, 4}) {
+    auto impacts = analyzer.analyze(
+        areaLinkStates, prefixState, scenarios, numWorkers);
+    ASSERT_EQ(scenarios.size(), impacts.size());
+    for (size_t i = 0; i < impacts.size(); ++i) {
+      SCOPED_TRACE(impacts.at(i).scenario.toString());
+      EXPECT_EQ(expected.at(i).first, impacts.at(i).routeDelta.size());
+      EXPECT_EQ(expected.at(i).second, impacts.at(i).ecmpWidthChanges);
+    }
+  }
+
+  // Unknown link yields no impact
+  auto impacts = analyzer.analyze(
+      areaLinkStates,
+      prefixState,
+      {FailureScenario{kTestingAreaName, "1", "unknown"}});
+  ASSERT_EQ(1, impacts.size());
+  EXPECT_TRUE(impacts.at(0).routeDelta.empty());
+}
+
 TEST(Decision, BestRouteSelection) {
   std::string nodeName("1");
   const auto expectedAddr = addr1;
@@ -4327,6 +4475,125 @@ TEST_F(DecisionTestFixture, BasicOperations) {
   EXPECT_TRUE(checkEqualRoutesDelta(routeDbDelta, routeDelta));
 }
 
+/**
+ * Node 2 advertises its adjacencies via `adj:<node>:shard:<id>` keys. Verify
+ * that transient keys of switching between full database and shards never
+ * take node 2 down:
+ * - empty full database withdrawn by node switched over to shards is ignored
+ * - expiry of stale shard of node switched back to full database is ignored
+ *
+ * Each step carries a new prefix of node 2 so that route delta is published.
+ */
+TEST_F(DecisionTestFixture, AdjDbShards) {
+  const auto shardKey = AdjDbShardKey("2", 0).getAdjDbShardKeyStr();
+
+  //
+  // 1. node 2 advertises its adjacency via shard
+  //
+  sendKvPublication(createThriftPublication(
+      {{"adj:1", createAdjValue(serializer, "1", 1, {adj12}, false, 1)},
+       {shardKey, createAdjValue(serializer, "2", 1, {adj21}, false, 2)},
+       createPrefixKeyValue("1", 1, addr1),
+       createPrefixKeyValue("2", 1, addr2)},
+      {},
+      {},
+      {}));
+  auto routeDbDelta = recvRouteUpdates();
+  EXPECT_EQ(1, routeDbDelta.unicastRoutesToUpdate.size());
+  EXPECT_EQ(1, routeDbDelta.unicastRoutesToUpdate.count(toIPNetwork(addr2)));
+  EXPECT_EQ(0, routeDbDelta.unicastRoutesToDelete.size());
+
+  //
+  // 2. empty full database of node 2 is ignored as node 2 has shards
+  //
+  sendKvPublication(createThriftPublication(
+      {{"adj:2", createAdjValue(serializer, "2", 2, {}, false, 2)},
+       createPrefixKeyValue("2", 1, addr3)},
+      {},
+      {},
+      {}));
+  routeDbDelta = recvRouteUpdates();
+  EXPECT_EQ(1, routeDbDelta.unicastRoutesToUpdate.size());
+  EXPECT_EQ(1, routeDbDelta.unicastRoutesToUpdate.count(toIPNetwork(addr3)));
+  EXPECT_EQ(0, routeDbDelta.unicastRoutesToDelete.size());
+  EXPECT_EQ(0, routeDbDelta.mplsRoutesToDelete.size());
+
+  //
+  // 3. node 2 switches back to full database and its shard expires later
+  //
+  sendKvPublication(createThriftPublication(
+      {{"adj:2", createAdjValue(serializer, "2", 3, {adj21}, false, 2)},
+       createPrefixKeyValue("2", 1, addr4)},
+      {shardKey},
+      {},
+      {}));
+  routeDbDelta = recvRouteUpdates();
+  EXPECT_EQ(1, routeDbDelta.unicastRoutesToUpdate.size());
+  EXPECT_EQ(1, routeDbDelta.unicastRoutesToUpdate.count(toIPNetwork(addr4)));
+  EXPECT_EQ(0, routeDbDelta.unicastRoutesToDelete.size());
+  EXPECT_EQ(0, routeDbDelta.mplsRoutesToDelete.size());
+
+  auto routeDb = dumpRouteDb({"1"})["1"];
+  RouteMap routeMap;
+  fillRouteMap("1", routeMap, routeDb);
+  for (const auto& addr : {addr2, addr3, addr4}) {
+    EXPECT_EQ(
+        routeMap[make_pair("1", toString(addr))],
+        NextHops({createNextHopFromAdj(adj12, false, 10)}));
+  }
+}
+
+/*
+ * Stale shard of a node using full adjacency database, e.g. left over from an
+ * earlier encoding, must neither override the full database (regardless of
+ * order within publication) nor take the node down once it expires.
+ */
+TEST_F(DecisionTestFixture, AdjDbStaleShardWithFullDb) {
+  const auto shardKey = AdjDbShardKey("2", 0).getAdjDbShardKeyStr();
+
+  //
+  // 1. full database and stale shard of node 2 in one publication
+  //
+  sendKvPublication(createThriftPublication(
+      {{"adj:1", createAdjValue(serializer, "1", 1, {adj12, adj13}, false, 1)},
+       {"adj:2", createAdjValue(serializer, "2", 1, {adj21, adj23}, false, 2)},
+       {shardKey, createAdjValue(serializer, "2", 1, {adj23}, false, 2)},
+       {"adj:3", createAdjValue(serializer, "3", 1, {adj31, adj32}, false, 3)},
+       createPrefixKeyValue("1", 1, addr1),
+       createPrefixKeyValue("2", 1, addr2),
+       createPrefixKeyValue("3", 1, addr3)},
+      {},
+      {},
+      {}));
+  auto routeDbDelta = recvRouteUpdates();
+  EXPECT_EQ(2, routeDbDelta.unicastRoutesToUpdate.size());
+  EXPECT_EQ(1, routeDbDelta.unicastRoutesToUpdate.count(toIPNetwork(addr2)));
+  EXPECT_EQ(1, routeDbDelta.unicastRoutesToUpdate.count(toIPNetwork(addr3)));
+
+  //
+  // 2. stale shard expires, node 2 and its links stay
+  //
+  sendKvPublication(createThriftPublication(
+      {createPrefixKeyValue("2", 1, addr4)}, {shardKey}, {}, {}));
+  routeDbDelta = recvRouteUpdates();
+  EXPECT_EQ(1, routeDbDelta.unicastRoutesToUpdate.size());
+  EXPECT_EQ(1, routeDbDelta.unicastRoutesToUpdate.count(toIPNetwork(addr4)));
+  EXPECT_EQ(0, routeDbDelta.unicastRoutesToDelete.size());
+  EXPECT_EQ(0, routeDbDelta.mplsRoutesToDelete.size());
+
+  auto routeDb = dumpRouteDb({"1"})["1"];
+  RouteMap routeMap;
+  fillRouteMap("1", routeMap, routeDb);
+  for (const auto& addr : {addr2, addr4}) {
+    EXPECT_EQ(
+        routeMap[make_pair("1", toString(addr))],
+        NextHops({createNextHopFromAdj(adj12, false, 10)}));
+  }
+  EXPECT_EQ(
+      routeMap[make_pair("1", toString(addr3))],
+      NextHops({createNextHopFromAdj(adj13, false, 10)}));
+}
+
 /**
  * Publish all types of update to Decision and expect that Decision emits
  * a full route database that includes all the routes as its first update.
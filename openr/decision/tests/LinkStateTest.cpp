@@ -208,6 +208,105 @@ TEST(LinkStateTest, BasicOperation) {
   EXPECT_THAT(state.linksFromNode(n3), UnorderedElementsAre(Pointee(l2)));
 }
 
+TEST(LinkStateTest, AdjacencyDatabaseShards) {
+  std::string n1 = "node1";
+  std::string n2 = "node2";
+  std::string n3 = "node3";
+  auto adj12 =
+      openr::createAdjacency(n2, "if2", "if1", "fe80::2", "10.0.0.2", 1, 1, 1);
+  auto adj13 =
+      openr::createAdjacency(n3, "if3", "if1", "fe80::3", "10.0.0.3", 1, 1, 1);
+  auto adj21 =
+      openr::createAdjacency(n1, "if1", "if2", "fe80::1", "10.0.0.1", 1, 1, 1);
+  auto adj31 =
+      openr::createAdjacency(n1, "if1", "if3", "fe80::1", "10.0.0.1", 1, 1, 1);
+
+  openr::Link l1(kTestingAreaName, n1, adj12, n2, adj21);
+  openr::Link l3(kTestingAreaName, n3, adj31, n1, adj13);
+
+  openr::LinkState state{kTestingAreaName};
+  state.updateAdjacencyDatabase(
+      openr::createAdjDb(n2, {adj21}, 2), kTestingAreaName);
+  state.updateAdjacencyDatabase(
+      openr::createAdjDb(n3, {adj31}, 3), kTestingAreaName);
+
+  // node1 switches from full adjacency database to two shards. Shard
+  // advertised ahead of the full database withdrawal is kept aside.
+  state.updateAdjacencyDatabase(
+      openr::createAdjDb(n1, {adj12, adj13}, 1), kTestingAreaName);
+  EXPECT_FALSE(state.hasAdjacencyDatabaseShards(n1));
+  auto update = state.updateAdjacencyDatabaseShard(
+      openr::createAdjDb(n1, {adj12}, 1), 0, kTestingAreaName);
+  EXPECT_FALSE(update.topologyChanged);
+  EXPECT_FALSE(state.hasAdjacencyDatabaseShards(n1));
+  EXPECT_THAT(
+      state.linksFromNode(n1), UnorderedElementsAre(Pointee(l1), Pointee(l3)));
+  update = state.updateAdjacencyDatabase(
+      openr::createAdjDb(n1, {}, 1), kTestingAreaName);
+  EXPECT_TRUE(update.topologyChanged);
+  EXPECT_TRUE(state.hasAdjacencyDatabaseShards(n1));
+  EXPECT_THAT(state.linksFromNode(n1), UnorderedElementsAre(Pointee(l1)));
+  update = state.updateAdjacencyDatabaseShard(
+      openr::createAdjDb(n1, {adj13}, 1), 1, kTestingAreaName);
+  EXPECT_TRUE(update.topologyChanged);
+  EXPECT_EQ(update.addedLinks.size(), 1);
+  EXPECT_THAT(
+      state.linksFromNode(n1), UnorderedElementsAre(Pointee(l1), Pointee(l3)));
+  EXPECT_EQ(2, state.getAdjacencyDatabases().at(n1).adjacencies()->size());
+
+  // metric change within one shard leaves the other one untouched
+  auto adj13Metric = adj13;
+  adj13Metric.metric() = 10;
+  update = state.updateAdjacencyDatabaseShard(
+      openr::createAdjDb(n1, {adj13Metric}, 1), 1, kTestingAreaName);
+  EXPECT_TRUE(update.topologyChanged);
+  EXPECT_TRUE(update.addedLinks.empty());
+  EXPECT_THAT(
+      state.linksFromNode(n1), UnorderedElementsAre(Pointee(l1), Pointee(l3)));
+  EXPECT_EQ(
+      std::optional<openr::LinkStateMetric>(1),
+      state.getMetricFromAToB(n1, n2));
+
+  // node attributes are taken from the latest shard
+  auto overloadedShardDb = openr::createAdjDb(n1, {adj12}, 1);
+  overloadedShardDb.isOverloaded() = true;
+  update = state.updateAdjacencyDatabaseShard(
+      overloadedShardDb, 0, kTestingAreaName);
+  EXPECT_TRUE(update.topologyChanged);
+  EXPECT_TRUE(state.isNodeOverloaded(n1));
+
+  // adjacency moving to another shard belongs to that shard only
+  update = state.updateAdjacencyDatabaseShard(
+      openr::createAdjDb(n1, {adj12, adj13}, 1), 1, kTestingAreaName);
+  EXPECT_FALSE(state.isNodeOverloaded(n1));
+  EXPECT_EQ(2, state.getAdjacencyDatabases().at(n1).adjacencies()->size());
+  EXPECT_THAT(
+      state.linksFromNode(n1), UnorderedElementsAre(Pointee(l1), Pointee(l3)));
+
+  // deleting a shard withdraws its links, deleting the last one the node
+  EXPECT_FALSE(state.deleteAdjacencyDatabaseShard(n1, 0).topologyChanged);
+  EXPECT_THAT(
+      state.linksFromNode(n1), UnorderedElementsAre(Pointee(l1), Pointee(l3)));
+  EXPECT_TRUE(state.deleteAdjacencyDatabaseShard(n1, 1).topologyChanged);
+  EXPECT_FALSE(state.hasNode(n1));
+  EXPECT_FALSE(state.hasAdjacencyDatabaseShards(n1));
+  EXPECT_THAT(state.linksFromNode(n2), testing::IsEmpty());
+  EXPECT_THAT(state.linksFromNode(n3), testing::IsEmpty());
+
+  // stale shard never overrides full adjacency database, nor does its
+  // deletion take the node down
+  state.updateAdjacencyDatabase(
+      openr::createAdjDb(n1, {adj12, adj13}, 1), kTestingAreaName);
+  update = state.updateAdjacencyDatabaseShard(
+      openr::createAdjDb(n1, {adj12}, 1), 0, kTestingAreaName);
+  EXPECT_FALSE(update.topologyChanged);
+  EXPECT_FALSE(state.hasAdjacencyDatabaseShards(n1));
+  EXPECT_FALSE(state.deleteAdjacencyDatabaseShard(n1, 0).topologyChanged);
+  EXPECT_TRUE(state.hasNode(n1));
+  EXPECT_THAT(
+      state.linksFromNode(n1), UnorderedElementsAre(Pointee(l1), Pointee(l3)));
+}
+
 TEST(LinkStateTest, pathAInPathB) {
   auto l1 =
       std::make_shared<openr::Link>(kTestingAreaName, "1", "1/2", "2", "2/1");
@@ -327,6 +426,83 @@ TEST(LinkStateTest, getKthPaths) {
   }
 }
 
+//
+// Second paths are traced from an SPF run stopped at dest. They must match
+// first paths traced from a full SPF run over the same graph with the first
+// path links removed, ties included.
+//
+TEST(LinkStateTest, getKthPathsStopAtDest) {
+  using Walk = std::pair<std::vector<std::string>, openr::LinkStateMetric>;
+  // returns the nodes visited and the metric of a path traced from src
+  auto walkPath = [](const std::string& src, const LinkState::Path& path) {
+    Walk walk{{src}, 0};
+    for (auto const& link : path) {
+      walk.second += link->getMetricFromNode(walk.first.back());
+      walk.first.push_back(link->getOtherNodeName(walk.first.back()));
+    }
+    return walk;
+  };
+
+  //         2
+  //      2/   \2
+  //      /  1  \   1
+  //     1-------4-----7
+  //     |\ 1  3/|
+  //     | +-3-+ |
+  //    1|       |2
+  //     5-------6
+  //     |   1
+  //   10|
+  //     8
+  //
+  // first path is 1-4. Second paths 1-2-4, 1-3-4 and 1-5-6-4 tie at 4. Nodes
+  // 7 and 8 are further than 4 and left out by the bounded run.
+  std::unordered_map<int, std::vector<std::pair<int, int>>> adjMap{
+      {1, {{2, 2}, {3, 1}, {4, 1}, {5, 1}, {8, 10}}},
+      {2, {{1, 2}, {4, 2}}},
+      {3, {{1, 1}, {4, 3}}},
+      {4, {{1, 1}, {2, 2}, {3, 3}, {6, 2}, {7, 1}}},
+      {5, {{1, 1}, {6, 1}}},
+      {6, {{5, 1}, {4, 2}}},
+      {7, {{4, 1}}},
+      {8, {{1, 10}}},
+  };
+  auto linkState = openr::getLinkState(adjMap);
+
+  auto firstPaths = linkState.getKthPaths("1", "4", 1);
+  ASSERT_EQ(firstPaths.size(), 1);
+  EXPECT_EQ(walkPath("1", firstPaths.at(0)), Walk({"1", "4"}, 1));
+
+  // same graph without the first path link, whose SPF runs in full
+  adjMap.at(1).erase(
+      std::find(adjMap.at(1).begin(), adjMap.at(1).end(), std::pair{4, 1}));
+  adjMap.at(4).erase(
+      std::find(adjMap.at(4).begin(), adjMap.at(4).end(), std::pair{1, 1}));
+  auto prunedLinkState = openr::getLinkState(adjMap);
+  auto const& fullSpf = prunedLinkState.getSpfResult("1", true);
+  EXPECT_EQ(fullSpf.at("4").metric(), 4);
+  EXPECT_EQ(fullSpf.size(), 8);
+
+  auto secondPaths = linkState.getKthPaths("1", "4", 2);
+  auto fullPaths = prunedLinkState.getKthPaths("1", "4", 1);
+  ASSERT_EQ(secondPaths.size(), 3);
+  ASSERT_EQ(secondPaths.size(), fullPaths.size());
+
+  std::vector<Walk> secondWalks, fullWalks;
+  for (size_t i = 0; i < secondPaths.size(); ++i) {
+    secondWalks.push_back(walkPath("1", secondPaths.at(i)));
+    fullWalks.push_back(walkPath("1", fullPaths.at(i)));
+    EXPECT_EQ(secondWalks.back().second, fullSpf.at("4").metric());
+  }
+  EXPECT_THAT(secondWalks, UnorderedElementsAreArray(fullWalks));
+  EXPECT_THAT(
+      secondWalks,
+      UnorderedElementsAre(
+          Walk({"1", "2", "4"}, 4),
+          Walk({"1", "3", "4"}, 4),
+          Walk({"1", "5", "6", "4"}, 4)));
+}
+
 TEST(LinkStateTest, UcmpTest) {
   // Ucmp algorithm: LWP
   //
@@ -104,6 +104,64 @@ TEST_F(PrefixStateTestFixture, BasicOperation) {
       *entry);
 }
 
+/**
+ * Verifies prefix bundle carrying multiple prefix entries of one node:
+ *  - full content replacement withdraws prefixes dropped from the bundle
+ *  - withdrawal of per-prefix key doesn't affect prefixes owned by bundle
+ *  - bundle deletion withdraws all of its prefixes
+ */
+TEST(PrefixState, PrefixBundle) {
+  PrefixState state;
+  const std::string node{"node1"};
+  const std::string area{"area1"};
+  const NodeAndArea nodeArea{node, area};
+  const PrefixBundleKey bundleKey(node, 3, area);
+
+  auto entry1 = createPrefixEntry(toIpPrefix("10.0.0.1/32"));
+  auto entry2 = createPrefixEntry(toIpPrefix("10.0.0.2/32"));
+  auto entry3 = createPrefixEntry(toIpPrefix("10.0.0.3/32"));
+  const auto network1 = toIPNetwork(*entry1.prefix());
+  const auto network2 = toIPNetwork(*entry2.prefix());
+  const auto network3 = toIPNetwork(*entry3.prefix());
+
+  // 1. Advertise bundle of entry1/entry2
+  EXPECT_THAT(
+      state.updatePrefixBundle(bundleKey, {entry1, entry2}),
+      testing::UnorderedElementsAre(network1, network2));
+  EXPECT_EQ(*state.prefixes().at(network1).at(nodeArea), entry1);
+  EXPECT_EQ(*state.prefixes().at(network2).at(nodeArea), entry2);
+
+  // 2. Re-advertise same content - no change
+  EXPECT_TRUE(state.updatePrefixBundle(bundleKey, {entry2, entry1}).empty());
+
+  // 3. Replace content: entry1 updated, entry2 dropped, entry3 added
+  entry1.type() = thrift::PrefixType::BREEZE;
+  EXPECT_THAT(
+      state.updatePrefixBundle(bundleKey, {entry1, entry3}),
+      testing::UnorderedElementsAre(network1, network2, network3));
+  EXPECT_EQ(*state.prefixes().at(network1).at(nodeArea), entry1);
+  EXPECT_EQ(0, state.prefixes().count(network2));
+  EXPECT_EQ(*state.prefixes().at(network3).at(nodeArea), entry3);
+
+  // 4. Withdrawal of stale per-prefix key is ignored for bundled prefix
+  const PrefixKey prefixKey1(node, network1, area);
+  EXPECT_TRUE(state.deletePrefix(prefixKey1).empty());
+  EXPECT_EQ(*state.prefixes().at(network1).at(nodeArea), entry1);
+
+  // 5. Per-prefix key takes over ownership of entry3, which then survives
+  // bundle deletion
+  const PrefixKey prefixKey3(node, network3, area);
+  EXPECT_TRUE(state.updatePrefix(prefixKey3, entry3).empty());
+  EXPECT_THAT(
+      state.deletePrefixBundle(bundleKey),
+      testing::UnorderedElementsAre(network1));
+  EXPECT_EQ(0, state.prefixes().count(network1));
+  EXPECT_EQ(*state.prefixes().at(network3).at(nodeArea), entry3);
+
+  // 6. Deleting non-existing bundle is no-op
+  EXPECT_TRUE(state.deletePrefixBundle(bundleKey).empty());
+}
+
 /**
  * Verifies `getReceivedRoutesFiltered` with all filter combinations
  */
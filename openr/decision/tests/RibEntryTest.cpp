@@ -10,6 +10,7 @@
 
 #include <openr/common/LsdbUtil.h>
 #include <openr/decision/RibEntry.h>
+#include <openr/decision/RouteUpdate.h>
 
 namespace openr {
 
@@ -93,6 +94,92 @@ TEST(RibEntryTest, RibMplsEntry_filterNexthopsToUniqueAction) {
       std::unordered_set<thrift::NextHopThrift>({path1_3_1_php}));
 }
 
+TEST(DecisionRouteUpdateTest, Coalesce) {
+  const auto prefix1 = folly::IPAddress::createNetwork("fc00::1/128");
+  const auto prefix2 = folly::IPAddress::createNetwork("fc00::2/128");
+  const auto prefix3 = folly::IPAddress::createNetwork("fc00::3/128");
+
+  DecisionRouteUpdate pending;
+  pending.addRouteToUpdate(RibUnicastEntry(prefix1, {path1_2_1_swap}));
+  pending.unicastRoutesToDelete = {prefix2};
+  pending.addMplsRouteToUpdate(RibMplsEntry(1, {path1_2_1_swap}));
+
+  // Incremental update: prefix1 deleted, prefix2 re-added, prefix3 added
+  {
+    DecisionRouteUpdate incoming;
+    incoming.unicastRoutesToDelete = {prefix1};
+    incoming.addRouteToUpdate(RibUnicastEntry(prefix2, {path1_3_1_swap}));
+    incoming.addRouteToUpdate(RibUnicastEntry(prefix3, {path1_3_1_swap}));
+    incoming.mplsRoutesToDelete = {1};
+    EXPECT_TRUE(pending.coalesce(incoming));
+  }
+  EXPECT_EQ(DecisionRouteUpdate::INCREMENTAL, pending.type);
+  EXPECT_THAT(
+      pending.unicastRoutesToDelete, testing::UnorderedElementsAre(prefix1));
+  EXPECT_EQ(2, pending.unicastRoutesToUpdate.size());
+  EXPECT_EQ(
+      RibUnicastEntry(prefix2, {path1_3_1_swap}),
+      pending.unicastRoutesToUpdate.at(prefix2));
+  EXPECT_TRUE(pending.mplsRoutesToUpdate.empty());
+  EXPECT_THAT(pending.mplsRoutesToDelete, testing::UnorderedElementsAre(1));
+
+  // Different prefix type is never merged
+  {
+    DecisionRouteUpdate incoming;
+    incoming.prefixType = thrift::PrefixType::BGP;
+    EXPECT_FALSE(pending.coalesce(incoming));
+  }
+
+  // FULL_SYNC from Decision is a delta too. Pending routes it doesn't touch
+  // are retained
+  {
+    DecisionRouteUpdate incoming;
+    incoming.type = DecisionRouteUpdate::FULL_SYNC;
+    incoming.addRouteToUpdate(RibUnicastEntry(prefix3, {path1_2_2_swap}));
+    incoming.addMplsRouteToUpdate(RibMplsEntry(2, {path1_2_1_swap}));
+    EXPECT_TRUE(pending.coalesce(incoming));
+  }
+  EXPECT_EQ(DecisionRouteUpdate::FULL_SYNC, pending.type);
+  EXPECT_EQ(2, pending.unicastRoutesToUpdate.size());
+  EXPECT_EQ(
+      RibUnicastEntry(prefix2, {path1_3_1_swap}),
+      pending.unicastRoutesToUpdate.at(prefix2));
+  EXPECT_EQ(
+      RibUnicastEntry(prefix3, {path1_2_2_swap}),
+      pending.unicastRoutesToUpdate.at(prefix3));
+  EXPECT_THAT(
+      pending.unicastRoutesToDelete, testing::UnorderedElementsAre(prefix1));
+  EXPECT_EQ(1, pending.mplsRoutesToUpdate.count(2));
+  EXPECT_THAT(pending.mplsRoutesToDelete, testing::UnorderedElementsAre(1));
+
+  // Deletes on top of FULL_SYNC are retained, and FULL_SYNC type sticks
+  {
+    DecisionRouteUpdate incoming;
+    incoming.unicastRoutesToDelete = {prefix3};
+    incoming.mplsRoutesToDelete = {2};
+    EXPECT_TRUE(pending.coalesce(incoming));
+  }
+  EXPECT_EQ(DecisionRouteUpdate::FULL_SYNC, pending.type);
+  EXPECT_EQ(1, pending.unicastRoutesToUpdate.size());
+  EXPECT_EQ(1, pending.unicastRoutesToUpdate.count(prefix2));
+  EXPECT_THAT(
+      pending.unicastRoutesToDelete,
+      testing::UnorderedElementsAre(prefix1, prefix3));
+  EXPECT_TRUE(pending.mplsRoutesToUpdate.empty());
+  EXPECT_THAT(pending.mplsRoutesToDelete, testing::UnorderedElementsAre(1, 2));
+
+  // Deleted routes re-added by a later FULL_SYNC are no longer deleted
+  {
+    DecisionRouteUpdate incoming;
+    incoming.type = DecisionRouteUpdate::FULL_SYNC;
+    incoming.addRouteToUpdate(RibUnicastEntry(prefix1, {path1_2_1_swap}));
+    EXPECT_TRUE(pending.coalesce(incoming));
+  }
+  EXPECT_EQ(2, pending.unicastRoutesToUpdate.size());
+  EXPECT_THAT(
+      pending.unicastRoutesToDelete, testing::UnorderedElementsAre(prefix3));
+}
+
 } // namespace openr
 
 int
@@ -394,6 +394,129 @@ TEST(RibPolicy, ApplyPolicy) {
   }
 }
 
+/**
+ * Verifies statement order is retained with indexed lookup and that
+ * memoized outcomes are replayed only for unchanged routes:
+ * - stmt1 selects by tag, stmt2 by prefix. Route carrying both gets stmt1.
+ * - Re-applying on identical routes gives identical results from cache.
+ * - Changed route is re-evaluated, vanished route is evicted on full sync.
+ */
+TEST(RibPolicy, ApplyPolicyIndexAndCache) {
+  const auto stmt1 = createPolicyStatement(
+      std::nullopt, std::vector<std::string>{"TAG1"}, 1, {{"area1", 10}});
+  std::vector<thrift::IpPrefix> prefixes2{
+      toIpPrefix("fc01::/64"), toIpPrefix("fc02::/64")};
+  const auto stmt2 =
+      createPolicyStatement(prefixes2, std::nullopt, 1, {{"area1", 20}});
+  auto policy = RibPolicy(createPolicy({stmt1, stmt2}, 10));
+
+  const auto nh1 = createNextHop(
+      toBinaryAddress("fe80::1"), "iface1", 0, std::nullopt, "area1", "nbr1");
+  const auto nh2 = createNextHop(
+      toBinaryAddress("fe80::2"), "iface2", 0, std::nullopt, "area1", "nbr2");
+
+  thrift::PrefixEntry taggedEntry;
+  taggedEntry.tags() = {"TAG1"};
+  RibUnicastEntry const entry1(
+      folly::IPAddress::createNetwork("fc01::/64"),
+      {nh1},
+      taggedEntry,
+      "area1");
+  RibUnicastEntry const entry2(
+      folly::IPAddress::createNetwork("fc02::/64"), {nh1});
+  RibUnicastEntry const entry3(
+      folly::IPAddress::createNetwork("fc03::/64"), {nh1});
+
+  auto expectNh10 = nh1;
+  expectNh10.weight() = 10;
+  auto expectNh20 = nh1;
+  expectNh20.weight() = 20;
+
+  std::unordered_map<folly::CIDRNetwork, RibUnicastEntry> expectedEntries;
+  for (int i = 0; i < 2; ++i) {
+    std::unordered_map<folly::CIDRNetwork, RibUnicastEntry> entries;
+    entries.emplace(entry1.prefix, entry1);
+    entries.emplace(entry2.prefix, entry2);
+    entries.emplace(entry3.prefix, entry3);
+
+    auto const change = policy.applyPolicy(entries, true /* isFullSync */);
+    EXPECT_THAT(
+        change.updatedRoutes,
+        testing::UnorderedElementsAre(entry1.prefix, entry2.prefix));
+    EXPECT_THAT(
+        entries.at(entry1.prefix).nexthops,
+        testing::UnorderedElementsAre(expectNh10));
+    EXPECT_THAT(
+        entries.at(entry2.prefix).nexthops,
+        testing::UnorderedElementsAre(expectNh20));
+    EXPECT_EQ(entry3, entries.at(entry3.prefix));
+    // Only selected routes are memoized
+    EXPECT_EQ(2, policy.getCachedOutcomeCount());
+
+    if (i == 0) {
+      expectedEntries = entries;
+    } else {
+      EXPECT_EQ(expectedEntries, entries);
+    }
+  }
+
+  // Incremental update with changed next-hops of fc02::/64
+  {
+    std::unordered_map<folly::CIDRNetwork, RibUnicastEntry> entries;
+    entries.emplace(entry2.prefix, RibUnicastEntry(entry2.prefix, {nh1, nh2}));
+    auto const change = policy.applyPolicy(entries);
+    EXPECT_THAT(
+        change.updatedRoutes, testing::UnorderedElementsAre(entry2.prefix));
+    auto expectNh2 = nh2;
+    expectNh2.weight() = 20;
+    EXPECT_THAT(
+        entries.at(entry2.prefix).nexthops,
+        testing::UnorderedElementsAre(expectNh20, expectNh2));
+  }
+
+  // Full sync without fc01::/64 evicts its outcome
+  {
+    std::unordered_map<folly::CIDRNetwork, RibUnicastEntry> entries;
+    entries.emplace(entry2.prefix, entry2);
+    policy.applyPolicy(entries, true /* isFullSync */);
+    EXPECT_EQ(1, policy.getCachedOutcomeCount());
+  }
+}
+
+/**
+ * Verifies that replaying memoized outcome accounts invalidated routes the
+ * same as evaluation does, and that deleted routes are evicted from cache.
+ */
+TEST(RibPolicy, ApplyPolicyCacheCountersAndEviction) {
+  facebook::fb303::fbData->resetAllData();
+
+  std::vector<thrift::IpPrefix> prefixes{toIpPrefix("fc00::/64")};
+  const auto stmt =
+      createPolicyStatement(prefixes, std::nullopt, 1, {{"area2", 0}});
+  auto policy = RibPolicy(createPolicy({stmt}, 10));
+
+  const auto nh2 = createNextHop(
+      toBinaryAddress("fe80::1"), "iface2", 0, std::nullopt, "area2", "nbr2");
+  RibUnicastEntry const entry(
+      folly::IPAddress::createNetwork("fc00::/64"), {nh2});
+
+  // All next-hops invalidated on evaluation, and again on replay from cache
+  for (int i = 1; i <= 2; ++i) {
+    std::unordered_map<folly::CIDRNetwork, RibUnicastEntry> entries;
+    entries.emplace(entry.prefix, entry);
+    auto const change = policy.applyPolicy(entries);
+    EXPECT_THAT(change.updatedRoutes, testing::IsEmpty());
+    EXPECT_EQ(entry, entries.at(entry.prefix));
+    EXPECT_EQ(1, policy.getCachedOutcomeCount());
+    auto counters = facebook::fb303::fbData->getCounters();
+    EXPECT_EQ(i, counters.at("decision.rib_policy.invalidated_routes.count"));
+  }
+
+  // Deleted route is evicted
+  policy.evictCachedOutcomes({entry.prefix});
+  EXPECT_EQ(0, policy.getCachedOutcomeCount());
+}
+
 int
 main(int argc, char* argv[]) {
   // Parse command line flags
@@ -7,6 +7,9 @@
 
 #include <fb303/ServiceData.h>
 #include <folly/IPAddress.h>
+#include <folly/String.h>
+#include <folly/futures/Future.h>
+#include <folly/lang/Assume.h>
 #include <folly/logging/xlog.h>
 #include <thrift/lib/cpp2/async/HeaderClientChannel.h>
 
@@ -21,6 +24,20 @@ namespace openr {
 
 namespace { // anonymous for local function definitions
 
+// Counter name for each Fib::RoutePriority
+const std::array<std::string, 3> kRoutePriorityNames{
+    "repair", "priority", "default"};
+
+// Convergence histograms cover [0, kConvergenceMaxDuration] in 10ms buckets
+constexpr int64_t kConvergenceBucketMs{10};
+
+// Orders convergence traces by total duration, longest first
+bool
+isSlowerConvergence(
+    const thrift::PerfEvents& lhs, const thrift::PerfEvents& rhs) {
+  return getTotalPerfEventsDuration(lhs) > getTotalPerfEventsDuration(rhs);
+}
+
 void
 logFibUpdateError(thrift::PlatformFibUpdateError const& error) {
   fb303::fbData->addStatValue(
@@ -64,6 +81,15 @@ Fib::Fib(
   CHECK_GE(routeDeleteDelay_.count(), 0)
       << "Route delete duration must be >= 0ms";
 
+  if (auto priorityConfig = config->getConfig().fib_priority_config()) {
+    for (auto const& prefix : *priorityConfig->priority_prefixes()) {
+      priorityPrefixes_.emplace_back(folly::IPAddress::createNetwork(prefix));
+    }
+    priorityTags_.insert(
+        priorityConfig->priority_tags()->begin(),
+        priorityConfig->priority_tags()->end());
+  }
+
   // On startup we do require routedb_sync so explicitly set the counter to 0
   fb303::fbData->setCounter("fib.synced", 0);
 
@@ -82,6 +108,15 @@ Fib::Fib(
   addFiberTask(
       [this]() mutable noexcept { keepAliveTask(keepAliveStopSignal_); });
 
+  //
+  // Start RouteProgramming fiber with stop signal. Route updates read from
+  // Decision are handed over to it, so that we keep reading (and coalescing)
+  // updates while previous ones are being programmed.
+  //
+  addFiberTask([this]() mutable noexcept {
+    routeProgrammingTask(routeProgrammingStopSignal_);
+  });
+
   // Fiber to process route updates from Decision
   addFiberTask([q = std::move(routeUpdatesQueue), this]() mutable noexcept {
     while (true) {
@@ -108,6 +143,12 @@ Fib::Fib(
       "fib.thrift.failure.keepalive", fb303::COUNT);
   fb303::fbData->addStatExportType("fib.thrift.failure.sync_fib", fb303::COUNT);
   fb303::fbData->addStatExportType("fib.route_programming.time_ms", fb303::AVG);
+  fb303::fbData->addStatExportType("fib.route_batches_sent", fb303::SUM);
+  fb303::fbData->addStatExportType("fib.route_updates_merged", fb303::COUNT);
+  for (auto const& name : kRoutePriorityNames) {
+    fb303::fbData->addStatExportType(
+        fmt::format("fib.route_programming.{}.time_ms", name), fb303::AVG);
+  }
 }
 
 void
@@ -116,6 +157,8 @@ Fib::stop() {
   keepAliveStopSignal_.post();
   retryRoutesStopSignal_.post();
   retryRoutesSignal_.signal();
+  routeProgrammingStopSignal_.post();
+  routeProgrammingSignal_.signal();
 
   // Invoke stop method of super class
   OpenrEventBase::stop();
@@ -151,15 +194,22 @@ Fib::getRouteDb() {
   folly::Promise<std::unique_ptr<thrift::RouteDatabase>> p;
   auto sf = p.getSemiFuture();
   runInEventBaseThread([p = std::move(p), this]() mutable {
-    thrift::RouteDatabase routeDb;
-    routeDb.thisNodeName() = myNodeName_;
-    for (const auto& route : routeState_.unicastRoutes) {
-      routeDb.unicastRoutes()->emplace_back(route.second.toThrift());
-    }
-    for (const auto& route : routeState_.mplsRoutes) {
-      routeDb.mplsRoutes()->emplace_back(route.second.toThrift());
+    p.setValue(std::make_unique<thrift::RouteDatabase>(dumpRouteDb()));
+  });
+  return sf;
+}
+
+folly::SemiFuture<std::unique_ptr<thrift::VersionedRouteDb>>
+Fib::getRouteDbVersioned(int64_t lastGeneration) {
+  folly::Promise<std::unique_ptr<thrift::VersionedRouteDb>> p;
+  auto sf = p.getSemiFuture();
+  runInEventBaseThread([p = std::move(p), lastGeneration, this]() mutable {
+    auto versionedRouteDb = std::make_unique<thrift::VersionedRouteDb>();
+    versionedRouteDb->generation() = routeState_.generation;
+    if (lastGeneration != routeState_.generation) {
+      versionedRouteDb->routeDb() = dumpRouteDb();
     }
-    p.setValue(std::make_unique<thrift::RouteDatabase>(std::move(routeDb)));
+    p.setValue(std::move(versionedRouteDb));
   });
   return sf;
 }
@@ -196,6 +246,27 @@ Fib::getUnicastRoutes(std::vector<std::string> prefixes) {
   return sf;
 }
 
+folly::SemiFuture<std::unique_ptr<thrift::UnicastRoutesPage>>
+Fib::getUnicastRoutesPage(
+    thrift::PageRequest request,
+    PageKeysSnapshot<folly::CIDRNetwork> sortedKeys) {
+  auto [p, sf] =
+      folly::makePromiseContract<std::unique_ptr<thrift::UnicastRoutesPage>>();
+  runInEventBaseThread(
+      [p = std::move(p),
+       request = std::move(request),
+       sortedKeys = std::move(sortedKeys),
+       this]() mutable {
+        try {
+          p.setValue(std::make_unique<thrift::UnicastRoutesPage>(
+              getUnicastRoutesPageInternal(request, sortedKeys.get())));
+        } catch (const thrift::OpenrError& e) {
+          p.setException(e);
+        }
+      });
+  return std::move(sf);
+}
+
 folly::SemiFuture<std::unique_ptr<std::vector<thrift::MplsRoute>>>
 Fib::getMplsRoutes(std::vector<int32_t> labels) {
   folly::Promise<std::unique_ptr<std::vector<thrift::MplsRoute>>> p;
@@ -218,6 +289,16 @@ Fib::getPerfDb() {
   return sf;
 }
 
+folly::SemiFuture<std::unique_ptr<thrift::PerfDatabase>>
+Fib::getSlowestPerfDb() {
+  folly::Promise<std::unique_ptr<thrift::PerfDatabase>> p;
+  auto sf = p.getSemiFuture();
+  runInEventBaseThread([p = std::move(p), this]() mutable {
+    p.setValue(std::make_unique<thrift::PerfDatabase>(dumpSlowestPerfDb()));
+  });
+  return sf;
+}
+
 std::vector<thrift::UnicastRoute>
 Fib::getUnicastRoutesFiltered(std::vector<std::string> prefixes) {
   // return and send the vector<thrift::UnicastRoute>
@@ -260,6 +341,40 @@ Fib::getUnicastRoutesFiltered(std::vector<std::string> prefixes) {
   return retRouteVec;
 }
 
+thrift::UnicastRoutesPage
+Fib::getUnicastRoutesPageInternal(
+    const thrift::PageRequest& request,
+    std::vector<folly::CIDRNetwork>* sortedKeys) const {
+  std::optional<folly::CIDRNetwork> cursor;
+  if (request.cursor()) {
+    cursor = toIPNetwork(toIpPrefix(*request.cursor()));
+  }
+  std::optional<folly::CIDRNetwork> range;
+  if (request.keyPrefix()) {
+    range = toIPNetwork(toIpPrefix(*request.keyPrefix()));
+  }
+
+  auto const [page, hasMore] = selectPage(
+      routeState_.unicastRoutes,
+      cursor,
+      getPageLimit(*request.limit()),
+      [&range](auto const& entry) {
+        return not range or isPrefixWithin(entry.first, *range);
+      },
+      sortedKeys);
+
+  thrift::UnicastRoutesPage routesPage;
+  routesPage.routes()->reserve(page.size());
+  for (auto const& it : page) {
+    routesPage.routes()->emplace_back(it->second.toThrift());
+  }
+  if (hasMore) {
+    routesPage.nextCursor() =
+        folly::IPAddress::networkToString(page.back()->first);
+  }
+  return routesPage;
+}
+
 std::vector<thrift::MplsRoute>
 Fib::getMplsRoutesFiltered(std::vector<int32_t> labels) {
   // return and send the vector<thrift::MplsRoute>
@@ -296,6 +411,10 @@ Fib::getFibUpdatesReader() {
 
 void
 Fib::RouteState::update(const DecisionRouteUpdate& routeUpdate) {
+  if (not routeUpdate.empty()) {
+    ++generation;
+  }
+
   // Add/Update unicast routes to update
   for (const auto& [prefix, route] : routeUpdate.unicastRoutesToUpdate) {
     unicastRoutes.insert_or_assign(prefix, route);
@@ -439,9 +558,6 @@ Fib::RouteState::processFibUpdateError(
 // Process new route updates received from Decision module.
 void
 Fib::processDecisionRouteUpdate(DecisionRouteUpdate&& routeUpdate) {
-  // Process state transition event
-  transitionRouteState(RouteState::RIB_UPDATE);
-
   // Update perfEvents_ .. We replace existing perf events with new one as
   // convergence is going to be based on new data, not the old.
   if (routeUpdate.perfEvents.has_value()) {
@@ -466,11 +582,52 @@ Fib::processDecisionRouteUpdate(DecisionRouteUpdate&& routeUpdate) {
     mplsRoute.filterNexthopsToUniqueAction();
   }
 
-  updateRoutes(std::move(routeUpdate));
-  if (routeState_.needsRetry()) {
-    // Trigger initial Fib sync, or schedule retry routes timer if needed.
-    retryRoutesSignal_.signal();
+  // Hand over to route programming fiber. Coalesce with the last pending
+  // update if any, so that lagging programming only sees the latest routes.
+  if (pendingRouteUpdates_.empty() or
+      not pendingRouteUpdates_.back().coalesce(routeUpdate)) {
+    pendingRouteUpdates_.emplace_back(std::move(routeUpdate));
+  }
+  routeProgrammingSignal_.signal();
+}
+
+void
+Fib::routeProgrammingTask(folly::fibers::Baton& stopSignal) noexcept {
+  XLOG(INFO) << "Starting RouteProgramming fiber task";
+  while (true) {
+    routeProgrammingSignal_.wait();
+    if (stopSignal.ready()) {
+      break;
+    }
+
+    while (not pendingRouteUpdates_.empty()) {
+      auto routeUpdate = std::move(pendingRouteUpdates_.front());
+      pendingRouteUpdates_.pop_front();
+
+      // Process state transition event
+      transitionRouteState(RouteState::RIB_UPDATE);
+
+      updateRoutes(std::move(routeUpdate));
+      if (routeState_.needsRetry()) {
+        // Trigger initial Fib sync, or schedule retry routes timer if needed.
+        retryRoutesSignal_.signal();
+      }
+    }
+  } // while
+  XLOG(INFO) << "RouteProgramming fiber task got stopped";
+}
+
+thrift::RouteDatabase
+Fib::dumpRouteDb() const {
+  thrift::RouteDatabase routeDb;
+  routeDb.thisNodeName() = myNodeName_;
+  for (const auto& route : routeState_.unicastRoutes) {
+    routeDb.unicastRoutes()->emplace_back(route.second.toThrift());
+  }
+  for (const auto& route : routeState_.mplsRoutes) {
+    routeDb.mplsRoutes()->emplace_back(route.second.toThrift());
   }
+  return routeDb;
 }
 
 thrift::PerfDatabase
@@ -483,6 +640,18 @@ Fib::dumpPerfDb() const {
   return perfDb;
 }
 
+thrift::PerfDatabase
+Fib::dumpSlowestPerfDb() const {
+  thrift::PerfDatabase perfDb;
+  *perfDb.thisNodeName() = myNodeName_;
+  *perfDb.eventInfo() = slowestPerfDb_;
+  std::sort(
+      perfDb.eventInfo()->begin(),
+      perfDb.eventInfo()->end(),
+      isSlowerConvergence);
+  return perfDb;
+}
+
 void
 Fib::printUnicastRoutesAddUpdate(
     const std::vector<thrift::UnicastRoute>& unicastRoutesToUpdate) {
@@ -515,24 +684,49 @@ Fib::printMplsRoutesAddUpdate(
   }
 }
 
-bool
-Fib::updateUnicastRoutes(
+Fib::RoutePriority
+Fib::getRoutePriority(const RibUnicastEntry& route) const {
+  // Route losing any of its nexthops
+  auto it = routeState_.unicastRoutes.find(route.prefix);
+  if (it != routeState_.unicastRoutes.end()) {
+    for (auto const& nh : it->second.nexthops) {
+      if (not route.nexthops.count(nh)) {
+        return REPAIR;
+      }
+    }
+  }
+
+  // Configured priority prefixes & tags
+  for (auto const& network : priorityPrefixes_) {
+    if (route.prefix.first.inSubnet(network.first, network.second) and
+        route.prefix.second >= network.second) {
+      return PRIORITY;
+    }
+  }
+  for (auto const& tag : *route.bestPrefixEntry.tags()) {
+    if (priorityTags_.count(tag)) {
+      return PRIORITY;
+    }
+  }
+  return DEFAULT;
+}
+
+void
+Fib::enqueueRouteKeys(
     const bool useDeleteDelay,
     const std::chrono::time_point<std::chrono::steady_clock>& currentTime,
-    const std::chrono::time_point<std::chrono::steady_clock>& retryAt,
-    DecisionRouteUpdate& routeUpdate,
-    thrift::RouteDatabaseDelta& routeDbDelta) {
-  bool success{true};
+    const DecisionRouteUpdate& routeUpdate,
+    UnicastKeyQueues& unicastKeys,
+    std::deque<int32_t>& mplsKeys) {
+  const bool delayDelete = delayedDeletionEnabled() and useDeleteDelay;
+
   //
-  // Delete Unicast routes
+  // Unicast routes
   //
-  auto& unicastRoutesToDelete = *routeDbDelta.unicastRoutesToDelete();
-  if (delayedDeletionEnabled() and useDeleteDelay) {
-    // Clear the routes to delete
-    unicastRoutesToDelete.clear();
-
-    // Mark dirty state here & set
-    for (auto& prefix : routeUpdate.unicastRoutesToDelete) {
+  for (auto const& prefix : routeUpdate.unicastRoutesToDelete) {
+    if (delayDelete) {
+      // Drop from the queue if not yet sent & mark dirty state here
+      routeState_.unicastAckState.erase(prefix);
       const auto [itr, _] = routeState_.dirtyPrefixes.insert_or_assign(
           prefix, currentTime + routeDeleteDelay_);
       XLOG(INFO) << "Will delete unicast route "
@@ -541,181 +735,268 @@ Fib::updateUnicastRoutes(
                         itr->second - currentTime)
                         .count()
                  << "ms";
+      continue;
     }
-  }
-
-  if (unicastRoutesToDelete.size()) {
-    XLOG(INFO) << "Deleting " << unicastRoutesToDelete.size()
-               << " unicast routes in FIB";
-    for (auto const& prefix : unicastRoutesToDelete) {
-      XLOG(DBG1) << "> " << toString(prefix);
+    if (routeState_.unicastAckState.emplace(prefix, RouteState::PENDING)
+            .second) {
+      unicastKeys.at(REPAIR).emplace_back(prefix);
     }
-    if (dryrun_) {
-      XLOG(INFO) << "Skipping deletion of unicast routes in dryrun ... ";
-    } else {
-      try {
-        createFibClient(*getEvb(), socket_, client_, thriftPort_);
-        client_->sync_deleteUnicastRoutes(kFibId_, unicastRoutesToDelete);
-      } catch (std::exception& e) {
-        success = false;
-        client_.reset();
-        fb303::fbData->addStatValue(
-            "fib.thrift.failure.add_del_route", 1, fb303::COUNT);
-        XLOG(ERR) << "Failed to delete unicast routes from FIB. Error: "
-                  << folly::exceptionStr(e);
-        // Marked all routes to be deleted as dirty. So we try to remove them
-        // again from FIB.
-        for (const auto& prefix : routeUpdate.unicastRoutesToDelete) {
-          routeState_.dirtyPrefixes.insert_or_assign(prefix, retryAt);
-        }
-        // NOTE: We still want to advertise these prefixes as deleted
-      }
+  }
+  for (auto const& [prefix, route] : routeUpdate.unicastRoutesToUpdate) {
+    if (routeState_.unicastAckState.emplace(prefix, RouteState::PENDING)
+            .second) {
+      unicastKeys.at(getRoutePriority(route)).emplace_back(prefix);
     }
   }
 
   //
-  // Update Unicast routes
+  // Mpls routes. Programmed only if segment routing is enabled
   //
-  auto const& unicastRoutesToUpdate = *routeDbDelta.unicastRoutesToUpdate();
-  if (unicastRoutesToUpdate.size()) {
-    XLOG(INFO) << "Adding/Updating " << unicastRoutesToUpdate.size()
+  if (not enableSegmentRouting_) {
+    return;
+  }
+  for (auto const& label : routeUpdate.mplsRoutesToDelete) {
+    if (delayDelete) {
+      // Drop from the queue if not yet sent & mark dirty state here
+      routeState_.mplsAckState.erase(label);
+      const auto [itr, _] = routeState_.dirtyLabels.insert_or_assign(
+          label, currentTime + routeDeleteDelay_);
+      XLOG(INFO) << "Will delete mpls route " << label << " after "
+                 << std::chrono::duration_cast<std::chrono::milliseconds>(
+                        itr->second - currentTime)
+                        .count()
+                 << "ms";
+      continue;
+    }
+    if (routeState_.mplsAckState.emplace(label, RouteState::PENDING).second) {
+      mplsKeys.emplace_back(label);
+    }
+  }
+  for (auto const& [label, _] : routeUpdate.mplsRoutesToUpdate) {
+    if (routeState_.mplsAckState.emplace(label, RouteState::PENDING).second) {
+      mplsKeys.emplace_back(label);
+    }
+  }
+}
+
+folly::SemiFuture<folly::Unit>
+Fib::sendRouteBatch(
+    const DecisionRouteUpdate& routeUpdate, const RouteBatch& batch) {
+  switch (batch.type) {
+  case RouteBatch::UNICAST_DELETE: {
+    std::vector<thrift::IpPrefix> prefixes;
+    prefixes.reserve(batch.prefixes.size());
+    for (auto const& prefix : batch.prefixes) {
+      XLOG(DBG1) << "> " << folly::IPAddress::networkToString(prefix);
+      prefixes.emplace_back(toIpPrefix(prefix));
+    }
+    XLOG(INFO) << "Deleting " << prefixes.size() << " unicast routes in FIB";
+    if (dryrun_) {
+      XLOG(INFO) << "Skipping deletion of unicast routes in dryrun ... ";
+      return folly::makeSemiFuture();
+    }
+    createFibClient(*getEvb(), socket_, client_, thriftPort_);
+    return client_->semifuture_deleteUnicastRoutes(kFibId_, prefixes);
+  }
+  case RouteBatch::UNICAST_ADD: {
+    std::vector<thrift::UnicastRoute> routes;
+    routes.reserve(batch.prefixes.size());
+    for (auto const& prefix : batch.prefixes) {
+      routes.emplace_back(
+          routeUpdate.unicastRoutesToUpdate.at(prefix).toThrift());
+    }
+    XLOG(INFO) << "Adding/Updating " << routes.size()
                << " unicast routes in FIB";
-    printUnicastRoutesAddUpdate(unicastRoutesToUpdate);
+    printUnicastRoutesAddUpdate(routes);
     if (dryrun_) {
       XLOG(INFO) << "Skipping add/update of unicast routes in dryrun ... ";
-    } else {
-      try {
-        createFibClient(*getEvb(), socket_, client_, thriftPort_);
-        client_->sync_addUnicastRoutes(kFibId_, unicastRoutesToUpdate);
-      } catch (thrift::PlatformFibUpdateError const& fibUpdateError) {
-        success = false;
-        logFibUpdateError(fibUpdateError);
-        // Remove failed routes from fibRouteUpdates
-        routeUpdate.processFibUpdateError(fibUpdateError);
-        // Mark failed routes as dirty in route state
-        routeState_.processFibUpdateError(fibUpdateError, retryAt);
-      } catch (std::exception const& e) {
-        success = false;
-        client_.reset();
-        fb303::fbData->addStatValue(
-            "fib.thrift.failure.add_del_route", 1, fb303::COUNT);
-        XLOG(ERR) << "Failed to add/update unicast routes in FIB. Error: "
-                  << folly::exceptionStr(e);
-        // Mark routes we failed to update as dirty for retry. Also declare
-        // these routes as deleted to client, because we failed to update them
-        // Next retry should restore, but meanwhile clients can take appropriate
-        // action because FIB state is unclear e.g. withdraw route from KvStore
-        for (auto& [prefix, _] : routeUpdate.unicastRoutesToUpdate) {
-          routeState_.dirtyPrefixes.insert_or_assign(prefix, retryAt);
-          routeUpdate.unicastRoutesToDelete.emplace_back(prefix);
-        }
-
-        // We don't want to advertise failed route add/updates
-        routeUpdate.unicastRoutesToUpdate.clear();
-      }
+      return folly::makeSemiFuture();
     }
+    createFibClient(*getEvb(), socket_, client_, thriftPort_);
+    return client_->semifuture_addUnicastRoutes(kFibId_, routes);
   }
-
-  return success;
+  case RouteBatch::MPLS_DELETE: {
+    for (auto const& label : batch.labels) {
+      XLOG(DBG1) << "> " << std::to_string(label);
+    }
+    XLOG(INFO) << "Deleting " << batch.labels.size() << " mpls routes in FIB";
+    if (dryrun_) {
+      XLOG(INFO) << "Skipping deletion of mpls routes in dryrun ... ";
+      return folly::makeSemiFuture();
+    }
+    createFibClient(*getEvb(), socket_, client_, thriftPort_);
+    return client_->semifuture_deleteMplsRoutes(kFibId_, batch.labels);
+  }
+  case RouteBatch::MPLS_ADD: {
+    std::vector<thrift::MplsRoute> routes;
+    routes.reserve(batch.labels.size());
+    for (auto const& label : batch.labels) {
+      routes.emplace_back(routeUpdate.mplsRoutesToUpdate.at(label).toThrift());
+    }
+    XLOG(INFO) << "Adding/Updating " << routes.size() << " mpls routes in FIB";
+    printMplsRoutesAddUpdate(routes);
+    if (dryrun_) {
+      XLOG(INFO) << "Skipping add/update of mpls routes in dryrun ... ";
+      return folly::makeSemiFuture();
+    }
+    createFibClient(*getEvb(), socket_, client_, thriftPort_);
+    return client_->semifuture_addMplsRoutes(kFibId_, routes);
+  }
+  }
+  folly::assume_unreachable();
 }
 
 bool
-Fib::updateMplsRoutes(
-    const bool useDeleteDelay,
-    const std::chrono::time_point<std::chrono::steady_clock>& currentTime,
+Fib::programRouteBatches(
     const std::chrono::time_point<std::chrono::steady_clock>& retryAt,
     DecisionRouteUpdate& routeUpdate,
-    thrift::RouteDatabaseDelta& routeDbDelta) {
-  bool success{true};
+    UnicastKeyQueues& unicastKeys,
+    std::deque<int32_t>& mplsKeys) {
   //
-  // Delete Mpls routes
+  // Pack queued keys into at most `kFibMaxInflightBatches` batches, each
+  // holding at most `kFibProgrammingBatchSize` keys of a single type
   //
-  auto& mplsRoutesToDelete = *routeDbDelta.mplsRoutesToDelete();
-  if (useDeleteDelay and delayedDeletionEnabled()) {
-    // Clear the routes to delete
-    mplsRoutesToDelete.clear();
+  std::vector<RouteBatch> batches;
+  std::array<std::optional<size_t>, 4> openBatches;
+  // Returns batch to add key of given type to, or nullptr if wave is full
+  auto getBatch = [&](RouteBatch::Type type) -> RouteBatch* {
+    auto& index = openBatches.at(type);
+    if (index.has_value()) {
+      auto& batch = batches.at(*index);
+      if (batch.prefixes.size() + batch.labels.size() <
+          Constants::kFibProgrammingBatchSize) {
+        return &batch;
+      }
+    }
+    if (batches.size() >= Constants::kFibMaxInflightBatches) {
+      return nullptr;
+    }
+    index = batches.size();
+    batches.emplace_back().type = type;
+    return &batches.back();
+  };
 
-    // Mark dirty state here & set
-    for (auto& mplsRoute : routeUpdate.mplsRoutesToDelete) {
-      const auto [itr, _] = routeState_.dirtyLabels.insert_or_assign(
-          mplsRoute, currentTime + routeDeleteDelay_);
-      XLOG(INFO) << "Will delete mpls route " << mplsRoute << " after "
-                 << std::chrono::duration_cast<std::chrono::milliseconds>(
-                        itr->second - currentTime)
-                        .count()
-                 << "ms";
+  bool waveFull{false};
+  for (auto& keys : unicastKeys) {
+    while (not keys.empty()) {
+      auto const& prefix = keys.front();
+      auto it = routeState_.unicastAckState.find(prefix);
+      if (it == routeState_.unicastAckState.end() or
+          it->second != RouteState::PENDING) {
+        keys.pop_front(); // No longer to be programmed e.g. delayed
+        continue;
+      }
+      auto batch = getBatch(
+          routeUpdate.unicastRoutesToUpdate.count(prefix)
+              ? RouteBatch::UNICAST_ADD
+              : RouteBatch::UNICAST_DELETE);
+      if (not batch) {
+        waveFull = true;
+        break;
+      }
+      it->second = RouteState::INFLIGHT;
+      batch->prefixes.emplace_back(prefix);
+      keys.pop_front();
+    }
+    if (waveFull) {
+      // Lower priority keys must not be sent ahead of remaining ones
+      break;
     }
   }
 
-  if (mplsRoutesToDelete.size()) {
-    XLOG(INFO) << "Deleting " << mplsRoutesToDelete.size()
-               << " mpls routes in FIB";
-    for (auto const& topLabel : mplsRoutesToDelete) {
-      XLOG(DBG1) << "> " << std::to_string(topLabel);
+  while (not waveFull and not mplsKeys.empty()) {
+    auto const label = mplsKeys.front();
+    auto it = routeState_.mplsAckState.find(label);
+    if (it == routeState_.mplsAckState.end() or
+        it->second != RouteState::PENDING) {
+      mplsKeys.pop_front(); // No longer to be programmed e.g. delayed
+      continue;
     }
-    if (dryrun_) {
-      XLOG(INFO) << "Skipping deletion of mpls routes in dryrun ... ";
-    } else {
-      try {
-        createFibClient(*getEvb(), socket_, client_, thriftPort_);
-        client_->sync_deleteMplsRoutes(kFibId_, mplsRoutesToDelete);
-      } catch (std::exception const& e) {
-        success = false;
-        client_.reset();
-        fb303::fbData->addStatValue(
-            "fib.thrift.failure.add_del_route", 1, fb303::COUNT);
-        XLOG(ERR) << "Failed to delete mpls routes from FIB. Error: "
-                  << folly::exceptionStr(e);
-        // Marked all routes to be deleted as dirty. So we try to remove them
-        // again from FIB.
-        for (const auto& label : routeUpdate.mplsRoutesToDelete) {
-          routeState_.dirtyLabels.insert_or_assign(label, retryAt);
-        }
-        // NOTE: We still want to advertise these labels as deleted
-      }
+    auto batch = getBatch(
+        routeUpdate.mplsRoutesToUpdate.count(label) ? RouteBatch::MPLS_ADD
+                                                     : RouteBatch::MPLS_DELETE);
+    if (not batch) {
+      break;
     }
+    it->second = RouteState::INFLIGHT;
+    batch->labels.emplace_back(label);
+    mplsKeys.pop_front();
+  }
+
+  if (batches.empty()) {
+    return true;
   }
 
   //
-  // Update Mpls routes
+  // Send all batches and wait for them to be acknowledged. Fiber yields while
+  // waiting, hence Decision updates are read & coalesced meanwhile.
   //
-  auto const& mplsRoutesToUpdate = *routeDbDelta.mplsRoutesToUpdate();
-  if (mplsRoutesToUpdate.size()) {
-    XLOG(INFO) << "Adding/Updating " << mplsRoutesToUpdate.size()
-               << " mpls routes in FIB";
-    printMplsRoutesAddUpdate(mplsRoutesToUpdate);
-    if (dryrun_) {
-      XLOG(INFO) << "Skipping add/update of mpls routes in dryrun ... ";
-    } else {
-      try {
-        createFibClient(*getEvb(), socket_, client_, thriftPort_);
-        client_->sync_addMplsRoutes(kFibId_, mplsRoutesToUpdate);
-      } catch (thrift::PlatformFibUpdateError const& fibUpdateError) {
-        success = false;
-        logFibUpdateError(fibUpdateError);
-        // Remove failed routes from fibRouteUpdates
-        routeUpdate.processFibUpdateError(fibUpdateError);
-        // Mark failed routes as dirty in route state
-        routeState_.processFibUpdateError(fibUpdateError, retryAt);
-      } catch (std::exception const& e) {
-        success = false;
-        client_.reset();
-        fb303::fbData->addStatValue(
-            "fib.thrift.failure.add_del_route", 1, fb303::COUNT);
-        XLOG(ERR) << "Failed to add/update mpls routes in FIB. Error: "
-                  << folly::exceptionStr(e);
-        // Mark routes we failed to update as dirty for retry. Also declare
-        // these routes as deleted to client, because we failed to update them
-        // Next retry should restore, but meanwhile clients can take
-        // appropriate action because FIB state is unclear e.g. withdraw route
-        // from KvStore
-        for (auto& [label, _] : routeUpdate.mplsRoutesToUpdate) {
-          routeState_.dirtyLabels.insert_or_assign(label, retryAt);
-          routeUpdate.mplsRoutesToDelete.emplace_back(label);
-        }
+  std::vector<folly::SemiFuture<folly::Unit>> futures;
+  futures.reserve(batches.size());
+  for (auto const& batch : batches) {
+    futures.emplace_back(folly::makeSemiFutureWith(
+        [&]() { return sendRouteBatch(routeUpdate, batch); }));
+  }
+  fb303::fbData->addStatValue(
+      "fib.route_batches_sent", batches.size(), fb303::SUM);
+  auto results = folly::collectAll(std::move(futures)).get();
+
+  //
+  // Process acknowledgements
+  //
+  bool success{true};
+  for (size_t i = 0; i < batches.size(); ++i) {
+    auto& batch = batches.at(i);
+    auto& result = results.at(i);
+
+    // Keys are no longer in flight. Failed ones are marked dirty below
+    for (auto const& prefix : batch.prefixes) {
+      routeState_.unicastAckState.erase(prefix);
+    }
+    for (auto const& label : batch.labels) {
+      routeState_.mplsAckState.erase(label);
+    }
+
+    if (result.hasValue()) {
+      continue;
+    }
+    success = false;
+
+    if (auto fibUpdateError =
+            result.tryGetExceptionObject<thrift::PlatformFibUpdateError>()) {
+      logFibUpdateError(*fibUpdateError);
+      // Remove failed routes from fibRouteUpdates
+      routeUpdate.processFibUpdateError(*fibUpdateError);
+      // Mark failed routes as dirty in route state
+      routeState_.processFibUpdateError(*fibUpdateError, retryAt);
+      continue;
+    }
 
-        // We don't want to advertise failed route add/updates
-        routeUpdate.mplsRoutesToUpdate.clear();
+    client_.reset();
+    fb303::fbData->addStatValue(
+        "fib.thrift.failure.add_del_route", 1, fb303::COUNT);
+    XLOG(ERR) << "Failed to program batch of "
+              << batch.prefixes.size() + batch.labels.size()
+              << " routes in FIB. Error: "
+              << folly::exceptionStr(result.exception());
+
+    // Mark routes we failed to program as dirty for retry. Failed deletes are
+    // still advertised as deleted. Also declare failed add/updates as deleted
+    // to client, because FIB state is unclear. Next retry should restore, but
+    // meanwhile clients can take appropriate action e.g. withdraw route from
+    // KvStore.
+    for (auto const& prefix : batch.prefixes) {
+      routeState_.dirtyPrefixes.insert_or_assign(prefix, retryAt);
+      if (batch.type == RouteBatch::UNICAST_ADD) {
+        routeUpdate.unicastRoutesToUpdate.erase(prefix);
+        routeUpdate.unicastRoutesToDelete.emplace_back(prefix);
+      }
+    }
+    for (auto const& label : batch.labels) {
+      routeState_.dirtyLabels.insert_or_assign(label, retryAt);
+      if (batch.type == RouteBatch::MPLS_ADD) {
+        routeUpdate.mplsRoutesToUpdate.erase(label);
+        routeUpdate.mplsRoutesToDelete.emplace_back(label);
       }
     }
   }
@@ -723,6 +1004,43 @@ Fib::updateMplsRoutes(
   return success;
 }
 
+void
+Fib::mergePendingRouteUpdates(
+    DecisionRouteUpdate& routeUpdate,
+    UnicastKeyQueues& unicastKeys,
+    std::deque<int32_t>& mplsKeys) {
+  // Only incremental updates can be folded into an incremental programming
+  // round. Anything else, e.g. initial RIB snapshot, is processed on its own
+  // once this round finishes.
+  bool merged{false};
+  while (not pendingRouteUpdates_.empty() and
+         routeState_.state == RouteState::SYNCED) {
+    auto& pendingUpdate = pendingRouteUpdates_.front();
+    if (pendingUpdate.type != DecisionRouteUpdate::INCREMENTAL or
+        pendingUpdate.prefixType != routeUpdate.prefixType) {
+      break;
+    }
+
+    // ATTN: queue keys before updating routeState_ for route priorities
+    enqueueRouteKeys(
+        true /* useDeleteDelay */,
+        std::chrono::steady_clock::now(),
+        pendingUpdate,
+        unicastKeys,
+        mplsKeys);
+    routeState_.update(pendingUpdate);
+    routeUpdate.coalesce(pendingUpdate);
+    pendingRouteUpdates_.pop_front();
+    fb303::fbData->addStatValue("fib.route_updates_merged", 1, fb303::COUNT);
+    merged = true;
+  }
+
+  if (merged) {
+    // Update flat counters here as they depend on routeState_ and its change
+    updateGlobalCounters();
+  }
+}
+
 bool
 Fib::updateRoutes(
     std::optional<DecisionRouteUpdate>&& maybeRouteUpdate,
@@ -734,7 +1052,7 @@ Fib::updateRoutes(
 
   DecisionRouteUpdate routeUpdate;
   if (maybeRouteUpdate.has_value()) {
-    routeUpdate = *maybeRouteUpdate;
+    routeUpdate = std::move(maybeRouteUpdate).value();
     XLOG(INFO) << "Processing route update from Decision";
   } else {
     routeUpdate = routeState_.createUpdate();
@@ -747,6 +1065,27 @@ Fib::updateRoutes(
     return true;
   }
 
+  auto const currentTime = std::chrono::steady_clock::now();
+  auto const retryAt =
+      currentTime + retryRoutesExpBackoff_.getTimeRemainingUntilRetry();
+  bool success{true};
+  if (routeUpdate.perfEvents.has_value()) {
+    addPerfEvent(
+        *routeUpdate.perfEvents, myNodeName_, "FIB_ROUTES_PROGRAMMING");
+  }
+
+  // Queue keys of routes to program. Routes are picked up from `routeUpdate`
+  // when their batch is sent, hence the latest route is programmed for keys
+  // updated by Decision before being sent.
+  // ATTN: keys are queued before updating routeState_ for route priorities.
+  // Nothing is queued in SYNCING state, see below.
+  UnicastKeyQueues unicastKeys;
+  std::deque<int32_t> mplsKeys;
+  if (routeState_.state != RouteState::SYNCING) {
+    enqueueRouteKeys(
+        useDeleteDelay, currentTime, routeUpdate, unicastKeys, mplsKeys);
+  }
+
   // Backup routes in routeState_. In case update routes failed, routes will be
   // programmed in later scheduled FIB sync.
   routeState_.update(routeUpdate);
@@ -763,21 +1102,40 @@ Fib::updateRoutes(
   }
 
   XLOG(INFO) << "Updating routes in FIB";
-  auto const currentTime = std::chrono::steady_clock::now();
-  auto const retryAt =
-      currentTime + retryRoutesExpBackoff_.getTimeRemainingUntilRetry();
-  bool success{true};
-
-  // Convert DecisionRouteUpdate to RouteDatabaseDelta to use UnicastRoute
-  // and MplsRoute with the FibService client APIs
-  auto routeDbDelta = routeUpdate.toThrift();
 
-  success &= updateUnicastRoutes(
-      useDeleteDelay, currentTime, retryAt, routeUpdate, routeDbDelta);
-
-  if (enableSegmentRouting_) {
-    success &= updateMplsRoutes(
-        useDeleteDelay, currentTime, retryAt, routeUpdate, routeDbDelta);
+  // Program in waves of bounded batches, higher priority routes first.
+  // Decision updates received while a wave is in flight are merged into the
+  // remaining ones. Programming latency of each priority class is reported
+  // once all of its queued routes are acknowledged.
+  auto hasKeys = [&]() {
+    return not mplsKeys.empty() or
+        std::any_of(
+               unicastKeys.begin(), unicastKeys.end(), [](auto const& keys) {
+                 return not keys.empty();
+               });
+  };
+  std::array<bool, kNumRoutePriorities> pendingPriorities{};
+  while (hasKeys()) {
+    for (size_t priority = 0; priority < kNumRoutePriorities; ++priority) {
+      pendingPriorities.at(priority) |= not unicastKeys.at(priority).empty();
+    }
+    success &=
+        programRouteBatches(retryAt, routeUpdate, unicastKeys, mplsKeys);
+    for (size_t priority = 0; priority < kNumRoutePriorities; ++priority) {
+      if (pendingPriorities.at(priority) and
+          unicastKeys.at(priority).empty()) {
+        pendingPriorities.at(priority) = false;
+        fb303::fbData->addStatValue(
+            fmt::format(
+                "fib.route_programming.{}.time_ms",
+                kRoutePriorityNames.at(priority)),
+            std::chrono::ceil<std::chrono::milliseconds>(
+                std::chrono::steady_clock::now() - currentTime)
+                .count(),
+            fb303::AVG);
+      }
+    }
+    mergePendingRouteUpdates(routeUpdate, unicastKeys, mplsKeys);
   }
   // Log statistics
   const auto elapsedTime = std::chrono::ceil<std::chrono::milliseconds>(
@@ -789,6 +1147,11 @@ Fib::updateRoutes(
   fb303::fbData->addStatValue(
       "fib.num_of_route_updates", routeUpdate.size(), fb303::SUM);
 
+  // Conclude convergence trace once all routes got acknowledged by platform
+  if (success) {
+    logPerfEvents(routeUpdate.perfEvents);
+  }
+
   // Publish the route update. Clear MPLS routes if segment routing is disabled
   routeUpdate.type = DecisionRouteUpdate::INCREMENTAL;
   if (not enableSegmentRouting_) {
@@ -1109,7 +1472,7 @@ Fib::updateGlobalCounters() {
 }
 
 void
-Fib::logPerfEvents(std::optional<thrift::PerfEvents>& perfEvents) {
+Fib::logPerfEvents(std::optional<thrift::PerfEvents> perfEvents) {
   if (not perfEvents.has_value() or not perfEvents->events()->size()) {
     return;
   }
@@ -1146,6 +1509,32 @@ Fib::logPerfEvents(std::optional<thrift::PerfEvents>& perfEvents) {
     XLOG(DBG2) << "  " << str;
   }
 
+  // Aggregate time spent in each stage. Stage is named after the event
+  // concluding it, e.g. `decision_debounce` for time since DECISION_RECEIVED.
+  const auto& events = *perfEvents->events();
+  for (size_t i = 1; i < events.size(); ++i) {
+    auto stage = *events.at(i).eventDescr();
+    folly::toLowerAscii(stage);
+    addConvergenceHistogramValue(
+        fmt::format("fib.convergence_latency_ms.{}", stage),
+        *events.at(i).unixTs() - *events.at(i - 1).unixTs());
+  }
+  addConvergenceHistogramValue(
+      "fib.convergence_latency_ms", totalDuration.count());
+
+  // Keep slowest traces. Replace the fastest of them if full.
+  if (slowestPerfDb_.size() >= Constants::kPerfBufferSize and
+      isSlowerConvergence(*perfEvents, slowestPerfDb_.front())) {
+    std::pop_heap(
+        slowestPerfDb_.begin(), slowestPerfDb_.end(), isSlowerConvergence);
+    slowestPerfDb_.pop_back();
+  }
+  if (slowestPerfDb_.size() < Constants::kPerfBufferSize) {
+    slowestPerfDb_.emplace_back(*perfEvents);
+    std::push_heap(
+        slowestPerfDb_.begin(), slowestPerfDb_.end(), isSlowerConvergence);
+  }
+
   // Add new entry to perf DB and purge extra entries
   perfDb_.push_back(std::move(perfEvents).value());
   while (perfDb_.size() >= Constants::kPerfBufferSize) {
@@ -1164,6 +1553,19 @@ Fib::logPerfEvents(std::optional<thrift::PerfEvents>& perfEvents) {
   logSampleQueue_.push(sample);
 }
 
+void
+Fib::addConvergenceHistogramValue(const std::string& key, int64_t valueMs) {
+  if (convergenceHistograms_.emplace(key).second) {
+    fb303::fbData->addHistogram(
+        key,
+        kConvergenceBucketMs,
+        0,
+        std::chrono::milliseconds(Constants::kConvergenceMaxDuration).count());
+    fb303::fbData->exportHistogramPercentile(key, 50, 90, 99);
+  }
+  fb303::fbData->addHistogramValue(key, valueMs);
+}
+
 std::string
 Fib::RouteState::toStr(RouteState::State state) {
   switch (state) {
@@ -1228,6 +1630,7 @@ Fib::transitionRouteState(const RouteState::Event event) {
   if (prevState == RouteState::AWAITING && nextState == RouteState::SYNCING) {
     routeState_.unicastRoutes.clear();
     routeState_.mplsRoutes.clear();
+    ++routeState_.generation;
   }
 }
 
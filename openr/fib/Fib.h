@@ -7,12 +7,14 @@
 
 #pragma once
 
+#include <folly/container/F14Set.h>
 #include <folly/fibers/Semaphore.h>
 #include <folly/io/async/AsyncSocket.h>
 #include <folly/io/async/AsyncTimeout.h>
 
 #include <openr/common/ExponentialBackoff.h>
 #include <openr/common/OpenrEventBase.h>
+#include <openr/common/Util.h>
 #include <openr/config/Config.h>
 #include <openr/decision/RibEntry.h>
 #include <openr/decision/RouteUpdate.h>
@@ -91,6 +93,12 @@ class Fib final : public OpenrEventBase {
   folly::SemiFuture<std::unique_ptr<thrift::RouteDatabaseDetail>>
   getRouteDetailDb();
 
+  /**
+   * Retrieve route database only if it changed since `lastGeneration`
+   */
+  folly::SemiFuture<std::unique_ptr<thrift::VersionedRouteDb>>
+  getRouteDbVersioned(int64_t lastGeneration);
+
   /**
    * Retrieve unicast routes for specified prefixes or IP. Returns all if
    * no prefix is specified in filter list.
@@ -98,6 +106,16 @@ class Fib final : public OpenrEventBase {
   folly::SemiFuture<std::unique_ptr<std::vector<thrift::UnicastRoute>>>
   getUnicastRoutes(std::vector<std::string> prefixes);
 
+  /**
+   * Retrieve a page of unicast routes ordered by prefix. `keyPrefix` of
+   * request selects routes within the specified prefix. Pass the same
+   * `sortedKeys` snapshot for consecutive pages of a stream.
+   */
+  folly::SemiFuture<std::unique_ptr<thrift::UnicastRoutesPage>>
+  getUnicastRoutesPage(
+      thrift::PageRequest request,
+      PageKeysSnapshot<folly::CIDRNetwork> sortedKeys = nullptr);
+
   /**
    * Retrieve mpls routes for specified labels. Returns all if no label is
    * specified in filter list.
@@ -110,6 +128,11 @@ class Fib final : public OpenrEventBase {
    */
   folly::SemiFuture<std::unique_ptr<thrift::PerfDatabase>> getPerfDb();
 
+  /**
+   * Retrieve slowest convergence traces seen so far, slowest first
+   */
+  folly::SemiFuture<std::unique_ptr<thrift::PerfDatabase>> getSlowestPerfDb();
+
   /**
    * API to get reader for fibUpdatesQueue
    */
@@ -125,17 +148,35 @@ class Fib final : public OpenrEventBase {
   Fib(const Fib&) = delete;
   Fib& operator=(const Fib&) = delete;
 
+  /**
+   * Convert unicast and mpls routes into RouteDatabase
+   */
+  thrift::RouteDatabase dumpRouteDb() const;
+
   /**
    * Convert local perfDb_ into PerfDataBase
    */
   thrift::PerfDatabase dumpPerfDb() const;
 
+  /**
+   * Convert local slowestPerfDb_ into PerfDataBase, slowest first
+   */
+  thrift::PerfDatabase dumpSlowestPerfDb() const;
+
   /**
    * Retrieve unicast routes with specified filters
    */
   std::vector<thrift::UnicastRoute> getUnicastRoutesFiltered(
       std::vector<std::string> prefixes);
 
+  /**
+   * Retrieve a page of unicast routes. Throws thrift::OpenrError on malformed
+   * cursor or prefix range.
+   */
+  thrift::UnicastRoutesPage getUnicastRoutesPageInternal(
+      const thrift::PageRequest& request,
+      std::vector<folly::CIDRNetwork>* sortedKeys = nullptr) const;
+
   /**
    * Retrieve mpls routes with specified filters
    */
@@ -162,34 +203,96 @@ class Fib final : public OpenrEventBase {
       bool useDeleteDelay = true);
 
   /**
-   * The helper function of updateRoutes that programs unicast routes. On route
-   * programming failure, prefixes are marked dirty and retryRoutesSignal is
-   * invoked. If useDeleteDelay is false, delete routes without putting them in
-   * dirtyPrefixes (i.e., don't delay programming). Otherwise, delay deletion
-   * based on configured duration.
-   * @return true if all routes are successfully programmed
+   * A bounded batch of route keys of a single type programmed with one
+   * FibService call. Routes are looked up from the update being programmed
+   * when the batch is sent.
+   */
+  struct RouteBatch {
+    enum Type {
+      UNICAST_DELETE = 0,
+      UNICAST_ADD = 1,
+      MPLS_DELETE = 2,
+      MPLS_ADD = 3,
+    };
+    Type type{UNICAST_DELETE};
+    std::vector<folly::CIDRNetwork> prefixes;
+    std::vector<int32_t> labels;
+  };
+
+  /**
+   * Programming order of unicast route updates, lowest value first. Reduces
+   * blackholing of traffic-carrying routes on large route churn.
    */
-  bool updateUnicastRoutes(
+  enum RoutePriority {
+    // Route deletes & routes losing nexthops i.e. repair of dead nexthops
+    REPAIR = 0,
+    // Routes matching configured priority prefixes or tags
+    PRIORITY = 1,
+    // Everything else
+    DEFAULT = 2,
+  };
+  static constexpr size_t kNumRoutePriorities{3};
+  using UnicastKeyQueues =
+      std::array<std::deque<folly::CIDRNetwork>, kNumRoutePriorities>;
+
+  /**
+   * Get priority of unicast route add/update. Must be invoked before
+   * routeState_ is updated, as a route losing nexthops w.r.t. the current
+   * route in routeState_ is prioritized for repair.
+   */
+  RoutePriority getRoutePriority(const RibUnicastEntry& route) const;
+
+  /**
+   * The helper function of updateRoutes that queues route keys of the update
+   * for programming and marks them PENDING in routeState_. Unicast keys are
+   * queued by their priority. If useDeleteDelay is true and delayed deletion
+   * is enabled, deletes are not queued but put in dirtyPrefixes/dirtyLabels to
+   * be programmed after the configured duration. Keys already PENDING are not
+   * queued twice.
+   */
+  void enqueueRouteKeys(
       const bool useDeleteDelay,
       const std::chrono::time_point<std::chrono::steady_clock>& currentTime,
-      const std::chrono::time_point<std::chrono::steady_clock>& retryAt,
-      DecisionRouteUpdate& routeUpdate,
-      thrift::RouteDatabaseDelta& routeDbDelta);
+      const DecisionRouteUpdate& routeUpdate,
+      UnicastKeyQueues& unicastKeys,
+      std::deque<int32_t>& mplsKeys);
 
   /**
-   * The helper function of updateRoutes that programs MPLS routes. On route
-   * programming failure, labels are marked dirty and retryRoutesSignal is
-   * invoked. If useDeleteDelay is false, delete routes without putting them in
-   * dirtyLabels (i.e., don't delay programming). Otherwise, delay deletion
-   * based on configured duration.
+   * The helper function of updateRoutes that sends next wave of batches from
+   * the queued keys in order of priority, with up to `kFibMaxInflightBatches`
+   * batches in flight to the FibService, and waits for all of them to be
+   * acknowledged. On route programming failure, keys are marked dirty and
+   * failed add/updates are turned into deletes of `routeUpdate`.
    * @return true if all routes are successfully programmed
    */
-  bool updateMplsRoutes(
-      const bool useDeleteDelay,
-      const std::chrono::time_point<std::chrono::steady_clock>& currentTime,
+  bool programRouteBatches(
       const std::chrono::time_point<std::chrono::steady_clock>& retryAt,
       DecisionRouteUpdate& routeUpdate,
-      thrift::RouteDatabaseDelta& routeDbDelta);
+      UnicastKeyQueues& unicastKeys,
+      std::deque<int32_t>& mplsKeys);
+
+  /**
+   * Issue FibService call for a single batch. Completes immediately in dryrun.
+   */
+  folly::SemiFuture<folly::Unit> sendRouteBatch(
+      const DecisionRouteUpdate& routeUpdate, const RouteBatch& batch);
+
+  /**
+   * Merge Decision updates received while programming is in progress into
+   * the update being programmed. Routes of not yet sent keys are replaced
+   * in-place, others are queued again.
+   */
+  void mergePendingRouteUpdates(
+      DecisionRouteUpdate& routeUpdate,
+      UnicastKeyQueues& unicastKeys,
+      std::deque<int32_t>& mplsKeys);
+
+  /**
+   * Program route updates from Decision queued by the reader fiber. Runs as
+   * a separate fiber so that reading (and coalescing) of Decision updates
+   * overlaps with route programming.
+   */
+  void routeProgrammingTask(folly::fibers::Baton& stopSignal) noexcept;
 
   /**
    * Sync the current RouteState with the switch agent.
@@ -226,9 +329,18 @@ class Fib final : public OpenrEventBase {
   void updateGlobalCounters();
 
   /**
-   * Create, log, and publish Open/R convergence event through LogSampleQueue
+   * Create, log, and publish Open/R convergence event through LogSampleQueue.
+   * Time spent in each stage, i.e. since previous event, is aggregated into
+   * per-stage histograms `fib.convergence_latency_ms.<stage>`. Overall
+   * duration goes to `fib.convergence_latency_ms` histogram, next to the
+   * `fib.convergence_time_ms` average.
    */
-  void logPerfEvents(std::optional<thrift::PerfEvents>& perfEvents);
+  void logPerfEvents(std::optional<thrift::PerfEvents> perfEvents);
+
+  /**
+   * Add value to convergence histogram, registering it on first use
+   */
+  void addConvergenceHistogramValue(const std::string& key, int64_t valueMs);
 
   /**
    * State variables to represent computed and programmed routes.
@@ -238,6 +350,9 @@ class Fib final : public OpenrEventBase {
     std::unordered_map<folly::CIDRNetwork, RibUnicastEntry> unicastRoutes;
     std::unordered_map<int32_t, RibMplsEntry> mplsRoutes;
 
+    // Generation of unicast and mpls routes, changes on every update of them
+    int64_t generation{getInitialGeneration()};
+
     /**
      * Set of route keys (prefixes & labels) that needs to be updated in HW. Two
      * reasons for dirty marking
@@ -256,6 +371,19 @@ class Fib final : public OpenrEventBase {
         std::chrono::time_point<std::chrono::steady_clock>>
         dirtyLabels;
 
+    /**
+     * Programming (ack) state of route keys of the update being programmed.
+     * A key is PENDING until it is sent to FibService in a batch and INFLIGHT
+     * until the batch is acknowledged, after which it is removed (and marked
+     * dirty on failure). Newer routes for PENDING keys are merged in-place.
+     */
+    enum AckState {
+      PENDING = 0,
+      INFLIGHT = 1,
+    };
+    std::unordered_map<folly::CIDRNetwork, AckState> unicastAckState;
+    std::unordered_map<int32_t, AckState> mplsAckState;
+
     /**
      * Enumeration depicting the route event that may arrive and affect `State`
      */
@@ -348,6 +476,13 @@ class Fib final : public OpenrEventBase {
   // Events to capture and indicate performance of protocol convergence.
   std::deque<thrift::PerfEvents> perfDb_;
 
+  // Slowest convergence traces seen so far. Min-heap on total duration,
+  // bounded to `Constants::kPerfBufferSize`.
+  std::vector<thrift::PerfEvents> slowestPerfDb_;
+
+  // Convergence histograms registered with fb303
+  folly::F14FastSet<std::string> convergenceHistograms_;
+
   // Create timestamp of recently logged perf event
   int64_t recentPerfEventCreateTs_{0};
 
@@ -369,6 +504,10 @@ class Fib final : public OpenrEventBase {
   // deleting a a route (both unicast and mpls).
   const std::chrono::milliseconds routeDeleteDelay_{0};
 
+  // Config knob - Prefixes and tags of routes to be programmed with priority
+  std::vector<folly::CIDRNetwork> priorityPrefixes_;
+  std::unordered_set<std::string> priorityTags_;
+
   // Thrift client connection to switch FIB Agent using which we actually
   // manipulate routes.
   folly::AsyncSocket* socket_{nullptr};
@@ -385,6 +524,15 @@ class Fib final : public OpenrEventBase {
   // Stop signal for KeepAlive fiber
   folly::fibers::Baton keepAliveStopSignal_;
 
+  // State variables for RouteProgramming fiber.
+  // - Stop signal to terminate routeProgrammingFiber, sent only once
+  // - Semaphore used for signalling when Decision updates are pending
+  // - Decision updates received but not yet programmed. Newer updates are
+  //   coalesced into the last one
+  folly::fibers::Baton routeProgrammingStopSignal_;
+  folly::fibers::Semaphore routeProgrammingSignal_{0};
+  std::deque<DecisionRouteUpdate> pendingRouteUpdates_;
+
   // Queues to publish programmed incremental IP/label routes or those from Fib
   // sync. (Fib streaming)
   messaging::ReplicateQueue<DecisionRouteUpdate>& fibRouteUpdatesQueue_;
@@ -5,6 +5,7 @@
  * LICENSE file in the root directory of this source tree.
  */
 
+#include <fb303/ServiceData.h>
 #include <folly/init/Init.h>
 #include <glog/logging.h>
 #include <gmock/gmock.h>
@@ -12,6 +13,8 @@
 #include <thrift/lib/cpp2/server/ThriftServer.h>
 #include <thrift/lib/cpp2/util/ScopedServerThread.h>
 
+#include <openr/common/Constants.h>
+#include <openr/common/LsdbUtil.h>
 #include <openr/common/NetworkUtil.h>
 #include <openr/config/Config.h>
 #include <openr/ctrl-server/OpenrCtrlHandler.h>
@@ -327,16 +330,7 @@ class FibTestFixture : public ::testing::Test {
 
     fibThriftThread.start(server);
 
-    auto tConfig = getBasicOpenrConfig(
-        "node-1",
-        {}, /* area config */
-        true, /* enableV4 */
-        true, /* enableSegmentRouting */
-        false /* dryrun */);
-    tConfig.route_delete_delay_ms() = routeDeleteDelay_;
-    tConfig.fib_port() = fibThriftThread.getAddress()->getPort();
-
-    config_ = std::make_shared<Config>(tConfig);
+    config_ = std::make_shared<Config>(createConfig());
 
     fib_ = std::make_shared<Fib>(
         config_,
@@ -399,6 +393,19 @@ class FibTestFixture : public ::testing::Test {
     LOG(INFO) << "Mock fib platform is stopped";
   }
 
+  virtual thrift::OpenrConfig
+  createConfig() {
+    auto tConfig = getBasicOpenrConfig(
+        "node-1",
+        {}, /* area config */
+        true, /* enableV4 */
+        true, /* enableSegmentRouting */
+        false /* dryrun */);
+    tConfig.route_delete_delay_ms() = routeDeleteDelay_;
+    tConfig.fib_port() = fibThriftThread.getAddress()->getPort();
+    return tConfig;
+  }
+
   thrift::RouteDatabase
   getRouteDb() {
     auto resp = handler_->semifuture_getRouteDb().get();
@@ -1076,6 +1083,376 @@ TEST_F(FibTestFixture, processRouteDb) {
       checkEqualRouteDatabaseUnicastDetail(routeDetailDb, getRouteDetailDb()));
 }
 
+/**
+ * Verify that route update exceeding the batch size is programmed in multiple
+ * batches, and published only once after all of them got acknowledged.
+ */
+TEST_F(FibTestFixture, BatchedRouteProgramming) {
+  // initial syncFib debounce
+  routeUpdatesQueue.push(DecisionRouteUpdate());
+  mockFibHandler_->waitForSyncFib();
+  fibRouteUpdatesQueueReader.get().value();
+
+  const size_t numRoutes = Constants::kFibProgrammingBatchSize * 2 + 1;
+  DecisionRouteUpdate routeUpdate;
+  for (size_t i = 0; i < numRoutes; ++i) {
+    auto prefix = toIpPrefix(fmt::format("fc00::{:x}/128", i + 1));
+    routeUpdate.addRouteToUpdate(RibUnicastEntry(
+        toIPNetwork(prefix),
+        {path1_2_1, path1_2_2},
+        createPrefixEntry(prefix),
+        "0"));
+  }
+  routeUpdatesQueue.push(routeUpdate);
+
+  // Single publication for all batches
+  auto fibUpdate = fibRouteUpdatesQueueReader.get().value();
+  EXPECT_EQ(numRoutes, fibUpdate.unicastRoutesToUpdate.size());
+  EXPECT_EQ(numRoutes, mockFibHandler_->getAddRoutesCount());
+
+  std::vector<thrift::UnicastRoute> routes;
+  mockFibHandler_->getRouteTableByClient(routes, kFibId);
+  EXPECT_EQ(numRoutes, routes.size());
+
+  // Withdraw all of them. Deletion is advertised right away, and programmed
+  // in batches after route delete delay.
+  DecisionRouteUpdate deleteUpdate;
+  for (auto const& [prefix, _] : routeUpdate.unicastRoutesToUpdate) {
+    deleteUpdate.unicastRoutesToDelete.emplace_back(prefix);
+  }
+  routeUpdatesQueue.push(deleteUpdate);
+  fibUpdate = fibRouteUpdatesQueueReader.get().value();
+  EXPECT_EQ(numRoutes, fibUpdate.unicastRoutesToDelete.size());
+  EXPECT_EQ(0, mockFibHandler_->getDelRoutesCount());
+
+  fibUpdate = fibRouteUpdatesQueueReader.get().value();
+  EXPECT_EQ(numRoutes, fibUpdate.unicastRoutesToDelete.size());
+  EXPECT_EQ(numRoutes, mockFibHandler_->getDelRoutesCount());
+
+  mockFibHandler_->getRouteTableByClient(routes, kFibId);
+  EXPECT_EQ(0, routes.size());
+}
+
+/**
+ * Verify that a failure in one batch only marks its failed routes as dirty.
+ * Retry programs only those, while routes of other batches stay programmed.
+ */
+TEST_F(FibTestFixture, BatchedRouteProgrammingPartialFailure) {
+  // initial syncFib debounce
+  routeUpdatesQueue.push(DecisionRouteUpdate());
+  mockFibHandler_->waitForSyncFib();
+  fibRouteUpdatesQueueReader.get().value();
+  mockFibHandler_->clearUnicastCalls();
+
+  const size_t numRoutes = Constants::kFibProgrammingBatchSize + 1;
+  DecisionRouteUpdate routeUpdate;
+  for (size_t i = 0; i < numRoutes; ++i) {
+    auto prefix = toIpPrefix(fmt::format("fc00:3::{:x}/128", i + 1));
+    routeUpdate.addRouteToUpdate(RibUnicastEntry(
+        toIPNetwork(prefix), {path1_2_1}, createPrefixEntry(prefix), "0"));
+  }
+  const auto failedPrefix = toIPNetwork(toIpPrefix("fc00:3::1/128"));
+  mockFibHandler_->setDirtyState({failedPrefix}, {});
+  routeUpdatesQueue.push(routeUpdate);
+
+  // Failed route is withdrawn, all others are programmed
+  auto fibUpdate = fibRouteUpdatesQueueReader.get().value();
+  EXPECT_EQ(numRoutes - 1, fibUpdate.unicastRoutesToUpdate.size());
+  EXPECT_EQ(0, fibUpdate.unicastRoutesToUpdate.count(failedPrefix));
+  EXPECT_THAT(
+      fibUpdate.unicastRoutesToDelete, testing::ElementsAre(failedPrefix));
+
+  // Keep failing until dirty state is cleared, then failed route is retried
+  // successfully on its own
+  mockFibHandler_->setDirtyState({}, {});
+  while (true) {
+    fibUpdate = fibRouteUpdatesQueueReader.get().value();
+    if (fibUpdate.unicastRoutesToUpdate.count(failedPrefix)) {
+      break;
+    }
+    EXPECT_TRUE(fibUpdate.unicastRoutesToUpdate.empty());
+    EXPECT_THAT(
+        fibUpdate.unicastRoutesToDelete, testing::ElementsAre(failedPrefix));
+  }
+  EXPECT_EQ(1, fibUpdate.unicastRoutesToUpdate.size());
+  EXPECT_TRUE(fibUpdate.unicastRoutesToDelete.empty());
+
+  // Two batches were sent in first wave, retries only carry failed route
+  auto calls = mockFibHandler_->getUnicastCalls();
+  ASSERT_LE(3, calls.size());
+  std::unordered_set<folly::CIDRNetwork> firstWavePrefixes;
+  for (size_t i = 0; i < 2; ++i) {
+    EXPECT_TRUE(calls.at(i).isAdd);
+    EXPECT_GE(Constants::kFibProgrammingBatchSize, calls.at(i).prefixes.size());
+    firstWavePrefixes.insert(
+        calls.at(i).prefixes.begin(), calls.at(i).prefixes.end());
+  }
+  EXPECT_EQ(numRoutes, firstWavePrefixes.size());
+  for (size_t i = 2; i < calls.size(); ++i) {
+    EXPECT_TRUE(calls.at(i).isAdd);
+    EXPECT_THAT(calls.at(i).prefixes, testing::ElementsAre(failedPrefix));
+  }
+
+  std::vector<thrift::UnicastRoute> routes;
+  mockFibHandler_->getRouteTableByClient(routes, kFibId);
+  EXPECT_EQ(numRoutes, routes.size());
+}
+
+/**
+ * Verify that deletes and adds of one update are never mixed in a batch, and
+ * that delayed deletes are only sent after all add batches got acknowledged.
+ */
+TEST_F(FibTestFixture, BatchedRouteProgrammingDeleteAfterAdd) {
+  // initial syncFib debounce
+  routeUpdatesQueue.push(DecisionRouteUpdate());
+  mockFibHandler_->waitForSyncFib();
+  fibRouteUpdatesQueueReader.get().value();
+
+  const size_t numRoutes = Constants::kFibProgrammingBatchSize + 1;
+  auto createUpdate = [&](const std::string& subnet) {
+    DecisionRouteUpdate routeUpdate;
+    for (size_t i = 0; i < numRoutes; ++i) {
+      auto prefix = toIpPrefix(fmt::format("{}{:x}/128", subnet, i + 1));
+      routeUpdate.addRouteToUpdate(RibUnicastEntry(
+          toIPNetwork(prefix), {path1_2_1}, createPrefixEntry(prefix), "0"));
+    }
+    return routeUpdate;
+  };
+  auto oldRoutes = createUpdate("fc00:4::");
+  routeUpdatesQueue.push(oldRoutes);
+  fibRouteUpdatesQueueReader.get().value();
+  mockFibHandler_->clearUnicastCalls();
+
+  // Replace all old routes with new ones in a single update
+  auto routeUpdate = createUpdate("fc00:5::");
+  for (auto const& [prefix, _] : oldRoutes.unicastRoutesToUpdate) {
+    routeUpdate.unicastRoutesToDelete.emplace_back(prefix);
+  }
+  routeUpdatesQueue.push(routeUpdate);
+
+  // New routes are programmed right away, old ones after route delete delay
+  auto fibUpdate = fibRouteUpdatesQueueReader.get().value();
+  EXPECT_EQ(numRoutes, fibUpdate.unicastRoutesToUpdate.size());
+  EXPECT_EQ(numRoutes, fibUpdate.unicastRoutesToDelete.size());
+  fibUpdate = fibRouteUpdatesQueueReader.get().value();
+  EXPECT_TRUE(fibUpdate.unicastRoutesToUpdate.empty());
+  EXPECT_EQ(numRoutes, fibUpdate.unicastRoutesToDelete.size());
+
+  // All add batches come first, followed by delete batches
+  std::unordered_set<folly::CIDRNetwork> addedPrefixes, deletedPrefixes;
+  for (auto const& call : mockFibHandler_->getUnicastCalls()) {
+    EXPECT_GE(Constants::kFibProgrammingBatchSize, call.prefixes.size());
+    if (call.isAdd) {
+      EXPECT_TRUE(deletedPrefixes.empty());
+      addedPrefixes.insert(call.prefixes.begin(), call.prefixes.end());
+    } else {
+      deletedPrefixes.insert(call.prefixes.begin(), call.prefixes.end());
+    }
+  }
+  EXPECT_EQ(numRoutes, addedPrefixes.size());
+  EXPECT_EQ(numRoutes, deletedPrefixes.size());
+  for (auto const& [prefix, _] : routeUpdate.unicastRoutesToUpdate) {
+    EXPECT_EQ(1, addedPrefixes.count(prefix));
+  }
+  for (auto const& prefix : routeUpdate.unicastRoutesToDelete) {
+    EXPECT_EQ(1, deletedPrefixes.count(prefix));
+  }
+
+  // Only new routes are left
+  std::vector<thrift::UnicastRoute> routes;
+  mockFibHandler_->getRouteTableByClient(routes, kFibId);
+  ASSERT_EQ(numRoutes, routes.size());
+  for (auto const& route : routes) {
+    EXPECT_EQ(
+        1, routeUpdate.unicastRoutesToUpdate.count(toIPNetwork(*route.dest())));
+  }
+}
+
+/**
+ * Verify that a FULL_SYNC update from Decision, which is a delta as well, is
+ * merged with a pending INCREMENTAL one without losing any of its adds or
+ * deletes. Both programmed routes and published updates must reflect them.
+ */
+TEST_F(FibTestFixture, IncrementalThenFullSyncUpdate) {
+  // initial syncFib debounce
+  routeUpdatesQueue.push(DecisionRouteUpdate());
+  mockFibHandler_->waitForSyncFib();
+  fibRouteUpdatesQueueReader.get().value();
+
+  DecisionRouteUpdate routeUpdate;
+  routeUpdate.addRouteToUpdate(
+      RibUnicastEntry(toIPNetwork(prefix1), {path1_2_1}));
+  routeUpdatesQueue.push(std::move(routeUpdate));
+  fibRouteUpdatesQueueReader.get().value();
+
+  // Back to back updates, likely coalesced by Fib
+  DecisionRouteUpdate incrementalUpdate;
+  incrementalUpdate.addRouteToUpdate(
+      RibUnicastEntry(toIPNetwork(prefix2), {path1_2_1}));
+  incrementalUpdate.unicastRoutesToDelete.emplace_back(toIPNetwork(prefix1));
+  DecisionRouteUpdate fullSyncUpdate;
+  fullSyncUpdate.type = DecisionRouteUpdate::FULL_SYNC;
+  fullSyncUpdate.addRouteToUpdate(
+      RibUnicastEntry(toIPNetwork(prefix3), {path1_2_2}));
+  routeUpdatesQueue.push(incrementalUpdate);
+  routeUpdatesQueue.push(fullSyncUpdate);
+
+  // Published updates carry all adds & deletes, whether coalesced or not
+  DecisionRouteUpdate published;
+  while (not published.unicastRoutesToUpdate.count(toIPNetwork(prefix3))) {
+    auto fibUpdate = fibRouteUpdatesQueueReader.get().value();
+    EXPECT_EQ(DecisionRouteUpdate::INCREMENTAL, fibUpdate.type);
+    EXPECT_TRUE(published.coalesce(fibUpdate));
+  }
+  EXPECT_EQ(2, published.unicastRoutesToUpdate.size());
+  EXPECT_EQ(1, published.unicastRoutesToUpdate.count(toIPNetwork(prefix2)));
+  EXPECT_THAT(
+      published.unicastRoutesToDelete,
+      testing::ElementsAre(toIPNetwork(prefix1)));
+
+  // prefix1 is deleted after route delete delay, others stay programmed
+  mockFibHandler_->waitForDeleteUnicastRoutes();
+  std::vector<thrift::UnicastRoute> routes;
+  mockFibHandler_->getRouteTableByClient(routes, kFibId);
+  std::unordered_set<folly::CIDRNetwork> programmed;
+  for (auto const& route : routes) {
+    programmed.emplace(toIPNetwork(*route.dest()));
+  }
+  EXPECT_THAT(
+      programmed,
+      testing::UnorderedElementsAre(
+          toIPNetwork(prefix2), toIPNetwork(prefix3)));
+
+  // Fib state matches programmed routes
+  auto routeDb = getRouteDb();
+  EXPECT_EQ(2, routeDb.unicastRoutes()->size());
+}
+
+class FibPriorityTestFixture : public FibTestFixture {
+ public:
+  thrift::OpenrConfig
+  createConfig() override {
+    auto tConfig = FibTestFixture::createConfig();
+    thrift::FibPriorityConfig priorityConfig;
+    priorityConfig.priority_prefixes() = {"fc00:1::/32"};
+    priorityConfig.priority_tags() = {"PRIORITY"};
+    tConfig.fib_priority_config() = std::move(priorityConfig);
+    return tConfig;
+  }
+};
+
+/**
+ * Verify that routes of an update are programmed in order of priority i.e.
+ * routes losing nexthops first, then routes matching priority prefixes or
+ * tags, and everything else last.
+ */
+TEST_F(FibPriorityTestFixture, RouteProgrammingOrder) {
+  // initial syncFib debounce
+  routeUpdatesQueue.push(DecisionRouteUpdate());
+  mockFibHandler_->waitForSyncFib();
+  fibRouteUpdatesQueueReader.get().value();
+
+  DecisionRouteUpdate routeUpdate;
+  routeUpdate.addRouteToUpdate(
+      RibUnicastEntry(toIPNetwork(prefix1), {path1_2_1, path1_2_2}));
+  routeUpdatesQueue.push(std::move(routeUpdate));
+  fibRouteUpdatesQueueReader.get().value();
+  mockFibHandler_->clearUnicastCalls();
+
+  // Update carrying routes of all priorities
+  const auto repairPrefix = toIPNetwork(prefix1);
+  const auto priorityPrefix = toIPNetwork(toIpPrefix("fc00:1::1/128"));
+  const auto taggedPrefix = toIPNetwork(prefix3);
+  std::vector<folly::CIDRNetwork> defaultPrefixes;
+  routeUpdate = DecisionRouteUpdate();
+  for (size_t i = 0; i < 8; ++i) {
+    auto prefix = toIpPrefix(fmt::format("fc00:2::{:x}/128", i + 1));
+    defaultPrefixes.emplace_back(toIPNetwork(prefix));
+    routeUpdate.addRouteToUpdate(RibUnicastEntry(
+        toIPNetwork(prefix), {path1_2_1}, createPrefixEntry(prefix), "0"));
+  }
+  auto taggedEntry = createPrefixEntry(prefix3);
+  taggedEntry.tags() = {"PRIORITY"};
+  routeUpdate.addRouteToUpdate(
+      RibUnicastEntry(taggedPrefix, {path1_2_1}, taggedEntry, "0"));
+  routeUpdate.addRouteToUpdate(RibUnicastEntry(
+      priorityPrefix,
+      {path1_2_1},
+      createPrefixEntry(toIpPrefix("fc00:1::1/128")),
+      "0"));
+  // prefix1 loses path1_2_2
+  routeUpdate.addRouteToUpdate(RibUnicastEntry(repairPrefix, {path1_2_1}));
+  routeUpdatesQueue.push(std::move(routeUpdate));
+  fibRouteUpdatesQueueReader.get().value();
+
+  // All of them fit into one batch, in order of priority
+  auto calls = mockFibHandler_->getUnicastCalls();
+  ASSERT_EQ(1, calls.size());
+  EXPECT_TRUE(calls.at(0).isAdd);
+  auto const& prefixes = calls.at(0).prefixes;
+  ASSERT_EQ(3 + defaultPrefixes.size(), prefixes.size());
+  EXPECT_EQ(repairPrefix, prefixes.at(0));
+  const std::vector<folly::CIDRNetwork> priorityPrefixes(
+      prefixes.begin() + 1, prefixes.begin() + 3);
+  EXPECT_THAT(
+      priorityPrefixes,
+      testing::UnorderedElementsAre(priorityPrefix, taggedPrefix));
+  const std::vector<folly::CIDRNetwork> remainingPrefixes(
+      prefixes.begin() + 3, prefixes.end());
+  EXPECT_THAT(
+      remainingPrefixes, testing::UnorderedElementsAreArray(defaultPrefixes));
+}
+
+TEST_F(FibTestFixture, ConvergenceTracing) {
+  // initial syncFib debounce
+  routeUpdatesQueue.push(DecisionRouteUpdate());
+  mockFibHandler_->waitForSyncFib();
+  fibRouteUpdatesQueueReader.get().value();
+
+  // Route update carrying trace of Decision
+  DecisionRouteUpdate routeUpdate;
+  routeUpdate.addRouteToUpdate(
+      RibUnicastEntry(toIPNetwork(prefix1), {path1_2_1, path1_2_2}));
+  thrift::PerfEvents perfEvents;
+  addPerfEvent(perfEvents, "node1", "DECISION_RECEIVED");
+  addPerfEvent(perfEvents, "node1", "ROUTE_UPDATE");
+  routeUpdate.perfEvents = perfEvents;
+  routeUpdatesQueue.push(std::move(routeUpdate));
+  fibRouteUpdatesQueueReader.get().value();
+
+  // Trace is concluded with Fib stages once routes are programmed
+  const std::vector<std::string> expectedEvents{
+      "DECISION_RECEIVED",
+      "ROUTE_UPDATE",
+      "FIB_ROUTE_DB_RECVD",
+      "FIB_ROUTES_PROGRAMMING",
+      "OPENR_FIB_ROUTES_PROGRAMMED"};
+  for (auto const& perfDb :
+       {fib_->getPerfDb().get(), fib_->getSlowestPerfDb().get()}) {
+    ASSERT_EQ(1, perfDb->eventInfo()->size());
+    std::vector<std::string> events;
+    for (auto const& event : *perfDb->eventInfo()->at(0).events()) {
+      events.emplace_back(*event.eventDescr());
+    }
+    EXPECT_EQ(expectedEvents, events);
+  }
+
+  // Per-stage histograms are exported
+  auto counters = facebook::fb303::fbData->getCounters();
+  for (auto const& stage :
+       {"route_update",
+        "fib_routes_programming",
+        "openr_fib_routes_programmed"}) {
+    EXPECT_EQ(
+        1,
+        counters.count(
+            fmt::format("fib.convergence_latency_ms.{}.p99", stage)))
+        << stage;
+  }
+  EXPECT_EQ(1, counters.count("fib.convergence_latency_ms.p99"));
+  EXPECT_EQ(1, counters.count("fib.convergence_time_ms.avg"));
+}
+
 TEST_F(FibTestFixture, WaitOnDecision) {
   // Make sure fib starts with clean route database
   std::vector<thrift::UnicastRoute> routes;
@@ -415,6 +415,9 @@ struct KvStoreConfig {
   13: optional string x509_ca_path;
   /** Knob to enable/disable TLS thrift client. */
   14: bool enable_secure_thrift_client = false;
+
+  /** Run KvStoreDb of every area on its own event base and thread */
+  15: bool enable_per_area_event_base = false;
 } (cpp.minimize_padding)
 
 /**
@@ -86,6 +86,14 @@ struct KvstoreConfig {
    */
   6: optional list<string> key_prefix_filters;
   7: optional list<string> key_originator_id_filters;
+
+  /**
+   * Run the KvStore database of every area on its own event base and thread,
+   * instead of sharing KvStore's single event base. Full-sync storms or large
+   * floods in one area then don't delay flooding and TTL processing in the
+   * other areas. Only useful with multiple areas.
+   */
+  8: bool enable_per_area_event_base = false;
 } (cpp.minimize_padding)
 
 /*
@@ -186,6 +194,23 @@ struct LinkMonitorConfig {
   * Enable convergence performance measurement for adjacency updates.
   */
   7: bool enable_perf_measurement = true;
+
+  /**
+   * [RTT damping] Hysteresis on RTT re-advertisement. A new RTT is only
+   * advertised if its RTT metric deviates from the advertised one by more
+   * than this percentage, e.g. 10 ignores jitter within +/-10%. 0 advertises
+   * every change. Only applies if `use_rtt_metric` is set. Adjacency metric
+   * is derived from RTT at adjacency up and not affected by RTT changes.
+   */
+  8: i32 rtt_metric_change_threshold_pct = 10;
+
+  /**
+   * [RTT damping] Minimum time between two advertised RTT changes of an
+   * adjacency, counted from adjacency up. Changes within the hold time are
+   * deferred, only the latest is advertised once it expires. Deferred changes
+   * of all neighbors are advertised in one batch. 0 disables holding.
+   */
+  9: i32 rtt_metric_hold_time_ms = 5000;
 }
 
 struct StepDetectorConfig {
@@ -675,6 +700,28 @@ struct BgpRouteTranslationConfig {
   12: map<i32, string> igp_cost_to_community;
 } (cpp.minimize_padding)
 
+/**
+ * Ordering of incremental route programming in Fib. Route updates are
+ * programmed by class:
+ * 1. Route deletes and routes losing nexthops (repair of dead nexthops)
+ * 2. Routes for prefixes within `priority_prefixes` or tagged with any of
+ *    `priority_tags` e.g. default route, loopbacks, high-traffic aggregates
+ * 3. Everything else
+ */
+struct FibPriorityConfig {
+  /**
+   * Prefixes (in CIDR format) whose routes, including more specifics, are
+   * programmed with priority
+   */
+  1: list<string> priority_prefixes = [];
+
+  /**
+   * Routes whose best prefix entry carries any of these tags are programmed
+   * with priority
+   */
+  2: list<string> priority_tags = [];
+}
+
 struct OpenrConfig {
   1: string node_name;
   3: list<AreaConfig> areas = [];
@@ -886,6 +933,32 @@ struct OpenrConfig {
    */
   61: bool enable_ucmp = false;
 
+  /**
+   * Number of prefix bundles (KvStore keys) to spread self-originated prefixes
+   * across. If set, PrefixManager packs prefix entries into sharded
+   * `prefix:<node>:bundle:<shard>` keys instead of one key per (prefix, area),
+   * cutting per-key TTL refresh, hashing and flooding overhead for nodes
+   * originating a large number of prefixes. Shard assignment is stable, so a
+   * change of one prefix rewrites exactly one bundle. 0 disables bundling.
+   */
+  62: i32 prefix_bundle_shards = 0;
+
+  /**
+   * Classes of routes to be programmed ahead of others by Fib. Reduces time
+   * to repair traffic-carrying routes on failures with large route churn.
+   */
+  63: optional FibPriorityConfig fib_priority_config;
+
+  /**
+   * Number of shards (KvStore keys) to spread the adjacency database of this
+   * node across. If set, LinkMonitor advertises `adj:<node>:shard:<shard>`
+   * keys instead of a single `adj:<node>` key. Adjacencies are assigned to
+   * shards by neighbor name, hence a change of one adjacency (e.g. RTT) only
+   * re-floods and re-parses one shard on high radix nodes. 0 disables
+   * sharding.
+   */
+  64: i32 adj_db_shards = 0;
+
   # vip thrift injection service
   90: optional bool enable_vip_service;
   91: optional vip_service_config.VipServiceConfig vip_service_config;
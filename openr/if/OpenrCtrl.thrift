@@ -78,6 +78,14 @@ struct StreamSubscriberInfo {
   3: i64 last_msg_sent_time;
   // Total number of messages streamed
   4: i64 total_streamed_msgs;
+  // Bytes of updates published, but not yet pulled by the subscriber
+  5: optional i64 pending_bytes;
+  // Time since the oldest update not yet pulled by the subscriber, in msecs
+  6: optional i64 lag_ms;
+  // Total bytes (keys & values) streamed
+  7: optional i64 total_streamed_bytes;
+  // Number of resync snapshots sent because subscriber fell too far behind
+  8: optional i64 num_resyncs;
 }
 
 //
@@ -239,6 +247,83 @@ struct RouteDatabaseDeltaDetail {
   4: list<i32> mplsRoutesToDelete;
 }
 
+//
+// Pagination related data structures
+//
+
+/**
+ * Request for a single page of a large read API. Entries are returned in a
+ * stable order of their keys (prefix for routes, node name for adjacency
+ * databases and key for KvStore key-vals).
+ *
+ * - `cursor` is opaque to the client. Set it to `nextCursor` of the previous
+ *   page to fetch the next one, leave it unset to start from the beginning.
+ * - `limit` bounds the number of entries in the page. Non-positive value
+ *   selects the server default and values above the server maximum are
+ *   clamped.
+ * - `keyPrefix` restricts the entries to a key range. For route APIs it is an
+ *   IP prefix and only routes within it are returned, for others it is a
+ *   string prefix of the key.
+ */
+struct PageRequest {
+  1: optional string cursor;
+  2: i32 limit = 0;
+  3: optional string keyPrefix;
+}
+
+/**
+ * Pages of the respective read APIs. `nextCursor` is unset on the last page.
+ */
+struct UnicastRoutesPage {
+  1: list<Network.UnicastRoute> routes;
+  2: optional string nextCursor;
+}
+
+struct ReceivedRoutesPage {
+  1: list<ReceivedRouteDetail> routes;
+  2: optional string nextCursor;
+}
+
+struct AdjacencyDbsPage {
+  1: list<Types.AdjacencyDatabase> adjDbs;
+  2: optional string nextCursor;
+}
+
+struct KeyValsPage {
+  1: KvStore.KeyVals keyVals;
+  2: optional string nextCursor;
+}
+
+//
+// Versioned read related data structures
+//
+
+/**
+ * Responses of versioned read APIs. `generation` identifies the state served
+ * by the module and changes on every update of it. Payload is left unset if
+ * the state didn't change since `lastGeneration` provided by the client, in
+ * which case client can keep using its previous copy.
+ */
+struct VersionedRouteDb {
+  1: i64 generation;
+  2: optional Types.RouteDatabase routeDb;
+}
+
+struct VersionedAdjDbs {
+  1: i64 generation;
+  2: optional Types.AdjDbs adjDbs;
+}
+
+struct VersionedPublication {
+  1: i64 generation;
+  2: optional KvStore.Publication publication;
+}
+
+struct VersionedInterfaces {
+  1: i64 generation;
+  2: optional Types.DumpLinksReply interfaces;
+}
+
 /**
  * Thrift service - exposes RPC APIs for interaction with all of Open/R's
  * modules.
@@ -381,11 +466,26 @@ service OpenrCtrl extends KvStore.KvStoreService {
     1: ReceivedRouteFilter filter,
   ) throws (1: OpenrError error);
 
+  /**
+   * Paginated variant of `getReceivedRoutes`. Routes are ordered by prefix.
+   */
+  ReceivedRoutesPage getReceivedRoutesPage(1: PageRequest request) throws (
+    1: OpenrError error,
+  );
+
   /**
    * Get route database of the current node. It is retrieved from FIB module.
    */
   Types.RouteDatabase getRouteDb() throws (1: OpenrError error);
 
+  /**
+   * Versioned variant of `getRouteDb`. Route database is only returned if it
+   * changed since `lastGeneration`.
+   */
+  VersionedRouteDb getRouteDbVersioned(1: i64 lastGeneration) throws (
+    1: OpenrError error,
+  );
+
   /**
    * Get route detailed database of the current node. It is retrieved from FIB module.
    */
@@ -421,6 +521,13 @@ service OpenrCtrl extends KvStore.KvStoreService {
    */
   list<Network.UnicastRoute> getUnicastRoutes() throws (1: OpenrError error);
 
+  /**
+   * Paginated variant of `getUnicastRoutes`. Routes are ordered by prefix.
+   */
+  UnicastRoutesPage getUnicastRoutesPage(1: PageRequest request) throws (
+    1: OpenrError error,
+  );
+
   /**
    * Get Mpls routes after applying a list of prefix filter.
    * Return all Mpls routes if the input list is empty.
@@ -452,6 +559,12 @@ service OpenrCtrl extends KvStore.KvStoreService {
 
   Types.PerfDatabase getPerfDb() throws (1: OpenrError error);
 
+  /**
+   * Get slowest convergence events seen since start, slowest first. Unlike
+   * `getPerfDb` these are not rotated out by more recent events.
+   */
+  Types.PerfDatabase getSlowestPerfDb() throws (1: OpenrError error);
+
   //
   // Decision APIs
   //
@@ -465,6 +578,14 @@ service OpenrCtrl extends KvStore.KvStoreService {
    */
   Types.AdjDbs getDecisionAdjacencyDbs() throws (1: OpenrError error);
 
+  /**
+   * Versioned variant of `getDecisionAdjacencyDbs`. Adjacency databases are
+   * only returned if any of them changed since `lastGeneration`.
+   */
+  VersionedAdjDbs getDecisionAdjacencyDbsVersioned(
+    1: i64 lastGeneration,
+  ) throws (1: OpenrError error);
+
   /**
    * Get adjacency databases of all nodes. NOTE: for ABRs, there can be more
    * than one AdjDb for a node (one per area)
@@ -485,6 +606,35 @@ service OpenrCtrl extends KvStore.KvStoreService {
     1: AdjacenciesFilter filter,
   ) throws (1: OpenrError error);
 
+  /**
+   * Paginated variant of adjacency databases of all nodes in given area.
+   * Databases are ordered by node name.
+   */
+  AdjacencyDbsPage getDecisionAdjacencyDbsPage(
+    1: string area,
+    2: PageRequest request,
+  ) throws (1: OpenrError error);
+
+  /**
+   * Paginated dump of KvStore key-vals of given area. Key-vals are ordered by
+   * key and `keyPrefix` if specified selects keys starting with it.
+   */
+  KeyValsPage getKvStoreKeyValsPage(
+    1: string area,
+    2: PageRequest request,
+  ) throws (1: KvStore.KvStoreError error);
+
+  /**
+   * Versioned variant of `getKvStoreKeyValsFilteredArea`. Key-vals are only
+   * returned if any key-val of the area changed since `lastGeneration`. TTL
+   * refreshes are not considered as change.
+   */
+  VersionedPublication getKvStoreKeyValsFilteredAreaVersioned(
+    1: KvStore.KeyDumpParams filter,
+    2: string area,
+    3: i64 lastGeneration,
+  ) throws (1: KvStore.KvStoreError error);
+
   /**
    * Long poll API to get KvStore
    * Will return true/false with our own KeyVal snapshot provided
@@ -584,6 +734,14 @@ service OpenrCtrl extends KvStore.KvStoreService {
    */
   Types.DumpLinksReply getInterfaces() throws (1: OpenrError error);
 
+  /**
+   * Versioned variant of `getInterfaces`. Link information is only returned
+   * if it changed since `lastGeneration`.
+   */
+  VersionedInterfaces getInterfacesVersioned(1: i64 lastGeneration) throws (
+    1: OpenrError error,
+  );
+
   /**
    * Get the current adjacencies information, only works for nodes with one
    * configured area.
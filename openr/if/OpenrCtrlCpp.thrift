@@ -53,4 +53,27 @@ service OpenrCtrlCpp extends OpenrCtrl.OpenrCtrl {
   OpenrCtrl.RouteDatabaseDetail, stream<
     OpenrCtrl.RouteDatabaseDeltaDetail
   > subscribeAndGetFibDetail();
+
+  /**
+   * Stream large read APIs page by page. Pages follow the same order and
+   * bounds as of respective paginated API with `request` selecting the first
+   * page. Next page is only fetched once the previous one is consumed by the
+   * client, and stream completes after the last page. Keys are snapshotted
+   * with the first page, i.e. keys added later on are not streamed.
+   * NOTE: Servers built without coroutine support stream the first page only.
+   */
+  stream<OpenrCtrl.UnicastRoutesPage> streamUnicastRoutes(
+    1: OpenrCtrl.PageRequest request,
+  );
+  stream<OpenrCtrl.ReceivedRoutesPage> streamReceivedRoutes(
+    1: OpenrCtrl.PageRequest request,
+  );
+  stream<OpenrCtrl.AdjacencyDbsPage> streamDecisionAdjacencyDbs(
+    1: string area,
+    2: OpenrCtrl.PageRequest request,
+  );
+  stream<OpenrCtrl.KeyValsPage> streamKvStoreKeyVals(
+    1: string area,
+    2: OpenrCtrl.PageRequest request,
+  );
 }
@@ -6,8 +6,10 @@
  */
 
 #include <fb303/ServiceData.h>
+#include <folly/futures/Future.h>
 #include <folly/io/async/SSLContext.h>
 #include <folly/logging/xlog.h>
+#include <folly/system/ThreadName.h>
 
 #include <openr/common/Constants.h>
 #include <openr/common/EventLogger.h>
@@ -41,9 +43,12 @@ KvStore<ClientType>::KvStore(
           kvStoreConfig.x509_ca_path().to_optional()) {
   // Schedule periodic timer for counters submission
   counterUpdateTimer_ = folly::AsyncTimeout::make(*getEvb(), [this]() noexcept {
-    for (auto& [key, val] : getGlobalCounters()) {
-      fb303::fbData->setCounter(key, val);
-    }
+    getGlobalCounters().via(getEvb()).thenValue(
+        [](std::map<std::string, int64_t>&& counters) {
+          for (auto& [key, val] : counters) {
+            fb303::fbData->setCounter(key, val);
+          }
+        });
     counterUpdateTimer_->scheduleTimeout(Constants::kCounterSubmitInterval);
   });
   counterUpdateTimer_->scheduleTimeout(Constants::kCounterSubmitInterval);
@@ -98,18 +103,42 @@ KvStore<ClientType>::KvStore(
 
   // create KvStoreDb instances
   for (auto const& area : areaIds) {
+    OpenrEventBase* evb = this;
+    if (*kvStoreConfig.enable_per_area_event_base()) {
+      evb = areaEvbs_.emplace_back(std::make_unique<OpenrEventBase>()).get();
+      evb->setEvbName(fmt::format("kvstore.{}", area));
+    }
     kvStoreDb_.emplace(
         std::piecewise_construct,
         std::forward_as_tuple(area),
         std::forward_as_tuple(
-            this,
+            evb,
             kvParams_,
             area,
             *kvStoreConfig.node_name(),
-            std::bind(&KvStore::initialKvStoreDbSynced, this)));
+            [this, area]() {
+              getEvb()->runImmediatelyOrRunInEventBaseThread(
+                  [this, area]() { initialKvStoreDbSynced(area); });
+            }));
   }
 }
 
+template <class ClientType>
+void
+KvStore<ClientType>::run() {
+  // Start dedicated per-area event bases, if any, along with our own
+  for (auto& areaEvb : areaEvbs_) {
+    areaEvbThreads_.emplace_back([evb = areaEvb.get()]() noexcept {
+      XLOG(INFO) << "Starting " << evb->getEvbName() << " thread ...";
+      folly::setThreadName(fmt::format("openr-{}", evb->getEvbName()));
+      evb->run();
+      XLOG(INFO) << evb->getEvbName() << " thread got stopped.";
+    });
+  }
+
+  OpenrEventBase::run();
+}
+
 template <class ClientType>
 void
 KvStore<ClientType>::stop() {
@@ -122,11 +151,46 @@ KvStore<ClientType>::stop() {
     }
   });
 
+  // Stop per-area event bases once their KvStoreDb is stopped
+  for (auto& areaEvb : areaEvbs_) {
+    areaEvb->stop();
+  }
+  for (auto& thread : areaEvbThreads_) {
+    thread.join();
+  }
+  areaEvbThreads_.clear();
+
   // Invoke stop method of super class
   OpenrEventBase::stop();
   XLOG(DBG1) << "KvStore event base stopped";
 }
 
+template <class ClientType>
+std::vector<OpenrEventBase*>
+KvStore<ClientType>::getAreaEventBases() const {
+  std::vector<OpenrEventBase*> evbs;
+  for (auto& areaEvb : areaEvbs_) {
+    evbs.emplace_back(areaEvb.get());
+  }
+  return evbs;
+}
+
+template <class ClientType>
+OpenrEventBase*
+KvStore<ClientType>::getAreaEvb(std::string const& areaId) {
+  // NOTE: `kvStoreDb_` is not modified after construction and is safe to look
+  // up from any thread
+  auto search = kvStoreDb_.find(areaId);
+  if (search != kvStoreDb_.end()) {
+    return search->second.getEvb();
+  }
+  if (kvStoreDb_.size() == 1) {
+    // Single area fallback, see `getAreaDbOrThrow()`
+    return kvStoreDb_.begin()->second.getEvb();
+  }
+  return this;
+}
+
 template <class ClientType>
 KvStoreDb<ClientType>&
 KvStore<ClientType>::getAreaDbOrThrow(
@@ -165,6 +229,16 @@ KvStore<ClientType>::processKeyValueRequest(KeyValueRequest&& kvRequest) {
   const auto& area = std::visit(
       [](auto&& request) -> AreaId { return request.getArea(); }, kvRequest);
 
+  // Hand the request over to the event base owning the area's KvStoreDb
+  auto* evb = getAreaEvb(area.t);
+  if (not evb->getEvb()->isInEventBaseThread()) {
+    evb->runInEventBaseThread(
+        [this, kvRequest = std::move(kvRequest)]() mutable {
+          processKeyValueRequest(std::move(kvRequest));
+        });
+    return;
+  }
+
   try {
     auto& kvStoreDb = getAreaDbOrThrow(area, "processKeyValueRequest");
     if (auto pPersistKvRequest =
@@ -224,12 +298,15 @@ KvStore<ClientType>::processPeerUpdates(PeerEvent&& event) {
     // 'initialKvStoreDbSynced()' will not publish kvStoreSynced signal, and
     // downstream modules cannot proceed to complete initialization.
     for (auto& [area, kvStoreDb] : kvStoreDb_) {
-      if (kvStoreDb.getPeerCnt() != 0) {
-        continue;
-      }
-      XLOG(INFO)
-          << fmt::format("[Initialization] Received 0 peers in area {}.", area);
-      kvStoreDb.processInitializationEvent();
+      kvStoreDb.getEvb()->runImmediatelyOrRunInEventBaseThread(
+          [&kvStoreDb = kvStoreDb, area = area]() {
+            if (kvStoreDb.getPeerCnt() != 0) {
+              return;
+            }
+            XLOG(INFO) << fmt::format(
+                "[Initialization] Received 0 peers in area {}.", area);
+            kvStoreDb.processInitializationEvent();
+          });
     }
   }
 }
@@ -240,10 +317,11 @@ KvStore<ClientType>::semifuture_getKvStoreKeyVals(
     std::string area, thrift::KeyGetParams keyGetParams) {
   folly::Promise<std::unique_ptr<thrift::Publication>> p;
   auto sf = p.getSemiFuture();
-  runInEventBaseThread([this,
-                        p = std::move(p),
-                        keyGetParams = std::move(keyGetParams),
-                        area]() mutable {
+  auto* evb = getAreaEvb(area);
+  evb->runInEventBaseThread([this,
+                             p = std::move(p),
+                             keyGetParams = std::move(keyGetParams),
+                             area]() mutable {
     XLOG(DBG3) << "Get key requested for AREA: " << area;
     try {
       auto& kvStoreDb = getAreaDbOrThrow(area, "getKvStoreKeyVals");
@@ -263,13 +341,63 @@ KvStore<ClientType>::semifuture_getKvStoreKeyVals(
   return sf;
 }
 
+template <class ClientType>
+folly::SemiFuture<std::unique_ptr<thrift::VersionedPublication>>
+KvStore<ClientType>::semifuture_dumpKvStoreKeysVersioned(
+    std::string area,
+    thrift::KeyDumpParams keyDumpParams,
+    int64_t lastGeneration) {
+  folly::Promise<int64_t> p;
+  auto sf = p.getSemiFuture();
+  auto* evb = getAreaEvb(area);
+  evb->runInEventBaseThread([this, p = std::move(p), area]() mutable {
+    try {
+      auto& kvStoreDb =
+          getAreaDbOrThrow(area, "semifuture_dumpKvStoreKeysVersioned");
+      p.setValue(kvStoreDb.getGeneration());
+    } catch (thrift::KvStoreError const& e) {
+      p.setException(e);
+    }
+  });
+
+  // Generation is read ahead of dump. Any change in between will be reported
+  // again with the next call.
+  return std::move(sf).deferValue(
+      [this,
+       area = std::move(area),
+       keyDumpParams = std::move(keyDumpParams),
+       lastGeneration](int64_t generation) mutable {
+        thrift::VersionedPublication versionedPub;
+        versionedPub.generation() = generation;
+        if (generation == lastGeneration) {
+          fb303::fbData->addStatValue(
+              "kvstore.cmd_key_dump_not_modified", 1, fb303::COUNT);
+          return folly::makeSemiFuture(
+              std::make_unique<thrift::VersionedPublication>(
+                  std::move(versionedPub)));
+        }
+        return semifuture_dumpKvStoreKeys(std::move(keyDumpParams), {area})
+            .deferValue(
+                [versionedPub = std::move(versionedPub)](
+                    std::unique_ptr<std::vector<thrift::Publication>>&&
+                        pubs) mutable {
+                  versionedPub.publication() = pubs->empty()
+                      ? thrift::Publication{}
+                      : std::move(pubs->front());
+                  return std::make_unique<thrift::VersionedPublication>(
+                      std::move(versionedPub));
+                });
+      });
+}
+
 template <class ClientType>
 folly::SemiFuture<std::unique_ptr<SelfOriginatedKeyVals>>
 KvStore<ClientType>::semifuture_dumpKvStoreSelfOriginatedKeys(
     std::string area) {
   folly::Promise<std::unique_ptr<SelfOriginatedKeyVals>> p;
   auto sf = p.getSemiFuture();
-  runInEventBaseThread([this, p = std::move(p), area]() mutable {
+  auto* evb = getAreaEvb(area);
+  evb->runInEventBaseThread([this, p = std::move(p), area]() mutable {
     XLOG(DBG3) << "Dump self originated key-vals for AREA: " << area;
     try {
       auto& kvStoreDb =
@@ -291,23 +419,23 @@ template <class ClientType>
 folly::SemiFuture<std::unique_ptr<std::vector<thrift::Publication>>>
 KvStore<ClientType>::semifuture_dumpKvStoreKeys(
     thrift::KeyDumpParams keyDumpParams, std::set<std::string> selectAreas) {
-  folly::Promise<std::unique_ptr<std::vector<thrift::Publication>>> p;
-  auto sf = p.getSemiFuture();
-  runInEventBaseThread([this,
-                        p = std::move(p),
-                        selectAreas = std::move(selectAreas),
-                        keyDumpParams = std::move(keyDumpParams)]() mutable {
-    // Empty senderID means local call.
-    XLOG(DBG3) << fmt::format(
-        "Dump all keys requested for {}, by sender: {}",
-        (selectAreas.empty()
-             ? "all areas."
-             : fmt::format("areas: {}", folly::join(", ", selectAreas))),
-        (keyDumpParams.senderId().has_value() ? keyDumpParams.senderId().value()
-                                              : ""));
-
-    auto result = std::make_unique<std::vector<thrift::Publication>>();
-    for (auto& area : selectAreas) {
+  // Empty senderID means local call.
+  XLOG(DBG3) << fmt::format(
+      "Dump all keys requested for {}, by sender: {}",
+      (selectAreas.empty()
+           ? "all areas."
+           : fmt::format("areas: {}", folly::join(", ", selectAreas))),
+      (keyDumpParams.senderId().has_value() ? keyDumpParams.senderId().value()
+                                            : ""));
+
+  // Dump every area on the event base owning its KvStoreDb
+  std::vector<folly::SemiFuture<std::optional<thrift::Publication>>> futures;
+  for (auto& area : selectAreas) {
+    auto pf = folly::makePromiseContract<std::optional<thrift::Publication>>();
+    getAreaEvb(area)->runInEventBaseThread([this,
+                                            p = std::move(pf.first),
+                                            keyDumpParams,
+                                            area]() mutable {
       try {
         auto& kvStoreDb = getAreaDbOrThrow(area, "dumpKvStoreKeys");
         fb303::fbData->addStatValue("kvstore.cmd_key_dump", 1, fb303::COUNT);
@@ -356,14 +484,26 @@ KvStore<ClientType>::semifuture_dumpKvStoreKeys(
                      << thriftPub.keyVals()->size() << " key-vals and "
                      << numMissingKeys << " missing keys";
         }
-        result->push_back(std::move(thriftPub));
+        p.setValue(std::move(thriftPub));
       } catch (thrift::KvStoreError const& e) {
         XLOG(ERR) << " Failed to find area " << area << " in kvStoreDb_.";
+        p.setValue(std::nullopt);
       }
-    }
-    p.setValue(std::move(result));
-  });
-  return sf;
+    });
+    futures.emplace_back(std::move(pf.second));
+  }
+
+  return folly::collect(std::move(futures))
+      .deferValue(
+          [](std::vector<std::optional<thrift::Publication>>&& publications) {
+            auto result = std::make_unique<std::vector<thrift::Publication>>();
+            for (auto& maybePub : publications) {
+              if (maybePub.has_value()) {
+                result->push_back(std::move(maybePub).value());
+              }
+            }
+            return result;
+          });
 }
 
 template <class ClientType>
@@ -372,10 +512,11 @@ KvStore<ClientType>::semifuture_dumpKvStoreHashes(
     std::string area, thrift::KeyDumpParams keyDumpParams) {
   folly::Promise<std::unique_ptr<thrift::Publication>> p;
   auto sf = p.getSemiFuture();
-  runInEventBaseThread([this,
-                        p = std::move(p),
-                        keyDumpParams = std::move(keyDumpParams),
-                        area]() mutable {
+  auto* evb = getAreaEvb(area);
+  evb->runInEventBaseThread([this,
+                             p = std::move(p),
+                             keyDumpParams = std::move(keyDumpParams),
+                             area]() mutable {
     // Empty senderID means local call.
     XLOG(DBG3) << fmt::format(
         "Dump all hashes requested for AREA: {}, by sender: {}",
@@ -406,16 +547,72 @@ KvStore<ClientType>::semifuture_dumpKvStoreHashes(
   return sf;
 }
 
+template <class ClientType>
+folly::SemiFuture<std::unique_ptr<thrift::KeyValsPage>>
+KvStore<ClientType>::semifuture_getKvStoreKeyValsPage(
+    std::string area,
+    thrift::PageRequest request,
+    PageKeysSnapshot<std::string> sortedKeys) {
+  folly::Promise<std::unique_ptr<thrift::KeyValsPage>> p;
+  auto sf = p.getSemiFuture();
+  auto* evb = getAreaEvb(area);
+  evb->runInEventBaseThread([this,
+                             p = std::move(p),
+                             request = std::move(request),
+                             sortedKeys = std::move(sortedKeys),
+                             area]() mutable {
+    XLOG(DBG3) << "Dump page of key-vals requested for AREA: " << area;
+    try {
+      auto& kvStoreDb =
+          getAreaDbOrThrow(area, "semifuture_getKvStoreKeyValsPage");
+      fb303::fbData->addStatValue("kvstore.cmd_key_dump_page", 1, fb303::COUNT);
+
+      auto const& keyPrefix = request.keyPrefix();
+      auto const [page, hasMore] = selectPage(
+          kvStoreDb.getKeyValueMap(),
+          request.cursor().to_optional(),
+          getPageLimit(*request.limit()),
+          [&keyPrefix](auto const& entry) {
+            return not keyPrefix or entry.first.find(*keyPrefix) == 0;
+          },
+          sortedKeys.get());
+
+      thrift::Publication thriftPub;
+      thriftPub.area() = area;
+      thriftPub.keyVals()->reserve(page.size());
+      for (auto const& it : page) {
+        thriftPub.keyVals()->emplace(it->first, it->second);
+      }
+      updatePublicationTtl(
+          kvStoreDb.getTtlCountdownQueue(),
+          kvParams_.ttlDecr,
+          thriftPub,
+          false);
+
+      auto keyValsPage = std::make_unique<thrift::KeyValsPage>();
+      keyValsPage->keyVals() = std::move(*thriftPub.keyVals());
+      if (hasMore) {
+        keyValsPage->nextCursor() = page.back()->first;
+      }
+      p.setValue(std::move(keyValsPage));
+    } catch (thrift::KvStoreError const& e) {
+      p.setException(e);
+    }
+  });
+  return sf;
+}
+
 template <class ClientType>
 folly::SemiFuture<folly::Unit>
 KvStore<ClientType>::semifuture_setKvStoreKeyVals(
     std::string area, thrift::KeySetParams keySetParams) {
   folly::Promise<folly::Unit> p;
   auto sf = p.getSemiFuture();
-  runInEventBaseThread([this,
-                        p = std::move(p),
-                        keySetParams = std::move(keySetParams),
-                        area]() mutable {
+  auto* evb = getAreaEvb(area);
+  evb->runInEventBaseThread([this,
+                             p = std::move(p),
+                             keySetParams = std::move(keySetParams),
+                             area]() mutable {
     // Empty senderID means local call.
     XLOG(DBG3) << fmt::format(
         "Set key requested for AREA: {}, by sender: {}",
@@ -440,7 +637,8 @@ KvStore<ClientType>::semifuture_getKvStorePeerState(
     std::string const& area, std::string const& peerName) {
   folly::Promise<std::optional<thrift::KvStorePeerState>> promise;
   auto sf = promise.getSemiFuture();
-  runInEventBaseThread(
+  auto* evb = getAreaEvb(area);
+  evb->runInEventBaseThread(
       [this, p = std::move(promise), peerName, area]() mutable {
         try {
           p.setValue(getAreaDbOrThrow(area, "semifuture_getKvStorePeerState")
@@ -457,7 +655,8 @@ folly::SemiFuture<std::unique_ptr<thrift::PeersMap>>
 KvStore<ClientType>::semifuture_getKvStorePeers(std::string area) {
   folly::Promise<std::unique_ptr<thrift::PeersMap>> p;
   auto sf = p.getSemiFuture();
-  runInEventBaseThread([this, p = std::move(p), area]() mutable {
+  auto* evb = getAreaEvb(area);
+  evb->runInEventBaseThread([this, p = std::move(p), area]() mutable {
     XLOG(DBG2) << "Peer dump requested for AREA: " << area;
     try {
       p.setValue(std::make_unique<thrift::PeersMap>(
@@ -474,32 +673,38 @@ template <class ClientType>
 folly::SemiFuture<std::unique_ptr<std::vector<thrift::KvStoreAreaSummary>>>
 KvStore<ClientType>::semifuture_getKvStoreAreaSummaryInternal(
     std::set<std::string> selectAreas) {
-  folly::Promise<std::unique_ptr<std::vector<thrift::KvStoreAreaSummary>>> p;
-  auto sf = p.getSemiFuture();
-  runInEventBaseThread([this,
-                        p = std::move(p),
-                        selectAreas = std::move(selectAreas)]() mutable {
-    XLOG(INFO)
-        << "KvStore Summary requested for "
-        << (selectAreas.empty()
-                ? "all areas."
-                : fmt::format("areas: {}.", folly::join(", ", selectAreas)));
-
-    auto result = std::make_unique<std::vector<thrift::KvStoreAreaSummary>>();
-    for (auto& [area, kvStoreDb] : kvStoreDb_) {
-      thrift::KvStoreAreaSummary areaSummary;
-
-      areaSummary.area() = area;
-      auto kvDbCounters = kvStoreDb.getCounters();
-      areaSummary.keyValsCount() = kvDbCounters["kvstore.num_keys"];
-      areaSummary.peersMap() = kvStoreDb.dumpPeers();
-      areaSummary.keyValsBytes() = kvStoreDb.getKeyValsSize();
+  XLOG(INFO) << "KvStore Summary requested for "
+             << (selectAreas.empty()
+                     ? "all areas."
+                     : fmt::format(
+                           "areas: {}.", folly::join(", ", selectAreas)));
+
+  // Collect summary of every area on the event base owning its KvStoreDb
+  std::vector<folly::SemiFuture<thrift::KvStoreAreaSummary>> futures;
+  for (auto& [area, kvStoreDb] : kvStoreDb_) {
+    auto pf = folly::makePromiseContract<thrift::KvStoreAreaSummary>();
+    kvStoreDb.getEvb()->runInEventBaseThread(
+        [p = std::move(pf.first),
+         &kvStoreDb = kvStoreDb,
+         area = area]() mutable {
+          thrift::KvStoreAreaSummary areaSummary;
+
+          areaSummary.area() = area;
+          auto kvDbCounters = kvStoreDb.getCounters();
+          areaSummary.keyValsCount() = kvDbCounters["kvstore.num_keys"];
+          areaSummary.peersMap() = kvStoreDb.dumpPeers();
+          areaSummary.keyValsBytes() = kvStoreDb.getKeyValsSize();
+
+          p.setValue(std::move(areaSummary));
+        });
+    futures.emplace_back(std::move(pf.second));
+  }
 
-      result->emplace_back(std::move(areaSummary));
-    }
-    p.setValue(std::move(result));
-  });
-  return sf;
+  return folly::collect(std::move(futures))
+      .deferValue([](std::vector<thrift::KvStoreAreaSummary>&& summaries) {
+        return std::make_unique<std::vector<thrift::KvStoreAreaSummary>>(
+            std::move(summaries));
+      });
 }
 
 template <class ClientType>
@@ -508,10 +713,11 @@ KvStore<ClientType>::semifuture_addUpdateKvStorePeers(
     std::string area, thrift::PeersMap peersToAdd) {
   folly::Promise<folly::Unit> p;
   auto sf = p.getSemiFuture();
-  runInEventBaseThread([this,
-                        p = std::move(p),
-                        peersToAdd = std::move(peersToAdd),
-                        area]() mutable {
+  auto* evb = getAreaEvb(area);
+  evb->runInEventBaseThread([this,
+                             p = std::move(p),
+                             peersToAdd = std::move(peersToAdd),
+                             area]() mutable {
     try {
       auto str = folly::gen::from(peersToAdd) | folly::gen::get<0>() |
           folly::gen::as<std::vector<std::string>>();
@@ -541,10 +747,11 @@ KvStore<ClientType>::semifuture_deleteKvStorePeers(
     std::string area, std::vector<std::string> peersToDel) {
   folly::Promise<folly::Unit> p;
   auto sf = p.getSemiFuture();
-  runInEventBaseThread([this,
-                        p = std::move(p),
-                        peersToDel = std::move(peersToDel),
-                        area]() mutable {
+  auto* evb = getAreaEvb(area);
+  evb->runInEventBaseThread([this,
+                             p = std::move(p),
+                             peersToDel = std::move(peersToDel),
+                             area]() mutable {
     XLOG(INFO) << "Peer deletion for: [" << folly::join(",", peersToDel)
                << "] in area: " << area;
     try {
@@ -566,11 +773,13 @@ KvStore<ClientType>::semifuture_deleteKvStorePeers(
 
 template <class ClientType>
 void
-KvStore<ClientType>::initialKvStoreDbSynced() {
-  for (auto& [_, kvStoreDb] : kvStoreDb_) {
-    if (not kvStoreDb.getInitialSyncedWithPeers()) {
-      return;
-    }
+KvStore<ClientType>::initialKvStoreDbSynced(std::string const& area) {
+  // NOTE: Always invoked on KvStore's own event base. Per-area KvStoreDb may
+  // run on a dedicated event base hence track synced areas here instead of
+  // polling state of every KvStoreDb.
+  initialSyncedAreas_.emplace(area);
+  if (initialSyncedAreas_.size() < kvStoreDb_.size()) {
+    return;
   }
 
   if (not initialSyncSignalSent_) {
@@ -589,28 +798,35 @@ KvStore<ClientType>::initialKvStoreDbSynced() {
 template <class ClientType>
 folly::SemiFuture<std::map<std::string, int64_t>>
 KvStore<ClientType>::semifuture_getCounters() {
-  auto pf = folly::makePromiseContract<std::map<std::string, int64_t>>();
-  runInEventBaseThread([this, p = std::move(pf.first)]() mutable {
-    p.setValue(getGlobalCounters());
-  });
-  return std::move(pf.second);
+  return getGlobalCounters();
 }
 
 template <class ClientType>
-std::map<std::string, int64_t>
-KvStore<ClientType>::getGlobalCounters() const {
-  std::map<std::string, int64_t> flatCounters;
+folly::SemiFuture<std::map<std::string, int64_t>>
+KvStore<ClientType>::getGlobalCounters() {
+  // Read counters of every KvStoreDb on the event base owning it
+  std::vector<folly::SemiFuture<std::map<std::string, int64_t>>> futures;
   for (auto& [_, kvDb] : kvStoreDb_) {
-    auto kvDbCounters = kvDb.getCounters();
-    // add up counters for same key from all kvStoreDb instances
-    std::for_each(
-        kvDbCounters.begin(),
-        kvDbCounters.end(),
-        [&](const std::pair<const std::string, int64_t>& kvDbCounter) {
-          flatCounters[kvDbCounter.first] += kvDbCounter.second;
+    auto pf = folly::makePromiseContract<std::map<std::string, int64_t>>();
+    kvDb.getEvb()->runInEventBaseThread(
+        [p = std::move(pf.first), &kvDb = kvDb]() mutable {
+          p.setValue(kvDb.getCounters());
         });
-  }
-  return flatCounters;
+    futures.emplace_back(std::move(pf.second));
+  }
+
+  return folly::collect(std::move(futures))
+      .deferValue(
+          [](std::vector<std::map<std::string, int64_t>>&& allKvDbCounters) {
+            std::map<std::string, int64_t> flatCounters;
+            // add up counters for same key from all kvStoreDb instances
+            for (auto& kvDbCounters : allKvDbCounters) {
+              for (auto& [key, val] : kvDbCounters) {
+                flatCounters[key] += val;
+              }
+            }
+            return flatCounters;
+          });
 }
 
 template <class ClientType>
@@ -682,6 +898,9 @@ KvStore<ClientType>::initGlobalCounters() {
   fb303::fbData->addStatExportType(
       "kvstore.cmd_self_originated_key_dump", fb303::COUNT);
   fb303::fbData->addStatExportType("kvstore.cmd_key_dump", fb303::COUNT);
+  fb303::fbData->addStatExportType("kvstore.cmd_key_dump_page", fb303::COUNT);
+  fb303::fbData->addStatExportType(
+      "kvstore.cmd_key_dump_not_modified", fb303::COUNT);
   fb303::fbData->addStatExportType("kvstore.cmd_key_get", fb303::COUNT);
   fb303::fbData->addStatExportType("kvstore.cmd_key_set", fb303::COUNT);
   fb303::fbData->addStatExportType("kvstore.cmd_peer_add", fb303::COUNT);
@@ -2153,6 +2372,7 @@ KvStoreDb<ClientType>::cleanupTtlCountdownQueue() {
 
   fb303::fbData->addStatValue(
       "kvstore.expired_key_vals", expiredKeys.size(), fb303::SUM);
+  ++generation_;
 
   // ATTN: expired key will be ONLY notified to local subscribers
   //       via replicate-queue. KvStore will NOT flood publication
@@ -2608,6 +2828,11 @@ KvStoreDb<ClientType>::mergePublication(
     }
   }
 
+  // Bump generation unless only ttl of key-vals got refreshed
+  if (stats.updateStats.valUpdateCnt > 0) {
+    ++generation_;
+  }
+
   thrift::Publication deltaPublication;
 
   deltaPublication.keyVals() = std::move(mergedKeyVals);
@@ -18,7 +18,9 @@
 #include <openr/common/OpenrClient.h>
 #include <openr/common/OpenrEventBase.h>
 #include <openr/common/Types.h>
+#include <openr/common/Util.h>
 #include <openr/if/gen-cpp2/KvStore_types.h>
+#include <openr/if/gen-cpp2/OpenrCtrl_types.h>
 #include <openr/kvstore/KvStoreUtil.h>
 #include <openr/messaging/ReplicateQueue.h>
 #include <openr/monitor/LogSample.h>
@@ -159,6 +161,12 @@ class KvStoreDb {
     return thriftPeers_.size();
   }
 
+  // Event base this instance runs on. All methods must be invoked on it.
+  inline OpenrEventBase*
+  getEvb() const {
+    return evb_;
+  }
+
   inline bool
   getInitialSyncedWithPeers() const {
     return initialSyncCompleted_;
@@ -174,6 +182,14 @@ class KvStoreDb {
   getKeyValueMap() const {
     return kvStore_;
   }
+
+  // get generation of key-vals, changes on every key-val update or expiry
+  // but not on ttl refresh
+  inline int64_t
+  getGeneration() const {
+    return generation_;
+  }
+
   inline TtlCountdownQueue const&
   getTtlCountdownQueue() const {
     return ttlCountdownQueue_;
@@ -522,6 +538,9 @@ class KvStoreDb {
   // store keys mapped to (version, originatoId, value)
   std::unordered_map<std::string, thrift::Value> kvStore_{};
 
+  // generation of kvStore_
+  int64_t generation_{getInitialGeneration()};
+
   // TTL count down queue
   TtlCountdownQueue ttlCountdownQueue_;
 
@@ -597,6 +616,12 @@ class KvStoreDb {
  * thrift channel. The configuration is passed via constructor arguments.
  * This class instantiates individual KvStoreDb per area. Area config is
  * passed in the constructor.
+ *
+ * By default every KvStoreDb runs on KvStore's own event base. With
+ * `enable_per_area_event_base` each KvStoreDb gets a dedicated event base and
+ * thread, started along with KvStore's. Requests for an area are then routed
+ * to the event base owning it, and requests spanning areas are fanned out and
+ * collected.
  */
 template <class ClientType>
 class KvStore final : public OpenrEventBase {
@@ -617,15 +642,21 @@ class KvStore final : public OpenrEventBase {
 
   ~KvStore() override = default;
 
+  void run() override;
+
   void stop() override;
 
   /*
    * [Open/R Initialization]
    *
    * This is the callback function used by KvStoreDb to mark initial
-   * KVSTORE_SYNC stage done during Open/R initialization sequence.
+   * KVSTORE_SYNC stage done during Open/R initialization sequence. Must be
+   * invoked on KvStore's event base.
    */
-  void initialKvStoreDbSynced();
+  void initialKvStoreDbSynced(std::string const& area);
+
+  // Dedicated per-area event bases. Empty unless enabled by config
+  std::vector<OpenrEventBase*> getAreaEventBases() const;
 
   /*
    * [Public APIs]
@@ -647,6 +678,16 @@ class KvStore final : public OpenrEventBase {
       thrift::KeyDumpParams keyDumpParams,
       std::set<std::string> selectAreas = {});
 
+  /*
+   * Dump key-vals of given area only if any key-val changed since
+   * `lastGeneration`
+   */
+  folly::SemiFuture<std::unique_ptr<thrift::VersionedPublication>>
+  semifuture_dumpKvStoreKeysVersioned(
+      std::string area,
+      thrift::KeyDumpParams keyDumpParams,
+      int64_t lastGeneration);
+
   folly::SemiFuture<std::unique_ptr<SelfOriginatedKeyVals>>
   semifuture_dumpKvStoreSelfOriginatedKeys(std::string area);
 
@@ -654,6 +695,17 @@ class KvStore final : public OpenrEventBase {
   semifuture_dumpKvStoreHashes(
       std::string area, thrift::KeyDumpParams keyDumpParams);
 
+  /*
+   * Dump a page of key-vals of given area ordered by key. `keyPrefix` of
+   * request selects keys starting with it. Pass the same `sortedKeys`
+   * snapshot for consecutive pages of a stream.
+   */
+  folly::SemiFuture<std::unique_ptr<thrift::KeyValsPage>>
+  semifuture_getKvStoreKeyValsPage(
+      std::string area,
+      thrift::PageRequest request,
+      PageKeysSnapshot<std::string> sortedKeys = nullptr);
+
   /*
    * [Public APIs]
    *
@@ -710,11 +762,19 @@ class KvStore final : public OpenrEventBase {
   /*
    * [Counter]
    *
-   * util methods called by getCounters() public API
+   * util methods called by getCounters() public API. Counters of all
+   * KvStoreDb instances are collected from their event bases.
    */
-  std::map<std::string, int64_t> getGlobalCounters() const;
+  folly::SemiFuture<std::map<std::string, int64_t>> getGlobalCounters();
   void initGlobalCounters();
 
+  /*
+   * Event base owning KvStoreDb of `areaId`. Follows the area resolution of
+   * `getAreaDbOrThrow()`. Unknown areas resolve to KvStore's own event base,
+   * on which `getAreaDbOrThrow()` reports the error.
+   */
+  OpenrEventBase* getAreaEvb(std::string const& areaId);
+
   /*
    * This is a helper function which returns a reference to the relevant
    * KvStoreDb or throws an instance of KvStoreError for backward compaytibilty.
@@ -736,10 +796,18 @@ class KvStore final : public OpenrEventBase {
   // kvstore parameters common to all kvstoreDB
   KvStoreParams kvParams_;
 
+  // Dedicated event bases and their threads when per-area event base is
+  // enabled. Declared ahead of `kvStoreDb_` to outlive it.
+  std::vector<std::unique_ptr<OpenrEventBase>> areaEvbs_;
+  std::vector<std::thread> areaEvbThreads_;
+
   // map of area IDs and instance of KvStoreDb
   std::unordered_map<std::string /* area ID */, KvStoreDb<ClientType>>
       kvStoreDb_{};
 
+  // Areas which have completed initial sync with peers
+  std::unordered_set<std::string> initialSyncedAreas_;
+
   // Boolean flag to indicate if kvStoreSynced signal is published in OpenR
   // initialization process.
   bool initialSyncSignalSent_{false};
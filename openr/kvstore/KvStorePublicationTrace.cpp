@@ -0,0 +1,114 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include <fmt/format.h>
+#include <folly/Exception.h>
+#include <folly/FileUtil.h>
+#include <folly/logging/xlog.h>
+#include <thrift/lib/cpp2/protocol/Serializer.h>
+
+#include <openr/common/Util.h>
+#include <openr/kvstore/KvStorePublicationTrace.h>
+
+namespace {
+
+// Leading marker of every trace file. Bump version on format changes.
+constexpr folly::StringPiece kPublicationTraceMarker{"OpenrKvTraceV1"};
+
+} // anonymous namespace
+
+namespace openr {
+
+PublicationTraceWriter::PublicationTraceWriter(const std::string& filePath)
+    : file_(filePath.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0666) {
+  if (folly::writeFull(
+          file_.fd(),
+          kPublicationTraceMarker.data(),
+          kPublicationTraceMarker.size()) < 0) {
+    folly::throwSystemError(
+        fmt::format("Failed to write trace marker to {}", filePath));
+  }
+}
+
+void
+PublicationTraceWriter::append(
+    std::chrono::milliseconds timestamp,
+    const thrift::Publication& publication) {
+  PublicationTraceRecord record;
+  record.timestamp = timestamp;
+  record.publication = publication;
+  auto ioBuf = encodePublicationTraceRecord(record);
+  auto iov = ioBuf->getIovec();
+  if (folly::writevFull(file_.fd(), iov.data(), iov.size()) < 0) {
+    folly::throwSystemError("Failed to append trace record");
+  }
+  ++numRecords_;
+}
+
+PublicationTraceReader::PublicationTraceReader(const std::string& filePath)
+    : mapping_(filePath.c_str()),
+      ioBuf_(folly::IOBuf::wrapBuffer(
+          mapping_.range().data(), mapping_.range().size())),
+      cursor_(ioBuf_.get()),
+      filePath_(filePath) {
+  if (not cursor_.canAdvance(kPublicationTraceMarker.size()) or
+      cursor_.readFixedString(kPublicationTraceMarker.size()) !=
+          kPublicationTraceMarker) {
+    throw std::runtime_error(
+        fmt::format("{} is not a publication trace", filePath));
+  }
+}
+
+std::optional<PublicationTraceRecord>
+PublicationTraceReader::next() {
+  auto maybeRecord = decodePublicationTraceRecord(cursor_);
+  if (maybeRecord.hasError()) {
+    // Incomplete trailing record, e.g. capture was interrupted. Everything
+    // before it is intact, hence treat it as end of trace.
+    XLOG(WARNING) << "Ignoring truncated record at the end of '" << filePath_
+                  << "'. Error: " << maybeRecord.error();
+    return std::nullopt;
+  }
+  return std::move(maybeRecord).value();
+}
+
+std::unique_ptr<folly::IOBuf>
+encodePublicationTraceRecord(const PublicationTraceRecord& record) {
+  apache::thrift::CompactSerializer serializer;
+  const auto payload = writeThriftObjStr(record.publication, serializer);
+
+  auto buf = folly::IOBuf::create(
+      sizeof(uint64_t) + sizeof(uint32_t) + payload.size());
+  folly::io::Appender appender(buf.get(), 0);
+  appender.writeBE<uint64_t>(record.timestamp.count());
+  appender.writeBE<uint32_t>(payload.size());
+  appender.push(folly::StringPiece(payload));
+  return buf;
+}
+
+folly::Expected<std::optional<PublicationTraceRecord>, std::string>
+decodePublicationTraceRecord(folly::io::Cursor& cursor) noexcept {
+  // If nothing can be read, return
+  if (not cursor.canAdvance(1)) {
+    return std::nullopt;
+  }
+
+  PublicationTraceRecord record;
+  try {
+    record.timestamp = std::chrono::milliseconds(cursor.readBE<uint64_t>());
+    const auto length = cursor.readBE<uint32_t>();
+    apache::thrift::CompactSerializer serializer;
+    record.publication = readThriftObjStr<thrift::Publication>(
+        cursor.readFixedString(length), serializer);
+  } catch (std::exception const& e) {
+    return folly::makeUnexpected<std::string>(
+        folly::exceptionStr(e).toStdString());
+  }
+  return record;
+}
+
+} // namespace openr
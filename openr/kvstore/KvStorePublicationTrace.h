@@ -0,0 +1,84 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#pragma once
+
+#include <chrono>
+#include <optional>
+#include <string>
+
+#include <folly/Expected.h>
+#include <folly/File.h>
+#include <folly/io/Cursor.h>
+#include <folly/io/IOBuf.h>
+#include <folly/system/MemoryMapping.h>
+
+#include <openr/if/gen-cpp2/Types_types.h>
+
+namespace openr {
+
+struct PublicationTraceRecord {
+  // Time at which publication was received, relative to start of capture
+  std::chrono::milliseconds timestamp{0};
+  thrift::Publication publication;
+};
+
+/*
+ * Capture of KvStore publications received from a live node, used to replay
+ * real churn offline (see `openr_kvstore_snooper --record_file` and
+ * `decision_replay_benchmark`).
+ *
+ * The file starts with a format marker followed by length-prefixed records
+ *   <uint64 timestamp-ms> <uint32 length> <compact serialized Publication>
+ * Records are only ever appended, hence a truncated trailing record (e.g.
+ * capture interrupted mid-write) is ignored on read. The reader maps the file
+ * instead of loading it, so large captures can be iterated cheaply.
+ */
+class PublicationTraceWriter {
+ public:
+  // Create or truncate `filePath`. Throws std::system_error on failure.
+  explicit PublicationTraceWriter(const std::string& filePath);
+
+  // Append publication received at `timestamp`. Throws on write failure.
+  void append(
+      std::chrono::milliseconds timestamp,
+      const thrift::Publication& publication);
+
+  size_t
+  getNumRecords() const {
+    return numRecords_;
+  }
+
+ private:
+  folly::File file_;
+  size_t numRecords_{0};
+};
+
+class PublicationTraceReader {
+ public:
+  // Map `filePath`. Throws if file can't be mapped or isn't a trace.
+  explicit PublicationTraceReader(const std::string& filePath);
+
+  // Next record in the trace, or std::nullopt once trace is exhausted
+  std::optional<PublicationTraceRecord> next();
+
+ private:
+  folly::MemoryMapping mapping_;
+  std::unique_ptr<folly::IOBuf> ioBuf_;
+  folly::io::Cursor cursor_;
+  const std::string filePath_;
+};
+
+/**
+ * Encode/Decode a single trace record. Exposed for unit test.
+ */
+std::unique_ptr<folly::IOBuf> encodePublicationTraceRecord(
+    const PublicationTraceRecord& record);
+folly::Expected<std::optional<PublicationTraceRecord>, std::string>
+decodePublicationTraceRecord(folly::io::Cursor& cursor) noexcept;
+
+} // namespace openr
@@ -5,22 +5,25 @@
  * LICENSE file in the root directory of this source tree.
  */
 
+#include <fb303/ServiceData.h>
+
+#include <openr/common/Constants.h>
 #include <openr/common/Util.h>
 #include <openr/kvstore/KvStorePublisher.h>
 
+namespace fb303 = facebook::fb303;
+
 namespace openr {
 
 KvStorePublisher::KvStorePublisher(
     std::set<std::string> const& selectAreas,
     thrift::KeyDumpParams filter,
-    apache::thrift::ServerStreamPublisher<thrift::Publication>&& publisher,
-    std::chrono::steady_clock::time_point subscription_time,
-    int64_t total_messages)
+    SnapshotCallback snapshotCallback,
+    std::chrono::steady_clock::time_point subscription_time)
     : selectAreas_(selectAreas),
       filter_(filter),
-      publisher_(std::move(publisher)),
-      subscription_time_(subscription_time),
-      total_messages_(total_messages) {
+      snapshotCallback_(std::move(snapshotCallback)),
+      subscriptionTime_(subscription_time) {
   std::vector<std::string> keyPrefix;
 
   if (filter.keys().has_value()) {
@@ -36,6 +39,138 @@ KvStorePublisher::KvStorePublisher(
       KvStoreFilters(keyPrefix, std::move(*filter.originatorIds()), op);
 }
 
+apache::thrift::ServerStream<thrift::Publication>
+KvStorePublisher::createStream(std::function<void()> onComplete) {
+#if FOLLY_HAS_COROUTINES
+  // Guard is owned by the generator frame, hence completion callback is
+  // invoked whenever the stream goes away, even if it was never pulled from
+  std::shared_ptr<void> completionGuard(
+      nullptr, [onComplete = std::move(onComplete)](void*) { onComplete(); });
+  return streamPublications(shared_from_this(), std::move(completionGuard));
+#else
+  auto streamAndPublisher =
+      apache::thrift::ServerStream<thrift::Publication>::createPublisher(
+          std::move(onComplete));
+  publisher_.emplace(std::move(streamAndPublisher.second));
+  return std::move(streamAndPublisher.first);
+#endif
+}
+
+#if FOLLY_HAS_COROUTINES
+folly::coro::AsyncGenerator<thrift::Publication&&>
+KvStorePublisher::streamPublications(
+    std::shared_ptr<KvStorePublisher> self,
+    std::shared_ptr<void> /* completionGuard */) {
+  while (true) {
+    co_await self->pendingSignal_;
+
+    // Take all pending publications at once
+    std::vector<thrift::Publication> pubs;
+    bool needsResync{false};
+    std::optional<folly::exception_wrapper> completion;
+    self->state_.withWLock([&](auto& state) {
+      self->pendingSignal_.reset();
+      completion = state.completion;
+      needsResync = std::exchange(state.needsResync, false);
+      for (auto& [_, pub] : state.pendingPublications) {
+        pubs.emplace_back(std::move(pub));
+      }
+      state.pendingPublications.clear();
+      state.pendingBytes = 0;
+      state.pendingSince.reset();
+    });
+
+    // Publications arriving from now on are pending until snapshot is sent,
+    // hence nothing is lost. Expired keys retained during resync are sent
+    // ahead of snapshot, as the snapshot may bring some of them back.
+    // NOTE: no resync on termination, only what's pending is flushed.
+    if (needsResync and not completion.has_value()) {
+      auto snapshot = co_await self->snapshotCallback_();
+      for (auto& pub : *snapshot) {
+        pubs.emplace_back(std::move(pub));
+      }
+    }
+
+    for (auto& pub : pubs) {
+      if (pub.keyVals()->empty() and pub.expiredKeys()->empty()) {
+        continue; // e.g. pending publication emptied for resync
+      }
+      const auto bytes = getPublicationBytes(pub);
+      self->state_.withWLock([&](auto& state) {
+        state.totalMessages++;
+        state.totalBytes += bytes;
+        state.lastMessageTime = std::chrono::system_clock::now();
+      });
+      pub.timestamp_ms() = getUnixTimeStampMs();
+      co_yield std::move(pub);
+    }
+
+    if (completion.has_value()) {
+      if (*completion) {
+        co_yield folly::coro::co_error(std::move(*completion));
+      }
+      co_return;
+    }
+  }
+}
+#endif
+
+void
+KvStorePublisher::complete(folly::exception_wrapper ew) {
+#if FOLLY_HAS_COROUTINES
+  state_.withWLock([&](auto& state) {
+    state.completion = std::move(ew);
+    pendingSignal_.post();
+  });
+#else
+  if (publisher_.has_value()) {
+    if (ew) {
+      std::move(*publisher_).complete(std::move(ew));
+    } else {
+      std::move(*publisher_).complete();
+    }
+  }
+#endif
+}
+
+thrift::StreamSubscriberInfo
+KvStorePublisher::getSubscriberInfo() const {
+  auto const currentTime = std::chrono::steady_clock::now();
+  thrift::StreamSubscriberInfo subscriber;
+  subscriber.uptime() = std::chrono::duration_cast<std::chrono::milliseconds>(
+                            currentTime - subscriptionTime_)
+                            .count();
+  state_.withRLock([&](auto const& state) {
+    subscriber.last_msg_sent_time() =
+        std::chrono::time_point_cast<std::chrono::milliseconds>(
+            state.lastMessageTime)
+            .time_since_epoch()
+            .count();
+    subscriber.total_streamed_msgs() = state.totalMessages;
+    subscriber.total_streamed_bytes() = state.totalBytes;
+    subscriber.pending_bytes() = state.pendingBytes;
+    subscriber.lag_ms() = state.pendingSince.has_value()
+        ? std::chrono::duration_cast<std::chrono::milliseconds>(
+              currentTime - *state.pendingSince)
+              .count()
+        : 0;
+    subscriber.num_resyncs() = state.numResyncs;
+  });
+  return subscriber;
+}
+
+size_t
+KvStorePublisher::getPublicationBytes(const thrift::Publication& pub) {
+  size_t bytes{0};
+  for (auto const& [key, val] : *pub.keyVals()) {
+    bytes += key.size() + (val.value().has_value() ? val.value()->size() : 0);
+  }
+  for (auto const& key : *pub.expiredKeys()) {
+    bytes += key.size();
+  }
+  return bytes;
+}
+
 /**
  * A publication object (param) can have multiple key value pairs as follows.
  * pub = {"prefix1": value1, "prefix2": value2, "random-key": random-value}
@@ -50,10 +185,10 @@ KvStorePublisher::KvStorePublisher(
  * "prefix2": value2} will be returned to the client (i.e., published) on the
  * stream.
  */
-void
-KvStorePublisher::publish(const thrift::Publication& pub) {
+std::optional<thrift::Publication>
+KvStorePublisher::getFilteredPublication(const thrift::Publication& pub) {
   if (not(selectAreas_.empty() || selectAreas_.count(*pub.area()))) {
-    return;
+    return std::nullopt;
   }
   if ((not filter_.keys().has_value() or (*filter_.keys()).empty()) and
       (not filter_.originatorIds().is_set() or
@@ -62,10 +197,7 @@ KvStorePublisher::publish(const thrift::Publication& pub) {
     // No filtering criteria. Accept all updates as TTL updates are not be
     // to be updated. If we don't optimize here, we will have go through
     // key values of a publication and copy them.
-    auto filteredPub = std::make_unique<thrift::Publication>(pub);
-    filteredPub->timestamp_ms() = getUnixTimeStampMs();
-    publisher_.next(std::move(*filteredPub));
-    return;
+    return pub;
   }
 
   thrift::Publication publication_filtered;
@@ -86,9 +218,73 @@ KvStorePublisher::publish(const thrift::Publication& pub) {
       publication_filtered.expiredKeys()->size()) {
     // There is at least one key value in the publication for the client
     // or there are some expiredKeys
-    publication_filtered.timestamp_ms() = getUnixTimeStampMs();
-    publisher_.next(std::move(publication_filtered));
+    return publication_filtered;
+  }
+  return std::nullopt;
+}
+
+void
+KvStorePublisher::publish(const thrift::Publication& pub) {
+  auto filteredPub = getFilteredPublication(pub);
+  if (not filteredPub.has_value()) {
+    return;
+  }
+
+#if FOLLY_HAS_COROUTINES
+  const auto bytes = getPublicationBytes(*filteredPub);
+  state_.withWLock([&](auto& state) {
+    if (state.completion.has_value()) {
+      return;
+    }
+    // Bytes are no longer buffered once resync is due, stop counting them
+    if (not state.needsResync) {
+      state.pendingBytes += bytes;
+    }
+    if (not state.pendingSince.has_value()) {
+      state.pendingSince = std::chrono::steady_clock::now();
+    }
+
+    // Subscriber fell too far behind. Drop pending updates, except expired
+    // keys, and convey the rest with a snapshot once subscriber catches up.
+    if (not state.needsResync and
+        state.pendingBytes > Constants::kKvStoreSubscriberMaxPendingBytes) {
+      state.needsResync = true;
+      state.numResyncs++;
+      for (auto& [_, pendingPub] : state.pendingPublications) {
+        pendingPub.keyVals()->clear();
+      }
+      fb303::fbData->addStatValue(
+          "ctrl.kvstore_subscriber.resync", 1, fb303::COUNT);
+    }
+    if (state.needsResync) {
+      filteredPub->keyVals()->clear();
+    }
+
+    // Coalesce with pending publication of the area. Attributes for
+    // flooding & full-sync are irrelevant to subscribers, drop them.
+    auto it = state.pendingPublications.find(*filteredPub->area());
+    if (it == state.pendingPublications.end()) {
+      state.pendingPublications.emplace(
+          *filteredPub->area(), std::move(*filteredPub));
+    } else {
+      it->second.nodeIds().reset();
+      it->second.tobeUpdatedKeys().reset();
+      filteredPub->nodeIds().reset();
+      filteredPub->tobeUpdatedKeys().reset();
+      mergePublication(it->second, *filteredPub);
+    }
+    pendingSignal_.post();
+  });
+#else
+  auto state = state_.wlock();
+  state->totalMessages++;
+  state->totalBytes += getPublicationBytes(*filteredPub);
+  state->lastMessageTime = std::chrono::system_clock::now();
+  filteredPub->timestamp_ms() = getUnixTimeStampMs();
+  if (publisher_.has_value()) {
+    publisher_->next(std::move(*filteredPub));
   }
+#endif
 }
 
 thrift::KeyVals
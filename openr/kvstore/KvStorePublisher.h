@@ -7,46 +7,117 @@
 
 #pragma once
 
+#include <folly/Synchronized.h>
+#if FOLLY_HAS_COROUTINES
+#include <folly/experimental/coro/AsyncGenerator.h>
+#include <folly/experimental/coro/Baton.h>
+#endif
+
 #include <openr/if/gen-cpp2/KvStore_types.h>
+#include <openr/if/gen-cpp2/OpenrCtrl_types.h>
 #include <openr/kvstore/KvStoreUtil.h>
 #include <thrift/lib/cpp2/async/ServerPublisherStream.h>
+#include <thrift/lib/cpp2/async/ServerStream.h>
 
 namespace openr {
-class KvStorePublisher {
+
+/**
+ * Streams KvStore publications to a single ctrl subscriber.
+ *
+ * Publications are filtered and buffered per subscriber. Subscriber pulls
+ * them at its own pace, while newer updates are coalesced into pending ones
+ * (key-level last-writer-wins). Once a subscriber lags more than
+ * `Constants::kKvStoreSubscriberMaxPendingBytes` behind, pending updates are
+ * dropped and a snapshot (via `SnapshotCallback`) is sent instead once it
+ * catches up. Hence a stalled client doesn't grow server memory unbounded.
+ *
+ * NOTE: publishing and streaming may happen from different threads.
+ */
+class KvStorePublisher
+    : public std::enable_shared_from_this<KvStorePublisher> {
  public:
+  // Dump of KvStore for areas and filter of the subscriber
+  using SnapshotCallback = std::function<
+      folly::SemiFuture<std::unique_ptr<std::vector<thrift::Publication>>>()>;
+
   KvStorePublisher(
       std::set<std::string> const& selectAreas,
       thrift::KeyDumpParams filter,
-      apache::thrift::ServerStreamPublisher<thrift::Publication>&& publisher,
+      SnapshotCallback snapshotCallback,
       std::chrono::steady_clock::time_point subscription_time =
-          std::chrono::steady_clock::now(),
-      int64_t total_messages = 0);
+          std::chrono::steady_clock::now());
 
   ~KvStorePublisher() {}
 
+  /**
+   * Create stream for the subscriber. Must be invoked exactly once.
+   * `onComplete` is invoked when stream gets terminated.
+   */
+  apache::thrift::ServerStream<thrift::Publication> createStream(
+      std::function<void()> onComplete);
+
   // Invoked whenever there is change. Apply filter and publish changes
   void publish(const thrift::Publication& pub);
 
-  template <class... Args>
-  void
-  complete(Args&&... args) {
-    std::move(publisher_).complete(std::forward<Args>(args)...);
-  }
+  // Terminate the stream, optionally with an error
+  void complete(folly::exception_wrapper ew = {});
+
+  // Stats of the subscriber. Caller fills `subscriber_id`
+  thrift::StreamSubscriberInfo getSubscriberInfo() const;
 
  private:
+  std::optional<thrift::Publication> getFilteredPublication(
+      const thrift::Publication& pub);
   thrift::KeyVals getFilteredKeyVals(const thrift::KeyVals& origKeyVals);
   std::vector<std::string> getFilteredExpiredKeys(
       const std::vector<std::string>& origExpiredKeys);
 
+  // Approximate size of publication (keys & values) in bytes
+  static size_t getPublicationBytes(const thrift::Publication& pub);
+
+#if FOLLY_HAS_COROUTINES
+  // `completionGuard` gets released, i.e. completion callback invoked, along
+  // with the generator
+  static folly::coro::AsyncGenerator<thrift::Publication&&> streamPublications(
+      std::shared_ptr<KvStorePublisher> self,
+      std::shared_ptr<void> completionGuard);
+#endif
+
   // set of areas whose updates should be published. If empty, publish all
   std::set<std::string> selectAreas_;
   thrift::KeyDumpParams filter_;
   KvStoreFilters keyPrefixFilter_{{}, {}};
-  apache::thrift::ServerStreamPublisher<thrift::Publication> publisher_;
+  const SnapshotCallback snapshotCallback_;
+  const std::chrono::steady_clock::time_point subscriptionTime_;
 
- public:
-  std::chrono::steady_clock::time_point subscription_time_;
-  int64_t total_messages_;
-  std::chrono::system_clock::time_point last_message_time_;
+  struct State {
+    // Coalesced publications not yet pulled by the subscriber, per area
+    std::map<std::string, thrift::Publication> pendingPublications;
+    // Bytes published since subscriber last pulled, and time of the oldest
+    size_t pendingBytes{0};
+    std::optional<std::chrono::steady_clock::time_point> pendingSince;
+    // Subscriber fell behind. Only expired keys are retained in pending
+    // publications, the rest is conveyed by a snapshot.
+    bool needsResync{false};
+    // Set once stream is terminated
+    std::optional<folly::exception_wrapper> completion;
+
+    // Stats
+    int64_t totalMessages{0};
+    int64_t totalBytes{0};
+    int64_t numResyncs{0};
+    std::chrono::system_clock::time_point lastMessageTime;
+  };
+  folly::Synchronized<State> state_;
+
+#if FOLLY_HAS_COROUTINES
+  // Posted when there is pending data or completion for subscriber to pull.
+  // Posted & reset with `state_` lock held.
+  folly::coro::Baton pendingSignal_;
+#else
+  // Without coroutines publications are pushed right away
+  std::optional<apache::thrift::ServerStreamPublisher<thrift::Publication>>
+      publisher_;
+#endif
 };
 } // namespace openr
@@ -490,6 +490,48 @@ dumpDifference(
   return thriftPub;
 }
 
+bool
+mergePublication(thrift::Publication& pending, thrift::Publication& incoming) {
+  if (*pending.area() != *incoming.area()) {
+    return false;
+  }
+  if (pending.nodeIds() or pending.tobeUpdatedKeys() or incoming.nodeIds() or
+      incoming.tobeUpdatedKeys()) {
+    return false;
+  }
+
+  for (auto& [key, val] : *incoming.keyVals()) {
+    auto it = pending.keyVals()->find(key);
+    if (it != pending.keyVals()->end() and not val.value().has_value() and
+        it->second.value().has_value() and
+        *it->second.version() == *val.version() and
+        *it->second.originatorId() == *val.originatorId()) {
+      // TTL refresh of the pending value
+      it->second.ttl() = *val.ttl();
+      it->second.ttlVersion() = *val.ttlVersion();
+      continue;
+    }
+    pending.keyVals()->insert_or_assign(key, std::move(val));
+  }
+
+  // Expired keys override pending values and vice versa
+  std::unordered_set<std::string> expiredKeys(
+      pending.expiredKeys()->begin(), pending.expiredKeys()->end());
+  for (const auto& [key, _] : *incoming.keyVals()) {
+    expiredKeys.erase(key);
+  }
+  for (auto& key : *incoming.expiredKeys()) {
+    pending.keyVals()->erase(key);
+    expiredKeys.emplace(std::move(key));
+  }
+  pending.expiredKeys()->assign(expiredKeys.begin(), expiredKeys.end());
+
+  if (incoming.timestamp_ms()) {
+    pending.timestamp_ms() = *incoming.timestamp_ms();
+  }
+  return true;
+}
+
 // dump the entries of my KV store whose keys match filter
 // KvStoreFilters contains `thrift::FilterOperator`
 // Default to thrift::FilterOperator::OR
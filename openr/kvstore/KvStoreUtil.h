@@ -276,6 +276,17 @@ thrift::Publication dumpHashWithFilters(
     const std::unordered_map<std::string, thrift::Value>& kvStore,
     const KvStoreFilters& kvFilters);
 
+/*
+ * Merge `incoming` publication, generated right after `pending`, into
+ * `pending` (last-writer-wins per key). TTL-only updates of `incoming` refresh
+ * TTL of the value carried by `pending` instead of replacing it.
+ *
+ * @return: false if publications can't be merged, i.e. they belong to
+ *          different areas or carry flooding info (nodeIds/tobeUpdatedKeys).
+ */
+bool mergePublication(
+    thrift::Publication& pending, thrift::Publication& incoming);
+
 // Update Time to expire filed in Publication
 // If timeleft is below Constants::kTtlThreshold and removeAboutToExpire is
 // true, erase keyVals
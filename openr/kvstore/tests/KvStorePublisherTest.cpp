@@ -5,7 +5,10 @@
  * LICENSE file in the root directory of this source tree.
  */
 
+#include <folly/executors/GlobalExecutor.h>
 #include <folly/init/Init.h>
+#include <folly/synchronization/Baton.h>
+#include <gmock/gmock.h>
 #include <gtest/gtest.h>
 
 #include <openr/common/Util.h>
@@ -13,6 +16,31 @@
 
 using namespace openr;
 
+namespace {
+
+KvStorePublisher::SnapshotCallback
+createSnapshotCallback(std::vector<thrift::Publication> snapshot = {}) {
+  return [snapshot = std::move(snapshot)]() {
+    return folly::makeSemiFuture(
+        std::make_unique<std::vector<thrift::Publication>>(snapshot));
+  };
+}
+
+// Drain the stream of terminated publisher
+std::vector<thrift::Publication>
+getPublications(apache::thrift::ServerStream<thrift::Publication>&& stream) {
+  std::vector<thrift::Publication> publications;
+  std::move(stream).toClientStreamUnsafeDoNotUse().subscribeInline(
+      [&](folly::Try<thrift::Publication>&& receivedPublication) {
+        if (receivedPublication.hasValue()) {
+          publications.emplace_back(std::move(*receivedPublication));
+        }
+      });
+  return publications;
+}
+
+} // namespace
+
 TEST(KvStorePublisher, OnlyExpiredKeysFilterTest) {
   // dummy settings
   std::set<std::string> selectAreas;
@@ -22,15 +50,12 @@ TEST(KvStorePublisher, OnlyExpiredKeysFilterTest) {
   // We only keep the keys with prefix "adj:"
   filter.keys() = keys;
 
-  auto streamAndPublisher =
-      apache::thrift::ServerStream<thrift::Publication>::createPublisher();
-
-  auto kvStorePublisher = std::make_unique<KvStorePublisher>(
+  auto kvStorePublisher = std::make_shared<KvStorePublisher>(
       selectAreas,
       std::move(filter),
-      std::move(streamAndPublisher.second),
-      std::chrono::steady_clock::now(),
-      0);
+      createSnapshotCallback(),
+      std::chrono::steady_clock::now());
+  auto stream = kvStorePublisher->createStream([]() {});
 
   thrift::Publication publication;
   publication.expiredKeys()->push_back("adj:test1");
@@ -44,20 +69,143 @@ TEST(KvStorePublisher, OnlyExpiredKeysFilterTest) {
 
   // check the received keys
   const RegexSet prefixMatcher(keys);
-  std::move(streamAndPublisher.first)
-      .toClientStreamUnsafeDoNotUse()
-      .subscribeInline(
-          [&prefixMatcher](
-              folly::Try<thrift::Publication>&& receivedPublication) {
+  for (auto& receivedPublication : getPublications(std::move(stream))) {
+    // we wil receive one key: adj:test1
+    EXPECT_EQ(1, receivedPublication.expiredKeys()->size());
+    for (auto& key : *receivedPublication.expiredKeys()) {
+      EXPECT_TRUE(prefixMatcher.match(key));
+    }
+  }
+}
+
+#if FOLLY_HAS_COROUTINES
+/**
+ * Updates not yet pulled by the subscriber are coalesced per key, with the
+ * last writer winning.
+ */
+TEST(KvStorePublisher, CoalescePendingUpdates) {
+  auto kvStorePublisher = std::make_shared<KvStorePublisher>(
+      std::set<std::string>{},
+      thrift::KeyDumpParams{},
+      createSnapshotCallback(),
+      std::chrono::steady_clock::now());
+  bool completed{false};
+  auto stream =
+      kvStorePublisher->createStream([&completed]() { completed = true; });
+
+  thrift::Publication publication;
+  publication.area() = "default";
+  publication.keyVals() = {{"key1", createThriftValue(1, "node1", "v1")}};
+  kvStorePublisher->publish(publication);
+  publication.keyVals() = {
+      {"key1", createThriftValue(2, "node1", "v2")},
+      {"key2", createThriftValue(1, "node1", "v1")}};
+  kvStorePublisher->publish(publication);
+  publication.keyVals()->clear();
+  publication.expiredKeys() = {"key2"};
+  kvStorePublisher->publish(publication);
+
+  auto info = kvStorePublisher->getSubscriberInfo();
+  EXPECT_GT(*info.pending_bytes(), 0);
+  EXPECT_EQ(0, *info.total_streamed_msgs());
+
+  kvStorePublisher->complete();
+  auto publications = getPublications(std::move(stream));
+  EXPECT_TRUE(completed);
+  ASSERT_EQ(1, publications.size());
+  EXPECT_EQ(1, publications.at(0).keyVals()->size());
+  EXPECT_EQ("v2", *publications.at(0).keyVals()->at("key1").value());
+  EXPECT_THAT(*publications.at(0).expiredKeys(), testing::ElementsAre("key2"));
+
+  info = kvStorePublisher->getSubscriberInfo();
+  EXPECT_EQ(0, *info.pending_bytes());
+  EXPECT_EQ(1, *info.total_streamed_msgs());
+  EXPECT_EQ(0, *info.num_resyncs());
+}
+
+/**
+ * Stream dropped before subscriber ever pulled from it still invokes the
+ * completion callback, so that publisher gets unregistered.
+ */
+TEST(KvStorePublisher, CompleteStreamNeverPulled) {
+  auto kvStorePublisher = std::make_shared<KvStorePublisher>(
+      std::set<std::string>{},
+      thrift::KeyDumpParams{},
+      createSnapshotCallback(),
+      std::chrono::steady_clock::now());
+  bool completed{false};
+  {
+    auto stream =
+        kvStorePublisher->createStream([&completed]() { completed = true; });
+    EXPECT_FALSE(completed);
+  }
+  EXPECT_TRUE(completed);
+}
+
+/**
+ * Subscriber lagging too far behind gets a snapshot instead of the updates it
+ * missed, while keys expired meanwhile are retained.
+ */
+TEST(KvStorePublisher, ResyncLaggingSubscriber) {
+  thrift::Publication snapshot;
+  snapshot.area() = "default";
+  snapshot.keyVals() = {{"key3", createThriftValue(1, "node1", "v1")}};
+
+  auto kvStorePublisher = std::make_shared<KvStorePublisher>(
+      std::set<std::string>{},
+      thrift::KeyDumpParams{},
+      createSnapshotCallback({snapshot}),
+      std::chrono::steady_clock::now());
+  auto stream = kvStorePublisher->createStream([]() {});
+
+  // Publish more than allowed pending bytes
+  const std::string value(
+      Constants::kKvStoreSubscriberMaxPendingBytes / 2 + 1, 'x');
+  thrift::Publication publication;
+  publication.area() = "default";
+  publication.expiredKeys() = {"key0"};
+  kvStorePublisher->publish(publication);
+  publication.expiredKeys()->clear();
+  for (auto const& key : {"key1", "key2"}) {
+    publication.keyVals() = {{key, createThriftValue(1, "node1", value)}};
+    kvStorePublisher->publish(publication);
+  }
+  EXPECT_EQ(1, *kvStorePublisher->getSubscriberInfo().num_resyncs());
+
+  // Updates dropped in favor of resync are not accounted as pending
+  const auto pendingBytes =
+      *kvStorePublisher->getSubscriberInfo().pending_bytes();
+  publication.keyVals() = {{"key4", createThriftValue(1, "node1", value)}};
+  kvStorePublisher->publish(publication);
+  EXPECT_EQ(
+      pendingBytes, *kvStorePublisher->getSubscriberInfo().pending_bytes());
+  EXPECT_EQ(1, *kvStorePublisher->getSubscriberInfo().num_resyncs());
+
+  // Resync is performed while stream is active. Only expired keys and then
+  // the snapshot gets delivered.
+  std::vector<thrift::Publication> publications;
+  folly::Baton<> baton;
+  auto subscription =
+      std::move(stream).toClientStreamUnsafeDoNotUse().subscribeExTry(
+          folly::getGlobalCPUExecutor().get(),
+          [&](folly::Try<thrift::Publication>&& receivedPublication) {
             if (receivedPublication.hasValue()) {
-              // we wil receive one key: adj:test1
-              EXPECT_EQ(1, receivedPublication->expiredKeys()->size());
-              for (auto& key : *receivedPublication->expiredKeys()) {
-                EXPECT_TRUE(prefixMatcher.match(key));
+              publications.emplace_back(std::move(*receivedPublication));
+              if (publications.size() == 2) {
+                baton.post();
               }
             }
           });
+  baton.wait();
+  ASSERT_EQ(2, publications.size());
+  EXPECT_THAT(*publications.at(0).expiredKeys(), testing::ElementsAre("key0"));
+  EXPECT_TRUE(publications.at(0).keyVals()->empty());
+  EXPECT_EQ(1, publications.at(1).keyVals()->count("key3"));
+
+  kvStorePublisher->complete();
+  std::move(subscription).join();
 }
+#endif
 
 int
 main(int argc, char* argv[]) {
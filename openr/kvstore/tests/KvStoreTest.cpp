@@ -325,6 +325,70 @@ TEST_F(KvStoreTestFixture, PublishKvStoreSyncedIfNoPeersInSomeAreas) {
   storeB->recvKvStoreSyncedSignal();
 }
 
+/**
+ * Verify KvStore running every area on a dedicated event base. KvStoreDb of
+ * each area must sync with its peers independently, while multi-area APIs
+ * (summary, counters) still report all areas.
+ */
+TEST_F(KvStoreTestFixture, PerAreaEventBase) {
+  messaging::ReplicateQueue<PeerEvent> storeBPeerUpdatesQueue;
+  auto storeBConf = getTestKvConf("storeB");
+  storeBConf.enable_per_area_event_base() = true;
+
+  auto* storeA = createKvStore(getTestKvConf("storeA"), {"area1"});
+  auto* storeB = createKvStore(
+      storeBConf, {"area1", "area2"}, storeBPeerUpdatesQueue.getReader());
+  auto* storeC = createKvStore(getTestKvConf("storeC"), {"area2"});
+  storeA->run();
+  storeB->run();
+  storeC->run();
+
+  // storeB owns one event base per configured area
+  EXPECT_EQ(2, storeB->getKvStore()->getAreaEventBases().size());
+
+  EXPECT_TRUE(
+      storeA->addPeer(AreaId{"area1"}, "storeB", storeB->getPeerSpec()));
+  EXPECT_TRUE(
+      storeC->addPeer(AreaId{"area2"}, "storeB", storeB->getPeerSpec()));
+
+  PeerEvent peerEvent;
+  peerEvent.emplace(
+      "area1",
+      AreaPeerEvent(
+          {{storeA->getNodeId(), storeA->getPeerSpec()}}, {} /*peersToDel*/));
+  peerEvent.emplace(
+      "area2",
+      AreaPeerEvent(
+          {{storeC->getNodeId(), storeC->getPeerSpec()}}, {} /*peersToDel*/));
+  storeBPeerUpdatesQueue.push(std::move(peerEvent));
+
+  // Initial sync is reported once both areas are synced
+  storeB->recvKvStoreSyncedSignal();
+
+  // Keys are flooded within their own area only
+  EXPECT_TRUE(storeA->setKey(
+      AreaId{"area1"}, "key1", createThriftValue(1, "storeA", "value1")));
+  EXPECT_TRUE(storeC->setKey(
+      AreaId{"area2"}, "key2", createThriftValue(1, "storeC", "value2")));
+  waitForKeyInStoreWithTimeout(storeB, AreaId{"area1"}, "key1");
+  waitForKeyInStoreWithTimeout(storeB, AreaId{"area2"}, "key2");
+  EXPECT_FALSE(storeB->getKey(AreaId{"area1"}, "key2").has_value());
+  EXPECT_FALSE(storeB->getKey(AreaId{"area2"}, "key1").has_value());
+
+  // Summary is collected from all area event bases
+  auto summaries = storeB->getSummary({});
+  ASSERT_EQ(2, summaries.size());
+  for (auto const& summary : summaries) {
+    EXPECT_EQ(1, *summary.keyValsCount());
+    EXPECT_EQ(1, summary.peersMap()->size());
+  }
+
+  // Counters are summed up across areas
+  auto counters = storeB->getCounters();
+  EXPECT_EQ(2, counters.at("kvstore.num_keys"));
+  EXPECT_EQ(2, counters.at("kvstore.num_peers"));
+}
+
 /**
  * Verify if an inconsistent update (a ttl update with incorrect key version) is
  * received. Two kvstore will resync and reach consistency.
@@ -5,6 +5,7 @@
  * LICENSE file in the root directory of this source tree.
  */
 
+#include <folly/experimental/TestUtil.h>
 #include <folly/init/Init.h>
 #include <folly/io/async/ScopedEventBaseThread.h>
 #include <gtest/gtest.h>
@@ -12,6 +13,7 @@
 #include <openr/common/OpenrClient.h>
 #include <openr/if/gen-cpp2/KvStoreServiceAsyncClient.h>
 #include <openr/if/gen-cpp2/KvStore_types.h>
+#include <openr/kvstore/KvStorePublicationTrace.h>
 #include <openr/kvstore/KvStoreUtil.h>
 #include <openr/kvstore/KvStoreWrapper.h>
 
@@ -472,6 +474,61 @@ TEST(KvStoreUtil, KvStoreFiltersTest) {
   ASSERT_FALSE(andFilter.keyMatch(node3_key1, node3_val1)); // No match
 }
 
+TEST(KvStoreUtil, MergePublicationTest) {
+  const auto value1 = createThriftValue(1, "node1", "value1", 3600, 0, 0);
+  const auto value2 = createThriftValue(2, "node1", "value2", 3600, 0, 0);
+  auto ttlUpdate = createThriftValue(2, "node1", "", 1800, 1, 0);
+  ttlUpdate.value().reset();
+
+  thrift::Publication pending;
+  pending.area() = "area1";
+  pending.keyVals() = {{"key1", value1}, {"key2", value1}};
+  pending.expiredKeys() = {"key3"};
+
+  // different area is never merged
+  {
+    thrift::Publication incoming;
+    incoming.area() = "area2";
+    auto pendingCopy = pending;
+    EXPECT_FALSE(mergePublication(pendingCopy, incoming));
+    EXPECT_EQ(pending, pendingCopy);
+  }
+
+  // flooding info is never merged
+  {
+    thrift::Publication incoming;
+    incoming.area() = "area1";
+    incoming.tobeUpdatedKeys() = std::vector<std::string>{"key1"};
+    auto pendingCopy = pending;
+    EXPECT_FALSE(mergePublication(pendingCopy, incoming));
+  }
+
+  // key1: updated, key2: expired, key3: revived
+  {
+    thrift::Publication incoming;
+    incoming.area() = "area1";
+    incoming.keyVals() = {{"key1", value2}, {"key3", value1}};
+    incoming.expiredKeys() = {"key2"};
+    EXPECT_TRUE(mergePublication(pending, incoming));
+    EXPECT_EQ(2, pending.keyVals()->size());
+    EXPECT_EQ(value2, pending.keyVals()->at("key1"));
+    EXPECT_EQ(value1, pending.keyVals()->at("key3"));
+    EXPECT_EQ(std::vector<std::string>{"key2"}, *pending.expiredKeys());
+  }
+
+  // ttl refresh retains pending value
+  {
+    thrift::Publication incoming;
+    incoming.area() = "area1";
+    incoming.keyVals() = {{"key1", ttlUpdate}};
+    EXPECT_TRUE(mergePublication(pending, incoming));
+    const auto& merged = pending.keyVals()->at("key1");
+    EXPECT_EQ("value2", merged.value().value());
+    EXPECT_EQ(1800, *merged.ttl());
+    EXPECT_EQ(1, *merged.ttlVersion());
+  }
+}
+
 TEST(KvStoreUtil, IsValidTtlTest) {
   EXPECT_TRUE(isValidTtl(1));
   EXPECT_TRUE(isValidTtl(Constants::kTtlInfinity));
@@ -505,6 +562,53 @@ TEST(KvStoreUtil, IsValidVersionTest) {
   }
 }
 
+/**
+ * Record publications into a trace and read them back. A truncated trailing
+ * record must be ignored without losing the records before it.
+ */
+TEST(KvStoreUtil, PublicationTraceTest) {
+  folly::test::TemporaryFile traceFile;
+  const std::string filePath = traceFile.path().string();
+
+  thrift::Publication pub1;
+  pub1.area() = kTestingAreaName;
+  pub1.keyVals()->emplace("key1", createThriftValue(1, "node1", "value1"));
+  thrift::Publication pub2;
+  pub2.area() = kTestingAreaName;
+  pub2.expiredKeys()->emplace_back("key1");
+
+  {
+    PublicationTraceWriter writer(filePath);
+    writer.append(std::chrono::milliseconds(0), pub1);
+    writer.append(std::chrono::milliseconds(1500), pub2);
+    EXPECT_EQ(2, writer.getNumRecords());
+  }
+
+  {
+    PublicationTraceReader reader(filePath);
+    auto record = reader.next();
+    ASSERT_TRUE(record.has_value());
+    EXPECT_EQ(std::chrono::milliseconds(0), record->timestamp);
+    EXPECT_EQ(pub1, record->publication);
+    record = reader.next();
+    ASSERT_TRUE(record.has_value());
+    EXPECT_EQ(std::chrono::milliseconds(1500), record->timestamp);
+    EXPECT_EQ(pub2, record->publication);
+    EXPECT_FALSE(reader.next().has_value());
+  }
+
+  // Chop off the tail of the last record
+  const auto fileSize = ::lseek(traceFile.fd(), 0, SEEK_END);
+  ASSERT_EQ(0, ::ftruncate(traceFile.fd(), fileSize - 1));
+  {
+    PublicationTraceReader reader(filePath);
+    auto record = reader.next();
+    ASSERT_TRUE(record.has_value());
+    EXPECT_EQ(pub1, record->publication);
+    EXPECT_FALSE(reader.next().has_value());
+  }
+}
+
 int
 main(int argc, char* argv[]) {
   // Parse command line flags
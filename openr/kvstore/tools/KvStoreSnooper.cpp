@@ -13,12 +13,18 @@
 #include <openr/common/OpenrClient.h>
 #include <openr/if/gen-cpp2/OpenrCtrlCppAsyncClient.h>
 #include <openr/kvstore/KvStore.h>
+#include <openr/kvstore/KvStorePublicationTrace.h>
 #include <openr/kvstore/KvStoreUtil.h>
 
 DEFINE_string(host, "::1", "Host to connect to");
 DEFINE_int32(port, openr::Constants::kOpenrCtrlPort, "OpenrCtrl server port");
 DEFINE_int32(connect_timeout_ms, 1000, "Connect timeout for client");
 DEFINE_int32(processing_timeout_ms, 5000, "Processing timeout for client");
+DEFINE_string(
+    record_file,
+    "",
+    "If set, record initial dump and all publications received into this "
+    "file for replay (see decision_replay_benchmark)");
 
 int
 main(int argc, char** argv) {
@@ -29,6 +35,15 @@ main(int argc, char** argv) {
   folly::EventBase evb;
   std::thread evbThread([&evb]() { evb.loopForever(); });
 
+  // Create trace writer if recording is requested. Timestamps are relative
+  // to the initial dump.
+  std::unique_ptr<openr::PublicationTraceWriter> traceWriter;
+  if (not FLAGS_record_file.empty()) {
+    traceWriter =
+        std::make_unique<openr::PublicationTraceWriter>(FLAGS_record_file);
+    XLOG(INFO) << "Recording publications into " << FLAGS_record_file;
+  }
+
   // Create Open/R client
   auto client = openr::getOpenrCtrlPlainTextClient<
       openr::thrift::OpenrCtrlCppAsyncClient,
@@ -39,6 +54,7 @@ main(int argc, char** argv) {
       std::chrono::milliseconds(FLAGS_connect_timeout_ms),
       std::chrono::milliseconds(FLAGS_processing_timeout_ms));
   auto response = client->semifuture_subscribeAndGetAreaKvStores({}, {}).get();
+  const auto captureStart = std::chrono::steady_clock::now();
   std::unordered_map<
       std::string /* area */,
       std::unordered_map<std::string /* key */, openr::thrift::Value>>
@@ -48,6 +64,9 @@ main(int argc, char** argv) {
     XLOG(INFO) << "Received " << pub.keyVals()->size()
                << " entries in initial dump for area: " << *pub.area();
     areaKeyVals[*pub.area()] = *pub.keyVals();
+    if (traceWriter) {
+      traceWriter->append(std::chrono::milliseconds(0), pub);
+    }
   }
   XLOG(INFO) << "";
 
@@ -55,13 +74,21 @@ main(int argc, char** argv) {
       std::move(response.stream)
           .subscribeExTry(
               folly::Executor::getKeepAliveToken(&evb),
-              [areaKeyVals = std::move(areaKeyVals)](
+              [areaKeyVals = std::move(areaKeyVals),
+               traceWriter = std::move(traceWriter),
+               captureStart](
                   folly::Try<openr::thrift::Publication>&& maybePub) mutable {
                 if (maybePub.hasException()) {
                   XLOG(ERR) << maybePub.exception().what();
                   return;
                 }
                 auto& pub = maybePub.value();
+                if (traceWriter) {
+                  traceWriter->append(
+                      std::chrono::duration_cast<std::chrono::milliseconds>(
+                          std::chrono::steady_clock::now() - captureStart),
+                      pub);
+                }
                 // Print expired key-vals
                 for (const auto& key : *pub.expiredKeys()) {
                   std::cout << "Expired Key: " << key << std::endl;
@@ -7,6 +7,9 @@
 
 #pragma once
 
+#include <chrono>
+#include <optional>
+
 #include <folly/io/async/AsyncTimeout.h>
 
 #include <openr/common/AsyncThrottle.h>
@@ -57,6 +60,12 @@ class AdjacencyEntry final {
   // metric info from Spark module
   int32_t baseMetric_;
 
+  // [RTT damping] time of last advertised RTT change (or adjacency up)
+  // and latest RTT held back since then, if any
+  std::chrono::steady_clock::time_point lastRttMetricChange_{
+      std::chrono::steady_clock::now()};
+  std::optional<int64_t> pendingRttUs_;
+
   // flag for WARM_BOOT(GR) and COLD_BOOT processing
   bool isRestarting_{false};
   bool onlyUsedByOtherNode_{false};
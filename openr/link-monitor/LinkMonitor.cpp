@@ -113,12 +113,17 @@ LinkMonitor::LinkMonitor(
     : nodeId_(config->getNodeName()),
       enablePerfMeasurement_(
           *config->getLinkMonitorConfig().enable_perf_measurement()),
+      adjDbShards_(config->getAdjDbShards()),
       enableV4_(config->isV4Enabled()),
       enableSegmentRouting_(config->isSegmentRoutingEnabled()),
       prefixForwardingType_(*config->getConfig().prefix_forwarding_type()),
       prefixForwardingAlgorithm_(
           *config->getConfig().prefix_forwarding_algorithm()),
       useRttMetric_(*config->getLinkMonitorConfig().use_rtt_metric()),
+      rttMetricChangeThresholdPct_(
+          *config->getLinkMonitorConfig().rtt_metric_change_threshold_pct()),
+      rttMetricHoldTime_(std::chrono::milliseconds(
+          *config->getLinkMonitorConfig().rtt_metric_hold_time_ms())),
       linkflapInitBackoff_(std::chrono::milliseconds(
           *config->getLinkMonitorConfig().linkflap_initial_backoff_ms())),
       linkflapMaxBackoff_(std::chrono::milliseconds(
@@ -176,6 +181,23 @@ LinkMonitor::LinkMonitor(
   advertiseIfaceAddrTimer_->scheduleTimeout(
       Constants::kMaxDurationLinkDiscovery);
 
+  // [RTT damping] timer applying held back RTT changes
+  rttDampingTimer_ = folly::AsyncTimeout::make(
+      *getEvb(), [this]() noexcept { processPendingRttChanges(); });
+
+  adjDbClearTimer_ = folly::AsyncTimeout::make(*getEvb(), [this]() noexcept {
+    // ATTN: KvStore unsets the key only if it is known, e.g. left behind by
+    // a previous run without sharding
+    for (auto& [area, emptyAdjDbStr] : pendingAdjDbClears_) {
+      kvRequestQueue_.push(ClearKeyValueRequest(
+          AreaId{area},
+          Constants::kAdjDbMarker.toString() + nodeId_,
+          std::move(emptyAdjDbStr),
+          true));
+    }
+    pendingAdjDbClears_.clear();
+  });
+
   /*
    * [Config-Store]
    *
@@ -319,14 +341,24 @@ LinkMonitor::LinkMonitor(
 
   // Add fiber to process the LINK/ADDR events from platform
   addFiberTask([q = std::move(netlinkEventsQueue), this]() mutable noexcept {
-    NetlinkEventProcessor visitor(*this);
     while (true) {
       auto maybeEvent = q.get();
       if (maybeEvent.hasError()) {
         XLOG(INFO) << "Terminating netlink events processing fiber";
         break;
       }
-      std::visit(visitor, std::move(*maybeEvent));
+      // Drain events already queued up, e.g. netlink storm on boot, and
+      // process them as one burst
+      std::vector<fbnl::NetlinkEvent> events;
+      events.emplace_back(std::move(*maybeEvent));
+      while (q.size() > 0) {
+        maybeEvent = q.get();
+        if (maybeEvent.hasError()) {
+          break;
+        }
+        events.emplace_back(std::move(*maybeEvent));
+      }
+      processNetlinkEvents(std::move(events));
     }
   });
 
@@ -341,6 +373,8 @@ LinkMonitor::LinkMonitor(
   fb303::fbData->addStatExportType("link_monitor.advertise_links", fb303::SUM);
   fb303::fbData->addStatExportType(
       "link_monitor.sync_interface.failure", fb303::SUM);
+  fb303::fbData->addStatExportType(
+      "link_monitor.netlink_events_coalesced", fb303::SUM);
 }
 
 void
@@ -555,14 +589,113 @@ LinkMonitor::neighborRttChangeEvent(const NeighborEvent& event) {
              << " on interface: " << localIfName << " to " << newRttMetric;
 
   auto areaAdjIt = adjacencies_.find(area);
-  if (areaAdjIt != adjacencies_.end()) {
-    auto it = areaAdjIt->second.find({remoteNodeName, localIfName});
-    if (it != areaAdjIt->second.end()) {
-      auto& adj = it->second.adj_;
-      adj.metric() = newRttMetric;
-      adj.rtt() = rttUs;
-      advertiseAdjacenciesThrottledPerArea_.at(area)->operator()();
+  if (areaAdjIt == adjacencies_.end()) {
+    return;
+  }
+  auto it = areaAdjIt->second.find({remoteNodeName, localIfName});
+  if (it == areaAdjIt->second.end()) {
+    return;
+  }
+  auto& adjEntry = it->second;
+
+  // [RTT damping] Hysteresis. Ignore jitter around the advertised RTT and
+  // drop any change held back so far, RTT is back to where it was.
+  const int64_t advertisedRttMetric = getRttMetric(*adjEntry.adj_.rtt());
+  if (std::abs(newRttMetric - advertisedRttMetric) * 100 <=
+      rttMetricChangeThresholdPct_ * advertisedRttMetric) {
+    const bool hadPendingChange = adjEntry.pendingRttUs_.has_value();
+    if (hadPendingChange) {
+      adjEntry.pendingRttUs_.reset();
+      pendingRttChanges_[area].erase(it->first);
+    }
+    if (hadPendingChange or newRttMetric != advertisedRttMetric) {
+      fb303::fbData->addStatValue(
+          "link_monitor.rtt_changes_suppressed", 1, fb303::SUM);
+    }
+    if (newRttMetric == advertisedRttMetric) {
+      // Same metric, only RTT got refined
+      adjEntry.adj_.rtt() = rttUs;
     }
+    return;
+  }
+
+  // [RTT damping] Hold time. Hold back change, only the latest one is applied
+  // once hold time since last change expires.
+  const auto holdExpiry = adjEntry.lastRttMetricChange_ + rttMetricHoldTime_;
+  const auto now = std::chrono::steady_clock::now();
+  if (holdExpiry > now) {
+    if (adjEntry.pendingRttUs_.has_value()) {
+      fb303::fbData->addStatValue(
+          "link_monitor.rtt_changes_suppressed", 1, fb303::SUM);
+    }
+    adjEntry.pendingRttUs_ = rttUs;
+    pendingRttChanges_[area].emplace(it->first);
+    if (not rttDampingTimer_->isScheduled()) {
+      rttDampingTimer_->scheduleTimeout(
+          std::chrono::ceil<std::chrono::milliseconds>(holdExpiry - now));
+    }
+    return;
+  }
+
+  applyRttChange(area, adjEntry, rttUs);
+}
+
+void
+LinkMonitor::applyRttChange(
+    const std::string& area, AdjacencyEntry& adjEntry, int64_t rttUs) {
+  // NOTE: advertised metric stays `baseMetric_`, see buildAdjacencyDatabase()
+  adjEntry.adj_.metric() = getRttMetric(rttUs);
+  adjEntry.adj_.rtt() = rttUs;
+  adjEntry.lastRttMetricChange_ = std::chrono::steady_clock::now();
+  adjEntry.pendingRttUs_.reset();
+  fb303::fbData->addStatValue(
+      "link_monitor.rtt_changes_propagated", 1, fb303::SUM);
+  advertiseAdjacenciesThrottledPerArea_.at(area)->operator()();
+}
+
+void
+LinkMonitor::processPendingRttChanges() {
+  const auto now = std::chrono::steady_clock::now();
+  std::optional<std::chrono::steady_clock::time_point> nextExpiry;
+
+  for (auto areaIt = pendingRttChanges_.begin();
+       areaIt != pendingRttChanges_.end();) {
+    auto& [area, adjKeys] = *areaIt;
+    for (auto keyIt = adjKeys.begin(); keyIt != adjKeys.end();) {
+      // Adjacency may have gone down or up again meanwhile
+      AdjacencyEntry* adjEntryPtr{nullptr};
+      auto areaAdjIt = adjacencies_.find(area);
+      if (areaAdjIt != adjacencies_.end()) {
+        auto adjIt = areaAdjIt->second.find(*keyIt);
+        if (adjIt != areaAdjIt->second.end() and
+            adjIt->second.pendingRttUs_.has_value()) {
+          adjEntryPtr = &adjIt->second;
+        }
+      }
+      if (not adjEntryPtr) {
+        keyIt = adjKeys.erase(keyIt);
+        continue;
+      }
+      auto& adjEntry = *adjEntryPtr;
+      const auto holdExpiry =
+          adjEntry.lastRttMetricChange_ + rttMetricHoldTime_;
+      if (holdExpiry > now) {
+        nextExpiry = nextExpiry.has_value() ? std::min(*nextExpiry, holdExpiry)
+                                            : holdExpiry;
+        ++keyIt;
+        continue;
+      }
+      // Advertisement is throttled per area, hence all changes applied here
+      // go out in one adjacency database update
+      applyRttChange(area, adjEntry, *adjEntry.pendingRttUs_);
+      keyIt = adjKeys.erase(keyIt);
+    }
+    areaIt = adjKeys.empty() ? pendingRttChanges_.erase(areaIt) : ++areaIt;
+  }
+
+  if (nextExpiry.has_value()) {
+    rttDampingTimer_->scheduleTimeout(
+        std::chrono::ceil<std::chrono::milliseconds>(*nextExpiry - now));
   }
 }
 
@@ -706,12 +839,16 @@ LinkMonitor::advertiseAdjacencies(const std::string& area) {
       adjDb.adjacencies()->size(),
       area);
 
-  // Persist `adj:node_Id` key into KvStore
-  const auto keyName = Constants::kAdjDbMarker.toString() + nodeId_;
-  std::string adjDbStr = writeThriftObjStr(adjDb, serializer_);
-  auto persistAdjacencyKeyVal =
-      PersistKeyValueRequest(AreaId{area}, keyName, adjDbStr);
-  kvRequestQueue_.push(std::move(persistAdjacencyKeyVal));
+  if (adjDbShards_ > 0) {
+    advertiseAdjacencyShards(area, std::move(adjDb));
+  } else {
+    // Persist `adj:node_Id` key into KvStore
+    const auto keyName = Constants::kAdjDbMarker.toString() + nodeId_;
+    std::string adjDbStr = writeThriftObjStr(adjDb, serializer_);
+    auto persistAdjacencyKeyVal =
+        PersistKeyValueRequest(AreaId{area}, keyName, adjDbStr);
+    kvRequestQueue_.push(std::move(persistAdjacencyKeyVal));
+  }
 
   // Config is most likely to have changed. Update it in `ConfigStore`
   configStore_->storeThriftObj(kConfigKey, state_); // not awaiting on result
@@ -729,6 +866,81 @@ LinkMonitor::advertiseAdjacencies(const std::string& area) {
   }
 }
 
+void
+LinkMonitor::advertiseAdjacencyShards(
+    const std::string& area, thrift::AdjacencyDatabase&& adjDb) {
+  // Every shard carries node attributes (overload, node label etc.) plus the
+  // adjacencies towards neighbors assigned to it. Perf events are stamped on
+  // advertisement only, so that shards can be compared against the ones
+  // advertised before.
+  auto perfEvents = adjDb.perfEvents().to_optional();
+  adjDb.perfEvents().reset();
+  auto adjacencies = std::move(*adjDb.adjacencies());
+  adjDb.adjacencies()->clear();
+
+  std::map<uint32_t, thrift::AdjacencyDatabase> shards;
+  for (auto& adj : adjacencies) {
+    const auto shardId =
+        AdjDbShardKey::getShardId(*adj.otherNodeName(), adjDbShards_);
+    auto it = shards.find(shardId);
+    if (it == shards.end()) {
+      it = shards.emplace(shardId, adjDb).first;
+    }
+    it->second.adjacencies()->emplace_back(std::move(adj));
+  }
+  // Node without any adjacency still advertises its attributes
+  if (shards.empty()) {
+    shards.emplace(0, adjDb);
+  }
+
+  auto& advertisedShards = advertisedAdjDbShards_[area];
+  if (advertisedShards.empty()) {
+    // First advertisement in this area. Withdraw `adj:node_Id` key left behind
+    // by a previous run without sharding, if any. Peers must learn about the
+    // shards first, they ignore an empty database of a sharded node only.
+    pendingAdjDbClears_.insert_or_assign(
+        area, writeThriftObjStr(adjDb, serializer_));
+    if (not adjDbClearTimer_->isScheduled()) {
+      adjDbClearTimer_->scheduleTimeout(Constants::kAdjDbUnshardedClearDelay);
+    }
+  }
+
+  // Withdraw shards left without adjacencies. They are flooded empty (instead
+  // of only not being refreshed anymore) so that links go down right away.
+  for (auto it = advertisedShards.begin(); it != advertisedShards.end();) {
+    if (shards.count(it->first)) {
+      ++it;
+      continue;
+    }
+    kvRequestQueue_.push(ClearKeyValueRequest(
+        AreaId{area},
+        AdjDbShardKey(nodeId_, it->first).getAdjDbShardKeyStr(),
+        writeThriftObjStr(adjDb, serializer_),
+        true));
+    it = advertisedShards.erase(it);
+  }
+
+  // Advertise changed shards only
+  for (auto& [shardId, shardDb] : shards) {
+    auto it = advertisedShards.find(shardId);
+    if (it != advertisedShards.end() and it->second == shardDb) {
+      continue;
+    }
+    auto shardDbToAdvertise = shardDb;
+    if (perfEvents.has_value()) {
+      shardDbToAdvertise.perfEvents() = *perfEvents;
+    }
+    kvRequestQueue_.push(PersistKeyValueRequest(
+        AreaId{area},
+        AdjDbShardKey(nodeId_, shardId).getAdjDbShardKeyStr(),
+        writeThriftObjStr(shardDbToAdvertise, serializer_)));
+    advertisedShards.insert_or_assign(shardId, std::move(shardDb));
+
+    fb303::fbData->addStatValue(
+        "link_monitor.advertise_adjacency_shards", 1, fb303::SUM);
+  }
+}
+
 void
 LinkMonitor::advertiseAdjacencies() {
   // advertise to all areas. Once area configuration per link is implemented
@@ -763,12 +975,13 @@ LinkMonitor::advertiseIfaceAddr() {
 void
 LinkMonitor::advertiseInterfaces() {
   fb303::fbData->addStatValue("link_monitor.advertise_links", 1, fb303::SUM);
+  ++dumpLinksReplyGeneration_;
 
   // Create interface database
   InterfaceDatabase ifDb;
   for (auto& [_, interface] : interfaces_) {
     // Perform regex match
-    if (not anyAreaShouldDiscoverOnIface(interface.getIfName())) {
+    if (not getInterfaceAreas(interface.getIfName()).shouldDiscover) {
       continue;
     }
     // Transform to `InterfaceInfo` object
@@ -809,12 +1022,8 @@ LinkMonitor::advertiseRedistAddrs() {
     }
 
     // Derive list of area to advertise (NOTE: areas are ordered persistently)
-    std::vector<std::string> dstAreas;
-    for (auto const& [areaId, areaConf] : areas_) {
-      if (areaConf.shouldRedistributeIface(interface.getIfName())) {
-        dstAreas.emplace_back(areaId);
-      }
-    }
+    auto const& dstAreas =
+        getInterfaceAreas(interface.getIfName()).redistributeAreas;
 
     // Do not advertise interface addresses if no destination area qualifies
     if (dstAreas.empty()) {
@@ -1008,18 +1217,18 @@ LinkMonitor::buildAdjacencyDatabase(const std::string& area) {
 
 InterfaceEntry* FOLLY_NULLABLE
 LinkMonitor::getOrCreateInterfaceEntry(const std::string& ifName) {
-  // Return null if ifName doesn't quality regex match criteria
-  if (not anyAreaShouldDiscoverOnIface(ifName) &&
-      not anyAreaShouldRedistributeIface(ifName)) {
-    return nullptr;
-  }
-
-  // Return existing element if any
+  // Return existing element if any. It already qualified regex match.
   auto it = interfaces_.find(ifName);
   if (it != interfaces_.end()) {
     return &(it->second);
   }
 
+  // Return null if ifName doesn't quality regex match criteria
+  auto const& ifAreas = getInterfaceAreas(ifName);
+  if (not ifAreas.shouldDiscover and ifAreas.redistributeAreas.empty()) {
+    return nullptr;
+  }
+
   // Create one and return it's reference
   auto res = interfaces_.emplace(
       ifName,
@@ -1119,6 +1328,14 @@ LinkMonitor::syncInterfaces() {
       continue;
     }
 
+    // Most interfaces are in sync with netlink events already. Skip them
+    // without copying their addresses.
+    if (interfaceEntry->getIfIndex() == info.ifIndex and
+        interfaceEntry->isUp() == info.isUp and
+        interfaceEntry->getNetworks() == info.networks) {
+      continue;
+    }
+
     const auto oldNetworks =
         interfaceEntry->getNetworks(); // NOTE: Copy intended
     const auto& newNetworks = info.networks;
@@ -1148,6 +1365,16 @@ LinkMonitor::syncInterfaces() {
       }
     }
   }
+
+  // Drop cached regex matches of links which are gone. Netlink events don't
+  // tell link deletion apart from link down, hence prune upon sync only.
+  std::unordered_set<std::string> ifNames;
+  for (const auto& info : ifDb) {
+    ifNames.emplace(info.ifName);
+  }
+  for (auto it = interfaceAreas_.begin(); it != interfaceAreas_.end();) {
+    it = ifNames.count(it->first) ? std::next(it) : interfaceAreas_.erase(it);
+  }
   return true;
 }
 
@@ -1199,6 +1426,42 @@ LinkMonitor::processAddressEvent(fbnl::IfAddress&& addr) {
   }
 }
 
+void
+LinkMonitor::processNetlinkEvents(std::vector<fbnl::NetlinkEvent>&& events) {
+  // Walk backwards to find address events superseded by a later one for the
+  // same address. Link events can remap ifIndex to another interface, hence
+  // don't coalesce address events across them.
+  std::vector<bool> superseded(events.size(), false);
+  std::unordered_map<int64_t, std::unordered_set<folly::CIDRNetwork>>
+      laterAddrs;
+  for (size_t i = events.size(); i-- > 0;) {
+    if (auto link = std::get_if<fbnl::Link>(&events.at(i))) {
+      laterAddrs.erase(link->getIfIndex());
+    } else if (auto addr = std::get_if<fbnl::IfAddress>(&events.at(i))) {
+      auto prefix = addr->getPrefix();
+      superseded.at(i) = prefix.has_value() and
+          not laterAddrs[addr->getIfIndex()].emplace(prefix.value()).second;
+    }
+  }
+
+  NetlinkEventProcessor visitor(*this);
+  size_t numCoalesced{0};
+  for (size_t i = 0; i < events.size(); ++i) {
+    if (superseded.at(i)) {
+      ++numCoalesced;
+      continue;
+    }
+    std::visit(visitor, std::move(events.at(i)));
+  }
+
+  XLOG_IF(DBG2, events.size() > 1) << fmt::format(
+      "Processed burst of {} netlink events, {} coalesced",
+      events.size(),
+      numCoalesced);
+  fb303::fbData->addStatValue(
+      "link_monitor.netlink_events_coalesced", numCoalesced, fb303::SUM);
+}
+
 void
 LinkMonitor::processNeighborEvents(NeighborEvents&& events) {
   for (const auto& event : events) {
@@ -1269,6 +1532,7 @@ LinkMonitor::semifuture_setNodeOverload(bool isOverloaded) {
                  << (isOverloaded ? "OVERLOADED" : "NOT OVERLOADED") << "]";
     } else {
       state_.isOverloaded() = isOverloaded;
+      ++dumpLinksReplyGeneration_;
       SYSLOG(INFO) << EventTag() << (isOverloaded ? "Setting" : "Unsetting")
                    << " overload bit for node";
       advertiseAdjacencies();
@@ -1597,51 +1861,71 @@ LinkMonitor::semifuture_getInterfaces() {
   folly::Promise<std::unique_ptr<thrift::DumpLinksReply>> p;
   auto sf = p.getSemiFuture();
   runInEventBaseThread([this, p = std::move(p)]() mutable {
-    thrift::DumpLinksReply reply;
+    p.setValue(std::make_unique<thrift::DumpLinksReply>(buildDumpLinksReply()));
+  });
+  return sf;
+}
 
-    // Populate nodeId
-    reply.thisNodeName() = nodeId_;
+folly::SemiFuture<std::unique_ptr<thrift::VersionedInterfaces>>
+LinkMonitor::semifuture_getInterfacesVersioned(int64_t lastGeneration) {
+  folly::Promise<std::unique_ptr<thrift::VersionedInterfaces>> p;
+  auto sf = p.getSemiFuture();
+  runInEventBaseThread([this, p = std::move(p), lastGeneration]() mutable {
+    auto versionedInterfaces = std::make_unique<thrift::VersionedInterfaces>();
+    versionedInterfaces->generation() = dumpLinksReplyGeneration_;
+    if (lastGeneration != dumpLinksReplyGeneration_) {
+      versionedInterfaces->interfaces() = buildDumpLinksReply();
+    }
+    p.setValue(std::move(versionedInterfaces));
+  });
+  return sf;
+}
 
-    // Populate node-level overload state(hard-drain)
-    reply.isOverloaded() = *state_.isOverloaded();
+thrift::DumpLinksReply
+LinkMonitor::buildDumpLinksReply() const {
+  thrift::DumpLinksReply reply;
 
-    // Populate node-level metric override(soft-drain)
-    reply.nodeMetricIncrementVal() = *state_.nodeMetricIncrementVal();
+  // Populate nodeId
+  reply.thisNodeName() = nodeId_;
 
-    // Fill interface details
-    for (auto& [_, interface] : interfaces_) {
-      const auto& ifName = interface.getIfName();
+  // Populate node-level overload state(hard-drain)
+  reply.isOverloaded() = *state_.isOverloaded();
 
-      thrift::InterfaceDetails ifDetails;
-      ifDetails.info() = interface.getInterfaceInfo().toThrift();
+  // Populate node-level metric override(soft-drain)
+  reply.nodeMetricIncrementVal() = *state_.nodeMetricIncrementVal();
 
-      // Populate link-level overload state
-      ifDetails.isOverloaded() = state_.overloadedLinks()->count(ifName) > 0;
+  // Fill interface details
+  for (auto& [_, interface] : interfaces_) {
+    const auto& ifName = interface.getIfName();
 
-      // [TO_BE_DEPRECATED] Add metric override if any
-      if (state_.linkMetricOverrides()->count(ifName) > 0) {
-        ifDetails.metricOverride() = state_.linkMetricOverrides()->at(ifName);
-      }
+    thrift::InterfaceDetails ifDetails;
+    ifDetails.info() = interface.getInterfaceInfo().toThrift();
 
-      // Populate link-level metric override if any
-      if (state_.linkMetricIncrementMap()->count(ifName) > 0) {
-        ifDetails.linkMetricIncrementVal() =
-            state_.linkMetricIncrementMap()->at(ifName);
-      }
+    // Populate link-level overload state
+    ifDetails.isOverloaded() = state_.overloadedLinks()->count(ifName) > 0;
 
-      // Add link-backoff
-      auto backoffMs = interface.getBackoffDuration();
-      if (backoffMs.count() != 0) {
-        ifDetails.linkFlapBackOffMs() = backoffMs.count();
-      } else {
-        ifDetails.linkFlapBackOffMs().reset();
-      }
+    // [TO_BE_DEPRECATED] Add metric override if any
+    if (state_.linkMetricOverrides()->count(ifName) > 0) {
+      ifDetails.metricOverride() = state_.linkMetricOverrides()->at(ifName);
+    }
 
-      reply.interfaceDetails()->emplace(ifName, std::move(ifDetails));
+    // Populate link-level metric override if any
+    if (state_.linkMetricIncrementMap()->count(ifName) > 0) {
+      ifDetails.linkMetricIncrementVal() =
+          state_.linkMetricIncrementMap()->at(ifName);
     }
-    p.setValue(std::make_unique<thrift::DumpLinksReply>(std::move(reply)));
-  });
-  return sf;
+
+    // Add link-backoff
+    auto backoffMs = interface.getBackoffDuration();
+    if (backoffMs.count() != 0) {
+      ifDetails.linkFlapBackOffMs() = backoffMs.count();
+    } else {
+      ifDetails.linkFlapBackOffMs().reset();
+    }
+
+    reply.interfaceDetails()->emplace(ifName, std::move(ifDetails));
+  }
+  return reply;
 }
 
 folly::SemiFuture<std::unique_ptr<std::vector<thrift::AdjacencyDatabase>>>
@@ -1794,22 +2078,21 @@ LinkMonitor::logPeerEvent(
                << ", port: " << std::to_string(ctrlPort);
 }
 
-bool
-LinkMonitor::anyAreaShouldDiscoverOnIface(std::string const& iface) const {
-  bool anyMatch = false;
-  for (auto const& [_, areaConf] : areas_) {
-    anyMatch |= areaConf.shouldDiscoverOnIface(iface);
+LinkMonitor::InterfaceAreas const&
+LinkMonitor::getInterfaceAreas(std::string const& iface) {
+  auto it = interfaceAreas_.find(iface);
+  if (it != interfaceAreas_.end()) {
+    return it->second;
   }
-  return anyMatch;
-}
 
-bool
-LinkMonitor::anyAreaShouldRedistributeIface(std::string const& iface) const {
-  bool anyMatch = false;
-  for (auto const& [_, areaConf] : areas_) {
-    anyMatch |= areaConf.shouldRedistributeIface(iface);
+  InterfaceAreas ifAreas;
+  for (auto const& [areaId, areaConf] : areas_) {
+    ifAreas.shouldDiscover |= areaConf.shouldDiscoverOnIface(iface);
+    if (areaConf.shouldRedistributeIface(iface)) {
+      ifAreas.redistributeAreas.emplace_back(areaId);
+    }
   }
-  return anyMatch;
+  return interfaceAreas_.emplace(iface, std::move(ifAreas)).first->second;
 }
 
 int32_t
@@ -1826,6 +2109,9 @@ LinkMonitor::getStaticNodeSegmentLabel(
 
 void
 LinkMonitor::scheduleAdvertiseAdjAllArea() {
+  // Called upon drain and metric override changes, which are part of link
+  // information as well
+  ++dumpLinksReplyGeneration_;
   for (const auto& [area, _] : areas_) {
     advertiseAdjacenciesThrottledPerArea_.at(area)->operator()();
   }
@@ -150,6 +150,8 @@ class LinkMonitor final : public OpenrEventBase {
    */
   folly::SemiFuture<std::unique_ptr<thrift::DumpLinksReply>>
   semifuture_getInterfaces();
+  folly::SemiFuture<std::unique_ptr<thrift::VersionedInterfaces>>
+  semifuture_getInterfacesVersioned(int64_t lastGeneration);
   folly::SemiFuture<InterfaceDatabase> semifuture_getAllLinks();
   folly::SemiFuture<std::unique_ptr<
       std::map<std::string, std::vector<thrift::AdjacencyDatabase>>>>
@@ -181,6 +183,19 @@ class LinkMonitor final : public OpenrEventBase {
   void neighborDownEvent(const NeighborEvent& event);
   void neighborRttChangeEvent(const NeighborEvent& event);
 
+  /*
+   * [RTT damping] Update RTT of adjacency to `rttUs` and schedule
+   * advertisement of its area. Adjacency metric is left untouched.
+   */
+  void applyRttChange(
+      const std::string& area, AdjacencyEntry& adjEntry, int64_t rttUs);
+
+  /*
+   * [RTT damping] Apply held back RTT changes whose hold time expired, all in
+   * one batch, and re-arm the timer for the remaining ones.
+   */
+  void processPendingRttChanges();
+
   /*
    * [Netlink Platform]
    *
@@ -195,6 +210,10 @@ class LinkMonitor final : public OpenrEventBase {
   void processLinkEvent(fbnl::Link&& link);
   void processAddressEvent(fbnl::IfAddress&& addr);
 
+  // Process a burst of events read off the netlink queue at once. Address
+  // events superseded by a later event for the same address are dropped.
+  void processNetlinkEvents(std::vector<fbnl::NetlinkEvent>&& events);
+
   void syncInterfaceTask() noexcept;
   bool syncInterfaces();
 
@@ -237,6 +256,14 @@ class LinkMonitor final : public OpenrEventBase {
    */
   void advertiseAdjacencies(const std::string& area);
   void advertiseAdjacencies(); // Advertise my adjacencies_ in to all areas
+
+  /*
+   * [Kvstore] Advertise `adjDb` as `adj:<node>:shard:<shard>` keys. Only
+   * shards whose content changed since last advertisement are written. Shards
+   * left without adjacencies are withdrawn.
+   */
+  void advertiseAdjacencyShards(
+      const std::string& area, thrift::AdjacencyDatabase&& adjDb);
   void scheduleAdvertiseAdjAllArea();
   /*
    * [Spark/Fib] Advertise interfaces_ over interfaceUpdatesQueue_ to Spark/Fib
@@ -275,11 +302,22 @@ class LinkMonitor final : public OpenrEventBase {
   // build AdjacencyDatabase
   thrift::AdjacencyDatabase buildAdjacencyDatabase(const std::string& area);
 
-  // returns any(a.shouldDiscoverOnIface(iface) for a in areas_)
-  bool anyAreaShouldDiscoverOnIface(std::string const& iface) const;
+  // build DumpLinksReply out of interfaces and drain state
+  thrift::DumpLinksReply buildDumpLinksReply() const;
+
+  // Result of matching an interface name against discover/redistribute
+  // regexes of all areas
+  struct InterfaceAreas {
+    // any(a.shouldDiscoverOnIface(iface) for a in areas_)
+    bool shouldDiscover{false};
+    // [a for a in areas_ if a.shouldRedistributeIface(iface)], ordered
+    std::vector<std::string> redistributeAreas;
+  };
 
-  // returns any(a.anyAreaShouldRedistributeIface(iface) for a in areas_)
-  bool anyAreaShouldRedistributeIface(std::string const& iface) const;
+  // Regex matching dominates per-event cost with hundreds of interfaces,
+  // hence results are cached per interface name. Areas don't change at
+  // runtime.
+  InterfaceAreas const& getInterfaceAreas(std::string const& iface);
 
   // Total # of adjacencies stored.
   size_t getTotalAdjacencies();
@@ -317,6 +355,8 @@ class LinkMonitor final : public OpenrEventBase {
   const std::string nodeId_;
   // enable performance measurement
   const bool enablePerfMeasurement_{false};
+  // number of adjacency database shards, 0 if sharding is disabled
+  const uint32_t adjDbShards_{0};
   // enable v4
   bool enableV4_{false};
   // enable segment routing
@@ -326,6 +366,10 @@ class LinkMonitor final : public OpenrEventBase {
   thrift::PrefixForwardingAlgorithm prefixForwardingAlgorithm_;
   // Use spark measured RTT to neighbor as link metric
   bool useRttMetric_{false};
+  // RTT damping: hysteresis (in percent of advertised RTT metric) and minimum
+  // time between advertised RTT changes of an adjacency
+  const int32_t rttMetricChangeThresholdPct_{0};
+  const std::chrono::milliseconds rttMetricHoldTime_{0};
   // link flap back offs
   std::chrono::milliseconds linkflapInitBackoff_;
   std::chrono::milliseconds linkflapMaxBackoff_;
@@ -345,6 +389,11 @@ class LinkMonitor final : public OpenrEventBase {
   // LinkMonitor config attributes
   thrift::LinkMonitorState state_;
 
+  // Generation of DumpLinksReply served by versioned API. Bumped whenever
+  // interfaces get advertised and on drain/metric override changes. Link
+  // backoff counting down alone doesn't bump it.
+  int64_t dumpLinksReplyGeneration_{getInitialGeneration()};
+
   // Queue to publish interface updates to fib/spark
   messaging::ReplicateQueue<InterfaceDatabase>& interfaceUpdatesQueue_;
 
@@ -373,6 +422,18 @@ class LinkMonitor final : public OpenrEventBase {
       std::unordered_map<AdjacencyKey, AdjacencyEntry>>
       adjacencies_;
 
+  // Adjacency database shards last advertised, without perf events. Only
+  // used if adjacency database sharding is enabled.
+  std::unordered_map<
+      std::string /* area */,
+      std::map<uint32_t /* shardId */, thrift::AdjacencyDatabase>>
+      advertisedAdjDbShards_;
+
+  // Empty adjacency database per area to withdraw unsharded `adj:<node>` key
+  // with, once shards are advertised. Timer defers it behind the shards.
+  std::unordered_map<std::string /* area */, std::string> pendingAdjDbClears_;
+  std::unique_ptr<folly::AsyncTimeout> adjDbClearTimer_;
+
   // Previously announced KvStore peers
   std::unordered_map<
       std::string /* area */,
@@ -391,6 +452,10 @@ class LinkMonitor final : public OpenrEventBase {
   // on address events
   std::unordered_map<int64_t, std::string> ifIndexToName_;
 
+  // Cache of getInterfaceAreas(), keyed by interface name. Pruned to
+  // existing links upon interface sync.
+  std::unordered_map<std::string, InterfaceAreas> interfaceAreas_;
+
   // Throttled versions of "advertise<>" functions. It batches
   // up multiple calls and send them in one go!
 
@@ -415,6 +480,12 @@ class LinkMonitor final : public OpenrEventBase {
   // Timer for initial hold time expiry
   std::unique_ptr<folly::AsyncTimeout> adjHoldTimer_;
 
+  // Adjacencies with an RTT change held back by damping, and timer to apply
+  // them once their hold time expires
+  std::unordered_map<std::string /* area */, std::unordered_set<AdjacencyKey>>
+      pendingRttChanges_;
+  std::unique_ptr<folly::AsyncTimeout> rttDampingTimer_;
+
   // Boolean flag indicating whether initial neighbors are received in OpenR
   // initialization procedure.
   bool initialNeighborsReceived_{false};
@@ -8,6 +8,7 @@
 #include <folly/Subprocess.h>
 #include <folly/init/Init.h>
 #include <folly/io/async/EventBase.h>
+#include <folly/synchronization/Baton.h>
 #include <folly/system/Shell.h>
 #include <glog/logging.h>
 #include <gmock/gmock.h>
@@ -15,6 +16,7 @@
 #include <thrift/lib/cpp2/protocol/Serializer.h>
 
 #include <openr/common/Constants.h>
+#include <openr/common/LsdbTypes.h>
 #include <openr/common/NetworkUtil.h>
 #include <openr/common/Types.h>
 #include <openr/common/Util.h>
@@ -1674,6 +1676,146 @@ TEST_F(LinkMonitorTestFixture, NeighborGracefulRestartFailure) {
   }
 }
 
+class RttDampingTestFixture : public LinkMonitorTestFixture {
+ public:
+  thrift::OpenrConfig
+  createConfig() override {
+    auto tConfig = LinkMonitorTestFixture::createConfig();
+
+    // override LM config
+    tConfig.link_monitor_config()->use_rtt_metric() = true;
+    tConfig.link_monitor_config()->rtt_metric_change_threshold_pct() = 50;
+    tConfig.link_monitor_config()->rtt_metric_hold_time_ms() = 1000;
+
+    return tConfig;
+  }
+
+  void
+  sendRttChange(int64_t rttUs) {
+    auto neighborEvent = nb2_up_event;
+    neighborEvent.eventType = NeighborEventType::NEIGHBOR_RTT_CHANGE;
+    neighborEvent.rttUs = rttUs;
+    neighborUpdatesQueue.push(
+        NeighborInitEvent(NeighborEvents({std::move(neighborEvent)})));
+  }
+
+  void
+  expectAdjPub(int32_t metric, int64_t rttUs) {
+    auto adj = adj_2_1;
+    adj.metric() = metric;
+    adj.rtt() = rttUs;
+    expectedAdjDbs.push(createAdjDb("node-1", {adj}, kNodeLabel));
+    checkNextAdjPub("adj:node-1");
+  }
+};
+
+// Verify RTT changes are damped by hysteresis and hold time
+//
+// Event Sequence:
+//
+// neighbor 2 up with rtt 100us, i.e. metric 1
+// rtt change to 1000us
+// check rtt 1000us is advertised right away, metric stays 1
+//
+// rtt change to 2000us and 3000us within hold time
+// check only rtt 3000us is advertised once hold time expires
+//
+// rtt change to 4000us, i.e. within 50% of rtt metric 30
+// check no new publication
+TEST_F(RttDampingTestFixture, RttChangeDamping) {
+  {
+    auto neighborEvent = nb2_up_event;
+    neighborUpdatesQueue.push(
+        NeighborInitEvent(NeighborEvents({std::move(neighborEvent)})));
+    expectAdjPub(1, 100);
+  }
+
+  // change beyond hysteresis after hold time is advertised
+  {
+    std::this_thread::sleep_for(std::chrono::milliseconds(1000));
+    sendRttChange(1000);
+    expectAdjPub(1, 1000);
+  }
+
+  // changes within hold time since last change are held back
+  {
+    sendRttChange(2000);
+    sendRttChange(3000);
+    std::this_thread::sleep_for(std::chrono::milliseconds(200));
+    CHECK_EQ(0, kvStoreWrapper->getReader().size());
+  }
+
+  // latest change is advertised once hold time expires
+  expectAdjPub(1, 3000);
+
+  // change within hysteresis is suppressed
+  {
+    sendRttChange(4000);
+    std::this_thread::sleep_for(std::chrono::milliseconds(1500));
+    CHECK_EQ(0, kvStoreWrapper->getReader().size());
+  }
+}
+
+class AdjDbShardTestFixture : public LinkMonitorTestFixture {
+ public:
+  thrift::OpenrConfig
+  createConfig() override {
+    auto tConfig = LinkMonitorTestFixture::createConfig();
+    tConfig.adj_db_shards() = kNumShards;
+    return tConfig;
+  }
+
+  void
+  sendNeighborEvent(NeighborEvent neighborEvent) {
+    neighborUpdatesQueue.push(
+        NeighborInitEvent(NeighborEvents({std::move(neighborEvent)})));
+  }
+
+  int64_t
+  getNumShardsAdvertised() {
+    auto counters = facebook::fb303::fbData->getCounters();
+    auto it = counters.find("link_monitor.advertise_adjacency_shards.sum");
+    return it == counters.end() ? 0 : it->second;
+  }
+
+ protected:
+  static constexpr uint32_t kNumShards{4};
+};
+
+// Verify adjacency database is advertised per shard
+//
+// Event Sequence:
+//
+// neighbor 2 up, check its shard is advertised
+// neighbor 3 up, check only its shard is advertised
+// neighbor 3 down, check its shard is withdrawn with empty database
+TEST_F(AdjDbShardTestFixture, ShardDiffAndWithdrawal) {
+  const auto shard2 =
+      AdjDbShardKey("node-1", AdjDbShardKey::getShardId("node-2", kNumShards))
+          .getAdjDbShardKeyStr();
+  const auto shard3 =
+      AdjDbShardKey("node-1", AdjDbShardKey::getShardId("node-3", kNumShards))
+          .getAdjDbShardKeyStr();
+  ASSERT_NE(shard2, shard3);
+
+  sendNeighborEvent(nb2_up_event);
+  expectedAdjDbs.push(createAdjDb("node-1", {adj_2_1}, kNodeLabel));
+  checkNextAdjPub(shard2);
+
+  // unchanged shard of neighbor 2 is not advertised again
+  const auto numShardsAdvertised = getNumShardsAdvertised();
+  sendNeighborEvent(nb3_up_event);
+  expectedAdjDbs.push(createAdjDb("node-1", {adj_3_1}, kNodeLabel));
+  checkNextAdjPub(shard3);
+  EXPECT_EQ(numShardsAdvertised + 1, getNumShardsAdvertised());
+
+  // shard left without adjacencies is flooded empty
+  sendNeighborEvent(nb3_down_event);
+  expectedAdjDbs.push(createAdjDb("node-1", {}, kNodeLabel));
+  checkNextAdjPub(shard3);
+  EXPECT_EQ(numShardsAdvertised + 1, getNumShardsAdvertised());
+}
+
 class DampenLinkTestFixture : public LinkMonitorTestFixture {
  public:
   thrift::OpenrConfig
@@ -1773,6 +1915,16 @@ TEST_F(DampenLinkTestFixture, DampenLinkFlaps) {
           links1->interfaceDetails()->at(ifName).linkFlapBackOffMs().value(),
           2000);
     }
+
+    // Backoff counting down doesn't change link information
+    auto versioned1 = linkMonitor->semifuture_getInterfacesVersioned(0).get();
+    ASSERT_TRUE(versioned1->interfaces().has_value());
+    const auto generation = *versioned1->generation();
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    auto versioned2 =
+        linkMonitor->semifuture_getInterfacesVersioned(generation).get();
+    EXPECT_EQ(generation, *versioned2->generation());
+    EXPECT_FALSE(versioned2->interfaces().has_value());
   }
 
   VLOG(2) << "*** bring up 2 interfaces ***";
@@ -2136,6 +2288,94 @@ TEST_F(LinkMonitorTestFixture, verifyAddrEventSubscription) {
   }
 }
 
+// Verify netlink events queued up while LinkMonitor is busy are processed
+// as one burst and only superseded address events are dropped
+TEST_F(LinkMonitorTestFixture, NetlinkEventsBurst) {
+  const std::string linkX = kTestVethNamePrefix + "X";
+  const std::string linkY = kTestVethNamePrefix + "Y";
+  const std::string linkZ = kTestVethNamePrefix + "Z";
+  const auto v4AddrX = folly::IPAddress::createNetwork("10.0.0.1/31");
+  const auto v4AddrY = folly::IPAddress::createNetwork("10.0.0.2/31");
+  const auto v6AddrX = folly::IPAddress::createNetwork("fe80::1/128");
+
+  // Hold LinkMonitor's event base, so that events queue up meanwhile
+  auto sendBurst = [&](std::function<void()> sendEvents) {
+    folly::Baton<> blocked, release;
+    linkMonitor->runInEventBaseThread([&]() {
+      blocked.post();
+      release.wait();
+    });
+    blocked.wait();
+    sendEvents();
+    release.post();
+  };
+  // Networks of interface, std::nullopt if interface is unknown
+  auto getNetworks = [&](const std::string& ifName)
+      -> std::optional<std::set<folly::CIDRNetwork>> {
+    auto links = linkMonitor->semifuture_getInterfaces().get();
+    auto it = links->interfaceDetails()->find(ifName);
+    if (it == links->interfaceDetails()->end()) {
+      return std::nullopt;
+    }
+    std::set<folly::CIDRNetwork> networks;
+    for (const auto& prefix : *it->second.info()->networks()) {
+      networks.emplace(toIPNetwork(prefix));
+    }
+    return networks;
+  };
+  // Burst is processed at once, hence wait for its last visible effect
+  auto waitFor = [](std::function<bool()> predicate) {
+    for (int i = 0; i < 500 and not predicate(); ++i) {
+      std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+    EXPECT_TRUE(predicate());
+  };
+  auto getNumCoalesced = []() {
+    auto counters = facebook::fb303::fbData->getCounters();
+    auto it = counters.find("link_monitor.netlink_events_coalesced.sum");
+    return it == counters.end() ? 0 : it->second;
+  };
+
+  nlEventsInjector->sendLinkEvent(linkX, kTestVethIfIndex[0], true);
+  nlEventsInjector->sendLinkEvent(linkY, kTestVethIfIndex[1], true);
+  waitFor([&]() { return getNetworks(linkY).has_value(); });
+  const auto numCoalesced = getNumCoalesced();
+
+  // Address added and deleted within one burst. Add is superseded.
+  sendBurst([&]() {
+    nlEventsInjector->sendAddrEvent(linkX, "10.0.0.1/31", true /* valid */);
+    nlEventsInjector->sendAddrEvent(linkX, "10.0.0.1/31", false /* valid */);
+    nlEventsInjector->sendAddrEvent(linkX, "fe80::1/128", true /* valid */);
+  });
+  waitFor([&]() { return getNetworks(linkX)->count(v6AddrX) > 0; });
+  EXPECT_EQ(0, getNetworks(linkX)->count(v4AddrX));
+  EXPECT_EQ(numCoalesced + 1, getNumCoalesced());
+
+  // Link event remapping ifIndex in between. Add to linkY and delete from
+  // linkZ are both applied, nothing is coalesced.
+  sendBurst([&]() {
+    nlEventsInjector->sendAddrEvent(linkY, "10.0.0.2/31", true /* valid */);
+    nlSock
+        ->addLink(fbnl::LinkBuilder()
+                      .setLinkName(linkZ)
+                      .setIfIndex(kTestVethIfIndex[1])
+                      .setFlags(IFF_RUNNING)
+                      .build())
+        .get();
+    nlSock
+        ->deleteIfAddress(fbnl::IfAddressBuilder()
+                              .setIfIndex(kTestVethIfIndex[1])
+                              .setPrefix(v4AddrY)
+                              .setValid(false)
+                              .build())
+        .get();
+  });
+  waitFor([&]() { return getNetworks(linkZ).has_value(); });
+  EXPECT_EQ(1, getNetworks(linkY)->count(v4AddrY));
+  EXPECT_EQ(0, getNetworks(linkZ)->count(v4AddrY));
+  EXPECT_EQ(numCoalesced + 1, getNumCoalesced());
+}
+
 class StaticNodeLabelTestFixture : public LinkMonitorTestFixture {
  public:
   std::vector<thrift::AreaConfig>
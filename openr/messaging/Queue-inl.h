@@ -7,6 +7,7 @@
 
 #pragma once
 
+#include <algorithm>
 #include <string>
 #include "openr/messaging/Queue.h"
 namespace openr {
@@ -51,6 +52,11 @@ RWQueue<ValueType>::RWQueue() {}
 template <typename ValueType>
 RWQueue<ValueType>::RWQueue(const std::string& queueId) : queueId_(queueId) {}
 
+template <typename ValueType>
+RWQueue<ValueType>::RWQueue(
+    const std::string& queueId, QueueOptions<ValueType> options)
+    : queueId_(queueId), options_(std::move(options)) {}
+
 template <typename ValueType>
 RWQueue<ValueType>::~RWQueue() {
   close();
@@ -73,11 +79,22 @@ RWQueue<ValueType>::push(ValueTypeT&& val) {
     pendingRead.data.emplace(std::forward<ValueTypeT>(val));
     pendingRead.baton.post();
     pendingReads_.pop_front();
+  } else if (
+      options_.maxPendingSize and options_.coalesce and
+      queue_.size() >= options_.maxPendingSize) {
+    // Reader is lagging behind. Try to merge into the last pending data
+    ValueType incoming(std::forward<ValueTypeT>(val));
+    if (options_.coalesce(queue_.back(), incoming)) {
+      ++coalesced_;
+    } else {
+      queue_.emplace_back(std::move(incoming));
+    }
   } else {
     // Add data into the queue
     queue_.emplace_back(std::forward<ValueTypeT>(val));
   }
   ++writes_;
+  maxSize_ = std::max(maxSize_, queue_.size());
 
   return true;
 }
@@ -224,7 +241,8 @@ template <typename ValueType>
 RWQueueStats
 RWQueue<ValueType>::getStats() {
   std::lock_guard<std::mutex> l(lock_);
-  return RWQueueStats{"", reads_, writes_, queue_.size()};
+  return RWQueueStats{
+      "", reads_, writes_, queue_.size(), maxSize_, coalesced_};
 }
 
 } // namespace messaging
@@ -9,6 +9,7 @@
 
 #include <any>
 #include <deque>
+#include <functional>
 #include <memory>
 #include <mutex>
 #include <utility>
@@ -32,6 +33,26 @@ struct RWQueueStats {
   const size_t reads{0};
   const size_t writes{0};
   const size_t size{0};
+  // High watermark of pending data
+  const size_t maxSize{0};
+  // Number of writes merged into pending data
+  const size_t coalesced{0};
+};
+
+/**
+ * Optional bounded mode of a queue. Once the pending data reaches
+ * `maxPendingSize`, every new write is first offered to `coalesce` which may
+ * merge it into the last pending element (last-writer-wins). Write which can
+ * not be merged is still queued, data is never dropped.
+ *
+ * `coalesce(pending, incoming)` returns true if `incoming` got merged into
+ * `pending`. It is invoked with the queue lock held and must not block.
+ */
+template <typename ValueType>
+struct QueueOptions {
+  size_t maxPendingSize{0}; // 0 => unbounded, never coalesce
+  std::function<bool(ValueType& pending, ValueType& incoming)> coalesce{
+      nullptr};
 };
 
 template <typename ValueType>
@@ -85,6 +106,7 @@ class RWQueue {
  public:
   RWQueue();
   explicit RWQueue(const std::string&);
+  RWQueue(const std::string&, QueueOptions<ValueType> options);
   ~RWQueue();
 
   /**
@@ -147,6 +169,9 @@ class RWQueue {
   // Name/id of the queue
   std::string queueId_{""};
 
+  // Bounded/coalescing behavior
+  const QueueOptions<ValueType> options_;
+
   struct PendingRead {
     folly::fibers::Baton baton;
     std::optional<ValueType> data;
@@ -177,6 +202,12 @@ class RWQueue {
 
   // Received messages
   size_t reads_{0};
+
+  // High watermark of pending data
+  size_t maxSize_{0};
+
+  // Messages merged into pending data
+  size_t coalesced_{0};
 };
 
 } // namespace messaging
@@ -17,6 +17,10 @@ namespace messaging {
 template <typename ValueType>
 ReplicateQueue<ValueType>::ReplicateQueue() {}
 
+template <typename ValueType>
+ReplicateQueue<ValueType>::ReplicateQueue(QueueOptions<ValueType> options)
+    : options_(std::move(options)) {}
+
 template <typename ValueType>
 ReplicateQueue<ValueType>::~ReplicateQueue() {
   close();
@@ -70,12 +74,8 @@ ReplicateQueue<ValueType>::getReader(
   if (closed_) {
     throw std::runtime_error("queue is closed");
   }
-  if (readerId) {
-    lockedReaders->emplace_back(
-        std::make_shared<RWQueue<ValueType>>(*readerId));
-  } else {
-    lockedReaders->emplace_back(std::make_shared<RWQueue<ValueType>>());
-  }
+  lockedReaders->emplace_back(std::make_shared<RWQueue<ValueType>>(
+      readerId.value_or(""), options_));
   return RQueue<ValueType>(lockedReaders->back());
 }
 
@@ -36,6 +36,11 @@ class ReplicateQueue : public ReplicateQueueBase {
  public:
   ReplicateQueue();
 
+  /**
+   * Replicated streams are created with the given bounded/coalescing options.
+   */
+  explicit ReplicateQueue(QueueOptions<ValueType> options);
+
   ~ReplicateQueue();
 
   /**
@@ -96,6 +101,7 @@ class ReplicateQueue : public ReplicateQueueBase {
   folly::Synchronized<std::list<std::shared_ptr<RWQueue<ValueType>>>> readers_;
   bool closed_{false}; // Protected by above Synchronized lock
   size_t writes_{0};
+  QueueOptions<ValueType> options_;
 };
 
 } // namespace messaging
@@ -106,6 +106,37 @@ TEST(RWQueueTest, OrderedPushGet) {
   EXPECT_EQ(0, q.size());
 }
 
+TEST(RWQueueTest, CoalescePendingData) {
+  // Sum up incoming integers once 2 of them are pending
+  auto sumUp = [](int& pending, int& incoming) {
+    if (incoming < 0) {
+      return false; // never merge negative
+    }
+    pending += incoming;
+    return true;
+  };
+  RWQueue<int> q("coalesce", QueueOptions<int>{2, sumUp});
+
+  q.push(1);
+  q.push(2);
+  q.push(3); // merged into 2
+  q.push(4); // merged into 5
+  q.push(-1); // not mergeable
+  q.push(5); // merged into -1
+
+  EXPECT_EQ(3, q.size());
+  EXPECT_EQ(6, q.numWrites());
+  auto stats = q.getStats();
+  EXPECT_EQ(3, stats.maxSize);
+  EXPECT_EQ(3, stats.coalesced);
+
+  EXPECT_EQ(1, q.get().value());
+  EXPECT_EQ(9, q.get().value());
+  EXPECT_EQ(4, q.get().value());
+  EXPECT_EQ(0, q.size());
+  EXPECT_EQ(3, q.getStats().maxSize); // high watermark is retained
+}
+
 TEST(RWQueueTest, ClosedPendingReads) {
   RWQueue<int> q;
 
@@ -23,6 +23,61 @@ const std::string STRINGTAGSET_KEY{"tagset"};
 
 const std::string kTimeCol{"time"};
 
+// Set value of the key, overriding previous one if any
+template <typename Fields, typename Value>
+void
+setField(Fields& fields, folly::StringPiece key, Value&& value) {
+  for (auto& [fieldKey, fieldValue] : fields) {
+    if (key == fieldKey) {
+      fieldValue = std::forward<Value>(value);
+      return;
+    }
+  }
+  fields.emplace_back(key.str(), std::forward<Value>(value));
+}
+
+// Get pointer to value of the key, nullptr if not set
+template <typename Fields>
+auto
+findField(const Fields& fields, folly::StringPiece key)
+    -> decltype(&fields.front().second) {
+  for (const auto& [fieldKey, fieldValue] : fields) {
+    if (key == fieldKey) {
+      return &fieldValue;
+    }
+  }
+  return nullptr;
+}
+
+template <typename Fields>
+const auto&
+getField(
+    const Fields& fields, folly::StringPiece keyType, folly::StringPiece key) {
+  if (auto value = findField(fields, key)) {
+    return *value;
+  }
+  throw std::invalid_argument(
+      fmt::format("invalid key: {} with keyType: {} ", key, keyType));
+}
+
+// Render fields as json object
+template <typename Fields, typename Fn>
+void
+addJsonObject(
+    folly::dynamic& json,
+    const std::string& keyType,
+    const Fields& fields,
+    Fn toDynamic) {
+  if (fields.empty()) {
+    return;
+  }
+  auto obj = folly::dynamic::object();
+  for (const auto& [key, value] : fields) {
+    obj[key] = toDynamic(value);
+  }
+  json.insert(keyType, std::move(obj));
+}
+
 } // anonymous namespace
 
 namespace openr {
@@ -31,8 +86,6 @@ LogSample::LogSample() : LogSample(std::chrono::system_clock::now()) {}
 
 LogSample::LogSample(std::chrono::system_clock::time_point timestamp)
     : timestamp_(timestamp) {
-  json_ = folly::dynamic::object;
-
   // add the timestamp to the json sample
   addInt(
       kTimeCol,
@@ -43,7 +96,35 @@ LogSample::LogSample(std::chrono::system_clock::time_point timestamp)
 
 LogSample::LogSample(
     folly::dynamic json, std::chrono::system_clock::time_point timestamp)
-    : json_(json), timestamp_(timestamp) {}
+    : timestamp_(timestamp) {
+  if (auto obj = json.get_ptr(INT_KEY)) {
+    for (const auto& [key, value] : obj->items()) {
+      addInt(key.asString(), value.asInt());
+    }
+  }
+  if (auto obj = json.get_ptr(DOUBLE_KEY)) {
+    for (const auto& [key, value] : obj->items()) {
+      addDouble(key.asString(), value.asDouble());
+    }
+  }
+  if (auto obj = json.get_ptr(STRING_KEY)) {
+    for (const auto& [key, value] : obj->items()) {
+      addString(key.asString(), value.asString());
+    }
+  }
+  if (auto obj = json.get_ptr(STRINGVECTOR_KEY)) {
+    for (const auto& [key, value] : obj->items()) {
+      addStringVector(
+          key.asString(), folly::convertTo<std::vector<std::string>>(value));
+    }
+  }
+  if (auto obj = json.get_ptr(STRINGTAGSET_KEY)) {
+    for (const auto& [key, value] : obj->items()) {
+      addStringTagset(
+          key.asString(), folly::convertTo<std::set<std::string>>(value));
+    }
+  }
+}
 
 LogSample
 LogSample::fromJson(const std::string& json) {
@@ -56,134 +137,97 @@ LogSample::fromJson(const std::string& json) {
 
 std::string
 LogSample::toJson() const {
+  auto json = folly::dynamic::object();
+  auto toDynamic = [](const auto& value) { return folly::dynamic(value); };
+  auto toDynamicArray = [](const auto& values) {
+    return folly::dynamic(values.begin(), values.end());
+  };
+  addJsonObject(json, INT_KEY, ints_, toDynamic);
+  addJsonObject(json, DOUBLE_KEY, doubles_, toDynamic);
+  addJsonObject(json, STRING_KEY, strings_, toDynamic);
+  addJsonObject(json, STRINGVECTOR_KEY, stringVectors_, toDynamicArray);
+  addJsonObject(json, STRINGTAGSET_KEY, stringTagsets_, toDynamicArray);
+
   folly::json::serialization_opts opts;
   opts.sort_keys = true;
-  return folly::json::serialize(json_, opts);
+  return folly::json::serialize(json, opts);
 }
 
 void
 LogSample::addInt(folly::StringPiece key, int64_t value) {
-  if (json_.find(INT_KEY) == json_.items().end()) {
-    json_.insert(INT_KEY, folly::dynamic::object());
-  }
-
-  json_[INT_KEY][key] = value;
+  setField(ints_, key, value);
 }
 
 void
 LogSample::addDouble(folly::StringPiece key, double value) {
-  if (json_.find(DOUBLE_KEY) == json_.items().end()) {
-    json_.insert(DOUBLE_KEY, folly::dynamic::object());
-  }
-
-  json_[DOUBLE_KEY][key] = value;
+  setField(doubles_, key, value);
 }
 
 void
 LogSample::addString(folly::StringPiece key, folly::StringPiece value) {
-  if (json_.find(STRING_KEY) == json_.items().end()) {
-    json_.insert(STRING_KEY, folly::dynamic::object());
-  }
-
-  json_[STRING_KEY][key] = value;
+  setField(strings_, key, value.str());
 }
 
 void
 LogSample::addStringVector(
     folly::StringPiece key, const std::vector<std::string>& values) {
-  if (json_.find(STRINGVECTOR_KEY) == json_.items().end()) {
-    json_.insert(STRINGVECTOR_KEY, folly::dynamic::object());
-  }
-
-  json_[STRINGVECTOR_KEY][key] = folly::dynamic(values.begin(), values.end());
+  setField(stringVectors_, key, values);
 }
 
 void
 LogSample::addStringTagset(
     folly::StringPiece key, const std::set<std::string>& tags) {
-  if (json_.find(STRINGTAGSET_KEY) == json_.items().end()) {
-    json_.insert(STRINGTAGSET_KEY, folly::dynamic::object());
-  }
-
-  json_[STRINGTAGSET_KEY][key] = folly::dynamic(tags.begin(), tags.end());
+  setField(stringTagsets_, key, tags);
 }
 
 int64_t
 LogSample::getInt(folly::StringPiece key) const {
-  return folly::convertTo<int64_t>(getInnerValue(INT_KEY, key));
+  return getField(ints_, INT_KEY, key);
 }
 
 double
 LogSample::getDouble(folly::StringPiece key) const {
-  return folly::convertTo<double>(getInnerValue(DOUBLE_KEY, key));
+  return getField(doubles_, DOUBLE_KEY, key);
 }
 
 std::string
 LogSample::getString(folly::StringPiece key) const {
-  return folly::convertTo<std::string>(getInnerValue(STRING_KEY, key));
+  return getField(strings_, STRING_KEY, key);
 }
 
 std::vector<std::string>
 LogSample::getStringVector(folly::StringPiece key) const {
-  return folly::convertTo<std::vector<std::string>>(
-      getInnerValue(STRINGVECTOR_KEY, key));
+  return getField(stringVectors_, STRINGVECTOR_KEY, key);
 }
 
 std::set<std::string>
 LogSample::getStringTagset(folly::StringPiece key) const {
-  return folly::convertTo<std::set<std::string>>(
-      getInnerValue(STRINGTAGSET_KEY, key));
+  return getField(stringTagsets_, STRINGTAGSET_KEY, key);
 }
 
 bool
 LogSample::isIntSet(folly::StringPiece key) const {
-  return isInnerValueSet(INT_KEY, key);
+  return findField(ints_, key) != nullptr;
 }
 
 bool
 LogSample::isDoubleSet(folly::StringPiece key) const {
-  return isInnerValueSet(DOUBLE_KEY, key);
+  return findField(doubles_, key) != nullptr;
 }
 
 bool
 LogSample::isStringSet(folly::StringPiece key) const {
-  return isInnerValueSet(STRING_KEY, key);
+  return findField(strings_, key) != nullptr;
 }
 
 bool
 LogSample::isStringVectorSet(folly::StringPiece key) const {
-  return isInnerValueSet(STRINGVECTOR_KEY, key);
+  return findField(stringVectors_, key) != nullptr;
 }
 
 bool
 LogSample::isStringTagsetSet(folly::StringPiece key) const {
-  return isInnerValueSet(STRINGTAGSET_KEY, key);
-}
-
-bool
-LogSample::isInnerValueSet(
-    folly::StringPiece keyType, folly::StringPiece key) const {
-  if (auto obj = json_.get_ptr(keyType)) {
-    if (auto data = obj->get_ptr(key)) {
-      (void)data;
-      return true;
-    }
-  }
-
-  return false;
-}
-
-const folly::dynamic&
-LogSample::getInnerValue(
-    folly::StringPiece keyType, folly::StringPiece key) const {
-  if (auto obj = json_.get_ptr(keyType)) {
-    if (auto data = obj->get_ptr(key)) {
-      return *data;
-    }
-  }
-
-  throw std::invalid_argument(
-      fmt::format("invalid key: {} with keyType: {} ", key, keyType));
+  return findField(stringTagsets_, key) != nullptr;
 }
 
 } // namespace openr
@@ -25,6 +25,10 @@ namespace openr {
  * This class is strictly meant to make things easier for services to create
  * samples and serialize them to json objects.
  *
+ * Attributes are kept as typed (key, value) fields and json is rendered only
+ * when `toJson()` is invoked, hence creating and passing samples around on
+ * the hot path doesn't pay for json construction.
+ *
  * Example usecase:
  *    LogSample sample(std::chrono::system_clock::now());
  *    sample.addString("event", "NEIGHBOR_UP");
@@ -102,13 +106,16 @@ class LogSample {
   bool isStringTagsetSet(folly::StringPiece key) const;
 
  private:
-  bool isInnerValueSet(
-      folly::StringPiece keyType, folly::StringPiece key) const;
-  const folly::dynamic& getInnerValue(
-      folly::StringPiece keyType, folly::StringPiece key) const;
-
-  // Internal json representation of this sample
-  folly::dynamic json_ = folly::dynamic::object;
+  // Typed attributes of the sample. Few attributes are set per sample, so a
+  // flat vector is cheaper than any map.
+  template <typename T>
+  using Fields = std::vector<std::pair<std::string, T>>;
+
+  Fields<int64_t> ints_;
+  Fields<double> doubles_;
+  Fields<std::string> strings_;
+  Fields<std::vector<std::string>> stringVectors_;
+  Fields<std::set<std::string>> stringTagsets_;
 
   // Timepoint associated with this sample
   std::chrono::system_clock::time_point timestamp_;
@@ -21,6 +21,9 @@ MonitorBase::MonitorBase(
       startTime_{std::chrono::steady_clock::now()} {
   // Initialize stats counter
   fb303::fbData->addStatExportType("monitor.log.publish.failure", fb303::COUNT);
+  fb303::fbData->addStatExportType("monitor.log.dropped", fb303::COUNT);
+
+  recentLog_.wlock()->logs.resize(maxLogEvents_);
 
   // Periodically set process cpu/uptime/memory counter
   setProcessCounterTimer_ =
@@ -61,18 +64,36 @@ MonitorBase::MonitorBase(
 
           // validate, process and publish the event logs
           try {
-            auto inputLog = maybeLog.value();
+            auto inputLog = std::move(maybeLog).value();
             // add common attributes
             inputLog.addString("node_name", config->getNodeName());
 
             // throws std::invalid_argument if not exist
             inputLog.getString("event");
 
-            // add to recent log list
-            if (recentLog_.size() >= maxLogEvents_) {
-              recentLog_.pop_front();
+            // add to recent log ring, overwriting the oldest one if full.
+            // Copy-assignment reuses the storage of the overwritten slot.
+            // Overwritten log is only lost if it was never exported nor read.
+            // Unread logs are always the newest ones, hence oldest one is
+            // unread only if all of them are.
+            if (maxLogEvents_ > 0) {
+              const bool exported = config->isLogSubmissionEnabled();
+              bool dropped{false};
+              recentLog_.withWLock([&](auto& ring) {
+                ring.logs[ring.next] = inputLog;
+                ring.next = (ring.next + 1) % maxLogEvents_;
+                dropped = ring.unread == maxLogEvents_;
+                ring.size = std::min<size_t>(ring.size + 1, maxLogEvents_);
+                if (not exported) {
+                  ring.unread =
+                      std::min<size_t>(ring.unread + 1, maxLogEvents_);
+                }
+              });
+              if (dropped) {
+                fb303::fbData->addStatValue(
+                    "monitor.log.dropped", 1, fb303::COUNT);
+              }
             }
-            recentLog_.emplace_back(inputLog.toJson());
 
             // publish the log if enable log submission
             if (config->isLogSubmissionEnabled()) {
@@ -90,7 +111,27 @@ MonitorBase::MonitorBase(
 
 std::list<std::string>
 MonitorBase::getRecentEventLogs() {
-  return recentLog_;
+  if (maxLogEvents_ == 0) {
+    return {};
+  }
+
+  // Copy out samples and render them outside of the lock. All of them are
+  // read now, hence no longer counted as dropped once overwritten.
+  std::vector<LogSample> logs;
+  recentLog_.withWLock([&](auto& ring) {
+    logs.reserve(ring.size);
+    const auto first = (ring.next + maxLogEvents_ - ring.size) % maxLogEvents_;
+    for (size_t i = 0; i < ring.size; ++i) {
+      logs.emplace_back(ring.logs[(first + i) % maxLogEvents_]);
+    }
+    ring.unread = 0;
+  });
+
+  std::list<std::string> recentLogs;
+  for (const auto& log : logs) {
+    recentLogs.emplace_back(log.toJson());
+  }
+  return recentLogs;
 }
 
 void
@@ -8,6 +8,7 @@
 #pragma once
 
 #include <folly/Function.h>
+#include <folly/Synchronized.h>
 
 #include <fb303/ServiceData.h>
 #include <openr/common/OpenrEventBase.h>
@@ -25,7 +26,8 @@ namespace openr {
  * implements common functions:
  * 1. Start a fiber to read the log queue and export logs to database based on
  *    subclass's processEventLog() implementation.
- * 2. Store and return the most recent logs;
+ * 2. Store and return the most recent logs. Logs are kept as LogSample in a
+ *    preallocated ring and rendered to json only when they are retrieved;
  * 3. Export process counters: process.memory.rss, process.uptime,
  *    and process.cpu.pct
  */
@@ -36,7 +38,7 @@ class MonitorBase : public OpenrEventBase {
       const std::string& category,
       messaging::RQueue<LogSample> logSampleQueue);
 
-  // Get recent event logs
+  // Get recent event logs, oldest first. Thread-safe.
   std::list<std::string> getRecentEventLogs();
 
   // Destructor
@@ -62,8 +64,19 @@ class MonitorBase : public OpenrEventBase {
   // Number of last log events to queue
   const uint32_t maxLogEvents_{0};
 
-  // List of recent log
-  std::list<std::string> recentLog_{};
+  // Ring of recent logs, preallocated to `maxLogEvents_` slots. Oldest log
+  // gets overwritten once full.
+  struct RecentLogRing {
+    std::vector<LogSample> logs;
+    // Slot to write next log into
+    size_t next{0};
+    // Number of valid logs
+    size_t size{0};
+    // Number of newest logs neither exported nor read by
+    // getRecentEventLogs() yet
+    size_t unread{0};
+  };
+  folly::Synchronized<RecentLogRing> recentLog_;
 
   // Timer to periodically set process cpu/uptime/memory counter
   std::unique_ptr<folly::AsyncTimeout> setProcessCounterTimer_;
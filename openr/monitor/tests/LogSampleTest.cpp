@@ -153,6 +153,36 @@ TEST(LogSampleTest, fromJsonTest) {
   EXPECT_THROW(LogSample::fromJson(jsonSampleNoTimeKey), std::exception);
 }
 
+TEST(LogSampleTest, OverrideValue) {
+  const auto timestamp =
+      std::chrono::system_clock::time_point(std::chrono::seconds(111));
+  LogSample sample(timestamp);
+
+  sample.addString("string-key", "hello");
+  sample.addString("string-key", "world");
+  sample.addInt("time", 222);
+  EXPECT_EQ("world", sample.getString("string-key"));
+  EXPECT_EQ(222, sample.getInt("time"));
+
+  // Only latest value is rendered and survives round-trip
+  const std::string jsonSample = R"config(
+    {
+     "int":{
+        "time":222
+     },
+     "normal":{
+        "string-key":"world"
+     }
+    }
+  )config";
+  folly::json::serialization_opts opts;
+  opts.sort_keys = true;
+  EXPECT_EQ(
+      folly::json::serialize(folly::parseJson(jsonSample), opts),
+      sample.toJson());
+  EXPECT_EQ(sample.toJson(), LogSample::fromJson(sample.toJson()).toJson());
+}
+
 } // namespace openr
 
 int
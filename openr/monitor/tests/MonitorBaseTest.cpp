@@ -34,12 +34,8 @@ class MonitorTestFixture : public ::testing::Test {
  public:
   void
   SetUp() override {
-    // generate a config for testing
-    openr::thrift::OpenrConfig config;
-    *config.node_name() = "node1";
-
     monitor = make_unique<MonitorMock>(
-        std::make_unique<openr::Config>(config),
+        std::make_unique<openr::Config>(createConfig()),
         category,
         eventLogUpdatesQueue.getReader());
     monitorThread = std::make_unique<std::thread>([this]() {
@@ -58,6 +54,15 @@ class MonitorTestFixture : public ::testing::Test {
     monitorThread->join();
     LOG(INFO) << "Monitor thread got stopped";
   }
+
+  virtual openr::thrift::OpenrConfig
+  createConfig() {
+    // generate a config for testing
+    openr::thrift::OpenrConfig config;
+    *config.node_name() = "node1";
+    return config;
+  }
+
   // monitor owned by the unit tests
   std::unique_ptr<MonitorMock> monitor{nullptr};
 
@@ -110,6 +115,87 @@ TEST_F(MonitorTestFixture, LogBasicOperation) {
   }
 }
 
+TEST_F(MonitorTestFixture, RecentLogRingOverflow) {
+  // Default config keeps 100 recent logs. Publish a few more.
+  const int64_t kMaxLogEvents = 100;
+  const int64_t kNumLogs = kMaxLogEvents + 5;
+  EXPECT_CALL(*monitor, processEventLog(_)).Times(AnyNumber());
+  for (int64_t i = 0; i < kNumLogs; ++i) {
+    LogSample log;
+    log.addString("event", "event_unit_test");
+    log.addInt("num", i);
+    eventLogUpdatesQueue.push(std::move(log));
+  }
+
+  // Wait for the last log. Oldest ones got overwritten, in order.
+  while (true) {
+    auto recentLogs = monitor->getRecentEventLogs();
+    if (not recentLogs.empty() and
+        LogSample::fromJson(recentLogs.back()).getInt("num") == kNumLogs - 1) {
+      EXPECT_EQ(kMaxLogEvents, static_cast<int64_t>(recentLogs.size()));
+      EXPECT_EQ(
+          kNumLogs - kMaxLogEvents,
+          LogSample::fromJson(recentLogs.front()).getInt("num"));
+      break;
+    }
+    std::this_thread::yield();
+  }
+  // Overwritten logs were all exported, none of them is dropped
+  EXPECT_EQ(
+      0, facebook::fb303::fbData->getCounters()["monitor.log.dropped.count"]);
+}
+
+class MonitorNoSubmissionTestFixture : public MonitorTestFixture {
+ public:
+  openr::thrift::OpenrConfig
+  createConfig() override {
+    auto config = MonitorTestFixture::createConfig();
+    config.monitor_config()->enable_event_log_submission() = false;
+    return config;
+  }
+};
+
+TEST_F(MonitorNoSubmissionTestFixture, RecentLogRingDropUnread) {
+  const int64_t kMaxLogEvents = 100;
+  const int64_t kNumLogs = kMaxLogEvents + 5;
+  auto getDroppedCount = []() {
+    return facebook::fb303::fbData->getCounters()["monitor.log.dropped.count"];
+  };
+  auto pushLogs = [&](int64_t from, int64_t to) {
+    for (int64_t i = from; i < to; ++i) {
+      LogSample log;
+      log.addString("event", "event_unit_test");
+      log.addInt("num", i);
+      eventLogUpdatesQueue.push(std::move(log));
+    }
+  };
+  EXPECT_CALL(*monitor, processEventLog(_)).Times(0);
+
+  // Logs neither exported nor read are dropped once overwritten
+  const auto droppedBefore = getDroppedCount();
+  pushLogs(0, kNumLogs);
+  while (getDroppedCount() - droppedBefore < kNumLogs - kMaxLogEvents) {
+    std::this_thread::yield();
+  }
+  auto recentLogs = monitor->getRecentEventLogs();
+  EXPECT_EQ(kMaxLogEvents, static_cast<int64_t>(recentLogs.size()));
+  EXPECT_EQ(
+      kNumLogs - kMaxLogEvents,
+      LogSample::fromJson(recentLogs.front()).getInt("num"));
+  EXPECT_EQ(kNumLogs - 1, LogSample::fromJson(recentLogs.back()).getInt("num"));
+
+  // Logs read above are not dropped when overwritten
+  pushLogs(kNumLogs, kNumLogs + 5);
+  while (true) {
+    recentLogs = monitor->getRecentEventLogs();
+    if (LogSample::fromJson(recentLogs.back()).getInt("num") == kNumLogs + 4) {
+      break;
+    }
+    std::this_thread::yield();
+  }
+  EXPECT_EQ(kNumLogs - kMaxLogEvents, getDroppedCount() - droppedBefore);
+}
+
 TEST_F(MonitorTestFixture, ProcessCounterTest) {
   // Wait for calling getCPUpercentage() twice for calculating the cpu% counter
   while (true) {
@@ -136,6 +136,13 @@ NetlinkProtocolSocket::init() {
     XLOG(FATAL) << "Failed to bind netlink socket: " << folly::errnoStr(errno);
   }
 
+  // Route notifications are opt-in. Subscribers must resync as notifications
+  // sent to the previous socket (if any) are lost.
+  if (routeEventCallback_) {
+    addRouteMembership();
+    routeEventCallback_(std::nullopt);
+  }
+
   // Retrieve and set pid that we will use for all subsequent messages
   portId_ = saddr.nl_pid;
   XLOG(INFO) << "Created netlink socket. fd=" << nlSock_
@@ -303,7 +310,11 @@ NetlinkProtocolSocket::processMessage(
     case RTM_DELROUTE: {
       // next RTM message to be processed
       auto route = NetlinkRouteMessage::parseMessage(nlh);
-      if (nlSeqIt != nlSeqNumMap_.end()) {
+      // NOTE: When subscribed, kernel also multicasts the changes made by our
+      // own add/del requests, carrying the sequence number of the request.
+      // Only replies to RTM_GETROUTE are responses.
+      if (nlSeqIt != nlSeqNumMap_.end() and nlh->nlmsg_pid == portId_ and
+          nlSeqIt->second->getMessageType() == RTM_GETROUTE) {
         // Extend message timer as we received a valid ack
         nlMessageTimer_->scheduleTimeout(kNlRequestAckTimeout);
         // Received route in response to request
@@ -311,7 +322,12 @@ NetlinkProtocolSocket::processMessage(
       } else {
         // Route notification
         fbData->addStatValue("netlink.notifications.route", 1, fb303::SUM);
-        DCHECK(false) << "Route notifications are not subscribed";
+        if (routeEventCallback_) {
+          XLOG(DBG2) << "Route event. " << route.str();
+          routeEventCallback_(std::move(route));
+        } else {
+          DCHECK(false) << "Route notifications are not subscribed";
+        }
       }
     } break;
 
@@ -443,6 +459,13 @@ NetlinkProtocolSocket::recvNetlinkMessage() {
     if (errno == EINTR || errno == EAGAIN) {
       return;
     }
+    if (errno == ENOBUFS) {
+      // Kernel dropped notifications as our receive buffer was full
+      fbData->addStatValue("netlink.notifications.overflow", 1, fb303::SUM);
+      if (routeEventCallback_) {
+        routeEventCallback_(std::nullopt);
+      }
+    }
     XLOG(ERR) << "Error in netlink socket receive: " << bytesRead
               << " err: " << folly::errnoStr(std::abs(errno));
     fbData->addStatValue("netlink.errors", 1, fb303::SUM);
@@ -737,4 +760,35 @@ NetlinkProtocolSocket::getMplsRoutes(uint8_t protocolId) {
   return getRoutes(builder.build());
 }
 
+void
+NetlinkProtocolSocket::subscribeRouteEvents(RouteEventCallback callback) {
+  evb_->runImmediatelyOrRunInEventBaseThreadAndWait(
+      [this, callback = std::move(callback)]() mutable {
+        const bool subscribed = static_cast<bool>(routeEventCallback_);
+        routeEventCallback_ = std::move(callback);
+        // Socket is yet to be initialized if negative. `init()` will subscribe
+        if (nlSock_ >= 0 and not subscribed and routeEventCallback_) {
+          addRouteMembership();
+        }
+      });
+}
+
+void
+NetlinkProtocolSocket::addRouteMembership() {
+  for (int group :
+       {RTNLGRP_IPV4_ROUTE, RTNLGRP_IPV6_ROUTE, RTNLGRP_MPLS_ROUTE}) {
+    if (setsockopt(
+            nlSock_,
+            SOL_NETLINK,
+            NETLINK_ADD_MEMBERSHIP,
+            &group,
+            sizeof(group)) != 0) {
+      XLOG(ERR) << "Failed to join netlink group " << group << ": "
+                << folly::errnoStr(errno);
+      fbData->addStatValue("netlink.errors", 1, fb303::SUM);
+    }
+  }
+  XLOG(INFO) << "Subscribed to route notifications. fd=" << nlSock_;
+}
+
 } // namespace openr::fbnl
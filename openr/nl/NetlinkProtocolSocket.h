@@ -29,6 +29,13 @@ namespace openr::fbnl {
 using NetlinkEvent =
     std::variant<fbnl::Link, fbnl::IfAddress, fbnl::Neighbor, fbnl::Rule>;
 
+// Callback for kernel route notifications (RTM_NEWROUTE/RTM_DELROUTE). The
+// route is invalid (`isValid() == false`) for deletions. `std::nullopt` is
+// delivered when notifications may have been lost, e.g. on socket buffer
+// overflow or socket re-initialization, and any state derived from them must
+// be rebuilt from a dump.
+using RouteEventCallback = folly::Function<void(std::optional<fbnl::Route>)>;
+
 // Receive socket buffer for netlink socket
 constexpr uint32_t kNetlinkSockRecvBuf{1 * 1024 * 1024};
 
@@ -95,6 +102,7 @@ constexpr std::chrono::milliseconds kNlRequestAckTimeout{1000};
  *   netlink.notifications.addr : Received address notifications
  *   netlink.notifications.neighbors : Received neighbor notifications
  *   netlink.notifications.route : Received route notifications
+ *   netlink.notifications.overflow : Notifications lost on buffer overflow
  */
 class NetlinkProtocolSocket : public folly::EventHandler {
  public:
@@ -228,6 +236,17 @@ class NetlinkProtocolSocket : public folly::EventHandler {
   virtual folly::SemiFuture<folly::Expected<std::vector<fbnl::Route>, int>>
   getMplsRoutes(uint8_t protocolId);
 
+  /**
+   * Opt-in subscription to IPv4, IPv6 and MPLS route notifications. Routes are
+   * not published on `netlinkEventsQueue` but passed to `callback` on the
+   * netlink event base. Passing an empty callback stops the delivery, though
+   * the socket stays subscribed.
+   *
+   * NOTE: Blocks until the subscription is in place. The event base must be
+   * running, or not yet started, when this is called from another thread.
+   */
+  virtual void subscribeRouteEvents(RouteEventCallback callback);
+
   /**
    * Utility function to accumulate result of multiple requests into one.
    * It will throw the exception with the first non-zero value(aka error code),
@@ -264,6 +283,9 @@ class NetlinkProtocolSocket : public folly::EventHandler {
   // Resume sending messages from queue_ if any pending
   void processAck(uint32_t ack, int status);
 
+  // Join route multicast groups on the current socket
+  void addRouteMembership();
+
   // Event base for serializing read/write requests to netlink socket. Also
   // ensure thread safety of private member variables.
   folly::EventBase* evb_{nullptr};
@@ -282,6 +304,9 @@ class NetlinkProtocolSocket : public folly::EventHandler {
   // Use new IPv6 route replace semantics. See documentation for addRoute(...)
   const bool enableIPv6RouteReplaceSemantics_{false};
 
+  // Receiver of route notifications. Set only with `subscribeRouteEvents`
+  RouteEventCallback routeEventCallback_;
+
   // Netlink socket fd. Created when class is constructed. Re-created on timeout
   // when no response is received for any of our pending requests.
   int nlSock_{-1};
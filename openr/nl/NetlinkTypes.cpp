@@ -5,6 +5,8 @@
  * LICENSE file in the root directory of this source tree.
  */
 
+#include <folly/hash/Hash.h>
+
 #include <openr/nl/NetlinkTypes.h>
 
 extern "C" {
@@ -271,12 +273,13 @@ Route::operator=(const Route& other) {
   return *this;
 }
 
+namespace {
+
+// Compare everything but the route key (destination prefix / MPLS label)
 bool
-operator==(const Route& lhs, const Route& rhs) {
+isEqualIgnoringKey(const Route& lhs, const Route& rhs) {
   bool ret =
-      (lhs.getDestination() == rhs.getDestination() &&
-       lhs.getMplsLabel() == rhs.getMplsLabel() &&
-       lhs.getNextHops().size() == rhs.getNextHops().size() &&
+      (lhs.getNextHops().size() == rhs.getNextHops().size() &&
        lhs.getType() == rhs.getType() &&
        lhs.getRouteTable() == rhs.getRouteTable() &&
        lhs.getProtocolId() == rhs.getProtocolId() &&
@@ -300,6 +303,14 @@ operator==(const Route& lhs, const Route& rhs) {
   return true;
 }
 
+} // namespace
+
+bool
+operator==(const Route& lhs, const Route& rhs) {
+  return lhs.getDestination() == rhs.getDestination() &&
+      lhs.getMplsLabel() == rhs.getMplsLabel() && isEqualIgnoringKey(lhs, rhs);
+}
+
 uint8_t
 Route::getFamily() const {
   return family_;
@@ -423,6 +434,137 @@ Route::setNextHops(const NextHopSet& nextHops) {
   nextHops_ = nextHops;
 }
 
+/*=============================CompactRouteTable==============================*/
+
+size_t
+CompactRouteTable::ShapeHash::operator()(const Route& route) const {
+  // Nexthop hashes are summed so that the result doesn't depend on the
+  // iteration order of the set
+  size_t nextHopsHash = 0;
+  for (const auto& nh : route.getNextHops()) {
+    nextHopsHash += NextHopHash()(nh);
+  }
+  return folly::hash::hash_combine(
+      nextHopsHash,
+      route.getType(),
+      route.getRouteTable(),
+      route.getProtocolId(),
+      route.getPriority().value_or(0),
+      route.getFamily());
+}
+
+void
+CompactRouteTable::insert(Route&& route) {
+  const auto family = route.getFamily();
+  const auto dst = route.getDestination();
+  const auto mplsLabel = route.getMplsLabel();
+
+  // Clear the key so that routes differing only by key share one shape
+  route.dst_ = folly::CIDRNetwork{};
+  route.mplsLabel_ = std::nullopt;
+  auto shapeIt = shapes_.try_emplace(std::move(route), 0).first;
+  ++shapeIt->second;
+  const Route* shape = &shapeIt->first;
+
+  const Route* oldShape{nullptr};
+  if (family == AF_MPLS) {
+    auto [it, inserted] = mplsRoutes_.try_emplace(mplsLabel.value(), shape);
+    if (not inserted) {
+      oldShape = std::exchange(it->second, shape);
+    }
+  } else {
+    auto [it, inserted] = unicastRoutes_.try_emplace(dst, shape);
+    if (not inserted) {
+      oldShape = std::exchange(it->second, shape);
+    }
+  }
+  if (oldShape) {
+    releaseShape(oldShape);
+  }
+}
+
+void
+CompactRouteTable::releaseShape(const Route* shape) {
+  auto it = shapes_.find(*shape);
+  if (--it->second == 0) {
+    shapes_.erase(it);
+  }
+}
+
+const Route*
+CompactRouteTable::findShape(const Route& route) const {
+  if (route.getFamily() == AF_MPLS) {
+    auto it = mplsRoutes_.find(route.getMplsLabel().value());
+    return it == mplsRoutes_.end() ? nullptr : it->second;
+  }
+  auto it = unicastRoutes_.find(route.getDestination());
+  return it == unicastRoutes_.end() ? nullptr : it->second;
+}
+
+bool
+CompactRouteTable::containsEqual(const Route& route) const {
+  const auto shape = findShape(route);
+  return shape and isEqualIgnoringKey(*shape, route);
+}
+
+std::optional<Route>
+CompactRouteTable::find(const Route& route) const {
+  const auto shape = findShape(route);
+  if (not shape) {
+    return std::nullopt;
+  }
+  Route result(*shape);
+  result.dst_ = route.getDestination();
+  result.mplsLabel_ = route.getMplsLabel();
+  return result;
+}
+
+bool
+CompactRouteTable::erase(const Route& route) {
+  const Route* shape{nullptr};
+  if (route.getFamily() == AF_MPLS) {
+    auto it = mplsRoutes_.find(route.getMplsLabel().value());
+    if (it == mplsRoutes_.end()) {
+      return false;
+    }
+    shape = it->second;
+    mplsRoutes_.erase(it);
+  } else {
+    auto it = unicastRoutes_.find(route.getDestination());
+    if (it == unicastRoutes_.end()) {
+      return false;
+    }
+    shape = it->second;
+    unicastRoutes_.erase(it);
+  }
+  releaseShape(shape);
+  return true;
+}
+
+void
+CompactRouteTable::forEachRoute(folly::FunctionRef<void(Route&&)> fn) const {
+  for (const auto& [dst, shape] : unicastRoutes_) {
+    Route route(*shape);
+    route.dst_ = dst;
+    fn(std::move(route));
+  }
+  for (const auto& [label, shape] : mplsRoutes_) {
+    Route route(*shape);
+    route.mplsLabel_ = label;
+    fn(std::move(route));
+  }
+}
+
+size_t
+CompactRouteTable::size() const {
+  return unicastRoutes_.size() + mplsRoutes_.size();
+}
+
+size_t
+CompactRouteTable::numShapes() const {
+  return shapes_.size();
+}
+
 /*=================================NextHop====================================*/
 
 NextHop
@@ -8,8 +8,10 @@
 #pragma once
 
 #include <folly/Format.h>
+#include <folly/Function.h>
 #include <folly/IPAddress.h>
 #include <folly/MacAddress.h>
+#include <folly/container/F14Map.h>
 
 #include <openr/if/gen-cpp2/Types_types.h>
 #include <thrift/lib/cpp/util/EnumUtils.h>
@@ -298,6 +300,9 @@ class Route final {
   void setNextHops(const NextHopSet& nextHops);
 
  private:
+  // Splits routes into key and interned shape by rewriting the key fields
+  friend class CompactRouteTable;
+
   uint8_t type_{RTN_UNICAST};
   uint32_t routeTable_{RT_TABLE_MAIN};
   uint8_t protocolId_{DEFAULT_PROTOCOL_ID};
@@ -317,6 +322,64 @@ class Route final {
 
 bool operator==(const Route& lhs, const Route& rhs);
 
+/**
+ * Compact snapshot of a kernel route table used for diffing a full FIB sync
+ * against the routes read back from the kernel.
+ *
+ * Every route is split into its key (destination prefix or top MPLS label)
+ * and its shape (nexthops plus the remaining attributes). Shapes are interned,
+ * so the many routes of a large table that share the same nexthop set and
+ * attributes reference one copy and each entry costs a key plus a pointer.
+ * Routes are re-materialized only when they need to be logged or deleted.
+ */
+class CompactRouteTable {
+ public:
+  CompactRouteTable() = default;
+
+  // Entries point into `shapes_` and can't be copied along
+  CompactRouteTable(const CompactRouteTable&) = delete;
+  CompactRouteTable& operator=(const CompactRouteTable&) = delete;
+  CompactRouteTable(CompactRouteTable&&) = default;
+  CompactRouteTable& operator=(CompactRouteTable&&) = default;
+
+  // Insert or replace the entry for the key of `route`
+  void insert(Route&& route);
+
+  // Return true if the entry with the same key as `route` is equal to it
+  bool containsEqual(const Route& route) const;
+
+  // Materialize the entry with the same key as `route`, if any
+  std::optional<Route> find(const Route& route) const;
+
+  // Remove the entry with the same key as `route`. Returns true if removed
+  bool erase(const Route& route);
+
+  // Invoke `fn` with every remaining route materialized in turn
+  void forEachRoute(folly::FunctionRef<void(Route&&)> fn) const;
+
+  size_t size() const;
+
+  // Number of distinct interned route shapes
+  size_t numShapes() const;
+
+ private:
+  struct ShapeHash {
+    size_t operator()(const Route& route) const;
+  };
+
+  const Route* findShape(const Route& route) const;
+
+  // Drop a reference on `shape` and free it once unused
+  void releaseShape(const Route* shape);
+
+  // Interned routes with their key fields cleared, and their reference count.
+  // Node storage keeps the key addresses referenced from the maps below
+  // stable.
+  folly::F14NodeMap<Route, size_t, ShapeHash> shapes_;
+  folly::F14FastMap<folly::CIDRNetwork, const Route*> unicastRoutes_;
+  folly::F14FastMap<uint32_t, const Route*> mplsRoutes_;
+};
+
 class IfAddress;
 class IfAddressBuilder final {
  public:
@@ -351,6 +351,77 @@ TEST(NetlinkTypes, RouteOptionalParamTest) {
   EXPECT_EQ(RTN_UNICAST, route.getType());
 }
 
+TEST(NetlinkTypes, CompactRouteTableTest) {
+  folly::IPAddress gateway1("face:cafe:3::3");
+  folly::IPAddress gateway2("face:cafe:3::4");
+  NextHopBuilder nhBuilder;
+  auto nh1 = nhBuilder.setIfIndex(kIfIndex).setGateway(gateway1).build();
+  nhBuilder.reset();
+  auto nh2 = nhBuilder.setIfIndex(kIfIndex).setGateway(gateway2).build();
+  nhBuilder.reset();
+  auto mplsNh = nhBuilder.setIfIndex(kIfIndex)
+                    .setGateway(gateway1)
+                    .setLabelAction(thrift::MplsActionCode::PHP)
+                    .build();
+
+  auto buildRoute = [&](const std::string& prefix, const NextHop& nh) {
+    RouteBuilder builder;
+    return builder.setDestination(folly::IPAddress::createNetwork(prefix))
+        .setProtocolId(kProtocolId)
+        .addNextHop(nh)
+        .build();
+  };
+  auto buildMplsRoute = [&](uint32_t label) {
+    RouteBuilder builder;
+    return builder.setMplsLabel(label)
+        .setProtocolId(kProtocolId)
+        .addNextHop(mplsNh)
+        .build();
+  };
+
+  auto route1 = buildRoute("fc00:cafe:1::/64", nh1);
+  auto route2 = buildRoute("fc00:cafe:2::/64", nh1);
+  auto route3 = buildRoute("fc00:cafe:3::/64", nh2);
+  auto mplsRoute = buildMplsRoute(100);
+
+  CompactRouteTable table;
+  for (const auto& route : {route1, route2, route3, mplsRoute}) {
+    table.insert(Route(route));
+  }
+  EXPECT_EQ(4, table.size());
+  // route1 and route2 only differ by destination and share a shape
+  EXPECT_EQ(3, table.numShapes());
+
+  // Lookup materializes the original route
+  EXPECT_TRUE(table.containsEqual(route1));
+  EXPECT_TRUE(table.containsEqual(mplsRoute));
+  EXPECT_TRUE(route2 == table.find(route2));
+  EXPECT_TRUE(mplsRoute == table.find(mplsRoute));
+
+  // Same key with different nexthops is found but isn't equal
+  auto updatedRoute1 = buildRoute("fc00:cafe:1::/64", nh2);
+  EXPECT_FALSE(table.containsEqual(updatedRoute1));
+  EXPECT_TRUE(route1 == table.find(updatedRoute1));
+
+  // Unknown keys
+  EXPECT_FALSE(table.find(buildRoute("fc00:cafe:4::/64", nh1)).has_value());
+  EXPECT_FALSE(table.find(buildMplsRoute(200)).has_value());
+
+  // Erased routes are not visited anymore
+  EXPECT_TRUE(table.erase(route1));
+  EXPECT_FALSE(table.erase(route1));
+  EXPECT_TRUE(table.erase(mplsRoute));
+  // Unused shapes are released
+  EXPECT_EQ(2, table.numShapes());
+  std::vector<Route> remaining;
+  table.forEachRoute(
+      [&](Route&& route) { remaining.emplace_back(std::move(route)); });
+  ASSERT_EQ(2, remaining.size());
+  for (const auto& route : remaining) {
+    EXPECT_TRUE(route == route2 or route == route3);
+  }
+}
+
 TEST(NetlinkTypes, IfAddressMoveTest) {
   folly::CIDRNetwork prefix{folly::IPAddress("fc00:cafe:3::3"), 128};
   uint32_t flags = 0x01;
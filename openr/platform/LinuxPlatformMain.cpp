@@ -19,6 +19,11 @@
 
 DEFINE_int32(
     fib_thrift_port, 60100, "Thrift server port for the NetlinkFibHandler");
+DEFINE_bool(
+    enable_route_mirror,
+    false,
+    "Mirror programmed routes from kernel route notifications and serve sync "
+    "and get requests from the mirror instead of dumping the kernel");
 
 using openr::NetlinkFibHandler;
 
@@ -49,7 +54,8 @@ main(int argc, char** argv) {
   nlEvb->waitUntilRunning();
 
   apache::thrift::ThriftServer linuxFibAgentServer;
-  auto fibHandler = std::make_shared<NetlinkFibHandler>(nlSock.get());
+  auto fibHandler = std::make_shared<NetlinkFibHandler>(
+      nlSock.get(), FLAGS_enable_route_mirror);
 
   // start FibService thread
   auto fibThriftThread = std::thread([fibHandler, &linuxFibAgentServer]() {
@@ -5,6 +5,7 @@
  * LICENSE file in the root directory of this source tree.
  */
 
+#include <fb303/ServiceData.h>
 #include <folly/gen/Base.h>
 #include <folly/logging/xlog.h>
 
@@ -15,6 +16,9 @@
 
 #include <net/if.h>
 
+using facebook::fb303::fbData;
+namespace fb303 = facebook::fb303;
+
 namespace openr {
 
 namespace {
@@ -36,13 +40,25 @@ createSemiFutureWithClientIdError() {
 
 } // namespace
 
-NetlinkFibHandler::NetlinkFibHandler(fbnl::NetlinkProtocolSocket* nlSock)
+NetlinkFibHandler::NetlinkFibHandler(
+    fbnl::NetlinkProtocolSocket* nlSock, bool enableRouteMirror)
     : facebook::fb303::BaseService("openr"),
       nlSock_(nlSock),
       startTime_(std::chrono::duration_cast<std::chrono::seconds>(
                      std::chrono::system_clock::now().time_since_epoch())
-                     .count()) {
+                     .count()),
+      enableRouteMirror_(enableRouteMirror),
+      routeMirrors_(std::make_shared<folly::Synchronized<RouteMirrors>>()) {
   CHECK_NOTNULL(nlSock);
+
+  if (enableRouteMirror_) {
+    // NOTE: Callback holds the mirrors and not `this` as socket may deliver
+    // events after this handler is gone
+    nlSock_->subscribeRouteEvents(
+        [mirrors = routeMirrors_](std::optional<fbnl::Route> route) {
+          processRouteEvent(*mirrors, std::move(route));
+        });
+  }
 }
 
 NetlinkFibHandler::~NetlinkFibHandler() {}
@@ -198,48 +214,25 @@ NetlinkFibHandler::semifuture_syncFib(
   // SemiFuture vector for collecting return values of all API calls
   std::vector<folly::SemiFuture<int>> result;
 
-  // Create set of existing route
-  // NOTE: Synchronous call to retrieve all the routes. We first make both
-  // requests to retrieve IPv4 and IPv6 routes. Subsequently we wait on them
-  // to complete and prepare the map of existing routes
-  std::unordered_map<folly::CIDRNetwork, fbnl::Route> existingRoutes;
-  {
-    auto v4Routes = nlSock_->getIPv4Routes(protocol.value()).get();
-    auto v6Routes = nlSock_->getIPv6Routes(protocol.value()).get();
-    if (v4Routes.hasError()) {
-      throw fbnl::NlException("Failed fetching IPv4 routes", v4Routes.error());
-    }
-    if (v6Routes.hasError()) {
-      throw fbnl::NlException("Failed fetching IPv6 routes", v6Routes.error());
-    }
-    for (auto& routesPtr : {&v4Routes, &v6Routes}) {
-      for (auto& route : routesPtr->value()) {
-        const auto prefix = route.getDestination();
-        // Linux will report a null next-hop for RTN_BLACKHOLE type while
-        // RIB does not
-        if (route.getType() == RTN_BLACKHOLE) {
-          route.setNextHops({});
-        }
-        existingRoutes.emplace(prefix, std::move(route));
-      }
-    }
-  }
+  // Create compact table of existing routes
+  // NOTE: Synchronous call to retrieve all the routes, unless served from
+  // the route mirror
+  auto existingRoutes = getExistingRoutes(protocol.value(), false /* mpls */);
 
-  // Go over the new routes. Add or update
-  std::unordered_set<folly::CIDRNetwork> newPrefixes;
+  // Go over the new routes. Add or update. Matched routes are removed from
+  // `existingRoutes` which leaves only the stale ones behind.
   for (auto& route : *unicastRoutes) {
-    const auto network = toIPNetwork(*route.dest());
-    newPrefixes.insert(network);
     auto nlRoute = buildRoute(route, protocol.value());
-    auto it = existingRoutes.find(network);
-    if (it != existingRoutes.end() and it->second == nlRoute) {
+    if (existingRoutes.containsEqual(nlRoute)) {
       // Existing route is same as the one we're trying to add. SKIP
+      existingRoutes.erase(nlRoute);
       continue;
     }
-    if (it != existingRoutes.end()) {
+    if (auto oldRoute = existingRoutes.find(nlRoute)) {
       XLOG(INFO) << "Updating unicast-route "
-                 << "\n[OLD] " << it->second.str() << "\n[NEW] "
+                 << "\n[OLD] " << oldRoute->str() << "\n[NEW] "
                  << nlRoute.str();
+      existingRoutes.erase(nlRoute);
     } else {
       XLOG(INFO) << "Adding unicast-route \n[NEW]" << nlRoute.str();
     }
@@ -248,16 +241,12 @@ NetlinkFibHandler::semifuture_syncFib(
   }
 
   // Go over the old routes to remove stale ones
-  for (auto& [prefix, nlRoute] : existingRoutes) {
-    if (newPrefixes.count(prefix)) {
-      // not a stale route
-      continue;
-    }
+  existingRoutes.forEachRoute([&](fbnl::Route&& nlRoute) {
     // Delete stale route
     XLOG(INFO) << "Deleting unicast-route "
-               << folly::IPAddress::networkToString(prefix);
+               << folly::IPAddress::networkToString(nlRoute.getDestination());
     result.emplace_back(nlSock_->deleteRoute(nlRoute));
-  }
+  });
 
   // Return collected result
   // NOTE: We're ignoring EEXIST error code. ESRCH error code must not be
@@ -281,33 +270,25 @@ NetlinkFibHandler::semifuture_syncMplsFib(
   // SemiFuture vector for collecting return values of all API calls
   std::vector<folly::SemiFuture<int>> result;
 
-  // Create set of existing route
-  // NOTE: Synchronous call to retrieve all the routes
-  std::unordered_map<int32_t, fbnl::Route> existingRoutes;
-  auto nlRoutes = nlSock_->getMplsRoutes(protocol.value()).get();
-  if (nlRoutes.hasError()) {
-    throw fbnl::NlException("Failed fetching IPv6 routes", nlRoutes.error());
-  }
-  for (auto& route : std::move(nlRoutes).value()) {
-    const auto topLabel = route.getMplsLabel().value();
-    existingRoutes.emplace(topLabel, std::move(route));
-  }
+  // Create compact table of existing routes
+  // NOTE: Synchronous call to retrieve all the routes, unless served from
+  // the route mirror
+  auto existingRoutes = getExistingRoutes(protocol.value(), true /* mpls */);
 
-  // Go over the new routes. Add or update
-  std::unordered_set<uint32_t> newLabels;
+  // Go over the new routes. Add or update. Matched routes are removed from
+  // `existingRoutes` which leaves only the stale ones behind.
   for (auto& route : *mplsRoutes) {
-    const auto label = *route.topLabel();
-    newLabels.insert(label);
     auto nlRoute = buildMplsRoute(route, protocol.value());
-    auto it = existingRoutes.find(label);
-    if (it != existingRoutes.end() and it->second == nlRoute) {
+    if (existingRoutes.containsEqual(nlRoute)) {
       // Existing route is same as the one we're trying to add. SKIP
+      existingRoutes.erase(nlRoute);
       continue;
     }
-    if (it != existingRoutes.end()) {
+    if (auto oldRoute = existingRoutes.find(nlRoute)) {
       XLOG(INFO) << "Updating mpls-route "
-                 << "\n[OLD] " << it->second.str() << "\n[NEW] "
+                 << "\n[OLD] " << oldRoute->str() << "\n[NEW] "
                  << nlRoute.str();
+      existingRoutes.erase(nlRoute);
     } else {
       XLOG(INFO) << "Adding mpls-route \n[NEW]" << nlRoute.str();
     }
@@ -316,15 +297,11 @@ NetlinkFibHandler::semifuture_syncMplsFib(
   }
 
   // Go over the old routes to remove stale ones
-  for (auto& [topLabel, nlRoute] : existingRoutes) {
-    if (newLabels.count(topLabel)) {
-      // not a stale route
-      continue;
-    }
+  existingRoutes.forEachRoute([&](fbnl::Route&& nlRoute) {
     // Delete stale route
     XLOG(INFO) << "Deleting mpls-route " << *nlRoute.getMplsLabel();
     result.emplace_back(nlSock_->deleteRoute(nlRoute));
-  }
+  });
 
   // Return collected result
   return fbnl::NetlinkProtocolSocket::collectReturnStatus(
@@ -356,6 +333,19 @@ NetlinkFibHandler::semifuture_getRouteTableByClient(int16_t clientId) {
   CHECK(protocol.has_value());
   XLOG(INFO) << "Get unicast routes for client " << getClientName(clientId);
 
+  fbnl::CompactRouteTable mirroredRoutes;
+  if (getMirroredRoutes(protocol.value(), false /* mpls */, mirroredRoutes)) {
+    auto routes = std::make_unique<std::vector<thrift::UnicastRoute>>();
+    routes->reserve(mirroredRoutes.size());
+    mirroredRoutes.forEachRoute([&](fbnl::Route&& nlRoute) {
+      thrift::UnicastRoute route;
+      route.dest() = toIpPrefix(nlRoute.getDestination());
+      route.nextHops() = toThriftNextHops(nlRoute.getNextHops());
+      routes->emplace_back(std::move(route));
+    });
+    return folly::makeSemiFuture(std::move(routes));
+  }
+
   auto v4Routes = nlSock_->getIPv4Routes(protocol.value());
   auto v6Routes = nlSock_->getIPv6Routes(protocol.value());
   return folly::collectAll(std::move(v4Routes), std::move(v6Routes))
@@ -391,6 +381,19 @@ NetlinkFibHandler::semifuture_getMplsRouteTableByClient(int16_t clientId) {
   CHECK(protocol.has_value());
   XLOG(INFO) << "Get mpls routes for client " << getClientName(clientId);
 
+  fbnl::CompactRouteTable mirroredRoutes;
+  if (getMirroredRoutes(protocol.value(), true /* mpls */, mirroredRoutes)) {
+    auto routes = std::make_unique<std::vector<thrift::MplsRoute>>();
+    routes->reserve(mirroredRoutes.size());
+    mirroredRoutes.forEachRoute([&](fbnl::Route&& nlRoute) {
+      thrift::MplsRoute route;
+      route.topLabel() = nlRoute.getMplsLabel().value();
+      route.nextHops() = toThriftNextHops(nlRoute.getNextHops());
+      routes->emplace_back(std::move(route));
+    });
+    return folly::makeSemiFuture(std::move(routes));
+  }
+
   return nlSock_->getMplsRoutes(protocol.value())
       .deferValue(
           [this](folly::Expected<std::vector<fbnl::Route>, int>&& nlRoutes) {
@@ -410,6 +413,143 @@ NetlinkFibHandler::semifuture_getMplsRouteTableByClient(int16_t clientId) {
           });
 }
 
+void
+NetlinkFibHandler::processRouteEvent(
+    folly::Synchronized<RouteMirrors>& mirrors,
+    std::optional<fbnl::Route> route) {
+  auto lockedMirrors = mirrors.wlock();
+  if (not route.has_value()) {
+    // Notifications are lost. Invalidate all mirrors, including those in
+    // the middle of resync, to enforce a fresh dump.
+    XLOG(WARNING) << "Route notifications lost. Invalidating route mirrors";
+    for (auto* byProtocol : {&lockedMirrors->unicast, &lockedMirrors->mpls}) {
+      for (auto& [_, mirror] : *byProtocol) {
+        mirror = RouteMirror{};
+      }
+    }
+    return;
+  }
+
+  // Only routes of protocols being mirrored are of interest
+  auto& byProtocol = lockedMirrors->get(route->getFamily() == AF_MPLS);
+  auto it = byProtocol.find(route->getProtocolId());
+  if (it == byProtocol.end()) {
+    return;
+  }
+  auto& mirror = it->second;
+  if (mirror.pendingEvents.has_value()) {
+    mirror.pendingEvents->emplace_back(std::move(route).value());
+  } else if (mirror.synced) {
+    applyRouteEvent(mirror.routes, std::move(route).value());
+  }
+}
+
+void
+NetlinkFibHandler::applyRouteEvent(
+    fbnl::CompactRouteTable& routes, fbnl::Route&& route) {
+  if (not route.isValid()) {
+    routes.erase(route);
+    return;
+  }
+  // Linux will report a null next-hop for RTN_BLACKHOLE type while
+  // RIB does not
+  if (route.getType() == RTN_BLACKHOLE) {
+    route.setNextHops({});
+  }
+  routes.insert(std::move(route));
+}
+
+bool
+NetlinkFibHandler::getMirroredRoutes(
+    uint8_t protocol, bool isMpls, fbnl::CompactRouteTable& routes) {
+  if (not enableRouteMirror_) {
+    return false;
+  }
+  auto lockedMirrors = routeMirrors_->rlock();
+  const auto& byProtocol =
+      isMpls ? lockedMirrors->mpls : lockedMirrors->unicast;
+  auto it = byProtocol.find(protocol);
+  if (it == byProtocol.end() or not it->second.synced) {
+    return false;
+  }
+  it->second.routes.forEachRoute(
+      [&](fbnl::Route&& route) { routes.insert(std::move(route)); });
+  return true;
+}
+
+fbnl::CompactRouteTable
+NetlinkFibHandler::getExistingRoutes(uint8_t protocol, bool isMpls) {
+  fbnl::CompactRouteTable existingRoutes;
+  if (getMirroredRoutes(protocol, isMpls, existingRoutes)) {
+    fbData->addStatValue("platform.route_mirror.hits", 1, fb303::COUNT);
+    return existingRoutes;
+  }
+
+  // Record notifications from now on. Those that race with the dump are
+  // replayed on top of its result, which converges to the kernel state as
+  // every event fully determines the state of its route. A resync already in
+  // progress is recording and any later dump can complete it.
+  if (enableRouteMirror_) {
+    auto lockedMirrors = routeMirrors_->wlock();
+    auto& mirror = lockedMirrors->get(isMpls)[protocol];
+    if (not mirror.pendingEvents.has_value()) {
+      fbData->addStatValue("platform.route_mirror.resyncs", 1, fb303::COUNT);
+      mirror = RouteMirror{};
+      mirror.pendingEvents.emplace();
+    }
+  }
+
+  // NOTE: Each address family is fetched and folded into the compact table in
+  // turn so that only one family is fully materialized at any time.
+  auto addRoutes = [&](folly::Expected<std::vector<fbnl::Route>, int>&& routes,
+                       const std::string& family) {
+    if (routes.hasError()) {
+      if (enableRouteMirror_) {
+        routeMirrors_->wlock()->get(isMpls)[protocol] = RouteMirror{};
+      }
+      throw fbnl::NlException(
+          fmt::format("Failed fetching {} routes", family), routes.error());
+    }
+    for (auto& route : routes.value()) {
+      // Linux will report a null next-hop for RTN_BLACKHOLE type while
+      // RIB does not
+      if (route.getType() == RTN_BLACKHOLE) {
+        route.setNextHops({});
+      }
+      existingRoutes.insert(std::move(route));
+    }
+  };
+  if (isMpls) {
+    addRoutes(nlSock_->getMplsRoutes(protocol).get(), "MPLS");
+  } else {
+    addRoutes(nlSock_->getIPv4Routes(protocol).get(), "IPv4");
+    addRoutes(nlSock_->getIPv6Routes(protocol).get(), "IPv6");
+  }
+  XLOG(INFO) << "Fetched " << existingRoutes.size() << " routes of protocol "
+             << static_cast<int>(protocol) << " from kernel with "
+             << existingRoutes.numShapes() << " distinct route shapes";
+
+  if (enableRouteMirror_) {
+    auto lockedMirrors = routeMirrors_->wlock();
+    auto& mirror = lockedMirrors->get(isMpls)[protocol];
+    // Notifications got lost while dumping, or a concurrent resync completed
+    if (not mirror.pendingEvents.has_value()) {
+      return existingRoutes;
+    }
+    existingRoutes.forEachRoute(
+        [&](fbnl::Route&& route) { mirror.routes.insert(std::move(route)); });
+    for (auto& route : *mirror.pendingEvents) {
+      applyRouteEvent(mirror.routes, std::move(route));
+    }
+    mirror.pendingEvents.reset();
+    mirror.synced = true;
+    XLOG(INFO) << "Route mirror for protocol " << static_cast<int>(protocol)
+               << (isMpls ? " (mpls)" : " (unicast)") << " is in sync with "
+               << mirror.routes.size() << " routes";
+  }
+  return existingRoutes;
+}
+
 std::vector<thrift::NextHopThrift>
 NetlinkFibHandler::toThriftNextHops(const fbnl::NextHopSet& nextHops) {
   std::vector<thrift::NextHopThrift> thriftNextHops;
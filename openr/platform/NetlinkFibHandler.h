@@ -28,11 +28,16 @@ namespace openr {
  * - Translates netlink representation of routes to thrift for get* queries
  * - All APIs exposed are asynchronous. Sync API retries the existing routing
  *   state in synchronous way and program changes asynchrnously.
+ * - Optionally mirrors the routes of every client protocol in memory from
+ *   kernel route notifications. Once a protocol's routes have been reconciled
+ *   against a kernel dump, sync and get APIs are served from the mirror and no
+ *   longer dump the kernel table, until notifications are lost.
  */
 class NetlinkFibHandler : public virtual thrift::FibServiceSvIf,
                           public facebook::fb303::BaseService {
  public:
-  explicit NetlinkFibHandler(fbnl::NetlinkProtocolSocket* nlSock);
+  explicit NetlinkFibHandler(
+      fbnl::NetlinkProtocolSocket* nlSock, bool enableRouteMirror = false);
   ~NetlinkFibHandler() override;
 
   void
@@ -199,6 +204,63 @@ class NetlinkFibHandler : public virtual thrift::FibServiceSvIf,
 
   // Flag indicating the interface cache contains invalid entries
   bool cacheInvalid_{false};
+
+  /**
+   * In-memory mirror of the routes of one protocol and one kind (unicast or
+   * MPLS), maintained from kernel route notifications.
+   */
+  struct RouteMirror {
+    // Set once reconciled against a kernel dump. Cleared on notification loss
+    bool synced{false};
+
+    // Notifications received while a dump is outstanding. They are replayed
+    // in arrival order over the dump result.
+    std::optional<std::vector<fbnl::Route>> pendingEvents;
+
+    fbnl::CompactRouteTable routes;
+  };
+
+  struct RouteMirrors {
+    std::unordered_map<uint8_t, RouteMirror> unicast;
+    std::unordered_map<uint8_t, RouteMirror> mpls;
+
+    std::unordered_map<uint8_t, RouteMirror>&
+    get(bool isMpls) {
+      return isMpls ? mpls : unicast;
+    }
+  };
+
+  /**
+   * Apply route notification to mirrors. Runs on the netlink event base.
+   * `std::nullopt` indicates lost notifications and invalidates all mirrors.
+   */
+  static void processRouteEvent(
+      folly::Synchronized<RouteMirrors>& mirrors,
+      std::optional<fbnl::Route> route);
+
+  // Apply a single route add (valid route) or delete to `routes`
+  static void applyRouteEvent(
+      fbnl::CompactRouteTable& routes, fbnl::Route&& route);
+
+  /**
+   * Copy routes of `protocol` from the mirror into `routes`. Returns false if
+   * the mirror is disabled or not in sync.
+   */
+  bool getMirroredRoutes(
+      uint8_t protocol, bool isMpls, fbnl::CompactRouteTable& routes);
+
+  /**
+   * Retrieve existing routes of `protocol` for sync. Served from the mirror
+   * when in sync. Otherwise routes are dumped from kernel and, with mirror
+   * enabled, the mirror is reconciled against the dump.
+   */
+  fbnl::CompactRouteTable getExistingRoutes(uint8_t protocol, bool isMpls);
+
+  const bool enableRouteMirror_{false};
+
+  // Shared with the route event callback registered on `nlSock_`, which may
+  // outlive this handler
+  std::shared_ptr<folly::Synchronized<RouteMirrors>> routeMirrors_;
 };
 
 } // namespace openr
@@ -761,6 +761,76 @@ TEST_P(FibHandlerFixture, MplsMultipleClient) {
   }
 }
 
+//
+// Test route mirror maintained from route notifications
+// - First sync reconciles the mirror against a kernel dump
+// - Subsequent syncs and reads are served from the mirror without dumps
+// - Lost notifications invalidate the mirror and enforce a dump again
+//
+TEST(NetlinkFibHandler, RouteMirror) {
+  const int16_t kClientId = 786;
+  folly::EventBase evb;
+  fbnl::MockNetlinkProtocolSocket nlSock(&evb);
+  ASSERT_EQ(
+      0,
+      nlSock.addLink(fbnl::utils::createLink(0, "lo", true, true)).get());
+  for (size_t i = 0; i < kInterfaces.size(); ++i) {
+    ASSERT_EQ(
+        0,
+        nlSock.addLink(fbnl::utils::createLink(i + 1, kInterfaces.at(i)))
+            .get());
+  }
+  NetlinkFibHandler handler(&nlSock, true /* enableRouteMirror */);
+
+  auto getRoutes = [&]() {
+    auto routes = handler.semifuture_getRouteTableByClient(kClientId).get();
+    // NOTE: Mirror doesn't return routes in sorted order
+    std::sort(routes->begin(), routes->end());
+    sortNextHops(*routes);
+    return *routes;
+  };
+  auto syncRoutes = [&](const std::vector<thrift::UnicastRoute>& routes) {
+    handler
+        .semifuture_syncFib(
+            kClientId,
+            std::make_unique<std::vector<thrift::UnicastRoute>>(routes))
+        .get();
+  };
+
+  // Sync routes. Mirror is not in sync and kernel is dumped (IPv4 + IPv6)
+  auto rts = createUnicastRoutes(4, false /* isV4 */);
+  syncRoutes(rts);
+  EXPECT_EQ(2, nlSock.getNumRouteDumps());
+
+  // Reads and syncs are served from the mirror
+  EXPECT_EQ(rts, getRoutes());
+  rts = createUnicastRoutes(6, false /* isV4 */);
+  syncRoutes(rts);
+  EXPECT_EQ(rts, getRoutes());
+  EXPECT_EQ(2, nlSock.getNumRouteDumps());
+
+  // Route deletion is reflected in the mirror
+  handler
+      .semifuture_deleteUnicastRoutes(
+          kClientId,
+          std::make_unique<std::vector<thrift::IpPrefix>>(
+              std::vector<thrift::IpPrefix>{*rts.back().dest()}))
+      .get();
+  rts.pop_back();
+  EXPECT_EQ(rts, getRoutes());
+  EXPECT_EQ(2, nlSock.getNumRouteDumps());
+
+  // Lost notifications. Reads fall back to kernel dumps until the next sync
+  // reconciles the mirror
+  nlSock.notifyRouteEventsLost();
+  EXPECT_EQ(rts, getRoutes());
+  EXPECT_EQ(4, nlSock.getNumRouteDumps());
+  syncRoutes(rts);
+  EXPECT_EQ(6, nlSock.getNumRouteDumps());
+  EXPECT_EQ(rts, getRoutes());
+  EXPECT_EQ(6, nlSock.getNumRouteDumps());
+}
+
 //
 // instantiate parameterized tests
 //
@@ -5,14 +5,919 @@
  * LICENSE file in the root directory of this source tree.
  */
 
+#include <array>
+#include <limits>
+#include <map>
+#include <stdexcept>
+#include <unordered_map>
+#include <unordered_set>
+
+#include <fb303/ServiceData.h>
+#include <fmt/format.h>
+#include <folly/IPAddress.h>
+#include <folly/String.h>
+#include <folly/hash/Hash.h>
+#include <folly/logging/xlog.h>
+#include <re2/re2.h>
+
+#include <openr/common/Constants.h>
+#include <openr/common/NetworkUtil.h>
 #include <openr/policy/PolicyManager.h>
 
 namespace openr {
 
-class PolicyManagerImpl {};
+namespace {
+
+using neteng::config::routing_policy::Filter;
+using neteng::config::routing_policy::FilterCriteria;
+using neteng::config::routing_policy::FilterTransform;
+using neteng::config::routing_policy::Operator;
+using neteng::config::routing_policy::PolicyConfig;
+using neteng::config::routing_policy::RuleAction;
+using neteng::config::routing_policy::RuleCondition;
+
+// Match/Miss action of a single rule inside of a ruleset
+struct RuleActions {
+  RuleAction onMatch{RuleAction::nextRule};
+  RuleAction onMiss{RuleAction::nextRule};
+};
+
+/*
+ * Walk through the ordered ruleset and return <allow, terminating rule index>.
+ * Rule index is std::nullopt if no rule terminated the walk and the ruleset
+ * miss action has been taken.
+ *
+ * `onMatchFn` is invoked for every matched rule before its action is taken.
+ * `gotoRule` is not supported yet and behaves like `nextRule`.
+ */
+template <typename MatchFn, typename OnMatchFn>
+std::pair<bool, std::optional<size_t>>
+walkRuleset(
+    const std::vector<RuleActions>& rules,
+    RuleAction rulesetMissAction,
+    MatchFn&& matchFn,
+    OnMatchFn&& onMatchFn) {
+  for (size_t idx = 0; idx < rules.size(); ++idx) {
+    RuleAction action;
+    if (matchFn(idx)) {
+      onMatchFn(idx);
+      action = rules[idx].onMatch;
+    } else {
+      action = rules[idx].onMiss;
+    }
+
+    if (action == RuleAction::allow) {
+      return {true, idx};
+    }
+    if (action == RuleAction::deny) {
+      return {false, idx};
+    }
+  }
+  return {rulesetMissAction == RuleAction::allow, std::nullopt};
+}
+
+bool
+evalCondition(RuleCondition condition, size_t matched, size_t total) {
+  switch (condition) {
+  case RuleCondition::matchAll:
+    return total > 0 and matched == total;
+  case RuleCondition::matchNone:
+    return matched == 0;
+  case RuleCondition::matchAny:
+  default:
+    return matched > 0;
+  }
+}
+
+RuleCondition
+getCondition(const FilterCriteria& criteria) {
+  return criteria.condition_id().value_or(RuleCondition::matchAny);
+}
+
+template <typename DefinitionsRef>
+const auto&
+lookupDefinition(
+    DefinitionsRef definitions,
+    const std::string& name,
+    folly::StringPiece kind) {
+  if (not definitions or definitions->objects()->count(name) == 0) {
+    throw std::invalid_argument(
+        fmt::format("No {} definition found for {}", kind, name));
+  }
+  return definitions->objects()->at(name);
+}
+
+std::vector<RuleActions>
+getRuleActions(const Filter& filter) {
+  std::vector<RuleActions> rules;
+  rules.reserve(filter.ruleset()->size());
+  for (const auto& rule : *filter.ruleset()) {
+    rules.emplace_back(
+        RuleActions{*rule.ruleMatchAction_id(), *rule.ruleMissAction_id()});
+  }
+  return rules;
+}
+
+/*
+ * Prefix filter (aka prefix-list) with ge/le ranges.
+ *
+ * Base prefixes are indexed by their length into hash buckets. Matching a
+ * prefix then costs one masked lookup per distinct base length which is
+ * shorter than (or equal to) the prefix length, regardless of the number of
+ * entries in the prefix-list.
+ */
+class PrefixFilter {
+ public:
+  explicit PrefixFilter(const Filter& filter)
+      : ignoreV4_(filter.ignoreIPv4().value_or(false)),
+        ignoreV6_(filter.ignoreIPv6().value_or(false)),
+        rules_(getRuleActions(filter)),
+        rulesetMissAction_(*filter.rulesetMissAction_id()) {
+    const auto& ruleset = *filter.ruleset();
+    for (size_t ruleIdx = 0; ruleIdx < ruleset.size(); ++ruleIdx) {
+      const auto& rule = ruleset.at(ruleIdx);
+      conditions_.emplace_back(*rule.condition_id());
+      criteriaCnt_.emplace_back(std::array<size_t, 2>{0, 0});
+      for (const auto& criteria : *rule.criteria()) {
+        if (auto base = criteria.basePrefixIPv4()) {
+          addCriteria(
+              ruleIdx,
+              *base,
+              criteria.minLengthIPv4().to_optional(),
+              criteria.maxLengthIPv4().to_optional());
+        }
+        if (auto base = criteria.basePrefixIPv6()) {
+          addCriteria(
+              ruleIdx,
+              *base,
+              criteria.minLengthIPv6().to_optional(),
+              criteria.maxLengthIPv6().to_optional());
+        }
+      }
+    }
+  }
+
+  bool
+  allow(const folly::CIDRNetwork& prefix) const {
+    const bool isV4 = prefix.first.isV4();
+    const auto& index = isV4 ? v4Index_ : v6Index_;
+    const bool ignored = isV4 ? ignoreV4_ : ignoreV6_;
+    std::vector<size_t> matchCnt(rules_.size(), 0);
+    if (not ignored) {
+      for (const auto& [baseLen, bases] : index) {
+        if (baseLen > prefix.second) {
+          break; // NOTE: std::map is ordered by base length
+        }
+        auto it = bases.find(prefix.first.mask(baseLen));
+        if (it == bases.end()) {
+          continue;
+        }
+        for (const auto& range : it->second) {
+          if (prefix.second >= range.minLen and prefix.second <= range.maxLen) {
+            ++matchCnt.at(range.ruleIdx);
+          }
+        }
+      }
+    }
+
+    return walkRuleset(
+               rules_,
+               rulesetMissAction_,
+               [&](size_t idx) {
+                 return evalCondition(
+                     conditions_.at(idx),
+                     matchCnt.at(idx),
+                     criteriaCnt_.at(idx).at(isV4 ? 0 : 1));
+               },
+               [](size_t) {})
+        .first;
+  }
+
+ private:
+  struct LengthRange {
+    size_t ruleIdx{0};
+    uint8_t minLen{0};
+    uint8_t maxLen{0};
+  };
+
+  // base prefix length -> masked base address -> length ranges
+  using Index = std::map<
+      uint8_t,
+      std::unordered_map<folly::IPAddress, std::vector<LengthRange>>>;
+
+  void
+  addCriteria(
+      size_t ruleIdx,
+      const std::string& basePrefix,
+      const std::optional<int16_t>& minLen,
+      const std::optional<int16_t>& maxLen) {
+    folly::CIDRNetwork base;
+    try {
+      base = folly::IPAddress::createNetwork(basePrefix);
+    } catch (const std::exception& ex) {
+      throw std::invalid_argument(fmt::format(
+          "Invalid base prefix {} in prefix filter: {}",
+          basePrefix,
+          ex.what()));
+    }
+
+    // ATTN: without explicit ge/le the base prefix is matched exactly
+    const int min = minLen.value_or(base.second);
+    const int max = maxLen.value_or(base.second);
+    if (min < base.second or min > max or max > base.first.bitCount()) {
+      throw std::invalid_argument(fmt::format(
+          "Invalid length range [{}, {}] for base prefix {}",
+          min,
+          max,
+          basePrefix));
+    }
+
+    LengthRange range;
+    range.ruleIdx = ruleIdx;
+    range.minLen = static_cast<uint8_t>(min);
+    range.maxLen = static_cast<uint8_t>(max);
+
+    auto& index = base.first.isV4() ? v4Index_ : v6Index_;
+    index[base.second][base.first].emplace_back(range);
+    ++criteriaCnt_.at(ruleIdx).at(base.first.isV4() ? 0 : 1);
+  }
+
+  const bool ignoreV4_{false};
+  const bool ignoreV6_{false};
+  const std::vector<RuleActions> rules_;
+  const RuleAction rulesetMissAction_;
+  std::vector<RuleCondition> conditions_;
+  // number of [v4, v6] criteria per rule
+  std::vector<std::array<size_t, 2>> criteriaCnt_;
+  Index v4Index_;
+  Index v6Index_;
+};
+
+/*
+ * Filter whose criteria are regular expressions, e.g. `openrTagFilters` and
+ * `openrAreaStackFilters`. A value is matched against the full regex.
+ */
+class RegexFilter {
+ public:
+  explicit RegexFilter(const Filter& filter)
+      : rules_(getRuleActions(filter)),
+        rulesetMissAction_(*filter.rulesetMissAction_id()) {
+    for (const auto& rule : *filter.ruleset()) {
+      conditions_.emplace_back(*rule.condition_id());
+      auto& regexes = regexes_.emplace_back();
+      for (const auto& criteria : *rule.criteria()) {
+        if (not criteria.regex()) {
+          continue;
+        }
+        auto re = std::make_unique<re2::RE2>(*criteria.regex());
+        if (not re->ok()) {
+          throw std::invalid_argument(fmt::format(
+              "Invalid regex {}: {}", *criteria.regex(), re->error()));
+        }
+        regexes.emplace_back(std::move(re));
+      }
+    }
+  }
+
+  bool
+  allow(const std::string& value) const {
+    return walkRuleset(
+               rules_,
+               rulesetMissAction_,
+               [&](size_t idx) {
+                 size_t matched{0};
+                 for (const auto& re : regexes_.at(idx)) {
+                   matched += re2::RE2::FullMatch(value, *re) ? 1 : 0;
+                 }
+                 return evalCondition(
+                     conditions_.at(idx), matched, regexes_.at(idx).size());
+               },
+               [](size_t) {})
+        .first;
+  }
+
+ private:
+  const std::vector<RuleActions> rules_;
+  const RuleAction rulesetMissAction_;
+  std::vector<RuleCondition> conditions_;
+  std::vector<std::vector<std::unique_ptr<re2::RE2>>> regexes_;
+};
+
+// Compiled form of `FilterCriteria`. All configured attributes must match.
+struct PolicyCriteria {
+  bool alwaysMatch{false};
+  std::vector<const PrefixFilter*> prefixFilters;
+  std::optional<std::unordered_set<std::string>> tags;
+  RuleCondition tagsCondition{RuleCondition::matchAny};
+  std::vector<const RegexFilter*> tagFilters;
+  std::vector<const RegexFilter*> areaStackFilters;
+  std::optional<std::vector<std::string>> areaStack;
+  std::optional<int32_t> pathPreference;
+  std::optional<int32_t> sourcePreference;
+  std::optional<thrift::PrefixForwardingType> forwardingType;
+  std::optional<thrift::PrefixForwardingAlgorithm> forwardingAlgorithm;
+  std::optional<std::pair<int64_t, int64_t>> igpCostRange;
+  // Set if criteria carries attribute which is not applicable to Open/R
+  // prefix entries, e.g. bgp communities. Such criteria never matches.
+  bool unsupported{false};
+  bool empty{true};
+};
+
+// Compiled form of `FilterTransform`
+struct PolicyTransform {
+  std::optional<std::pair<Operator, std::vector<std::string>>> tags;
+  std::vector<const RegexFilter*> removeTagFilters;
+  std::optional<std::pair<Operator, int64_t>> distance;
+  std::optional<int32_t> pathPreference;
+  std::optional<thrift::PrefixForwardingType> forwardingType;
+  std::optional<thrift::PrefixForwardingAlgorithm> forwardingAlgorithm;
+  std::optional<int64_t> minNexthop;
+  std::optional<bool> acceptPrependLabel;
+  std::optional<bool> acceptWeight;
+};
+
+struct PolicyRule {
+  std::string name;
+  RuleCondition condition{RuleCondition::matchAny};
+  std::vector<PolicyCriteria> criteria;
+  std::vector<PolicyTransform> transforms;
+  // pre-formatted fb303 hit counter key
+  std::string counterKey;
+};
+
+struct PolicyStatement {
+  std::string name;
+  std::vector<RuleActions> actions;
+  std::vector<PolicyRule> rules;
+  RuleAction rulesetMissAction{RuleAction::allow};
+  // hit counter key for ruleset miss
+  std::string counterKey;
+};
+
+// Memoized result of one policy evaluation
+struct PolicyResult {
+  // input of evaluation, used to verify a hash hit
+  const PolicyStatement* statement{nullptr};
+  thrift::PrefixEntry input;
+  std::optional<int64_t> actionWeight;
+  std::optional<unsigned int> igpCost;
+
+  // output of evaluation
+  bool accepted{false};
+  // post policy entry, only set if transforms changed the entry
+  std::shared_ptr<thrift::PrefixEntry> modified{nullptr};
+  std::optional<size_t> hitRule;
+};
+
+size_t
+hashPolicyInput(
+    const PolicyStatement* statement,
+    const thrift::PrefixEntry& entry,
+    const std::optional<int64_t>& actionWeight,
+    const std::optional<unsigned int>& igpCost) {
+  const auto& metrics = *entry.metrics();
+  return folly::hash::hash_combine(
+      statement,
+      *entry.prefix()->prefixAddress()->addr(),
+      *entry.prefix()->prefixLength(),
+      static_cast<int>(*entry.forwardingType()),
+      static_cast<int>(*entry.forwardingAlgorithm()),
+      entry.minNexthop().value_or(-1),
+      entry.prependLabel().value_or(-1),
+      entry.weight().value_or(-1),
+      *metrics.path_preference(),
+      *metrics.source_preference(),
+      *metrics.distance(),
+      *metrics.drain_metric(),
+      folly::hash::hash_range(entry.tags()->begin(), entry.tags()->end()),
+      folly::hash::hash_range(
+          entry.area_stack()->begin(), entry.area_stack()->end()),
+      actionWeight.value_or(-1),
+      igpCost.has_value() ? static_cast<int64_t>(*igpCost) : -1);
+}
+
+} // namespace
+
+class PolicyManagerImpl {
+ public:
+  explicit PolicyManagerImpl(const PolicyConfig& config) : config_(config) {
+    const auto& filters = *config_.filters();
+    // ATTN: propagation policy wins on name collision
+    for (const auto policies :
+         {filters.routePropagationPolicy(), filters.routeOriginationPolicy()}) {
+      if (not policies) {
+        continue;
+      }
+      for (const auto& [name, filter] : *policies->objects()) {
+        if (statements_.count(name) == 0) {
+          statements_.emplace(name, compileStatement(name, filter));
+        }
+      }
+    }
+    XLOG(INFO) << "[Policy] Compiled " << statements_.size()
+               << " policy statements, " << prefixFilters_.size()
+               << " prefix filters, " << regexFilters_.size()
+               << " regex filters";
+  }
+
+  std::pair<std::shared_ptr<thrift::PrefixEntry>, std::string>
+  applyPolicy(
+      const std::string& policyStatementName,
+      const std::shared_ptr<thrift::PrefixEntry>& prefixEntry,
+      const std::optional<OpenrPolicyActionData>& policyActionData,
+      const std::optional<OpenrPolicyMatchData>& policyMatchData,
+      bool countHit) {
+    auto stmtIt = statements_.find(policyStatementName);
+    if (stmtIt == statements_.end() or not prefixEntry) {
+      return {prefixEntry, "Always Allow"};
+    }
+    const auto& statement = stmtIt->second;
+
+    std::optional<int64_t> actionWeight;
+    if (policyActionData) {
+      actionWeight = policyActionData->weight;
+    }
+    std::optional<unsigned int> igpCost;
+    if (policyMatchData) {
+      igpCost = policyMatchData->igpCost;
+    }
+
+    // Look up memoized result first
+    const auto hash =
+        hashPolicyInput(&statement, *prefixEntry, actionWeight, igpCost);
+    auto cacheIt = resultCache_.find(hash);
+    if (cacheIt == resultCache_.end() or
+        cacheIt->second.statement != &statement or
+        cacheIt->second.actionWeight != actionWeight or
+        cacheIt->second.igpCost != igpCost or
+        cacheIt->second.input != *prefixEntry) {
+      if (resultCache_.size() >= Constants::kPolicyResultCacheMaxSize) {
+        resultCache_.clear();
+      }
+      auto result = evaluate(statement, *prefixEntry, actionWeight, igpCost);
+      cacheIt = resultCache_.insert_or_assign(hash, std::move(result)).first;
+    }
+    const auto& result = cacheIt->second;
+
+    std::string hitName = statement.name;
+    const auto* counterKey = &statement.counterKey;
+    if (result.hitRule) {
+      const auto& rule = statement.rules.at(*result.hitRule);
+      hitName = rule.name;
+      counterKey = &rule.counterKey;
+    }
+    if (countHit) {
+      fb303::fbData->addStatValue(*counterKey, 1, fb303::COUNT);
+    }
+
+    if (not result.accepted) {
+      return {nullptr, std::move(hitName)};
+    }
+    if (result.modified) {
+      // hand out a private copy, caller is free to mutate it
+      return {
+          std::make_shared<thrift::PrefixEntry>(*result.modified),
+          std::move(hitName)};
+    }
+    return {prefixEntry, std::move(hitName)};
+  }
+
+  size_t
+  getResultCacheSize() const {
+    return resultCache_.size();
+  }
+
+ private:
+  PolicyStatement
+  compileStatement(const std::string& name, const Filter& filter) {
+    PolicyStatement statement;
+    statement.name = name;
+    statement.actions = getRuleActions(filter);
+    statement.rulesetMissAction = *filter.rulesetMissAction_id();
+    statement.counterKey = fmt::format("policy_manager.{}.default.hit", name);
+    for (const auto& tRule : *filter.ruleset()) {
+      auto& rule = statement.rules.emplace_back();
+      rule.name = *tRule._name();
+      rule.condition = *tRule.condition_id();
+      rule.counterKey =
+          fmt::format("policy_manager.{}.{}.hit", name, rule.name);
+      for (const auto& tCriteria : *tRule.criteria()) {
+        rule.criteria.emplace_back(compileCriteria(tCriteria));
+      }
+      if (auto tTransforms = tRule.transform()) {
+        for (const auto& tTransform : *tTransforms) {
+          rule.transforms.emplace_back(compileTransform(tTransform));
+        }
+      }
+    }
+    return statement;
+  }
+
+  PolicyCriteria
+  compileCriteria(const FilterCriteria& tCriteria) {
+    const auto& definitions = *config_.definitions();
+    const auto& filters = *config_.filters();
+
+    PolicyCriteria criteria;
+    criteria.alwaysMatch = tCriteria.alwaysMatch().value_or(false);
+    if (auto names = tCriteria.prefixFilters()) {
+      for (const auto& name : *names) {
+        criteria.prefixFilters.emplace_back(getPrefixFilter(name));
+      }
+      criteria.empty = false;
+    }
+    if (auto names = tCriteria.openrTags()) {
+      criteria.tags.emplace();
+      for (const auto& name : *names) {
+        const auto& tag =
+            lookupDefinition(definitions.openrTag(), name, "openrTag");
+        criteria.tags->insert(tag.tagSet()->begin(), tag.tagSet()->end());
+      }
+      criteria.tagsCondition = getCondition(tCriteria);
+      criteria.empty = false;
+    }
+    if (auto names = tCriteria.openrTagFilters()) {
+      for (const auto& name : *names) {
+        criteria.tagFilters.emplace_back(
+            getRegexFilter(filters.openrTagFilters(), name, "openrTagFilter"));
+      }
+      criteria.empty = false;
+    }
+    if (auto names = tCriteria.openrAreaStackFilters()) {
+      for (const auto& name : *names) {
+        criteria.areaStackFilters.emplace_back(getRegexFilter(
+            filters.openrAreaStackFilters(), name, "openrAreaStackFilter"));
+      }
+      criteria.empty = false;
+    }
+    if (auto name = tCriteria.openrAreaStack()) {
+      criteria.areaStack = *lookupDefinition(
+                                definitions.openrAreaStack(),
+                                *name,
+                                "openrAreaStack")
+                                .areaStack();
+      criteria.empty = false;
+    }
+    if (auto name = tCriteria.openrPathPreference()) {
+      criteria.pathPreference = *lookupDefinition(
+                                     definitions.openrPathPreference(),
+                                     *name,
+                                     "openrPathPreference")
+                                     .pathPreference();
+      criteria.empty = false;
+    }
+    if (auto name = tCriteria.openrSourcePreference()) {
+      criteria.sourcePreference = *lookupDefinition(
+                                       definitions.openrSourcePreference(),
+                                       *name,
+                                       "openrSourcePreference")
+                                       .sourcePreference();
+      criteria.empty = false;
+    }
+    if (auto name = tCriteria.openrPrefixForwardingType()) {
+      criteria.forwardingType = getForwardingType(*name);
+      criteria.empty = false;
+    }
+    if (auto name = tCriteria.openrPrefixForwardingAlgorithm()) {
+      criteria.forwardingAlgorithm = getForwardingAlgorithm(*name);
+      criteria.empty = false;
+    }
+    if (auto name = tCriteria.openrIgpCostRange()) {
+      const auto& range = lookupDefinition(
+          definitions.openrIgpCostRange(), *name, "openrIgpCostRange");
+      criteria.igpCostRange = std::make_pair(
+          static_cast<int64_t>(range.minCost().value_or(0)),
+          range.maxCost().has_value() ? static_cast<int64_t>(*range.maxCost())
+                                      : std::numeric_limits<int64_t>::max());
+      criteria.empty = false;
+    }
+    if (tCriteria.nextHop() or tCriteria.bgpCommunities() or
+        tCriteria.bgpCommunityFilters() or tCriteria.bgpLocalPref() or
+        tCriteria.bgpOrigin() or tCriteria.bgpPathFilters() or
+        tCriteria.bgpPath()) {
+      XLOG(WARNING) << "[Policy] Ignoring criteria with attributes not "
+                    << "applicable to Open/R prefixes";
+      criteria.unsupported = true;
+    }
+    return criteria;
+  }
+
+  PolicyTransform
+  compileTransform(const FilterTransform& tTransform) {
+    const auto& definitions = *config_.definitions();
+    const auto& filters = *config_.filters();
+    const auto op = tTransform.operation_id().to_optional();
+
+    PolicyTransform transform;
+    if (auto names = tTransform.openrTags()) {
+      std::vector<std::string> tags;
+      for (const auto& name : *names) {
+        const auto& tag =
+            lookupDefinition(definitions.openrTag(), name, "openrTag");
+        tags.insert(tags.end(), tag.tagSet()->begin(), tag.tagSet()->end());
+      }
+      transform.tags = std::make_pair(op.value_or(Operator::add), tags);
+    }
+    if (auto names = tTransform.openrTagFilters()) {
+      for (const auto& name : *names) {
+        transform.removeTagFilters.emplace_back(
+            getRegexFilter(filters.openrTagFilters(), name, "openrTagFilter"));
+      }
+    }
+    if (auto distance = tTransform.openrDistance()) {
+      transform.distance =
+          std::make_pair(op.value_or(Operator::rewrite), *distance);
+    }
+    if (auto name = tTransform.openrPathPreference()) {
+      transform.pathPreference = *lookupDefinition(
+                                      definitions.openrPathPreference(),
+                                      *name,
+                                      "openrPathPreference")
+                                      .pathPreference();
+    }
+    if (auto name = tTransform.openrPrefixForwardingType()) {
+      transform.forwardingType = getForwardingType(*name);
+    }
+    if (auto name = tTransform.openrPrefixForwardingAlgorithm()) {
+      transform.forwardingAlgorithm = getForwardingAlgorithm(*name);
+    }
+    transform.minNexthop = tTransform.openrMinNexthop().to_optional();
+    transform.acceptPrependLabel =
+        tTransform.openrAcceptPrependLabel().to_optional();
+    transform.acceptWeight = tTransform.openrAcceptWeight().to_optional();
+    return transform;
+  }
+
+  thrift::PrefixForwardingType
+  getForwardingType(const std::string& name) const {
+    const auto& def = lookupDefinition(
+        config_.definitions()->openrPrefixForwardingType(),
+        name,
+        "openrPrefixForwardingType");
+    return static_cast<thrift::PrefixForwardingType>(*def.type());
+  }
+
+  thrift::PrefixForwardingAlgorithm
+  getForwardingAlgorithm(const std::string& name) const {
+    const auto& def = lookupDefinition(
+        config_.definitions()->openrPrefixForwardingAlgorithm(),
+        name,
+        "openrPrefixForwardingAlgorithm");
+    return static_cast<thrift::PrefixForwardingAlgorithm>(*def.algorithm());
+  }
+
+  const PrefixFilter*
+  getPrefixFilter(const std::string& name) {
+    auto it = prefixFilters_.find(name);
+    if (it == prefixFilters_.end()) {
+      const auto& filter = lookupDefinition(
+          config_.filters()->prefixFilter(), name, "prefixFilter");
+      it = prefixFilters_
+               .emplace(name, std::make_unique<PrefixFilter>(filter))
+               .first;
+    }
+    return it->second.get();
+  }
+
+  template <typename FiltersRef>
+  const RegexFilter*
+  getRegexFilter(
+      FiltersRef filters, const std::string& name, folly::StringPiece kind) {
+    const auto key = fmt::format("{}:{}", kind, name);
+    auto it = regexFilters_.find(key);
+    if (it == regexFilters_.end()) {
+      const auto& filter = lookupDefinition(filters, name, kind);
+      it = regexFilters_.emplace(key, std::make_unique<RegexFilter>(filter))
+               .first;
+    }
+    return it->second.get();
+  }
+
+  static bool
+  matchCriteria(
+      const PolicyCriteria& criteria,
+      const thrift::PrefixEntry& entry,
+      const folly::CIDRNetwork& prefix,
+      const std::optional<unsigned int>& igpCost) {
+    if (criteria.unsupported) {
+      return false;
+    }
+    if (criteria.alwaysMatch) {
+      return true;
+    }
+    if (criteria.empty) {
+      return false;
+    }
+
+    if (not criteria.prefixFilters.empty()) {
+      bool matched{false};
+      for (const auto* filter : criteria.prefixFilters) {
+        if (filter->allow(prefix)) {
+          matched = true;
+          break;
+        }
+      }
+      if (not matched) {
+        return false;
+      }
+    }
+    if (criteria.tags) {
+      size_t matched{0};
+      for (const auto& tag : *criteria.tags) {
+        matched += entry.tags()->count(tag);
+      }
+      if (not evalCondition(
+              criteria.tagsCondition, matched, criteria.tags->size())) {
+        return false;
+      }
+    }
+    if (not criteria.tagFilters.empty()) {
+      bool matched{false};
+      for (const auto* filter : criteria.tagFilters) {
+        for (const auto& tag : *entry.tags()) {
+          if (filter->allow(tag)) {
+            matched = true;
+            break;
+          }
+        }
+      }
+      if (not matched) {
+        return false;
+      }
+    }
+    if (not criteria.areaStackFilters.empty()) {
+      // NOTE: area stack is flattened with ' ' as delimiter
+      const auto areaStack = folly::join(" ", *entry.area_stack());
+      bool matched{false};
+      for (const auto* filter : criteria.areaStackFilters) {
+        if (filter->allow(areaStack)) {
+          matched = true;
+          break;
+        }
+      }
+      if (not matched) {
+        return false;
+      }
+    }
+    if (criteria.areaStack and *criteria.areaStack != *entry.area_stack()) {
+      return false;
+    }
+    if (criteria.pathPreference and
+        *criteria.pathPreference != *entry.metrics()->path_preference()) {
+      return false;
+    }
+    if (criteria.sourcePreference and
+        *criteria.sourcePreference != *entry.metrics()->source_preference()) {
+      return false;
+    }
+    if (criteria.forwardingType and
+        *criteria.forwardingType != *entry.forwardingType()) {
+      return false;
+    }
+    if (criteria.forwardingAlgorithm and
+        *criteria.forwardingAlgorithm != *entry.forwardingAlgorithm()) {
+      return false;
+    }
+    if (criteria.igpCostRange) {
+      if (not igpCost) {
+        return false;
+      }
+      const auto cost = static_cast<int64_t>(*igpCost);
+      if (cost < criteria.igpCostRange->first or
+          cost > criteria.igpCostRange->second) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  static void
+  applyTransform(
+      const PolicyTransform& transform,
+      thrift::PrefixEntry& entry,
+      const std::optional<int64_t>& actionWeight) {
+    if (transform.tags) {
+      const auto& [op, tags] = *transform.tags;
+      switch (op) {
+      case Operator::rewrite:
+        entry.tags()->clear();
+        entry.tags()->insert(tags.begin(), tags.end());
+        break;
+      case Operator::remove:
+        for (const auto& tag : tags) {
+          entry.tags()->erase(tag);
+        }
+        break;
+      default:
+        entry.tags()->insert(tags.begin(), tags.end());
+        break;
+      }
+    }
+    for (const auto* filter : transform.removeTagFilters) {
+      for (auto it = entry.tags()->begin(); it != entry.tags()->end();) {
+        it = filter->allow(*it) ? entry.tags()->erase(it) : std::next(it);
+      }
+    }
+    if (transform.distance) {
+      const auto& [op, distance] = *transform.distance;
+      auto& entryDistance = *entry.metrics()->distance();
+      entryDistance = op == Operator::add ? entryDistance + distance : distance;
+    }
+    if (transform.pathPreference) {
+      entry.metrics()->path_preference() = *transform.pathPreference;
+    }
+    if (transform.forwardingType) {
+      entry.forwardingType() = *transform.forwardingType;
+    }
+    if (transform.forwardingAlgorithm) {
+      entry.forwardingAlgorithm() = *transform.forwardingAlgorithm;
+    }
+    if (transform.minNexthop) {
+      entry.minNexthop() = *transform.minNexthop;
+    }
+    if (transform.acceptPrependLabel.has_value() and
+        not *transform.acceptPrependLabel) {
+      entry.prependLabel().reset();
+    }
+    if (transform.acceptWeight.has_value()) {
+      if (*transform.acceptWeight and actionWeight) {
+        entry.weight() = *actionWeight;
+      } else if (not *transform.acceptWeight) {
+        entry.weight().reset();
+      }
+    }
+  }
+
+  static PolicyResult
+  evaluate(
+      const PolicyStatement& statement,
+      const thrift::PrefixEntry& entry,
+      const std::optional<int64_t>& actionWeight,
+      const std::optional<unsigned int>& igpCost) {
+    PolicyResult result;
+    result.statement = &statement;
+    result.input = entry;
+    result.actionWeight = actionWeight;
+    result.igpCost = igpCost;
+
+    const auto prefix = toIPNetwork(*entry.prefix());
+    std::optional<thrift::PrefixEntry> postPolicyEntry;
+    std::tie(result.accepted, result.hitRule) = walkRuleset(
+        statement.actions,
+        statement.rulesetMissAction,
+        [&](size_t idx) {
+          const auto& rule = statement.rules.at(idx);
+          size_t matched{0};
+          for (const auto& criteria : rule.criteria) {
+            // ATTN: match against the transformed entry if any previous rule
+            // had already modified it
+            matched += matchCriteria(
+                           criteria,
+                           postPolicyEntry ? *postPolicyEntry : entry,
+                           prefix,
+                           igpCost)
+                ? 1
+                : 0;
+          }
+          return evalCondition(rule.condition, matched, rule.criteria.size());
+        },
+        [&](size_t idx) {
+          const auto& rule = statement.rules.at(idx);
+          if (rule.transforms.empty()) {
+            return;
+          }
+          if (not postPolicyEntry) {
+            postPolicyEntry = entry;
+          }
+          for (const auto& transform : rule.transforms) {
+            applyTransform(transform, *postPolicyEntry, actionWeight);
+          }
+        });
+
+    if (result.accepted and postPolicyEntry and *postPolicyEntry != entry) {
+      result.modified =
+          std::make_shared<thrift::PrefixEntry>(std::move(*postPolicyEntry));
+    }
+    return result;
+  }
+
+  const PolicyConfig config_;
+
+  // policy statement name -> compiled statement
+  std::unordered_map<std::string, PolicyStatement> statements_;
+
+  // compiled filters shared across statements, referenced by raw pointer
+  std::unordered_map<std::string, std::unique_ptr<PrefixFilter>>
+      prefixFilters_;
+  std::unordered_map<std::string, std::unique_ptr<RegexFilter>> regexFilters_;
+
+  // hash of evaluation input -> memoized result
+  std::unordered_map<size_t, PolicyResult> resultCache_;
+};
 
 PolicyManager::PolicyManager(
-    const neteng::config::routing_policy::PolicyConfig& config) {}
+    const neteng::config::routing_policy::PolicyConfig& config)
+    : impl_(std::make_shared<PolicyManagerImpl>(config)) {}
 PolicyManager::~PolicyManager() = default;
 
 std::pair<std::shared_ptr<thrift::PrefixEntry>, std::string /*policy name*/>
@@ -20,8 +925,19 @@ PolicyManager::applyPolicy(
     const std::string& policyStatementName,
     const std::shared_ptr<thrift::PrefixEntry>& prefixEntry,
     const std::optional<OpenrPolicyActionData>& policyActionData,
-    const std::optional<OpenrPolicyMatchData>& policyMatchData) noexcept {
-  return {prefixEntry, "Always Allow"};
+    const std::optional<OpenrPolicyMatchData>& policyMatchData,
+    bool countHit) noexcept {
+  return impl_->applyPolicy(
+      policyStatementName,
+      prefixEntry,
+      policyActionData,
+      policyMatchData,
+      countHit);
+}
+
+size_t
+PolicyManager::getResultCacheSize() const {
+  return impl_->getResultCacheSize();
 }
 
 } // namespace openr
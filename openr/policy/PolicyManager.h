@@ -17,6 +17,17 @@ class PolicyManagerImpl;
 
 /**
  * PolicyManager manages all policies defined in the config file.
+ *
+ * Policy statements (`routePropagationPolicy` and `routeOriginationPolicy`
+ * filters) are compiled once at construction into matchers and transforms.
+ * Referenced prefix-lists, tag sets, igp-cost ranges etc. are resolved
+ * upfront and any dangling reference is reported via std::invalid_argument.
+ *
+ * Results are memoized per (statement, prefix-entry, action/match data) so
+ * re-running the same policy over an unchanged entry is a hash lookup.
+ *
+ * NOTE: PolicyManager is NOT thread-safe. It is expected to be used from the
+ * owner's (PrefixManager) event base only.
  */
 class PolicyManager {
  public:
@@ -24,6 +35,19 @@ class PolicyManager {
       const neteng::config::routing_policy::PolicyConfig& config);
   ~PolicyManager();
 
+  /**
+   * Apply policy statement on given prefix entry.
+   *
+   * @return
+   *  - <nullptr, hitName> if the prefix entry is rejected
+   *  - <entry, hitName> if the prefix entry is accepted. `entry` is the very
+   *    same input pointer if no transform got applied, otherwise a new copy.
+   *  `hitName` is the name of the rule terminating the evaluation, or the
+   *  statement name itself if no rule did.
+   *
+   * `countHit` bumps the `policy_manager.<statement>.<rule>.hit` counter.
+   * Debug/ctrl evaluation should pass false to keep counters meaningful.
+   */
   std::pair<std::shared_ptr<thrift::PrefixEntry>, std::string /*policy name*/>
   applyPolicy(
       const std::string& policyStatementName,
@@ -31,7 +55,11 @@ class PolicyManager {
       const std::optional<OpenrPolicyActionData>& policyActionData =
           std::nullopt,
       const std::optional<OpenrPolicyMatchData>& policyMatchData =
-          std::nullopt) noexcept;
+          std::nullopt,
+      bool countHit = true) noexcept;
+
+  // Number of memoized policy results
+  size_t getResultCacheSize() const;
 
   // PolicyManagerImpl uses forward declaration
   // Use shared_ptr because it works with incomplete type, where unique_ptr
@@ -0,0 +1,288 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include <fb303/ServiceData.h>
+#include <folly/IPAddress.h>
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <openr/common/LsdbUtil.h>
+#include <openr/common/NetworkUtil.h>
+#include <openr/policy/PolicyManager.h>
+
+using namespace openr;
+using namespace neteng::config::routing_policy;
+
+namespace {
+
+const std::string kPolicyName{"AREA_POLICY"};
+
+FilterRule
+createRule(
+    const std::string& name,
+    std::vector<FilterCriteria> criteria,
+    RuleAction matchAction,
+    RuleAction missAction = RuleAction::nextRule,
+    RuleCondition condition = RuleCondition::matchAny) {
+  FilterRule rule;
+  rule._name() = name;
+  rule.condition_id() = condition;
+  rule.criteria() = std::move(criteria);
+  rule.ruleMatchAction_id() = matchAction;
+  rule.ruleMissAction_id() = missAction;
+  return rule;
+}
+
+FilterCriteria
+createPrefixCriteria(
+    const std::string& basePrefix,
+    std::optional<int16_t> minLen = std::nullopt,
+    std::optional<int16_t> maxLen = std::nullopt) {
+  FilterCriteria criteria;
+  if (folly::IPAddress::createNetwork(basePrefix).first.isV4()) {
+    criteria.basePrefixIPv4() = basePrefix;
+    criteria.minLengthIPv4().from_optional(minLen);
+    criteria.maxLengthIPv4().from_optional(maxLen);
+  } else {
+    criteria.basePrefixIPv6() = basePrefix;
+    criteria.minLengthIPv6().from_optional(minLen);
+    criteria.maxLengthIPv6().from_optional(maxLen);
+  }
+  return criteria;
+}
+
+/*
+ * Policy config with:
+ *  - prefix filter `PL` allowing 10.0.0.0/8 ge 24 le 32 and 2001:db8::/32
+ *  - rule `DENY_BLUE` rejecting prefixes tagged with BLUE
+ *  - rule `ALLOW_PL` accepting prefixes in `PL` with tag RED added and
+ *    accepted weight
+ *  - rule `ALLOW_NEAR` accepting prefixes within igp cost [0, 10]
+ *  - everything else rejected
+ */
+PolicyConfig
+createPolicyConfig() {
+  PolicyConfig config;
+
+  OpenrTag blue;
+  blue.tagSet() = {"BLUE"};
+  OpenrTag red;
+  red.tagSet() = {"RED"};
+  config.definitions()->openrTag().ensure().objects() = {
+      {"BLUE", blue}, {"RED", red}};
+
+  OpenrIgpCostRange near;
+  near.minCost() = 0;
+  near.maxCost() = 10;
+  config.definitions()->openrIgpCostRange().ensure().objects() = {
+      {"NEAR", near}};
+
+  Filter prefixList;
+  prefixList.ruleset() = {createRule(
+      "PL_RULE",
+      {createPrefixCriteria("10.0.0.0/8", 24, 32),
+       createPrefixCriteria("2001:db8::/32")},
+      RuleAction::allow)};
+  prefixList.rulesetMissAction_id() = RuleAction::deny;
+  config.filters()->prefixFilter().ensure().objects() = {{"PL", prefixList}};
+
+  FilterCriteria blueCriteria;
+  blueCriteria.openrTags() = {"BLUE"};
+
+  FilterCriteria plCriteria;
+  plCriteria.prefixFilters() = {"PL"};
+  FilterTransform addRed;
+  addRed.openrTags() = {"RED"};
+  addRed.operation_id() = Operator::add;
+  FilterTransform acceptWeight;
+  acceptWeight.openrAcceptWeight() = true;
+  auto allowPl = createRule("ALLOW_PL", {plCriteria}, RuleAction::allow);
+  allowPl.transform() = {addRed, acceptWeight};
+
+  FilterCriteria nearCriteria;
+  nearCriteria.openrIgpCostRange() = "NEAR";
+
+  Filter policy;
+  policy.ruleset() = {
+      createRule("DENY_BLUE", {blueCriteria}, RuleAction::deny),
+      allowPl,
+      createRule("ALLOW_NEAR", {nearCriteria}, RuleAction::allow)};
+  policy.rulesetMissAction_id() = RuleAction::deny;
+  config.filters()->routePropagationPolicy().ensure().objects() = {
+      {kPolicyName, policy}};
+
+  return config;
+}
+
+std::shared_ptr<thrift::PrefixEntry>
+createEntry(
+    const std::string& prefix, const std::set<std::string>& tags = {}) {
+  auto entry = createPrefixEntry(toIpPrefix(prefix));
+  entry.tags() = tags;
+  return std::make_shared<thrift::PrefixEntry>(std::move(entry));
+}
+
+} // namespace
+
+TEST(PolicyManagerTest, UnknownPolicy) {
+  PolicyManager policyManager(createPolicyConfig());
+  auto entry = createEntry("192.168.0.0/24");
+  auto [postEntry, hitName] = policyManager.applyPolicy("UNKNOWN", entry);
+  EXPECT_EQ(entry, postEntry);
+  EXPECT_EQ("Always Allow", hitName);
+}
+
+TEST(PolicyManagerTest, PrefixFilterRange) {
+  PolicyManager policyManager(createPolicyConfig());
+
+  // within 10.0.0.0/8 ge 24 le 32
+  for (const auto& prefix :
+       {"10.1.2.0/24", "10.255.0.128/25", "10.0.0.1/32", "2001:db8::/32"}) {
+    auto [postEntry, hitName] =
+        policyManager.applyPolicy(kPolicyName, createEntry(prefix));
+    ASSERT_NE(nullptr, postEntry) << prefix;
+    EXPECT_EQ("ALLOW_PL", hitName);
+    EXPECT_THAT(*postEntry->tags(), testing::ElementsAre("RED"));
+  }
+
+  // outside of the length range or base prefix
+  for (const auto& prefix :
+       {"10.1.0.0/16", "11.0.0.0/24", "2001:db8::/48", "2001:db9::/32"}) {
+    auto [postEntry, hitName] =
+        policyManager.applyPolicy(kPolicyName, createEntry(prefix));
+    EXPECT_EQ(nullptr, postEntry) << prefix;
+    EXPECT_EQ(kPolicyName, hitName);
+  }
+}
+
+TEST(PolicyManagerTest, RuleOrderAndMatchData) {
+  PolicyManager policyManager(createPolicyConfig());
+
+  // DENY_BLUE is evaluated before ALLOW_PL
+  {
+    auto [postEntry, hitName] = policyManager.applyPolicy(
+        kPolicyName, createEntry("10.1.2.0/24", {"BLUE"}));
+    EXPECT_EQ(nullptr, postEntry);
+    EXPECT_EQ("DENY_BLUE", hitName);
+  }
+
+  // igp cost range requires match data
+  {
+    auto entry = createEntry("192.168.0.0/24");
+    auto [postEntry, hitName] = policyManager.applyPolicy(
+        kPolicyName, entry, std::nullopt, OpenrPolicyMatchData(5));
+    EXPECT_EQ(entry, postEntry); // not modified, same pointer handed back
+    EXPECT_EQ("ALLOW_NEAR", hitName);
+
+    std::tie(postEntry, hitName) = policyManager.applyPolicy(
+        kPolicyName, entry, std::nullopt, OpenrPolicyMatchData(20));
+    EXPECT_EQ(nullptr, postEntry);
+
+    std::tie(postEntry, hitName) =
+        policyManager.applyPolicy(kPolicyName, entry);
+    EXPECT_EQ(nullptr, postEntry);
+  }
+
+  // weight from action data is accepted
+  {
+    auto [postEntry, hitName] = policyManager.applyPolicy(
+        kPolicyName, createEntry("10.1.2.0/24"), OpenrPolicyActionData(99));
+    ASSERT_NE(nullptr, postEntry);
+    EXPECT_EQ(99, postEntry->weight().value());
+  }
+}
+
+TEST(PolicyManagerTest, ResultCache) {
+  PolicyManager policyManager(createPolicyConfig());
+  auto entry = createEntry("10.1.2.0/24");
+
+  auto [postEntry1, hitName1] = policyManager.applyPolicy(kPolicyName, entry);
+  EXPECT_EQ(1, policyManager.getResultCacheSize());
+
+  // cache hit hands out an identical but private copy
+  auto [postEntry2, hitName2] = policyManager.applyPolicy(kPolicyName, entry);
+  EXPECT_EQ(1, policyManager.getResultCacheSize());
+  ASSERT_NE(nullptr, postEntry1);
+  ASSERT_NE(nullptr, postEntry2);
+  EXPECT_NE(postEntry1, postEntry2);
+  EXPECT_EQ(*postEntry1, *postEntry2);
+  EXPECT_EQ(hitName1, hitName2);
+
+  // mutating the returned copy doesn't poison the cache
+  postEntry1->tags()->insert("BLUE");
+  auto [postEntry3, _] = policyManager.applyPolicy(kPolicyName, entry);
+  EXPECT_EQ(*postEntry2, *postEntry3);
+
+  // different input is evaluated and memoized separately
+  auto [postEntry4, hitName4] = policyManager.applyPolicy(
+      kPolicyName, createEntry("10.1.2.0/24", {"BLUE"}));
+  EXPECT_EQ(nullptr, postEntry4);
+  EXPECT_EQ("DENY_BLUE", hitName4);
+  EXPECT_EQ(2, policyManager.getResultCacheSize());
+}
+
+TEST(PolicyManagerTest, HitCounter) {
+  PolicyManager policyManager(createPolicyConfig());
+  const std::string counterKey =
+      fmt::format("policy_manager.{}.ALLOW_PL.hit.count", kPolicyName);
+  auto entry = createEntry("10.1.2.0/24");
+
+  policyManager.applyPolicy(kPolicyName, entry);
+  const auto hitCount = fb303::fbData->getCounters().at(counterKey);
+
+  // debug evaluation doesn't count as hit
+  auto [postEntry, hitName] = policyManager.applyPolicy(
+      kPolicyName,
+      entry,
+      std::nullopt,
+      std::nullopt,
+      false /* countHit */);
+  ASSERT_NE(nullptr, postEntry);
+  EXPECT_EQ("ALLOW_PL", hitName);
+  EXPECT_EQ(hitCount, fb303::fbData->getCounters().at(counterKey));
+
+  policyManager.applyPolicy(kPolicyName, entry);
+  EXPECT_EQ(hitCount + 1, fb303::fbData->getCounters().at(counterKey));
+}
+
+TEST(PolicyManagerTest, InvalidConfig) {
+  // dangling tag reference
+  {
+    auto config = createPolicyConfig();
+    config.definitions()->openrTag()->objects()->erase("BLUE");
+    EXPECT_THROW(PolicyManager{config}, std::invalid_argument);
+  }
+
+  // dangling prefix filter reference
+  {
+    auto config = createPolicyConfig();
+    config.filters()->prefixFilter()->objects()->clear();
+    EXPECT_THROW(PolicyManager{config}, std::invalid_argument);
+  }
+
+  // invalid length range
+  {
+    auto config = createPolicyConfig();
+    auto& prefixList = config.filters()->prefixFilter()->objects()->at("PL");
+    prefixList.ruleset()->at(0).criteria()->emplace_back(
+        createPrefixCriteria("10.0.0.0/8", 4, 32));
+    EXPECT_THROW(PolicyManager{config}, std::invalid_argument);
+  }
+}
+
+int
+main(int argc, char* argv[]) {
+  // Parse command line flags
+  testing::InitGoogleTest(&argc, argv);
+  gflags::ParseCommandLineFlags(&argc, &argv, true);
+  google::InitGoogleLogging(argv[0]);
+  google::InstallFailureSignalHandler();
+  FLAGS_logtostderr = true;
+
+  // Run the tests
+  return RUN_ALL_TESTS();
+}
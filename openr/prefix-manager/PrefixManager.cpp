@@ -43,6 +43,7 @@ PrefixManager::PrefixManager(
       kvRequestQueue_(kvRequestQueue),
       prefixMgrRouteUpdatesQueue_(prefixMgrRouteUpdatesQueue),
       initializationEventQueue_(initializationEventQueue),
+      prefixBundleShards_(config->getPrefixBundleShards()),
       preferOpenrOriginatedRoutes_(
           *config->getConfig().prefer_openr_originated_routes()) {
   CHECK(config);
@@ -69,6 +70,7 @@ PrefixManager::PrefixManager(
     uninitializedPrefixTypes_.emplace(thrift::PrefixType::CONFIG);
   }
 
+  // ATTN: policies are compiled and validated along with config already
   if (auto policyConf = config->getAreaPolicies()) {
     policyManager_ = std::make_unique<PolicyManager>(*policyConf);
   }
@@ -258,6 +260,27 @@ PrefixManager::processPublication(thrift::Publication&& thriftPub) {
     try {
       const auto prefixDb =
           readThriftObjStr<thrift::PrefixDatabase>(*val.value(), serializer_);
+
+      // Self-originated bundle not tracked by this incarnation (e.g. left over
+      // before restart or change of shard number). Mark it dirty, so that it
+      // gets overridden with current content or cleared from KvStore.
+      auto maybeBundleKey = PrefixBundleKey::fromStr(keyStr, area);
+      if (maybeBundleKey.hasValue()) {
+        const auto shardId = maybeBundleKey->getShardId();
+        if (*prefixDb.thisNodeName() != nodeId_ or *prefixDb.deletePrefix() or
+            (prefixBundles_.count(area) and
+             prefixBundles_.at(area).count(shardId))) {
+          continue;
+        }
+        XLOG(DBG1) << fmt::format(
+            "[Prefix Update]: Area: {}, stale bundle {} inside KvStore",
+            area,
+            keyStr);
+        dirtyPrefixBundles_.emplace(area, shardId);
+        syncKvStoreThrottled_->operator()();
+        continue;
+      }
+
       if (prefixDb.prefixEntries()->size() != 1) {
         LOG(WARNING) << "Skip processing unexpected number of prefix entries";
         continue;
@@ -269,8 +292,20 @@ PrefixManager::processPublication(thrift::Publication&& thriftPub) {
         auto const& thisNodeName = *prefixDb.thisNodeName();
         auto const& network = toIPNetwork(*tPrefixEntry.prefix());
 
-        // Skip none-self advertised prefixes or already persisted keys.
-        if (thisNodeName != nodeId_ or advertiseStatus_.count(network) > 0) {
+        // Skip none-self advertised prefixes.
+        if (thisNodeName != nodeId_) {
+          continue;
+        }
+
+        // Per-prefix keys are superseded by prefix bundles. Withdraw keys
+        // left over from the previous incarnation.
+        if (prefixBundleShards_ > 0) {
+          clearPrefixKeyInKvStore(area, network);
+          continue;
+        }
+
+        // Skip already persisted keys.
+        if (advertiseStatus_.count(network) > 0) {
           continue;
         }
 
@@ -550,15 +585,20 @@ PrefixManager::addKvStoreKeyHelper(const PrefixEntry& entry) {
       postPolicyTPrefixEntry = tPrefixEntry;
     }
 
-    const auto prefixKeyStr =
-        PrefixKey(nodeId_, entry.network, toArea).getPrefixKeyV2();
-    auto prefixDb = createPrefixDb(nodeId_, {*postPolicyTPrefixEntry});
-    auto prefixDbStr = writeThriftObjStr(std::move(prefixDb), serializer_);
-
-    // advertise key to `KvStore`
-    auto persistPrefixKeyVal =
-        PersistKeyValueRequest(AreaId{toArea}, prefixKeyStr, prefixDbStr);
-    kvRequestQueue_.push(std::move(persistPrefixKeyVal));
+    if (prefixBundleShards_ > 0) {
+      // pack into bundle, which is advertised at the end of sync
+      addPrefixToBundle(toArea, entry.network, *postPolicyTPrefixEntry);
+    } else {
+      const auto prefixKeyStr =
+          PrefixKey(nodeId_, entry.network, toArea).getPrefixKeyV2();
+      auto prefixDb = createPrefixDb(nodeId_, {*postPolicyTPrefixEntry});
+      auto prefixDbStr = writeThriftObjStr(std::move(prefixDb), serializer_);
+
+      // advertise key to `KvStore`
+      auto persistPrefixKeyVal =
+          PersistKeyValueRequest(AreaId{toArea}, prefixKeyStr, prefixDbStr);
+      kvRequestQueue_.push(std::move(persistPrefixKeyVal));
+    }
 
     fb303::fbData->addStatValue(
         "prefix_manager.route_advertisements", 1, fb303::SUM);
@@ -596,31 +636,125 @@ PrefixManager::deleteKvStoreKeyHelper(
     const folly::CIDRNetwork& prefix,
     const std::unordered_set<std::string>& deletedArea) {
   for (const auto& area : deletedArea) {
-    // Prepare thrift::PrefixDatabase object for deletion
-    thrift::PrefixDatabase deletedPrefixDb;
-    deletedPrefixDb.thisNodeName() = nodeId_;
-    deletedPrefixDb.deletePrefix() = true;
-
-    const auto prefixKeyStr = PrefixKey(nodeId_, prefix, area).getPrefixKeyV2();
-    thrift::PrefixEntry entry;
-    entry.prefix() = toIpPrefix(prefix);
-    deletedPrefixDb.prefixEntries() = {entry};
-
-    // Remove prefix from KvStore and flood deletion by setting deleted value.
-    auto unsetPrefixRequest = ClearKeyValueRequest(
-        AreaId{area},
-        prefixKeyStr,
-        writeThriftObjStr(std::move(deletedPrefixDb), serializer_),
-        true);
-    kvRequestQueue_.push(std::move(unsetPrefixRequest));
+    if (prefixBundleShards_ > 0) {
+      // remove from bundle, which is advertised at the end of sync
+      removePrefixFromBundle(area, prefix);
+    } else {
+      clearPrefixKeyInKvStore(area, prefix);
+    }
 
     XLOG(DBG1) << "[Prefix Withdraw] "
-               << "Area: " << area << ", " << toString(*entry.prefix());
+               << "Area: " << area << ", "
+               << folly::IPAddress::networkToString(prefix);
     fb303::fbData->addStatValue(
         "prefix_manager.route_withdraws", 1, fb303::SUM);
   }
 }
 
+void
+PrefixManager::clearPrefixKeyInKvStore(
+    const std::string& area, const folly::CIDRNetwork& prefix) {
+  // Prepare thrift::PrefixDatabase object for deletion
+  thrift::PrefixDatabase deletedPrefixDb;
+  deletedPrefixDb.thisNodeName() = nodeId_;
+  deletedPrefixDb.deletePrefix() = true;
+
+  const auto prefixKeyStr = PrefixKey(nodeId_, prefix, area).getPrefixKeyV2();
+  thrift::PrefixEntry entry;
+  entry.prefix() = toIpPrefix(prefix);
+  deletedPrefixDb.prefixEntries() = {entry};
+
+  // Remove prefix from KvStore and flood deletion by setting deleted value.
+  auto unsetPrefixRequest = ClearKeyValueRequest(
+      AreaId{area},
+      prefixKeyStr,
+      writeThriftObjStr(std::move(deletedPrefixDb), serializer_),
+      true);
+  kvRequestQueue_.push(std::move(unsetPrefixRequest));
+}
+
+void
+PrefixManager::addPrefixToBundle(
+    const std::string& area,
+    const folly::CIDRNetwork& prefix,
+    const thrift::PrefixEntry& postPolicyTPrefixEntry) {
+  const auto shardId = PrefixBundleKey::getShardId(prefix, prefixBundleShards_);
+  prefixBundles_[area][shardId].insert_or_assign(
+      prefix, postPolicyTPrefixEntry);
+  dirtyPrefixBundles_.emplace(area, shardId);
+}
+
+void
+PrefixManager::removePrefixFromBundle(
+    const std::string& area, const folly::CIDRNetwork& prefix) {
+  const auto shardId = PrefixBundleKey::getShardId(prefix, prefixBundleShards_);
+  auto areaIt = prefixBundles_.find(area);
+  if (areaIt == prefixBundles_.end()) {
+    return;
+  }
+  auto shardIt = areaIt->second.find(shardId);
+  if (shardIt == areaIt->second.end() or (not shardIt->second.erase(prefix))) {
+    return;
+  }
+  dirtyPrefixBundles_.emplace(area, shardId);
+}
+
+void
+PrefixManager::syncPrefixBundlesInKvStore() {
+  for (const auto& [area, shardId] : dirtyPrefixBundles_) {
+    const auto bundleKeyStr =
+        PrefixBundleKey(nodeId_, shardId, area).getPrefixBundleKeyStr();
+
+    // Look up current content of the bundle
+    const std::map<folly::CIDRNetwork, thrift::PrefixEntry>* bundle{nullptr};
+    auto areaIt = prefixBundles_.find(area);
+    if (areaIt != prefixBundles_.end()) {
+      auto shardIt = areaIt->second.find(shardId);
+      if (shardIt != areaIt->second.end()) {
+        if (shardIt->second.empty()) {
+          areaIt->second.erase(shardIt);
+        } else {
+          bundle = &shardIt->second;
+        }
+      }
+    }
+
+    if (not bundle) {
+      // Bundle becomes empty. Remove it from KvStore and flood deletion by
+      // setting deleted value.
+      thrift::PrefixDatabase deletedPrefixDb;
+      deletedPrefixDb.thisNodeName() = nodeId_;
+      deletedPrefixDb.deletePrefix() = true;
+      kvRequestQueue_.push(ClearKeyValueRequest(
+          AreaId{area},
+          bundleKeyStr,
+          writeThriftObjStr(std::move(deletedPrefixDb), serializer_),
+          true));
+      XLOG(DBG1) << "[Prefix Bundle Withdraw] "
+                 << "Area: " << area << ", Key: " << bundleKeyStr;
+      continue;
+    }
+
+    std::vector<thrift::PrefixEntry> entries;
+    entries.reserve(bundle->size());
+    for (const auto& [_, entry] : *bundle) {
+      entries.emplace_back(entry);
+    }
+    auto prefixDb = createPrefixDb(nodeId_, std::move(entries));
+    kvRequestQueue_.push(PersistKeyValueRequest(
+        AreaId{area},
+        bundleKeyStr,
+        writeThriftObjStr(std::move(prefixDb), serializer_)));
+
+    fb303::fbData->addStatValue(
+        "prefix_manager.bundle_advertisements", 1, fb303::SUM);
+    XLOG(DBG1) << "[Prefix Bundle Advertisement] "
+               << "Area: " << area << ", Key: " << bundleKeyStr
+               << ", Prefixes: " << bundle->size();
+  }
+  dirtyPrefixBundles_.clear();
+}
+
 void
 PrefixManager::triggerInitialPrefixDbSync() {
   if (uninitializedPrefixTypes_.empty() and initialKvStoreSynced_) {
@@ -670,59 +804,96 @@ PrefixManager::prefixEntryReadyToBeAdvertised(const PrefixEntry& prefixEntry) {
 }
 
 void
-PrefixManager::syncKvStore() {
-  XLOG(DBG1) << "[KvStore Sync] Syncing " << pendingUpdates_.size()
-             << " pending updates.";
-  DecisionRouteUpdate routeUpdatesForDecision;
-  DecisionRouteUpdate routeUpdatesForBgp;
-  size_t receivedPrefixCnt = 0;
-  size_t syncedPrefixCnt = 0;
-  size_t awaitingPrefixCnt = 0;
-
-  // Withdraw prefixes that no longer exist.
-  for (auto const& prefix : pendingUpdates_.getChangedPrefixes()) {
-    auto it = prefixMap_.find(prefix);
-    if (it == prefixMap_.end()) {
-      // Delete prefixes that do not exist in prefixMap_.
-      deletePrefixKeysInKvStore(prefix, routeUpdatesForDecision);
-      advertisedPrefixEntries_.erase(prefix);
-      ++syncedPrefixCnt;
+PrefixManager::updateLabelDependencies(
+    const folly::CIDRNetwork& prefix, const PrefixEntry* bestEntry) {
+  // Unregister labels tracked from previous round of syncing
+  auto it = prefixToLabels_.find(prefix);
+  if (it != prefixToLabels_.end()) {
+    for (const auto& label : it->second) {
+      auto labelIt = labelToPrefixes_.find(label);
+      if (labelIt == labelToPrefixes_.end()) {
+        continue;
+      }
+      labelIt->second.erase(prefix);
+      if (labelIt->second.empty()) {
+        labelToPrefixes_.erase(labelIt);
+      }
     }
+    prefixToLabels_.erase(it);
   }
 
-  for (const auto& [prefix, prefixEntries] : prefixMap_) {
-    receivedPrefixCnt += prefixEntries.size();
-
-    // Check if prefix is updated and ready to be advertised.
-    auto [_, bestEntry] = getBestPrefixEntry(prefixEntries);
-    const auto& labelRef = bestEntry.tPrefixEntry->prependLabel();
-    bool hasPrefixUpdate = pendingUpdates_.hasPrefix(prefix);
-    bool haslabelUpdate =
-        labelRef.has_value() ? pendingUpdates_.hasLabel(*labelRef) : false;
-    bool readyToBeAdvertised = prefixEntryReadyToBeAdvertised(bestEntry);
-    bool needToAdvertise =
-        ((hasPrefixUpdate or haslabelUpdate) and readyToBeAdvertised);
-    // Get route updates from updated prefix entry.
-    if (hasPrefixUpdate) {
-      populateRouteUpdates(
-          prefix, bestEntry, routeUpdatesForDecision, routeUpdatesForBgp);
-    }
-    if (needToAdvertise) {
-      XLOG(DBG1) << fmt::format(
-          "Adding/updating keys for {}",
-          folly::IPAddress::networkToString(prefix));
-      updatePrefixKeysInKvStore(prefix, bestEntry);
-      advertisedPrefixEntries_[prefix] = bestEntry;
-      ++syncedPrefixCnt;
-      continue;
-    } else if (readyToBeAdvertised) {
-      // Skip still-ready-to-be and previously advertised prefix.
-      CHECK(advertisedPrefixEntries_.count(prefix));
-      continue;
+  // ATTN: both best entry and advertised entry are tracked. The advertised
+  // entry needs to be withdrawn once its label route is deleted, even if
+  // the best entry carries a different label.
+  std::vector<int32_t> labels;
+  if (bestEntry) {
+    if (auto labelRef = bestEntry->tPrefixEntry->prependLabel()) {
+      labels.emplace_back(*labelRef);
+    }
+  }
+  auto advertisedIt = advertisedPrefixEntries_.find(prefix);
+  if (advertisedIt != advertisedPrefixEntries_.end()) {
+    auto labelRef = advertisedIt->second.tPrefixEntry->prependLabel();
+    if (labelRef.has_value() and
+        (labels.empty() or labels.front() != *labelRef)) {
+      labels.emplace_back(*labelRef);
     }
+  }
+  if (labels.empty()) {
+    return;
+  }
+  for (const auto& label : labels) {
+    labelToPrefixes_[label].emplace(prefix);
+  }
+  prefixToLabels_.emplace(prefix, std::move(labels));
+}
 
+bool
+PrefixManager::syncPrefixWithKvStore(
+    const folly::CIDRNetwork& prefix,
+    DecisionRouteUpdate& routeUpdatesForDecision,
+    DecisionRouteUpdate& routeUpdatesForBgp) {
+  auto prefixIt = prefixMap_.find(prefix);
+  if (prefixIt == prefixMap_.end()) {
+    // Delete prefixes that do not exist in prefixMap_.
+    deletePrefixKeysInKvStore(prefix, routeUpdatesForDecision);
+    advertisedPrefixEntries_.erase(prefix);
+    awaitingPrefixes_.erase(prefix);
+    updateLabelDependencies(prefix, nullptr);
+    return true;
+  }
+
+  // Check if prefix is updated and ready to be advertised.
+  auto [_, bestEntry] = getBestPrefixEntry(prefixIt->second);
+  const auto& labelRef = bestEntry.tPrefixEntry->prependLabel();
+  bool hasPrefixUpdate = pendingUpdates_.hasPrefix(prefix);
+  bool haslabelUpdate =
+      labelRef.has_value() ? pendingUpdates_.hasLabel(*labelRef) : false;
+  bool readyToBeAdvertised = prefixEntryReadyToBeAdvertised(bestEntry);
+  bool needToAdvertise =
+      ((hasPrefixUpdate or haslabelUpdate) and readyToBeAdvertised);
+  bool synced{false};
+
+  // Get route updates from updated prefix entry.
+  if (hasPrefixUpdate) {
+    populateRouteUpdates(
+        prefix, bestEntry, routeUpdatesForDecision, routeUpdatesForBgp);
+  }
+  if (needToAdvertise) {
+    XLOG(DBG1) << fmt::format(
+        "Adding/updating keys for {}",
+        folly::IPAddress::networkToString(prefix));
+    updatePrefixKeysInKvStore(prefix, bestEntry);
+    advertisedPrefixEntries_[prefix] = bestEntry;
+    awaitingPrefixes_.erase(prefix);
+    synced = true;
+  } else if (readyToBeAdvertised) {
+    // Skip still-ready-to-be and previously advertised prefix.
+    CHECK(advertisedPrefixEntries_.count(prefix));
+    awaitingPrefixes_.erase(prefix);
+  } else {
     // The prefix is awaiting to be advertised.
-    ++awaitingPrefixCnt;
+    awaitingPrefixes_.emplace(prefix);
 
     // Check if previously advertised prefix is no longer ready to be
     // advertised.
@@ -734,13 +905,50 @@ PrefixManager::syncKvStore() {
           folly::IPAddress::networkToString(prefix));
       deletePrefixKeysInKvStore(prefix, routeUpdatesForDecision);
       advertisedPrefixEntries_.erase(prefix);
+      synced = true;
+    }
+  }
+
+  updateLabelDependencies(prefix, &bestEntry);
+  return synced;
+}
+
+void
+PrefixManager::syncKvStore() {
+  XLOG(DBG1) << "[KvStore Sync] Syncing " << pendingUpdates_.size()
+             << " pending updates.";
+  DecisionRouteUpdate routeUpdatesForDecision;
+  DecisionRouteUpdate routeUpdatesForBgp;
+  size_t syncedPrefixCnt = 0;
+
+  // ATTN: only prefixes affected by pending updates are visited, i.e.
+  //  - prefixes added/updated/withdrawn, or with unicast route programmed/
+  //    deleted by Fib;
+  //  - prefixes whose best or advertised entry is gated on a label route
+  //    programmed/deleted by Fib;
+  // Readiness of all other prefixes can't change within this batch.
+  std::unordered_set<folly::CIDRNetwork> affectedPrefixes =
+      pendingUpdates_.getChangedPrefixes();
+  for (const auto& label : pendingUpdates_.getChangedLabels()) {
+    auto it = labelToPrefixes_.find(label);
+    if (it != labelToPrefixes_.end()) {
+      affectedPrefixes.insert(it->second.begin(), it->second.end());
+    }
+  }
+
+  for (const auto& prefix : affectedPrefixes) {
+    if (syncPrefixWithKvStore(
+            prefix, routeUpdatesForDecision, routeUpdatesForBgp)) {
       ++syncedPrefixCnt;
     }
-  } // for
+  }
 
   // Reset pendingUpdates_ since all pending updates are processed.
   pendingUpdates_.clear();
 
+  // Advertise prefix bundles touched in this round.
+  syncPrefixBundlesInKvStore();
+
   // Push originatedRoutes update to staticRouteUpdatesQueue_.
   if (not routeUpdatesForDecision.empty()) {
     CHECK(routeUpdatesForDecision.mplsRoutesToUpdate.empty());
@@ -762,19 +970,20 @@ PrefixManager::syncKvStore() {
   }
 
   XLOG(DBG1) << fmt::format(
-      "[KvStore Sync] Updated {} prefixes in KvStore; {} more awaiting FIB-ACK.",
+      "[KvStore Sync] Updated {}/{} prefixes; {} more awaiting FIB-ACK.",
       syncedPrefixCnt,
-      awaitingPrefixCnt);
+      affectedPrefixes.size(),
+      awaitingPrefixes_.size());
 
   // Update flat counters
   fb303::fbData->setCounter(
-      "prefix_manager.received_prefixes", receivedPrefixCnt);
+      "prefix_manager.received_prefixes", receivedPrefixEntryCnt_);
   // TODO: report per-area advertised prefixes if openr is running in
   // multi-areas.
   fb303::fbData->setCounter(
       "prefix_manager.advertised_prefixes", advertisedPrefixEntries_.size());
   fb303::fbData->setCounter(
-      "prefix_manager.awaiting_prefixes", awaitingPrefixCnt);
+      "prefix_manager.awaiting_prefixes", awaitingPrefixes_.size());
 }
 
 folly::SemiFuture<bool>
@@ -1015,7 +1224,8 @@ PrefixManager::filterAndAddOriginatedRoute(
         policy,
         prePolicyTPrefixEntry,
         std::nullopt /* policy Action Data */,
-        prePolicyPrefixEntry.policyMatchData);
+        prePolicyPrefixEntry.policyMatchData,
+        false /* countHit */);
     if (routeFilterType == thrift::RouteFilterType::POSTFILTER_ADVERTISED and
         postPolicyTPrefixEntry) {
       // add post filter advertised route
@@ -1197,7 +1407,8 @@ PrefixManager::filterAndAddAreaRoute(
             *policy,
             prePolicyTPrefixEntry,
             std::nullopt /* policy Action Data */,
-            bestPrefixEntry.policyMatchData);
+            bestPrefixEntry.policyMatchData,
+            false /* countHit */);
   } else {
     postPolicyTPrefixEntry = prePolicyTPrefixEntry;
   }
@@ -1320,6 +1531,8 @@ PrefixManager::advertisePrefixesImpl(
       }
       // Case 2: update existing `PrefixEntry`
       it->second = entry;
+    } else {
+      ++receivedPrefixEntryCnt_;
     }
     // Case 3: store pendingUpdate for batch processing
     pendingUpdates_.addPrefixChange(prefixCidr);
@@ -1355,6 +1568,7 @@ PrefixManager::withdrawPrefixesImpl(
     // ONLY populate changed collection when successfully erased key
     if (typeIt != prefixMap_.end() and typeIt->second.erase(type)) {
       updated = true;
+      --receivedPrefixEntryCnt_;
       // store pendingUpdate for batch processing
       pendingUpdates_.addPrefixChange(prefixCidr);
       // clean up data structure
@@ -1392,6 +1606,7 @@ PrefixManager::withdrawPrefixEntriesImpl(
     // ONLY populate changed collection when successfully erased key
     if (typeIt != prefixMap_.end() and typeIt->second.erase(type)) {
       updated = true;
+      --receivedPrefixEntryCnt_;
       // store pendingUpdate for batch processing
       pendingUpdates_.addPrefixChange(prefixEntry.network);
       // clean up data structure
@@ -7,9 +7,12 @@
 
 #pragma once
 
+#include <map>
+
 #include <folly/IPAddress.h>
 #include <folly/futures/Future.h>
 #include <folly/gen/Base.h>
+#include <folly/hash/Hash.h>
 
 #include <openr/common/AsyncThrottle.h>
 #include <openr/common/OpenrEventBase.h>
@@ -46,6 +49,11 @@ class PrefixManagerPendingUpdates {
     return changedPrefixes_;
   }
 
+  const std::unordered_set<int32_t>&
+  getChangedLabels() {
+    return changedLabels_;
+  }
+
   bool
   hasPrefix(const folly::CIDRNetwork& prefix) {
     return changedPrefixes_.count(prefix) > 0;
@@ -270,6 +278,26 @@ class PrefixManager final : public OpenrEventBase {
    */
   void syncKvStore();
 
+  /*
+   * Sync one prefix affected by pending updates with KvStore. Called by
+   * syncKvStore() for prefixes which are either explicitly changed or gated on
+   * a changed label route.
+   *
+   * @return true if keys of the prefix are added/updated/removed in KvStore.
+   */
+  bool syncPrefixWithKvStore(
+      const folly::CIDRNetwork& prefix,
+      DecisionRouteUpdate& routeUpdatesForDecision,
+      DecisionRouteUpdate& routeUpdatesForBgp);
+
+  /*
+   * Refresh the label dependency index of one prefix, i.e. prepend labels of
+   * its best entry and of its advertised entry. Prefixes without entries in
+   * `prefixMap_` and `advertisedPrefixEntries_` are dropped from the index.
+   */
+  void updateLabelDependencies(
+      const folly::CIDRNetwork& prefix, const PrefixEntry* bestEntry);
+
   // Update KvStore keys of one prefix entry.
   void updatePrefixKeysInKvStore(
       const folly::CIDRNetwork& prefix, const PrefixEntry& prefixEntry);
@@ -288,6 +316,26 @@ class PrefixManager final : public OpenrEventBase {
       const folly::CIDRNetwork& prefix,
       const std::unordered_set<std::string>& deletedArea);
 
+  // Clear per-prefix KvStore key of one prefix from one area.
+  void clearPrefixKeyInKvStore(
+      const std::string& area, const folly::CIDRNetwork& prefix);
+
+  /*
+   * [Prefix Bundle]
+   *
+   * Util functions to add/remove post-policy prefix entry into/from the
+   * bundle of the area. Touched bundles are marked dirty and written to
+   * KvStore in one go by syncPrefixBundlesInKvStore() at the end of
+   * syncKvStore().
+   */
+  void addPrefixToBundle(
+      const std::string& area,
+      const folly::CIDRNetwork& prefix,
+      const thrift::PrefixEntry& postPolicyTPrefixEntry);
+  void removePrefixFromBundle(
+      const std::string& area, const folly::CIDRNetwork& prefix);
+  void syncPrefixBundlesInKvStore();
+
   /*
    * Perform best entry selection among the given prefixTypeToEntry
    */
@@ -416,6 +464,25 @@ class PrefixManager final : public OpenrEventBase {
   // Advertised prefixes in KvStore and associated best PrefixEntry.
   std::unordered_map<folly::CIDRNetwork, PrefixEntry> advertisedPrefixEntries_;
 
+  // Total number of prefix entries (of all types) inside `prefixMap_`.
+  // Maintained on write to avoid walking `prefixMap_` on every sync.
+  size_t receivedPrefixEntryCnt_{0};
+
+  // Prefixes whose best entry is not yet ready to be advertised, i.e. still
+  // awaiting FIB-ACK of the associated label/unicast routes.
+  std::unordered_set<folly::CIDRNetwork> awaitingPrefixes_;
+
+  /*
+   * Reverse index of prepend label -> prefixes whose best or advertised entry
+   * carries the label. Readiness of these prefixes is gated on the label route
+   * being programmed, so a label change from Fib re-evaluates only them
+   * instead of the whole `prefixMap_`.
+   */
+  std::unordered_map<int32_t, std::unordered_set<folly::CIDRNetwork>>
+      labelToPrefixes_;
+  std::unordered_map<folly::CIDRNetwork, std::vector<int32_t>>
+      prefixToLabels_;
+
   // For prefixes came from PrefixEvent with an origination policy,
   // store the pre-policy version in originatedPrefixMap_.
   // Used in thrift request getAdvertisedRoutesWithOriginationPolicy().
@@ -448,6 +515,27 @@ class PrefixManager final : public OpenrEventBase {
   // store pending updates from advertise/withdraw operation
   detail::PrefixManagerPendingUpdates pendingUpdates_;
 
+  /*
+   * [Prefix Bundle]
+   *
+   * Number of bundles prefixes are spread across. 0 means bundling is
+   * disabled and one KvStore key is advertised per (prefix, area).
+   */
+  const uint32_t prefixBundleShards_{0};
+
+  // Post-policy prefix entries packed in each bundle:
+  //  area -> shard id -> prefix -> post-policy prefix entry
+  // ATTN: ordered by prefix to keep the encoding of a bundle deterministic.
+  std::unordered_map<
+      std::string,
+      std::unordered_map<
+          uint32_t,
+          std::map<folly::CIDRNetwork, thrift::PrefixEntry>>>
+      prefixBundles_;
+
+  // Bundles changed since last sync, i.e. (area, shard id)
+  std::unordered_set<std::pair<std::string, uint32_t>> dirtyPrefixBundles_;
+
   std::unique_ptr<PolicyManager> policyManager_{nullptr};
 
   /*
@@ -5,6 +5,7 @@
  * LICENSE file in the root directory of this source tree.
  */
 
+#include <fb303/ServiceData.h>
 #include <folly/IPAddress.h>
 #include <folly/init/Init.h>
 #include <glog/logging.h>
@@ -2692,9 +2693,17 @@ TEST(PrefixManagerPendingUpdates, updatePrefixes) {
       updates.getChangedPrefixes(),
       testing::UnorderedElementsAre(network1, network2));
 
+  // label change is tracked separately from prefix change
+  updates.addLabelChange(label1);
+  EXPECT_TRUE(updates.hasLabel(label1));
+  EXPECT_FALSE(updates.hasLabel(label2));
+  EXPECT_THAT(updates.getChangedLabels(), testing::UnorderedElementsAre(label1));
+  EXPECT_EQ(3, updates.size());
+
   // cleanup
   updates.clear();
   EXPECT_TRUE(updates.getChangedPrefixes().empty());
+  EXPECT_TRUE(updates.getChangedLabels().empty());
 }
 
 class RouteOriginationKnobTestFixture : public PrefixManagerTestFixture {
@@ -3305,6 +3314,231 @@ TEST_F(PrefixManagerTestFixture, AdvertisePrefixes) {
   evb.run();
 }
 
+/**
+ * Verifies that a KvStore sync only visits prefixes affected by pending
+ * updates. Changing one prefix among many re-advertises only its key, i.e.
+ * version of all other keys is retained.
+ */
+TEST_F(PrefixManagerTestFixture, SyncOnlyChangedPrefix) {
+  int scheduleAt{0};
+  const std::vector<thrift::PrefixEntry> prefixEntries{
+      prefixEntry1,
+      prefixEntry2,
+      prefixEntry3,
+      prefixEntry4,
+      prefixEntry5,
+      prefixEntry6,
+      prefixEntry7,
+      prefixEntry8};
+  auto getVersion = [&](const thrift::PrefixEntry& entry) {
+    auto maybeValue = kvStoreWrapper->getKey(
+        kTestingAreaName,
+        PrefixKey(nodeId_, toIPNetwork(*entry.prefix()), kTestingAreaName)
+            .getPrefixKeyV2());
+    EXPECT_TRUE(maybeValue.has_value());
+    return maybeValue.has_value() ? *maybeValue->version() : 0;
+  };
+  auto getNumAdvertisements = []() {
+    return facebook::fb303::fbData->getCounters().at(
+        "prefix_manager.route_advertisements.sum");
+  };
+  int64_t numAdvertisements{0};
+
+  evb.scheduleTimeout(
+      std::chrono::milliseconds(scheduleAt += 0), [&]() noexcept {
+        prefixManager->advertisePrefixes(prefixEntries).get();
+      });
+
+  evb.scheduleTimeout(
+      std::chrono::milliseconds(
+          scheduleAt += 3 * Constants::kKvStoreSyncThrottleTimeout.count()),
+      [&]() noexcept {
+        for (const auto& entry : prefixEntries) {
+          EXPECT_EQ(1, getVersion(entry));
+        }
+        numAdvertisements = getNumAdvertisements();
+
+        // Change metrics of one prefix only
+        auto changedEntry = prefixEntry3;
+        changedEntry.metrics()->path_preference() = 100;
+        prefixManager->advertisePrefixes({changedEntry}).get();
+      });
+
+  evb.scheduleTimeout(
+      std::chrono::milliseconds(
+          scheduleAt += 3 * Constants::kKvStoreSyncThrottleTimeout.count()),
+      [&]() noexcept {
+        EXPECT_EQ(numAdvertisements + 1, getNumAdvertisements());
+        for (const auto& entry : prefixEntries) {
+          EXPECT_EQ(entry == prefixEntry3 ? 2 : 1, getVersion(entry));
+        }
+        evb.stop();
+      });
+
+  evb.run();
+}
+
+/**
+ * Verifies that programming of a label route resyncs only prefixes gated on
+ * that label, and the prefixes awaiting other labels keep waiting.
+ */
+TEST_F(PrefixManagerTestFixture, SyncLabelDependentPrefixes) {
+  int scheduleAt{0};
+  auto prefixDbMarker = Constants::kPrefixDbMarker.toString() + nodeId_;
+  auto getCounter = [](const std::string& key) {
+    return facebook::fb303::fbData->getCounters().at(key);
+  };
+  int64_t numAdvertisements{0};
+
+  evb.scheduleTimeout(
+      std::chrono::milliseconds(scheduleAt += 0), [&]() noexcept {
+        // Prefixes gated on label1 and label2 along with one without label
+        prefixUpdatesQueue.push(PrefixEvent(
+            PrefixEventType::ADD_PREFIXES,
+            thrift::PrefixType::BGP,
+            {prefixEntry1WithLabel1,
+             prefixEntry2WithLabel1,
+             prefixEntry3WithLabel2}));
+        prefixManager->advertisePrefixes({prefixEntry5}).get();
+      });
+
+  evb.scheduleTimeout(
+      std::chrono::milliseconds(
+          scheduleAt += 3 * Constants::kKvStoreSyncThrottleTimeout.count()),
+      [&]() {
+        EXPECT_EQ(1, getNumPrefixes(prefixDbMarker));
+        EXPECT_EQ(3, getCounter("prefix_manager.awaiting_prefixes"));
+        numAdvertisements =
+            getCounter("prefix_manager.route_advertisements.sum");
+
+        // Label route of label1 got programmed
+        DecisionRouteUpdate routeUpdates;
+        routeUpdates.type = DecisionRouteUpdate::INCREMENTAL;
+        routeUpdates.mplsRoutesToUpdate = {{label1, RibMplsEntry(label1)}};
+        fibRouteUpdatesQueue.push(std::move(routeUpdates));
+      });
+
+  evb.scheduleTimeout(
+      std::chrono::milliseconds(
+          scheduleAt += 3 * Constants::kKvStoreSyncThrottleTimeout.count()),
+      [&]() {
+        // Only prefixes gated on label1 got advertised
+        EXPECT_EQ(3, getNumPrefixes(prefixDbMarker));
+        EXPECT_EQ(1, getCounter("prefix_manager.awaiting_prefixes"));
+        EXPECT_EQ(
+            numAdvertisements + 2,
+            getCounter("prefix_manager.route_advertisements.sum"));
+
+        // Label route of label2 got programmed
+        DecisionRouteUpdate routeUpdates;
+        routeUpdates.type = DecisionRouteUpdate::INCREMENTAL;
+        routeUpdates.mplsRoutesToUpdate = {{label2, RibMplsEntry(label2)}};
+        fibRouteUpdatesQueue.push(std::move(routeUpdates));
+      });
+
+  evb.scheduleTimeout(
+      std::chrono::milliseconds(
+          scheduleAt += 3 * Constants::kKvStoreSyncThrottleTimeout.count()),
+      [&]() {
+        EXPECT_EQ(4, getNumPrefixes(prefixDbMarker));
+        EXPECT_EQ(0, getCounter("prefix_manager.awaiting_prefixes"));
+        EXPECT_EQ(
+            numAdvertisements + 3,
+            getCounter("prefix_manager.route_advertisements.sum"));
+        evb.stop();
+      });
+
+  evb.run();
+}
+
+class PrefixManagerBundleTestFixture : public PrefixManagerTestFixture {
+ protected:
+  thrift::OpenrConfig
+  createConfig() override {
+    auto tConfig = getBasicOpenrConfig(nodeId_);
+    // ATTN: single shard to pack all prefixes into one bundle
+    tConfig.prefix_bundle_shards() = 1;
+    return tConfig;
+  }
+
+  std::optional<thrift::PrefixDatabase>
+  getBundle() {
+    auto maybeValue = kvStoreWrapper->getKey(
+        kTestingAreaName,
+        PrefixBundleKey(nodeId_, 0, kTestingAreaName).getPrefixBundleKeyStr());
+    if (not maybeValue.has_value()) {
+      return std::nullopt;
+    }
+    return readThriftObjStr<thrift::PrefixDatabase>(
+        maybeValue->value().value(), serializer);
+  }
+};
+
+/**
+ * Verifies prefixes are packed into bundle key instead of per-prefix keys:
+ * 1. Advertise 3 prefixes. Single bundle carries all of them.
+ * 2. Withdraw 1 prefix. Bundle is rewritten with remaining prefixes.
+ * 3. Withdraw all prefixes. Bundle is marked as deleted.
+ */
+TEST_F(PrefixManagerBundleTestFixture, AdvertiseWithdrawInBundle) {
+  int scheduleAt{0};
+
+  evb.scheduleTimeout(
+      std::chrono::milliseconds(scheduleAt += 0), [&]() noexcept {
+        prefixManager
+            ->advertisePrefixes({prefixEntry1, prefixEntry2, prefixEntry3})
+            .get();
+      });
+
+  evb.scheduleTimeout(
+      std::chrono::milliseconds(
+          scheduleAt += 3 * Constants::kKvStoreSyncThrottleTimeout.count()),
+      [&]() noexcept {
+        auto maybeBundle = getBundle();
+        ASSERT_TRUE(maybeBundle.has_value());
+        EXPECT_FALSE(*maybeBundle->deletePrefix());
+        EXPECT_THAT(
+            *maybeBundle->prefixEntries(),
+            testing::UnorderedElementsAre(
+                prefixEntry1, prefixEntry2, prefixEntry3));
+
+        // No per-prefix key is advertised
+        auto prefixKey1 = PrefixKey(
+            nodeId_, toIPNetwork(*prefixEntry1.prefix()), kTestingAreaName);
+        EXPECT_FALSE(
+            kvStoreWrapper->getKey(kTestingAreaName, prefixKey1.getPrefixKeyV2())
+                .has_value());
+
+        prefixManager->withdrawPrefixes({prefixEntry1}).get();
+      });
+
+  evb.scheduleTimeout(
+      std::chrono::milliseconds(
+          scheduleAt += 3 * Constants::kKvStoreSyncThrottleTimeout.count()),
+      [&]() noexcept {
+        auto maybeBundle = getBundle();
+        ASSERT_TRUE(maybeBundle.has_value());
+        EXPECT_FALSE(*maybeBundle->deletePrefix());
+        EXPECT_THAT(
+            *maybeBundle->prefixEntries(),
+            testing::UnorderedElementsAre(prefixEntry2, prefixEntry3));
+
+        prefixManager->withdrawPrefixes({prefixEntry2, prefixEntry3}).get();
+      });
+
+  evb.scheduleTimeout(
+      std::chrono::milliseconds(
+          scheduleAt += 3 * Constants::kKvStoreSyncThrottleTimeout.count()),
+      [&]() noexcept {
+        auto maybeBundle = getBundle();
+        ASSERT_TRUE(maybeBundle.has_value());
+        EXPECT_TRUE(*maybeBundle->deletePrefix());
+        evb.stop();
+      });
+
+  evb.run();
+}
+
 TEST_F(PrefixManagerTestFixture, WithdrawPrefix) {
   int scheduleAt{0};
   auto prefixKeyStr =
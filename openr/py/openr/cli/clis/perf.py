@@ -23,8 +23,14 @@ class PerfCli(object):
 
 class ViewFibCli(object):
     @click.command()
+    @click.option(
+        "--slowest",
+        is_flag=True,
+        default=False,
+        help="Show slowest convergence events instead of latest ones",
+    )
     @click.pass_obj
-    def fib(cli_opts):  # noqa: B902
+    def fib(cli_opts, slowest):  # noqa: B902
         """View latest perf log of fib module from this node"""
 
-        perf.ViewFibCmd(cli_opts).run()
+        perf.ViewFibCmd(cli_opts).run(slowest)
@@ -16,10 +16,14 @@ class ViewFibCmd(OpenrCtrlCmd):
     async def _run(
         self,
         client: OpenrCtrlCppClient.Async,
+        slowest: bool = False,
         *args,
         **kwargs,
     ) -> None:
-        resp = await client.getPerfDb()
+        if slowest:
+            resp = await client.getSlowestPerfDb()
+        else:
+            resp = await client.getPerfDb()
         headers = ["Node", "Events", "Duration", "Unix Timestamp"]
         for i in range(len(resp.eventInfo)):
             rows = []
@@ -223,7 +223,7 @@ OpenrWrapper<Serializer>::OpenrWrapper(
       Constants::kPrefixAllocatorSyncInterval);
 
   // Watchdog thread to monitor thread aliveness
-  watchdog = std::make_unique<Watchdog>(config_);
+  watchdog = std::make_unique<Watchdog>(config_, logSampleQueue_);
 }
 
 template <class Serializer>
@@ -48,10 +48,12 @@ MockNetlinkFibHandler::addUnicastRoutes(
 
   // Update routes
   std::vector<thrift::IpPrefix> failedPrefixes;
+  UnicastCall call{true, {}};
   for (auto const& route : *routes) {
     auto prefix = std::make_pair(
         toIPAddress(*route.dest()->prefixAddress()),
         *route.dest()->prefixLength());
+    call.prefixes.emplace_back(prefix);
 
     if (dirtyPrefixes->count(prefix)) {
       failedPrefixes.emplace_back(*route.dest());
@@ -68,6 +70,7 @@ MockNetlinkFibHandler::addUnicastRoutes(
     unicastRouteDb->emplace(prefix, newNextHops);
   }
   addRoutesCount_ += routes->size() - failedPrefixes.size();
+  unicastCalls_.wlock()->emplace_back(std::move(call));
   updateUnicastRoutesBaton_.post();
 
   // Throw FibUpdateError if applicable
@@ -87,13 +90,16 @@ MockNetlinkFibHandler::deleteUnicastRoutes(
   auto unicastRouteDb = unicastRouteDb_.wlock();
 
   // Delete routes
+  UnicastCall call{false, {}};
   for (auto const& prefix : *prefixes) {
     auto myPrefix = std::make_pair(
         toIPAddress(*prefix.prefixAddress()), *prefix.prefixLength());
 
     unicastRouteDb->erase(myPrefix);
+    call.prefixes.emplace_back(myPrefix);
   }
   delRoutesCount_ += prefixes->size();
+  unicastCalls_.wlock()->emplace_back(std::move(call));
   deleteUnicastRoutesBaton_.post();
 }
 
@@ -22,6 +22,12 @@ using NextHops = std::unordered_set<std::pair<std::string, folly::IPAddress>>;
 // Route => prefix and its possible nextHops
 using UnicastRoutes = std::unordered_map<folly::CIDRNetwork, NextHops>;
 
+// Unicast route add (or delete) call and prefixes it carried
+struct UnicastCall {
+  bool isAdd{true};
+  std::vector<folly::CIDRNetwork> prefixes;
+};
+
 /**
  * This class implements Netlink Platform thrift interface for programming
  * NetlinkEvent Publisher as well as Fib Service on linux platform.
@@ -114,6 +120,19 @@ class MockNetlinkFibHandler final : public thrift::FibServiceSvIf {
     return delMplsRoutesCount_;
   }
 
+  /**
+   * Unicast route add/delete calls in order of arrival, with prefixes in
+   * order of the call, including prefixes that failed to program.
+   */
+  std::vector<UnicastCall>
+  getUnicastCalls() {
+    return *unicastCalls_.rlock();
+  }
+  void
+  clearUnicastCalls() {
+    unicastCalls_.wlock()->clear();
+  }
+
   void
   setHandlerHealthyState(bool isHealthy) {
     isHealthy_ = isHealthy;
@@ -146,6 +165,9 @@ class MockNetlinkFibHandler final : public thrift::FibServiceSvIf {
       std::unordered_map<int32_t, std::vector<thrift::NextHopThrift>>>
       mplsRouteDb_;
 
+  // Log of unicast route add/delete calls
+  folly::Synchronized<std::vector<UnicastCall>> unicastCalls_;
+
   // Dirty prefixes & labels in HW, and also won't be accepted from clients
   folly::Synchronized<std::unordered_set<folly::CIDRNetwork>> dirtyPrefixes_;
   folly::Synchronized<std::unordered_set<int32_t>> dirtyLabels_;
@@ -66,6 +66,9 @@ MockNetlinkProtocolSocket::addRoute(const fbnl::Route& route) {
   } else {
     unicastRoutes_[proto][route.getDestination()] = route;
   }
+  if (routeEventCallback_) {
+    routeEventCallback_(route);
+  }
   return folly::SemiFuture<int>(0);
 }
 
@@ -80,12 +83,24 @@ MockNetlinkProtocolSocket::deleteRoute(const fbnl::Route& route) {
   } else {
     cnt = unicastRoutes_[proto].erase(route.getDestination());
   }
+  if (cnt and routeEventCallback_) {
+    // Deleted routes are notified as invalid routes
+    fbnl::RouteBuilder builder;
+    builder.setProtocolId(proto).setValid(false);
+    if (route.getFamily() == AF_MPLS) {
+      builder.setMplsLabel(route.getMplsLabel().value());
+    } else {
+      builder.setDestination(route.getDestination());
+    }
+    routeEventCallback_(builder.build());
+  }
   // Return 0 on success else ESRCH (no such process) error code
   return folly::SemiFuture<int>(cnt ? 0 : ESRCH);
 }
 
 folly::SemiFuture<folly::Expected<std::vector<fbnl::Route>, int>>
 MockNetlinkProtocolSocket::getRoutes(const fbnl::Route& filter) {
+  ++numRouteDumps_;
   const auto filterFamily = filter.getFamily();
   const auto filterProto = filter.getProtocolId();
   const auto filterType = filter.getType();
@@ -127,6 +142,18 @@ MockNetlinkProtocolSocket::getRoutes(const fbnl::Route& filter) {
   return result;
 }
 
+void
+MockNetlinkProtocolSocket::subscribeRouteEvents(RouteEventCallback callback) {
+  routeEventCallback_ = std::move(callback);
+}
+
+void
+MockNetlinkProtocolSocket::notifyRouteEventsLost() {
+  if (routeEventCallback_) {
+    routeEventCallback_(std::nullopt);
+  }
+}
+
 folly::SemiFuture<int>
 MockNetlinkProtocolSocket::addIfAddress(const fbnl::IfAddress& addr) {
   // Search for addr list of interface index (it must exists)
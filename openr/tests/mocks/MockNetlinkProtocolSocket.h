@@ -55,6 +55,21 @@ class MockNetlinkProtocolSocket : public NetlinkProtocolSocket {
   folly::SemiFuture<folly::Expected<std::vector<fbnl::Route>, int>> getRoutes(
       const fbnl::Route& filter) override;
 
+  /**
+   * Route notifications are delivered synchronously on route add/delete
+   */
+  void subscribeRouteEvents(RouteEventCallback callback) override;
+
+  /**
+   * API to simulate loss of route notifications e.g. on buffer overflow
+   */
+  void notifyRouteEventsLost();
+
+  size_t
+  getNumRouteDumps() const {
+    return numRouteDumps_;
+  }
+
   folly::SemiFuture<int> addIfAddress(const fbnl::IfAddress&) override;
   folly::SemiFuture<int> deleteIfAddress(const fbnl::IfAddress&) override;
   folly::SemiFuture<folly::Expected<std::vector<fbnl::IfAddress>, int>>
@@ -105,6 +120,12 @@ class MockNetlinkProtocolSocket : public NetlinkProtocolSocket {
       unicastRoutes_;
   std::unordered_map<uint8_t, std::map<uint32_t, fbnl::Route>> mplsRoutes_;
 
+  // Number of `getRoutes` calls
+  size_t numRouteDumps_{0};
+
+  // Receiver of route notifications, if subscribed
+  RouteEventCallback routeEventCallback_;
+
   // queue to publish LINK/ADDR updates
   messaging::ReplicateQueue<NetlinkEvent> netlinkEventsQueue_;
 };
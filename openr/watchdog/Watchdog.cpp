@@ -15,12 +15,20 @@ namespace fb303 = facebook::fb303;
 
 namespace openr {
 
-Watchdog::Watchdog(std::shared_ptr<const Config> config)
+Watchdog::Watchdog(
+    std::shared_ptr<const Config> config,
+    messaging::ReplicateQueue<LogSample>& logSampleQueue)
     : myNodeName_(config->getNodeName()),
       interval_(*config->getWatchdogConfig().interval_s()),
       threadTimeout_(*config->getWatchdogConfig().thread_timeout_s()),
+      evbStallThreshold_(std::max(
+          threadTimeout_ / Constants::kEvbStallTimeoutDivisor,
+          Constants::kEvbStallThresholdMin)),
       maxMemoryMB_(*config->getWatchdogConfig().max_memory_mb()),
-      isDeadThreadDetected_(false) {
+      isDeadThreadDetected_(false),
+      logSampleQueue_(logSampleQueue) {
+  fb303::fbData->addStatExportType("watchdog.evb_stalls", fb303::COUNT);
+
   // Schedule periodic timer for checking thread health
   watchdogTimer_ = folly::AsyncTimeout::make(*getEvb(), [this]() noexcept {
     // check dead thread
@@ -114,6 +122,20 @@ Watchdog::monitorThreadStatus() {
     XLOG(DBG4) << "Thread " << name << ", " << (now - lastTs).count()
                << " seconds ever since last thread activity";
 
+    // Report stall once, well before thread is considered dead. Timestamp is
+    // refreshed every second by a healthy eventbase.
+    if (timeDiff > evbStallThreshold_) {
+      if (stalledEvbs_.emplace(evb).second) {
+        logEvbStall(
+            evb,
+            std::chrono::duration_cast<std::chrono::milliseconds>(
+                now - lastTs));
+      }
+    } else if (stalledEvbs_.erase(evb)) {
+      XLOG(INFO) << "[Dead Thread Detector] " << name << " thread recovered "
+                 << "from stall.";
+    }
+
     if (timeDiff > threadTimeout_) {
       XLOG(WARNING) << fmt::format(
           "[Dead Thread Detector] {} thread detected to be dead.", name);
@@ -155,9 +177,54 @@ Watchdog::updateThreadCounters() {
     fb303::fbData->setCounter(
         fmt::format("watchdog.evb_queue_size.{}", evb->getEvbName()),
         evb->getEvb()->getNotificationQueueSize());
+
+    // Record loop busy time distribution since last interval
+    const auto loopStats = evb->getAndResetLoopStats();
+    if (loopStats.numLoops == 0) {
+      continue;
+    }
+    auto& maxBusyTimeUs = maxLoopBusyTimeUs_[evb];
+    maxBusyTimeUs = std::max(maxBusyTimeUs, loopStats.maxBusyTimeUs);
+    fb303::fbData->setCounter(
+        fmt::format("watchdog.evb_loop_busy_us.p50.{}", evb->getEvbName()),
+        loopStats.busyTimeUs.getPercentileEstimate(0.5));
+    fb303::fbData->setCounter(
+        fmt::format("watchdog.evb_loop_busy_us.p99.{}", evb->getEvbName()),
+        loopStats.busyTimeUs.getPercentileEstimate(0.99));
+    fb303::fbData->setCounter(
+        fmt::format("watchdog.evb_loop_busy_us.max.{}", evb->getEvbName()),
+        loopStats.maxBusyTimeUs);
+    fb303::fbData->setCounter(
+        fmt::format("watchdog.evb_loops.{}", evb->getEvbName()),
+        loopStats.numLoops);
   }
 }
 
+void
+Watchdog::logEvbStall(
+    OpenrEventBase* evb, std::chrono::milliseconds stallTime) noexcept {
+  const auto& name = evb->getEvbName();
+  XLOG(WARNING) << fmt::format(
+      "[Dead Thread Detector] {} thread stalled for {}ms. Max loop busy time "
+      "before stall: {}us.",
+      name,
+      stallTime.count(),
+      maxLoopBusyTimeUs_[evb]);
+  fb303::fbData->addStatValue("watchdog.evb_stalls", 1, fb303::COUNT);
+
+  LogSample sample{};
+  sample.addString("event", "EVB_STALL");
+  sample.addString("evb_name", name);
+  sample.addInt("stall_time_ms", stallTime.count());
+  sample.addInt("max_loop_busy_time_us", maxLoopBusyTimeUs_[evb]);
+  sample.addInt(
+      "notification_queue_size", evb->getEvb()->getNotificationQueueSize());
+  logSampleQueue_.push(std::move(sample));
+
+  // Start tracking max busy time afresh for next stall
+  maxLoopBusyTimeUs_[evb] = 0;
+}
+
 void
 Watchdog::fireCrash(const std::string& msg) {
   SYSLOG(ERROR) << msg;
@@ -196,6 +263,15 @@ Watchdog::updateQueueCounters() {
       fb303::fbData->setCounter(
           fmt::format("messaging.rw_queue.{}-{}.sent", qName, stat.queueId),
           stat.writes);
+
+      fb303::fbData->setCounter(
+          fmt::format("messaging.rw_queue.{}-{}.max_size", qName, stat.queueId),
+          stat.maxSize);
+
+      fb303::fbData->setCounter(
+          fmt::format(
+              "messaging.rw_queue.{}-{}.coalesced", qName, stat.queueId),
+          stat.coalesced);
     }
   }
 }
@@ -13,13 +13,16 @@
 #include <openr/common/OpenrEventBase.h>
 #include <openr/config/Config.h>
 #include <openr/messaging/ReplicateQueue.h>
+#include <openr/monitor/LogSample.h>
 #include <openr/monitor/SystemMetrics.h>
 
 namespace openr {
 
 class Watchdog final : public OpenrEventBase {
  public:
-  explicit Watchdog(std::shared_ptr<const Config> config);
+  Watchdog(
+      std::shared_ptr<const Config> config,
+      messaging::ReplicateQueue<LogSample>& logSampleQueue);
 
   // non-copyable
   Watchdog(Watchdog const&) = delete;
@@ -44,6 +47,10 @@ class Watchdog final : public OpenrEventBase {
   // update per-eventbase related counters
   void updateThreadCounters();
 
+  // report stalled eventbase to event log
+  void logEvbStall(
+      OpenrEventBase* evb, std::chrono::milliseconds stallTime) noexcept;
+
   // update counters for each ReplicatedQueue and its internal RWQueues
   void updateQueueCounters();
 
@@ -67,12 +74,24 @@ class Watchdog final : public OpenrEventBase {
   // thread healthcheck threshold
   std::chrono::seconds threadTimeout_;
 
+  // thread stall threshold, derived from threadTimeout_
+  std::chrono::seconds evbStallThreshold_;
+
   // critcal memory threhsold
   uint32_t maxMemoryMB_{0};
 
   // boolean to indicate previous failure
   bool isDeadThreadDetected_{false};
 
+  // Eventbases reported as stalled, not yet recovered
+  folly::F14FastSet<OpenrEventBase*> stalledEvbs_;
+
+  // Max loop busy time of eventbase since its last stall report
+  folly::F14FastMap<OpenrEventBase*, int64_t> maxLoopBusyTimeUs_;
+
+  // Queue to publish the event log
+  messaging::ReplicateQueue<LogSample>& logSampleQueue_;
+
   // amount of time memory usage sustained above memory limit
   std::optional<std::chrono::steady_clock::time_point> memExceedTime_;
 
@@ -12,6 +12,7 @@
 
 #include <fb303/ServiceData.h>
 #include <folly/init/Init.h>
+#include <openr/common/Constants.h>
 #include <openr/tests/utils/Utils.h>
 #include <openr/watchdog/Watchdog.h>
 
@@ -21,6 +22,10 @@ using namespace openr;
 
 namespace {
 const std::chrono::seconds kWatchdogInterval{2};
+const std::chrono::seconds kThreadTimeout{60};
+// Stall threshold derived by Watchdog from kThreadTimeout
+const std::chrono::seconds kEvbStallThreshold{
+    kThreadTimeout / Constants::kEvbStallTimeoutDivisor};
 } // namespace
 
 class WatchdogTestFixture : public ::testing::Test {
@@ -30,6 +35,7 @@ class WatchdogTestFixture : public ::testing::Test {
     // create config
     thrift::WatchdogConfig watchdogConf;
     watchdogConf.interval_s() = kWatchdogInterval.count();
+    watchdogConf.thread_timeout_s() = kThreadTimeout.count();
 
     auto tConfig = getBasicOpenrConfig(nodeId_);
     tConfig.watchdog_config() = watchdogConf;
@@ -37,7 +43,7 @@ class WatchdogTestFixture : public ::testing::Test {
     config_ = std::make_shared<Config>(tConfig);
 
     // spawn watchdog thread
-    watchdog_ = std::make_unique<Watchdog>(config_);
+    watchdog_ = std::make_unique<Watchdog>(config_, logSampleQueue_);
 
     watchdogThread_ = std::make_unique<std::thread>([this]() {
       LOG(INFO) << "Starting watchdog thread...";
@@ -69,6 +75,7 @@ class WatchdogTestFixture : public ::testing::Test {
 
   void
   TearDown() override {
+    logSampleQueue_.close();
     watchdog_->stop();
     watchdogThread_->join();
     watchdog_.reset();
@@ -81,6 +88,9 @@ class WatchdogTestFixture : public ::testing::Test {
   // config
   std::shared_ptr<Config> config_;
 
+  // event log queue
+  messaging::ReplicateQueue<LogSample> logSampleQueue_;
+
   // watchdog
   std::unique_ptr<Watchdog> watchdog_;
   std::unique_ptr<std::thread> watchdogThread_;
@@ -206,6 +216,58 @@ TEST_F(WatchdogTestFixture, QueueCounterReport) {
   teardownDummyEvb();
 }
 
+TEST_F(WatchdogTestFixture, LoopBusyCounterReport) {
+  fb303::fbData->resetAllData();
+
+  setupDummyEvb();
+
+  // Hog dummyEvb for a while within single loop iteration
+  const std::chrono::milliseconds kBusyTime{50};
+  dummyEvb_->runInEventBaseThread(
+      [kBusyTime]() { std::this_thread::sleep_for(kBusyTime); });
+
+  OpenrEventBase evb;
+  evb.scheduleTimeout(
+      std::chrono::seconds(1 + kWatchdogInterval.count()), [&]() {
+        const auto name = dummyEvb_->getEvbName();
+        auto counters = fb303::fbData->getCounters();
+        ASSERT_TRUE(counters.count(
+            fmt::format("watchdog.evb_loop_busy_us.p50.{}", name)));
+        ASSERT_TRUE(counters.count(
+            fmt::format("watchdog.evb_loop_busy_us.p99.{}", name)));
+        EXPECT_GE(
+            counters.at(fmt::format("watchdog.evb_loop_busy_us.max.{}", name)),
+            std::chrono::microseconds(kBusyTime).count());
+        EXPECT_GT(counters.at(fmt::format("watchdog.evb_loops.{}", name)), 0);
+        evb.stop();
+      });
+
+  evb.run();
+  teardownDummyEvb();
+}
+
+TEST_F(WatchdogTestFixture, StallEventLog) {
+  auto logSampleReader = logSampleQueue_.getReader();
+  setupDummyEvb();
+
+  // Stall dummyEvb beyond stall threshold but well within thread timeout
+  dummyEvb_->runInEventBaseThread([]() {
+    std::this_thread::sleep_for(kEvbStallThreshold + 2 * kWatchdogInterval);
+  });
+
+  // Stall is reported to event log exactly once
+  auto maybeLog = logSampleReader.get();
+  ASSERT_TRUE(maybeLog.hasValue());
+  EXPECT_EQ("EVB_STALL", maybeLog->getString("event"));
+  EXPECT_EQ(dummyEvb_->getEvbName(), maybeLog->getString("evb_name"));
+  EXPECT_GT(
+      maybeLog->getInt("stall_time_ms"),
+      std::chrono::milliseconds(kEvbStallThreshold).count());
+  EXPECT_EQ(0, logSampleReader.size());
+
+  teardownDummyEvb();
+}
+
 int
 main(int argc, char* argv[]) {
   // Parse command line flags